@@ -0,0 +1,162 @@
+#include "Benchmark.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace sparky {
+	namespace bench {
+
+		volatile float g_Sink = 0.0f;
+		const void* volatile g_PtrSink = nullptr;
+
+		Runner::Runner(int argc, char** argv)
+		{
+			for (int i = 1; i + 1 < argc; i += 2) {
+				if (!strcmp(argv[i], "--filter"))
+					m_Filter = argv[i + 1];
+				else if (!strcmp(argv[i], "--json"))
+					m_JsonPath = argv[i + 1];
+				else if (!strcmp(argv[i], "--time"))
+					m_MinTimeNs = atof(argv[i + 1]) * 1e9;
+				else if (!strcmp(argv[i], "--baseline")) {
+					std::ifstream file(argv[i + 1]);
+					std::stringstream ss;
+					ss << file.rdbuf();
+					m_Baseline = ss.str();
+					if (m_Baseline.empty())
+						printf("warning: baseline %s is empty or missing\n", argv[i + 1]);
+				}
+				else
+					printf("warning: unknown option %s\n", argv[i]);
+			}
+
+			printf("%-40s %10s %10s %10s %10s %10s %8s\n", "benchmark", "mean ns", "p50", "p90", "p99", "max", m_Baseline.empty() ? "" : "vs base");
+		}
+
+		bool Runner::IsSelected(const char* name) const
+		{
+			return m_Filter.empty() || strstr(name, m_Filter.c_str()) != nullptr;
+		}
+
+		static double Percentile(const std::vector<double>& sorted, double p)
+		{
+			size_t i = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+			return sorted[i];
+		}
+
+		void Runner::Record(const char* name, std::vector<double>& samples)
+		{
+			if (m_RowPending)
+				PrintRow(m_Results.back());
+
+			std::sort(samples.begin(), samples.end());
+			double sum = 0.0;
+			for (double s : samples)
+				sum += s;
+
+			Result r;
+			r.Name = name;
+			r.Mean = sum / (double)samples.size();
+			r.Min = samples.front();
+			r.P50 = Percentile(samples, 0.50);
+			r.P90 = Percentile(samples, 0.90);
+			r.P99 = Percentile(samples, 0.99);
+			r.Max = samples.back();
+			r.Samples = samples.size();
+			m_Results.push_back(r);
+
+			// the row is printed once the counters for it are known
+			m_LastRan = true;
+			m_RowPending = true;
+		}
+
+		void Runner::Counter(const char* name, double value)
+		{
+			if (m_LastRan)
+				m_Results.back().Counters.emplace_back(name, value);
+		}
+
+		double Runner::BaselineP50(const std::string& name) const
+		{
+			// the baseline is a file written by WriteJson, so a plain search is enough
+			size_t at = m_Baseline.find("\"name\": \"" + name + "\"");
+			if (at == std::string::npos)
+				return 0.0;
+			at = m_Baseline.find("\"p50\": ", at);
+			return at == std::string::npos ? 0.0 : atof(m_Baseline.c_str() + at + 7);
+		}
+
+		void Runner::PrintRow(const Result& r) const
+		{
+			char delta[32] = "";
+			double base = BaselineP50(r.Name);
+			if (base > 0.0)
+				snprintf(delta, sizeof(delta), "%+.1f%%", (r.P50 / base - 1.0) * 100.0);
+
+			printf("%-40s %10.2f %10.2f %10.2f %10.2f %10.2f %8s", r.Name.c_str(), r.Mean, r.P50, r.P90, r.P99, r.Max, delta);
+			for (const auto& c : r.Counters)
+				printf("  %s=%.4g", c.first.c_str(), c.second);
+			printf("\n");
+		}
+
+		bool Runner::WriteJson(const char* path) const
+		{
+			FILE* file = fopen(path, "w");
+			if (!file)
+				return false;
+
+			const char* simd = SPARKY_SIMD_AVX ? "avx" : SPARKY_SIMD_SSE ? "sse" : "scalar";
+#if defined(_MSC_VER)
+			fprintf(file, "{\n  \"compiler\": \"msvc %d\",\n", _MSC_VER);
+#else
+			fprintf(file, "{\n  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+			fprintf(file, "  \"simd\": \"%s\",\n  \"benchmarks\": [\n", simd);
+			for (size_t i = 0; i < m_Results.size(); ++i) {
+				const Result& r = m_Results[i];
+				fprintf(file, "    { \"name\": \"%s\", \"mean\": %.4f, \"min\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f, \"samples\": %zu",
+					r.Name.c_str(), r.Mean, r.Min, r.P50, r.P90, r.P99, r.Max, r.Samples);
+				for (const auto& c : r.Counters)
+					fprintf(file, ", \"%s\": %.6g", c.first.c_str(), c.second);
+				fprintf(file, " }%s\n", i + 1 < m_Results.size() ? "," : "");
+			}
+			fprintf(file, "  ]\n}\n");
+			fclose(file);
+			return true;
+		}
+
+		void Runner::Check(const char* name, bool passed, const std::string& detail)
+		{
+			if (!IsSelected(name))
+				return;
+			if (m_RowPending)
+				PrintRow(m_Results.back());
+			m_RowPending = false;
+			printf("%-40s %s %s\n", name, passed ? "ok" : "FAILED", detail.c_str());
+			if (!passed)
+				m_FailedChecks++;
+		}
+
+		int Runner::Finish()
+		{
+			if (m_RowPending)
+				PrintRow(m_Results.back());
+			m_RowPending = false;
+
+			if (m_FailedChecks) {
+				printf("error: %zu checks failed\n", m_FailedChecks);
+				return 1;
+			}
+
+			if (!m_JsonPath.empty() && !WriteJson(m_JsonPath.c_str())) {
+				printf("error: could not write %s\n", m_JsonPath.c_str());
+				return 1;
+			}
+			return 0;
+		}
+	}
+}
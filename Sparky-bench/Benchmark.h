@@ -0,0 +1,109 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Sparky-bench harness. Every benchmark is a callable timed in batches; each
+// batch gives one ns/op sample, so the report carries percentiles as well as
+// the mean. Results can be written as JSON and compared against a previous run:
+//   Sparky-bench --json after.json --baseline before.json --filter maths/
+
+namespace sparky {
+	namespace bench {
+
+		// Results are folded into these so the optimiser cannot drop the measured work
+		extern volatile float g_Sink;
+		extern const void* volatile g_PtrSink;
+
+		inline void Consume(float value) { g_Sink = g_Sink + value; }
+		inline void Consume(const void* p) { g_PtrSink = p; }
+
+		struct Result
+		{
+			std::string Name;
+			double Mean, Min, P50, P90, P99, Max;
+			size_t Samples;
+			std::vector<std::pair<std::string, double>> Counters;
+		};
+
+		class Runner
+		{
+		public:
+			// --filter <text> --json <file> --baseline <file> --time <seconds>
+			Runner(int argc, char** argv);
+
+			// Times fn(), which performs opsPerCall operations on every call
+			template<typename F>
+			void Run(const char* name, size_t opsPerCall, F&& fn)
+			{
+				m_LastRan = false;
+				if (!IsSelected(name))
+					return;
+
+				fn(); // warm up caches
+
+				// grow the batch until one sample is well above the clock resolution
+				size_t batch = 1;
+				while (TimeBatch(fn, batch) < m_SampleNs && batch < (1u << 30))
+					batch *= 2;
+
+				std::vector<double> samples;
+				double total = 0.0;
+				while ((samples.size() < m_MinSamples || total < m_MinTimeNs) && samples.size() < m_MaxSamples) {
+					double ns = TimeBatch(fn, batch);
+					samples.push_back(ns / (double)(batch * opsPerCall));
+					total += ns;
+				}
+				Record(name, samples);
+			}
+
+			// Extra value reported next to the last benchmark, e.g. MB/s or a hit rate
+			void Counter(const char* name, double value);
+			// The last benchmark's result, nullptr if the filter skipped it
+			const Result* LastResult() const { return m_LastRan ? &m_Results.back() : nullptr; }
+
+			// Correctness check run next to the benchmarks, a failed one fails the run
+			void Check(const char* name, bool passed, const std::string& detail = std::string());
+
+			// Prints anything still pending and writes the JSON file, returns the exit code
+			int Finish();
+
+			bool IsSelected(const char* name) const;
+		private:
+			template<typename F>
+			static double TimeBatch(F& fn, size_t batch)
+			{
+				using clock = std::chrono::steady_clock;
+				clock::time_point start = clock::now();
+				for (size_t i = 0; i < batch; ++i)
+					fn();
+				return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+			}
+
+			void Record(const char* name, std::vector<double>& samples);
+			void PrintRow(const Result& result) const;
+			double BaselineP50(const std::string& name) const;
+			bool WriteJson(const char* path) const;
+		private:
+			std::string m_Filter;
+			std::string m_JsonPath;
+			std::string m_Baseline;
+			double m_SampleNs = 50e3;
+			double m_MinTimeNs = 200e6;
+			size_t m_MinSamples = 30;
+			size_t m_MaxSamples = 100000;
+
+			std::vector<Result> m_Results;
+			bool m_LastRan = false;
+			bool m_RowPending = false;
+			size_t m_FailedChecks = 0;
+		};
+
+		void RunMathsBenchmarks(Runner& runner);
+		void RunSimdMathBenchmarks(Runner& runner);
+		void RunEventBenchmarks(Runner& runner);
+		void RunResourceBenchmarks(Runner& runner);
+	}
+}
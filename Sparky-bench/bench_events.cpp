@@ -0,0 +1,160 @@
+#include "Benchmark.h"
+#include "Core.h"
+#include "LayerStack.h"
+#include "Events/EventQueue.h"
+
+namespace sparky {
+	namespace bench {
+
+		// Eight handlers, the same set ImGuiLayer registers
+		class EventSink
+		{
+		public:
+			int Count = 0;
+
+			// Dispatch the way the layers did before the handler tables
+			void OnEventStdFunction(Event& e)
+			{
+				using namespace std::placeholders;
+				EventDispatcher dispatcher(e);
+				dispatcher.Dispatch<MouseButtonPressedEvent>(std::function<bool(MouseButtonPressedEvent&)>(std::bind(&EventSink::OnMouseButtonPressed, this, _1)));
+				dispatcher.Dispatch<MouseButtonReleasedEvent>(std::function<bool(MouseButtonReleasedEvent&)>(std::bind(&EventSink::OnMouseButtonReleased, this, _1)));
+				dispatcher.Dispatch<MouseMovedEvent>(std::function<bool(MouseMovedEvent&)>(std::bind(&EventSink::OnMouseMoved, this, _1)));
+				dispatcher.Dispatch<MouseScrolledEvent>(std::function<bool(MouseScrolledEvent&)>(std::bind(&EventSink::OnMouseScrolled, this, _1)));
+				dispatcher.Dispatch<KeyPressedEvent>(std::function<bool(KeyPressedEvent&)>(std::bind(&EventSink::OnKeyPressed, this, _1)));
+				dispatcher.Dispatch<KeyTypedEvent>(std::function<bool(KeyTypedEvent&)>(std::bind(&EventSink::OnKeyTyped, this, _1)));
+				dispatcher.Dispatch<KeyReleasedEvent>(std::function<bool(KeyReleasedEvent&)>(std::bind(&EventSink::OnKeyReleased, this, _1)));
+				dispatcher.Dispatch<WindowResizeEvent>(std::function<bool(WindowResizeEvent&)>(std::bind(&EventSink::OnWindowResize, this, _1)));
+			}
+
+			void OnEventDispatcher(Event& e)
+			{
+				EventDispatcher dispatcher(e);
+				dispatcher.Dispatch<MouseButtonPressedEvent>(SPARKY_BIND_EVENT_FN(EventSink::OnMouseButtonPressed));
+				dispatcher.Dispatch<MouseButtonReleasedEvent>(SPARKY_BIND_EVENT_FN(EventSink::OnMouseButtonReleased));
+				dispatcher.Dispatch<MouseMovedEvent>(SPARKY_BIND_EVENT_FN(EventSink::OnMouseMoved));
+				dispatcher.Dispatch<MouseScrolledEvent>(SPARKY_BIND_EVENT_FN(EventSink::OnMouseScrolled));
+				dispatcher.Dispatch<KeyPressedEvent>(SPARKY_BIND_EVENT_FN(EventSink::OnKeyPressed));
+				dispatcher.Dispatch<KeyTypedEvent>(SPARKY_BIND_EVENT_FN(EventSink::OnKeyTyped));
+				dispatcher.Dispatch<KeyReleasedEvent>(SPARKY_BIND_EVENT_FN(EventSink::OnKeyReleased));
+				dispatcher.Dispatch<WindowResizeEvent>(SPARKY_BIND_EVENT_FN(EventSink::OnWindowResize));
+			}
+
+			void OnEvent(Event& e)
+			{
+				typedef EventHandlers<
+					SPARKY_EVENT_HANDLER(EventSink::OnMouseButtonPressed),
+					SPARKY_EVENT_HANDLER(EventSink::OnMouseButtonReleased),
+					SPARKY_EVENT_HANDLER(EventSink::OnMouseMoved),
+					SPARKY_EVENT_HANDLER(EventSink::OnMouseScrolled),
+					SPARKY_EVENT_HANDLER(EventSink::OnKeyPressed),
+					SPARKY_EVENT_HANDLER(EventSink::OnKeyTyped),
+					SPARKY_EVENT_HANDLER(EventSink::OnKeyReleased),
+					SPARKY_EVENT_HANDLER(EventSink::OnWindowResize)> Handlers;
+				Handlers::Dispatch(this, e);
+			}
+
+			bool OnMouseButtonPressed(MouseButtonPressedEvent& e) { Count += e.GetMouseButton(); return false; }
+			bool OnMouseButtonReleased(MouseButtonReleasedEvent& e) { Count -= e.GetMouseButton(); return false; }
+			bool OnMouseMoved(MouseMovedEvent& e) { Count += (int)e.GetX(); return false; }
+			bool OnMouseScrolled(MouseScrolledEvent& e) { Count += (int)e.GetYOffset(); return false; }
+			bool OnKeyPressed(KeyPressedEvent& e) { Count += e.GetKeyCode(); return false; }
+			bool OnKeyTyped(KeyTypedEvent& e) { Count += e.GetKeyCode(); return false; }
+			bool OnKeyReleased(KeyReleasedEvent& e) { Count -= e.GetKeyCode(); return false; }
+			bool OnWindowResize(WindowResizeEvent& e) { Count += e.GetWidth(); return false; }
+		};
+
+		class CountingLayer : public Layer
+		{
+		public:
+			int Updates = 0, Events = 0;
+
+			CountingLayer() : Layer("CountingLayer") {}
+
+			void OnUpdate() override { ++Updates; }
+			void OnEvent(Event&) override { ++Events; }
+		};
+
+		// A layer handling events through the sink, like ImGuiLayer
+		class SinkLayer : public Layer
+		{
+		public:
+			EventSink Sink;
+
+			SinkLayer() : Layer("SinkLayer") {}
+
+			void OnEvent(Event& event) override { Sink.OnEvent(event); }
+		};
+
+		// Same walk as Application::OnEvent, overlays first
+		static void WalkLayers(LayerStack& stack, Event& e)
+		{
+			for (auto it = stack.end(); it != stack.begin(); ) {
+				(*--it)->OnEvent(e);
+				if (e.Handled)
+					break;
+			}
+		}
+
+		void RunEventBenchmarks(Runner& runner)
+		{
+			EventSink sink;
+			MouseMovedEvent moved(10.0f, 20.0f);
+			KeyPressedEvent key(65, 0);
+			MouseScrolledEvent scrolled(0.0f, 1.0f);
+			WindowResizeEvent resized(1280, 720);
+			// cycle through event types so the compiler cannot fold the type checks
+			Event* events[] = { &moved, &key, &scrolled, &resized };
+			size_t next = 0;
+			auto nextEvent = [&]() -> Event& { return *events[next++ & 3]; };
+
+			runner.Run("events/dispatch/std_function", 1, [&]() {
+				EventDispatcher dispatcher(nextEvent());
+				dispatcher.Dispatch<MouseMovedEvent>(std::function<bool(MouseMovedEvent&)>(std::bind(&EventSink::OnMouseMoved, &sink, std::placeholders::_1)));
+			});
+			runner.Run("events/dispatch/lambda", 1, [&]() {
+				EventDispatcher dispatcher(nextEvent());
+				dispatcher.Dispatch<MouseMovedEvent>([&](MouseMovedEvent& e) { return sink.OnMouseMoved(e); });
+			});
+			runner.Run("events/dispatch/member_ptr", 1, [&]() {
+				EventDispatcher dispatcher(nextEvent());
+				dispatcher.Dispatch(&sink, &EventSink::OnMouseMoved);
+			});
+
+			// a layer with eight handlers, like ImGuiLayer
+			runner.Run("events/on_event_8_handlers/std_function", 1, [&]() { sink.OnEventStdFunction(nextEvent()); });
+			runner.Run("events/on_event_8_handlers/dispatcher", 1, [&]() { sink.OnEventDispatcher(nextEvent()); });
+			runner.Run("events/on_event_8_handlers/table", 1, [&]() { sink.OnEvent(nextEvent()); });
+			Consume((float)sink.Count);
+
+			// The stack owns and deletes its layers
+			const int layerCount = 8;
+			LayerStack stack;
+			for (int i = 0; i < layerCount; ++i)
+				stack.PushLayer(new CountingLayer());
+			stack.PushOverlay(new SinkLayer());
+
+			runner.Run("layers/update_9", 1, [&]() {
+				for (Layer* layer : stack)
+					layer->OnUpdate();
+			});
+			runner.Run("layers/on_event_9", 1, [&]() { WalkLayers(stack, nextEvent()); });
+
+			// One 60 Hz frame of a 1000 Hz mouse: ~16 moves, each walking the
+			// layers as it arrives, or queued and coalesced into one walk
+			const int movesPerFrame = 16;
+			runner.Run("events/frame_1000hz_mouse/direct", 1, [&]() {
+				for (int i = 0; i < movesPerFrame; ++i) {
+					MouseMovedEvent e((float)i, 20.0f);
+					WalkLayers(stack, e);
+				}
+			});
+			EventQueue queue;
+			runner.Run("events/frame_1000hz_mouse/queued", 1, [&]() {
+				for (int i = 0; i < movesPerFrame; ++i)
+					queue.Push(MouseMovedEvent((float)i, 20.0f));
+				queue.Flush([&](Event& e) { WalkLayers(stack, e); });
+			});
+		}
+	}
+}
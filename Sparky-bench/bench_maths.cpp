@@ -0,0 +1,77 @@
+#include "Benchmark.h"
+#include "maths.h"
+
+#include <cstring>
+#include <vector>
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_inverse.hpp"
+
+namespace sparky {
+	namespace bench {
+
+		using namespace maths;
+
+		static const size_t s_Matrices = 256;
+		static const size_t s_Points = 4096;
+
+		static glm::mat4 ToGlm(const mat4& m)
+		{
+			glm::mat4 r;
+			memcpy(&r[0][0], m.elements, sizeof(m.elements));
+			return r;
+		}
+
+		void RunMathsBenchmarks(Runner& runner)
+		{
+			// Model matrices like the demos build them: translate * rotate * scale
+			std::vector<mat4> a(s_Matrices), b(s_Matrices), out(s_Matrices);
+			std::vector<glm::mat4> ga(s_Matrices), gb(s_Matrices), gout(s_Matrices);
+			for (size_t i = 0; i < s_Matrices; ++i) {
+				float f = (float)i;
+				a[i] = mat4::translation(vec3(f, -f * 0.5f, 2.0f)) * mat4::rotation(f * 7.0f, vec3(0.3f, 1.0f, 0.2f)) * mat4::scale(vec3(1.0f + f * 0.01f, 1.0f, 2.0f));
+				b[i] = mat4::rotation(f * 3.0f, vec3(1.0f, 0.0f, 0.5f)) * mat4::translation(vec3(1.0f, f, -f));
+				ga[i] = ToGlm(a[i]);
+				gb[i] = ToGlm(b[i]);
+			}
+
+			runner.Run("maths/mat4_multiply/sparky", s_Matrices, [&]() {
+				for (size_t i = 0; i < s_Matrices; ++i) out[i] = a[i] * b[i];
+				Consume(out[s_Matrices / 2].elements[5]);
+			});
+			runner.Run("maths/mat4_multiply/glm", s_Matrices, [&]() {
+				for (size_t i = 0; i < s_Matrices; ++i) gout[i] = ga[i] * gb[i];
+				Consume(gout[s_Matrices / 2][1][1]);
+			});
+
+			runner.Run("maths/mat4_inverse/sparky", s_Matrices, [&]() {
+				for (size_t i = 0; i < s_Matrices; ++i) out[i] = mat4::Inverse(a[i]);
+				Consume(out[s_Matrices / 2].elements[5]);
+			});
+			runner.Run("maths/mat4_inverse/glm", s_Matrices, [&]() {
+				for (size_t i = 0; i < s_Matrices; ++i) gout[i] = glm::inverse(ga[i]);
+				Consume(gout[s_Matrices / 2][1][1]);
+			});
+			runner.Run("maths/mat4_affine_inverse/sparky", s_Matrices, [&]() {
+				for (size_t i = 0; i < s_Matrices; ++i) out[i] = mat4::AffineInverse(a[i]);
+				Consume(out[s_Matrices / 2].elements[5]);
+			});
+
+			std::vector<vec4> points(s_Points), transformed(s_Points);
+			std::vector<glm::vec4> gpoints(s_Points), gtransformed(s_Points);
+			for (size_t i = 0; i < s_Points; ++i) {
+				float f = (float)i;
+				points[i] = vec4(f, f * 0.5f, -f, 1.0f);
+				gpoints[i] = glm::vec4(f, f * 0.5f, -f, 1.0f);
+			}
+
+			runner.Run("maths/transform_points/sparky", s_Points, [&]() {
+				mat4::transformPoints(a[0], points.data(), transformed.data(), s_Points);
+				Consume(transformed[s_Points / 2].x);
+			});
+			runner.Run("maths/transform_points/glm", s_Points, [&]() {
+				for (size_t i = 0; i < s_Points; ++i) gtransformed[i] = ga[0] * gpoints[i];
+				Consume(gtransformed[s_Points / 2].x);
+			});
+		}
+	}
+}
@@ -0,0 +1,198 @@
+#include "Benchmark.h"
+#include "fileutils.h"
+#include "PackFile.h"
+#include "Shader.h"
+
+#include <cstdio>
+#include <vector>
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image/stb_image.h"
+
+namespace sparky {
+	namespace bench {
+
+		static std::vector<unsigned char> LoadBytes(const char* path)
+		{
+			std::vector<unsigned char> bytes;
+			FILE* file = fopen(path, "rb");
+			if (!file)
+				return bytes;
+			fseek(file, 0, SEEK_END);
+			bytes.resize(ftell(file));
+			fseek(file, 0, SEEK_SET);
+			bytes.resize(fread(bytes.data(), 1, bytes.size(), file));
+			fclose(file);
+			return bytes;
+		}
+
+		static void BenchReadFile(Runner& runner, const char* name, const char* path)
+		{
+			// read_file does not handle missing files
+			size_t bytes = LoadBytes(path).size();
+			if (bytes == 0) {
+				if (runner.IsSelected(name))
+					printf("%-40s skipped, %s not found (run from Sparky-core/)\n", name, path);
+				return;
+			}
+
+			runner.Run(name, 1, [&]() {
+				std::string source = read_file(path);
+				Consume(source.data());
+			});
+			if (const Result* result = runner.LastResult())
+				runner.Counter("mb_per_s", (double)bytes / result->P50 * 1e3);
+		}
+
+		static void BenchDecode(Runner& runner, const char* name, const char* path)
+		{
+			std::vector<unsigned char> encoded = LoadBytes(path);
+			if (encoded.empty()) {
+				if (runner.IsSelected(name))
+					printf("%-40s skipped, %s not found (run from Sparky-core/)\n", name, path);
+				return;
+			}
+
+			int width = 0, height = 0, channels = 0;
+			// same flip as graphics::Texture
+			stbi_set_flip_vertically_on_load(1);
+			runner.Run(name, 1, [&]() {
+				unsigned char* pixels = stbi_load_from_memory(encoded.data(), (int)encoded.size(), &width, &height, &channels, 0);
+				Consume(pixels);
+				stbi_image_free(pixels);
+			});
+			if (const Result* result = runner.LastResult())
+				runner.Counter("mpix_per_s", (double)width * height / result->P50 * 1e3);
+		}
+
+		static bool WriteBytes(const char* path, const uint8_t* data, size_t size)
+		{
+			FILE* file = fopen(path, "wb");
+			if (!file)
+				return false;
+			bool written = fwrite(data, 1, size, file) == size;
+			fclose(file);
+			return written;
+		}
+
+		// Opens a damaged pack and reads every entry. Returns false if the reader
+		// accepted an entry that reaches outside the file.
+		static bool OpenDamagedPack(const char* path, const std::vector<uint8_t>& bytes, size_t& rejected)
+		{
+			if (!WriteBytes(path, bytes.data(), bytes.size()))
+				return false;
+			PackReader reader;
+			if (!reader.Open(path)) {
+				rejected++;
+				return true;
+			}
+			for (uint32_t i = 0; i < reader.GetEntryCount(); ++i) {
+				const PackEntry& entry = reader.GetEntries()[i];
+				bool compressed = (entry.Flags & PackEntry::Compressed) != 0;
+				if (entry.Offset > bytes.size() || entry.StoredSize > bytes.size() - entry.Offset || (!compressed && entry.Size != entry.StoredSize))
+					return false;
+				FileData data = reader.Read(entry);
+				Consume(data.data());
+			}
+			return true;
+		}
+
+		// Truncated and bit flipped packs must be rejected or read within bounds
+		static void CheckDamagedPacks(Runner& runner)
+		{
+			const char* name = "resources/pack/damaged";
+			if (!runner.IsSelected(name))
+				return;
+
+			std::string text;
+			for (int i = 0; i < 2000; ++i)
+				text += "uniform vec3 light" + std::to_string(i % 7) + ";\n";
+			std::vector<uint8_t> noise(6000);
+			uint32_t state = 12345;
+			for (uint8_t& b : noise) {
+				state = state * 1664525u + 1013904223u;
+				b = (uint8_t)(state >> 24);
+			}
+			PackWriter writer;
+			writer.Add("shaders/text.glsl", reinterpret_cast<const uint8_t*>(text.data()), text.size(), true);
+			writer.Add("res/noise.bin", noise.data(), noise.size(), true);
+			writer.Add("res/empty.txt", nullptr, 0, false);
+
+			const char* packPath = "sparky-bench-pack.tmp";
+			const char* damagedPath = "sparky-bench-damaged.tmp";
+			std::vector<uint8_t> pack;
+			bool ok = writer.Write(packPath);
+			{
+				MappedFile file;
+				if (ok && file.Open(packPath))
+					pack.assign(file.GetData(), file.GetData() + file.GetSize());
+			}
+			ok = ok && !pack.empty();
+
+			size_t cases = 0, rejected = 0;
+			const PackHeader* header = reinterpret_cast<const PackHeader*>(pack.data());
+			size_t tableEnd = ok ? (size_t)(header->StringsOffset + header->StringsSize) : 0;
+			// every length through the table of contents, then around each entry
+			for (size_t length = 0; ok && length < pack.size(); length += length < tableEnd ? 1 : 509) {
+				std::vector<uint8_t> truncated(pack.begin(), pack.begin() + length);
+				ok = OpenDamagedPack(damagedPath, truncated, rejected);
+				cases++;
+			}
+			// every bit of the table of contents, a sample of the data
+			for (size_t bit = 0; ok && bit < pack.size() * 8; bit += bit < tableEnd * 8 ? 1 : 997) {
+				std::vector<uint8_t> flipped = pack;
+				flipped[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+				ok = OpenDamagedPack(damagedPath, flipped, rejected);
+				cases++;
+			}
+			remove(packPath);
+			remove(damagedPath);
+			runner.Check(name, ok, std::to_string(cases) + " packs, " + std::to_string(rejected) + " rejected");
+		}
+
+		static GLint APIENTRY FakeGetUniformLocation(GLuint program, const GLchar* name)
+		{
+			return (GLint)(program + name[0]);
+		}
+
+		void RunResourceBenchmarks(Runner& runner)
+		{
+			// Shader sources are a few hundred bytes, also time a larger file
+			BenchReadFile(runner, "resources/read_file/shader", "shaders/Lighting/3.Material.frag");
+			{
+				const char* path = "sparky-bench-read-file.tmp";
+				std::string text(1 << 20, 'x');
+				FILE* file = fopen(path, "wb");
+				if (file) {
+					fwrite(text.data(), 1, text.size(), file);
+					fclose(file);
+					BenchReadFile(runner, "resources/read_file/1mb", path);
+					remove(path);
+				}
+			}
+
+			BenchDecode(runner, "resources/texture_decode/wall_jpg", "res/Textures/wall.jpg");
+			BenchDecode(runner, "resources/texture_decode/awesomeface_png", "res/Textures/awesomeface.png");
+
+			CheckDamagedPacks(runner);
+
+			// Uniform names the lighting demos set every frame. No GL context exists
+			// here, so glGetUniformLocation is pointed at a stand in for the misses.
+			glad_glGetUniformLocation = FakeGetUniformLocation;
+			const char* names[] = {
+				"model", "view", "proj", "viewPos",
+				"material.ambient", "material.diffuse", "material.specular", "material.shininess",
+				"light.position", "light.ambient", "light.diffuse", "light.specular"
+			};
+			const size_t nameCount = sizeof(names) / sizeof(names[0]);
+			graphics::UniformCache cache;
+			runner.Run("resources/uniform_cache/hit", nameCount, [&]() {
+				GLint sum = 0;
+				for (size_t i = 0; i < nameCount; ++i)
+					sum += cache.getLocation(3, names[i]);
+				Consume((float)sum);
+			});
+			if (cache.hits() + cache.misses() > 0)
+				runner.Counter("hit_rate", (double)cache.hits() / (double)(cache.hits() + cache.misses()));
+		}
+	}
+}
@@ -0,0 +1,154 @@
+#include "Benchmark.h"
+#include "simd_math.h"
+
+#include <cmath>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace sparky {
+	namespace bench {
+
+		using namespace maths;
+
+		static const size_t s_Count = 4096;
+
+		struct Inputs
+		{
+			std::vector<float> x, y, out;
+			Inputs(float lo, float hi) : x(s_Count), y(s_Count), out(s_Count)
+			{
+				for (size_t i = 0; i < s_Count; ++i) {
+					x[i] = lo + (hi - lo) * (float)i / (float)s_Count;
+					y[i] = (float)std::cos(i * 0.37) * 8.0f;
+				}
+			}
+		};
+
+		typedef double(*Reference)(double, double);
+
+		static double MaxError(const Inputs& in, Reference ref, bool relative)
+		{
+			double err = 0.0;
+			for (size_t i = 0; i < s_Count; ++i) {
+				double r = ref(in.x[i], in.y[i]);
+				double e = std::fabs(in.out[i] - r);
+				if (relative && r != 0.0) e /= std::fabs(r);
+				err = e > err ? e : err;
+			}
+			return err;
+		}
+
+		typedef void(*SpecialKernel)(const float*, const float*, float*, size_t);
+
+		// IEEE special cases and denormals. Every input fills more lanes than a
+		// register holds, so the vector kernel and the scalar tail both see it.
+		static void CheckSpecialCases(Runner& runner, const char* name, const float (*cases)[2], size_t count, SpecialKernel kernel, Reference ref)
+		{
+			static const size_t Lanes = 11;
+			std::string failures;
+			for (size_t c = 0; c < count; ++c) {
+				float x[Lanes], y[Lanes], out[Lanes];
+				for (size_t i = 0; i < Lanes; ++i) {
+					x[i] = cases[c][0];
+					y[i] = cases[c][1];
+				}
+				kernel(x, y, out, Lanes);
+				float expected = (float)ref(x[0], y[0]);
+				for (float r : out) {
+					bool same = std::isnan(expected) ? std::isnan(r)
+						: std::isinf(expected) ? r == expected
+						: std::fabs(r - expected) <= 1e-3f * std::fmax(1.0f, std::fabs(expected));
+					if (!same) {
+						char text[96];
+						snprintf(text, sizeof(text), "(%g, %g) = %g, expected %g; ", x[0], y[0], r, expected);
+						failures += text;
+						break;
+					}
+				}
+			}
+			runner.Check(name, failures.empty(), failures.empty() ? std::to_string(count) + " cases" : failures);
+		}
+
+		// Times libm and both accuracy tiers on the same inputs, ns are per element
+		template<typename Libm, typename Simd>
+		static void Bench(Runner& runner, const char* func, Inputs& in, Libm libm, Simd fast, Simd def, Reference ref, bool relative)
+		{
+			std::string name = std::string("simd_math/") + func;
+
+			runner.Run((name + "/libm").c_str(), s_Count, [&]() {
+				for (size_t i = 0; i < s_Count; ++i) in.out[i] = libm(in.x[i], in.y[i]);
+				Consume(in.out[s_Count / 2]);
+			});
+			runner.Counter("max_err", MaxError(in, ref, relative));
+
+			runner.Run((name + "/fast").c_str(), s_Count, [&]() { fast(in); Consume(in.out[s_Count / 2]); });
+			runner.Counter("max_err", MaxError(in, ref, relative));
+
+			runner.Run((name + "/default").c_str(), s_Count, [&]() { def(in); Consume(in.out[s_Count / 2]); });
+			runner.Counter("max_err", MaxError(in, ref, relative));
+		}
+
+		void RunSimdMathBenchmarks(Runner& runner)
+		{
+			typedef void(*Kernel)(Inputs&);
+			using simd::Accuracy;
+
+			Inputs trig(-100.0f, 100.0f);
+			Bench(runner, "sin", trig, [](float x, float) { return std::sin(x); },
+				(Kernel)[](Inputs& in) { simd::sin<Accuracy::Fast>(in.x.data(), in.out.data(), s_Count); },
+				(Kernel)[](Inputs& in) { simd::sin<Accuracy::Default>(in.x.data(), in.out.data(), s_Count); },
+				[](double x, double) { return std::sin(x); }, false);
+			Bench(runner, "cos", trig, [](float x, float) { return std::cos(x); },
+				(Kernel)[](Inputs& in) { simd::cos<Accuracy::Fast>(in.x.data(), in.out.data(), s_Count); },
+				(Kernel)[](Inputs& in) { simd::cos<Accuracy::Default>(in.x.data(), in.out.data(), s_Count); },
+				[](double x, double) { return std::cos(x); }, false);
+
+			Inputs expIn(-80.0f, 80.0f);
+			Bench(runner, "exp", expIn, [](float x, float) { return std::exp(x); },
+				(Kernel)[](Inputs& in) { simd::exp<Accuracy::Fast>(in.x.data(), in.out.data(), s_Count); },
+				(Kernel)[](Inputs& in) { simd::exp<Accuracy::Default>(in.x.data(), in.out.data(), s_Count); },
+				[](double x, double) { return std::exp(x); }, true);
+
+			Inputs logIn(1e-3f, 1e4f);
+			Bench(runner, "log", logIn, [](float x, float) { return std::log(x); },
+				(Kernel)[](Inputs& in) { simd::log<Accuracy::Fast>(in.x.data(), in.out.data(), s_Count); },
+				(Kernel)[](Inputs& in) { simd::log<Accuracy::Default>(in.x.data(), in.out.data(), s_Count); },
+				[](double x, double) { return std::log(x); }, false);
+			static const float logCases[][2] = {
+				{ INFINITY, 0.0f }, { NAN, 0.0f }, { 0.0f, 0.0f }, { -1.0f, 0.0f }, { -INFINITY, 0.0f },
+				{ 1.17549435e-38f, 0.0f }, { 1e-40f, 0.0f }, { 1.4e-45f, 0.0f }, { 3e38f, 0.0f },
+			};
+			CheckSpecialCases(runner, "simd_math/log/special/fast", logCases, sizeof(logCases) / sizeof(logCases[0]),
+				[](const float* x, const float*, float* out, size_t count) { simd::log<Accuracy::Fast>(x, out, count); },
+				[](double x, double) { return std::log(x); });
+			CheckSpecialCases(runner, "simd_math/log/special/default", logCases, sizeof(logCases) / sizeof(logCases[0]),
+				[](const float* x, const float*, float* out, size_t count) { simd::log<Accuracy::Default>(x, out, count); },
+				[](double x, double) { return std::log(x); });
+
+			// Phong style specular: pow(cos, shininess)
+			Inputs powIn(0.0f, 1.0f);
+			for (size_t i = 0; i < s_Count; ++i) powIn.y[i] = 2.0f + (float)(i % 128);
+			Bench(runner, "pow", powIn, [](float x, float y) { return std::pow(x, y); },
+				(Kernel)[](Inputs& in) { simd::pow<Accuracy::Fast>(in.x.data(), in.y.data(), in.out.data(), s_Count); },
+				(Kernel)[](Inputs& in) { simd::pow<Accuracy::Default>(in.x.data(), in.y.data(), in.out.data(), s_Count); },
+				[](double x, double y) { return std::pow(x, y); }, false);
+			static const float powCases[][2] = {
+				{ 0.0f, 0.0f }, { 0.0f, 2.0f }, { 0.0f, -1.0f }, { 2.0f, 0.0f }, { INFINITY, 0.0f }, { NAN, 0.0f },
+				{ 0.5f, 2.0f }, { 1e-40f, 0.5f }, { NAN, 2.0f }, { 4.0f, NAN },
+			};
+			CheckSpecialCases(runner, "simd_math/pow/special/fast", powCases, sizeof(powCases) / sizeof(powCases[0]),
+				[](const float* x, const float* y, float* out, size_t count) { simd::pow<Accuracy::Fast>(x, y, out, count); },
+				[](double x, double y) { return std::pow(x, y); });
+			CheckSpecialCases(runner, "simd_math/pow/special/default", powCases, sizeof(powCases) / sizeof(powCases[0]),
+				[](const float* x, const float* y, float* out, size_t count) { simd::pow<Accuracy::Default>(x, y, out, count); },
+				[](double x, double y) { return std::pow(x, y); });
+
+			Inputs atanIn(-10.0f, 10.0f);
+			Bench(runner, "atan2", atanIn, [](float x, float y) { return std::atan2(y, x); },
+				(Kernel)[](Inputs& in) { simd::atan2<Accuracy::Fast>(in.y.data(), in.x.data(), in.out.data(), s_Count); },
+				(Kernel)[](Inputs& in) { simd::atan2<Accuracy::Default>(in.y.data(), in.x.data(), in.out.data(), s_Count); },
+				[](double x, double y) { return std::atan2(y, x); }, false);
+		}
+	}
+}
@@ -0,0 +1,21 @@
+#include "Benchmark.h"
+
+// Sparky-bench: standalone micro benchmarks for the engine core, no window or
+// GL context is created. On Linux it builds with the following command, given
+// on one line:
+//   g++ -O2 -std=c++14 -pthread -ISparky-core -ISparky-core/vendor -ISparky-core/vendor/spdlog/include -IDependencies/GLAD/include
+//       Sparky-bench/*.cpp Sparky-core/{simd_math,matrix,vector,soa,Layer,LayerStack,Log,Profiler,Memory,MemoryTracker,fileutils,Compression,FileData,PackFile,VirtualFileSystem,Shader,FrameContext,Events/EventQueue}.cpp
+//       Sparky-core/glad.c -ldl -o sparky-bench
+// and runs from Sparky-core/ so that res/ and shaders/ resolve like in the demos.
+
+int main(int argc, char** argv)
+{
+	using namespace sparky::bench;
+
+	Runner runner(argc, argv);
+	RunMathsBenchmarks(runner);
+	RunSimdMathBenchmarks(runner);
+	RunEventBenchmarks(runner);
+	RunResourceBenchmarks(runner);
+	return runner.Finish();
+}
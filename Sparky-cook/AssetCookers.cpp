@@ -0,0 +1,50 @@
+#include "AssetCookers.h"
+#include <ctype.h>
+
+namespace sparky {
+	namespace cook {
+
+		namespace {
+			const AssetCooker s_Texture = { "texture", 2, true, CookTexture, TextureVariant };
+			const AssetCooker s_Shader = { "shader", 2, true, CookShader, nullptr };
+			const AssetCooker s_Copy = { "copy", 1, true, CopyAsset, nullptr };
+
+			struct Extension
+			{
+				const char* Name;
+				const AssetCooker* Cooker;
+			};
+
+			const Extension s_Extensions[] = {
+				{ "png", &s_Texture }, { "jpg", &s_Texture }, { "jpeg", &s_Texture },
+				{ "tga", &s_Texture }, { "bmp", &s_Texture }, { "psd", &s_Texture },
+				{ "vert", &s_Shader }, { "frag", &s_Shader }, { "geom", &s_Shader },
+				{ "comp", &s_Shader }, { "tesc", &s_Shader }, { "tese", &s_Shader },
+				{ "glsl", &s_Shader },
+			};
+		}
+
+		bool CopyAsset(const std::string&, const uint8_t* data, size_t size, const CookSettings&, std::vector<uint8_t>& output, std::string&)
+		{
+			output.assign(data, data + size);
+			return true;
+		}
+
+		const AssetCooker& FindCooker(const std::string& path)
+		{
+			size_t dot = path.find_last_of('.');
+			size_t slash = path.find_last_of('/');
+			if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+				return s_Copy;
+			std::string extension = path.substr(dot + 1);
+			for (char& c : extension)
+				c = (char)tolower((unsigned char)c);
+			for (const Extension& entry : s_Extensions) {
+				if (extension == entry.Name)
+					return *entry.Cooker;
+			}
+			return s_Copy;
+		}
+
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace sparky {
+	namespace cook {
+
+		enum class TextureEncoding
+		{
+			// BC1, BC3 for textures with alpha, BC5 for normal maps
+			BC,
+			// BC7 in place of BC1 and BC3
+			BC7,
+			// uncompressed RGB8 or RGBA8
+			Raw
+		};
+
+		// Options that apply to every cooker
+		struct CookSettings
+		{
+			TextureEncoding Textures = TextureEncoding::BC;
+			// threads one asset may split its own work over
+			unsigned int EncoderThreads = 1;
+		};
+
+		// Turns one source file into what the engine loads at runtime. Cook is
+		// called from worker threads and must not touch shared state. Bump
+		// Version whenever the output of Cook changes so cached results are
+		// rebuilt.
+		struct AssetCooker
+		{
+			const char* Name;
+			uint32_t Version;
+			// LZ4 the output in the pack, pointless for already compressed data
+			bool Compress;
+			bool (*Cook)(const std::string& path, const uint8_t* data, size_t size, const CookSettings& settings, std::vector<uint8_t>& output, std::string& error);
+			// The settings that change the output as a small number, folded into
+			// the cached version; null when none do
+			uint32_t (*Variant)(const CookSettings& settings);
+		};
+
+		// Decoded, vertically flipped, mipmapped and block compressed, see
+		// CookedTexture.h. Files named *_n.*, *_normal* or *_nrm* are normal
+		// maps and keep only red and green in BC5, shaders rebuild blue.
+		bool CookTexture(const std::string& path, const uint8_t* data, size_t size, const CookSettings& settings, std::vector<uint8_t>& output, std::string& error);
+		uint32_t TextureVariant(const CookSettings& settings);
+		// Comments and indentation stripped, checked for a leading #version.
+		// Lines are kept so compiler errors point at the source line.
+		bool CookShader(const std::string& path, const uint8_t* data, size_t size, const CookSettings& settings, std::vector<uint8_t>& output, std::string& error);
+		bool CopyAsset(const std::string& path, const uint8_t* data, size_t size, const CookSettings& settings, std::vector<uint8_t>& output, std::string& error);
+
+		// Picked by file extension, files nothing claims are copied as they are
+		const AssetCooker& FindCooker(const std::string& path);
+
+	}
+}
@@ -0,0 +1,453 @@
+#include "BlockCompression.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "simd.h"
+
+namespace sparky {
+	namespace cook {
+
+		namespace {
+			// A block widened for the palette search, channels that are not
+			// encoded are left 0 in the pixels and the palette alike
+			struct Block
+			{
+				alignas(16) int16_t Pixels[16][4];
+			};
+
+			typedef int16_t PaletteEntry[4];
+
+			void Widen(const uint8_t* pixels, uint32_t firstChannel, uint32_t channels, Block& block)
+			{
+				memset(&block, 0, sizeof(block));
+				for (uint32_t i = 0; i < 16; ++i) {
+					for (uint32_t c = 0; c < channels; ++c)
+						block.Pixels[i][c] = pixels[i * 4 + firstChannel + c];
+				}
+			}
+
+			// Nearest of count palette entries for every pixel, returns the summed squared error
+			uint32_t FindIndices(const Block& block, const PaletteEntry* palette, uint32_t count, uint8_t* indices)
+			{
+				uint32_t total = 0;
+#if SPARKY_SIMD_SSE
+				// four pixels at a time, two per register
+				for (uint32_t group = 0; group < 16; group += 4) {
+					__m128i pixels01 = _mm_load_si128(reinterpret_cast<const __m128i*>(block.Pixels[group]));
+					__m128i pixels23 = _mm_load_si128(reinterpret_cast<const __m128i*>(block.Pixels[group + 2]));
+					__m128i best = _mm_set1_epi32(0x7fffffff);
+					__m128i bestIndex = _mm_setzero_si128();
+					for (uint32_t i = 0; i < count; ++i) {
+						__m128i entry = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(palette[i]));
+						entry = _mm_unpacklo_epi64(entry, entry);
+						__m128i d01 = _mm_sub_epi16(pixels01, entry);
+						__m128i d23 = _mm_sub_epi16(pixels23, entry);
+						// per pixel: red and green squared in one lane, blue and alpha in the next
+						d01 = _mm_madd_epi16(d01, d01);
+						d23 = _mm_madd_epi16(d23, d23);
+						__m128 even = _mm_shuffle_ps(_mm_castsi128_ps(d01), _mm_castsi128_ps(d23), SPARKY_SHUFFLE(0, 2, 0, 2));
+						__m128 odd = _mm_shuffle_ps(_mm_castsi128_ps(d01), _mm_castsi128_ps(d23), SPARKY_SHUFFLE(1, 3, 1, 3));
+						__m128i distance = _mm_add_epi32(_mm_castps_si128(even), _mm_castps_si128(odd));
+						__m128i closer = _mm_cmplt_epi32(distance, best);
+						best = _mm_or_si128(_mm_and_si128(closer, distance), _mm_andnot_si128(closer, best));
+						bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32((int)i)), _mm_andnot_si128(closer, bestIndex));
+					}
+					alignas(16) int32_t distances[4], chosen[4];
+					_mm_store_si128(reinterpret_cast<__m128i*>(distances), best);
+					_mm_store_si128(reinterpret_cast<__m128i*>(chosen), bestIndex);
+					for (uint32_t k = 0; k < 4; ++k) {
+						indices[group + k] = (uint8_t)chosen[k];
+						total += (uint32_t)distances[k];
+					}
+				}
+#else
+				for (uint32_t p = 0; p < 16; ++p) {
+					uint32_t best = 0xffffffff;
+					for (uint32_t i = 0; i < count; ++i) {
+						uint32_t distance = 0;
+						for (uint32_t c = 0; c < 4; ++c) {
+							int d = block.Pixels[p][c] - palette[i][c];
+							distance += (uint32_t)(d * d);
+						}
+						if (distance < best) {
+							best = distance;
+							indices[p] = (uint8_t)i;
+						}
+					}
+					total += best;
+				}
+#endif
+				return total;
+			}
+
+			// Endpoints where the principal axis of the channels enters and
+			// leaves the block's colours
+			void FitAxis(const uint8_t* pixels, uint32_t channels, float low[4], float high[4])
+			{
+				float mean[4] = {};
+				for (uint32_t i = 0; i < 16; ++i) {
+					for (uint32_t c = 0; c < channels; ++c)
+						mean[c] += pixels[i * 4 + c];
+				}
+				for (uint32_t c = 0; c < channels; ++c)
+					mean[c] /= 16.0f;
+
+				float covariance[4][4] = {};
+				for (uint32_t i = 0; i < 16; ++i) {
+					for (uint32_t a = 0; a < channels; ++a) {
+						for (uint32_t b = 0; b < channels; ++b)
+							covariance[a][b] += (pixels[i * 4 + a] - mean[a]) * (pixels[i * 4 + b] - mean[b]);
+					}
+				}
+
+				// power iteration from the diagonal, enough for a 4x4 block
+				float axis[4] = {};
+				for (uint32_t c = 0; c < channels; ++c)
+					axis[c] = covariance[c][c] + 1e-3f * (c + 1);
+				for (int iteration = 0; iteration < 8; ++iteration) {
+					float next[4] = {};
+					float length = 0.0f;
+					for (uint32_t a = 0; a < channels; ++a) {
+						for (uint32_t b = 0; b < channels; ++b)
+							next[a] += covariance[a][b] * axis[b];
+						length = std::max(length, fabsf(next[a]));
+					}
+					if (length < 1e-6f)
+						break;
+					for (uint32_t c = 0; c < channels; ++c)
+						axis[c] = next[c] / length;
+				}
+				float lengthSquared = 0.0f;
+				for (uint32_t c = 0; c < channels; ++c)
+					lengthSquared += axis[c] * axis[c];
+
+				float minimum = 0.0f, maximum = 0.0f;
+				if (lengthSquared > 1e-12f) {
+					minimum = 1e30f;
+					maximum = -1e30f;
+					for (uint32_t i = 0; i < 16; ++i) {
+						float t = 0.0f;
+						for (uint32_t c = 0; c < channels; ++c)
+							t += (pixels[i * 4 + c] - mean[c]) * axis[c];
+						minimum = std::min(minimum, t);
+						maximum = std::max(maximum, t);
+					}
+					minimum /= lengthSquared;
+					maximum /= lengthSquared;
+				}
+				for (uint32_t c = 0; c < channels; ++c) {
+					low[c] = std::min(std::max(mean[c] + minimum * axis[c], 0.0f), 255.0f);
+					high[c] = std::min(std::max(mean[c] + maximum * axis[c], 0.0f), 255.0f);
+				}
+			}
+
+			// Endpoints that best reproduce the pixels when pixel i is low + weights[i] * (high - low)
+			bool LeastSquares(const uint8_t* pixels, uint32_t channels, const float* weights, float low[4], float high[4])
+			{
+				float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+				float ax[4] = {}, bx[4] = {};
+				for (uint32_t i = 0; i < 16; ++i) {
+					float b = weights[i], a = 1.0f - b;
+					aa += a * a;
+					ab += a * b;
+					bb += b * b;
+					for (uint32_t c = 0; c < channels; ++c) {
+						ax[c] += a * pixels[i * 4 + c];
+						bx[c] += b * pixels[i * 4 + c];
+					}
+				}
+				float determinant = aa * bb - ab * ab;
+				if (fabsf(determinant) < 1e-6f)
+					return false;
+				for (uint32_t c = 0; c < channels; ++c) {
+					low[c] = std::min(std::max((ax[c] * bb - bx[c] * ab) / determinant, 0.0f), 255.0f);
+					high[c] = std::min(std::max((bx[c] * aa - ax[c] * ab) / determinant, 0.0f), 255.0f);
+				}
+				return true;
+			}
+
+			inline void Write16(uint8_t* data, uint16_t value)
+			{
+				data[0] = (uint8_t)value;
+				data[1] = (uint8_t)(value >> 8);
+			}
+
+			// BC1 ------------------------------------------------------------
+
+			inline uint16_t To565(const float color[4])
+			{
+				uint32_t r = (uint32_t)(color[0] * 31.0f / 255.0f + 0.5f);
+				uint32_t g = (uint32_t)(color[1] * 63.0f / 255.0f + 0.5f);
+				uint32_t b = (uint32_t)(color[2] * 31.0f / 255.0f + 0.5f);
+				return (uint16_t)((r << 11) | (g << 5) | b);
+			}
+
+			inline void From565(uint16_t color, PaletteEntry entry)
+			{
+				uint32_t r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+				entry[0] = (int16_t)((r << 3) | (r >> 2));
+				entry[1] = (int16_t)((g << 2) | (g >> 4));
+				entry[2] = (int16_t)((b << 3) | (b >> 2));
+				entry[3] = 0;
+			}
+
+			// Orders the endpoints for four colour mode and picks the indices
+			uint32_t FitBC1(const Block& block, uint16_t& color0, uint16_t& color1, uint8_t* indices)
+			{
+				if (color0 < color1)
+					std::swap(color0, color1);
+				PaletteEntry palette[4];
+				From565(color0, palette[0]);
+				From565(color1, palette[1]);
+				for (uint32_t c = 0; c < 4; ++c) {
+					palette[2][c] = (int16_t)((2 * palette[0][c] + palette[1][c]) / 3);
+					palette[3][c] = (int16_t)((palette[0][c] + 2 * palette[1][c]) / 3);
+				}
+				// equal endpoints decode in three colour mode, index 0 is still color0
+				return FindIndices(block, palette, color0 == color1 ? 1 : 4, indices);
+			}
+
+			void EncodeColor(const uint8_t* pixels, uint8_t* output)
+			{
+				static const float Weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+				Block block;
+				Widen(pixels, 0, 3, block);
+				float low[4], high[4];
+				FitAxis(pixels, 3, low, high);
+				uint16_t color0 = To565(high), color1 = To565(low);
+				uint8_t indices[16];
+				uint32_t error = FitBC1(block, color0, color1, indices);
+
+				// refit the endpoints to the chosen indices
+				if (error > 0 && color0 != color1) {
+					float weights[16];
+					for (uint32_t i = 0; i < 16; ++i)
+						weights[i] = Weights[indices[i]];
+					// weights are measured from color0, which LeastSquares calls low
+					if (LeastSquares(pixels, 3, weights, low, high)) {
+						uint16_t refined0 = To565(low), refined1 = To565(high);
+						uint8_t refinedIndices[16];
+						uint32_t refinedError = FitBC1(block, refined0, refined1, refinedIndices);
+						if (refinedError < error) {
+							color0 = refined0;
+							color1 = refined1;
+							memcpy(indices, refinedIndices, sizeof(indices));
+						}
+					}
+				}
+
+				uint32_t bits = 0;
+				for (uint32_t i = 0; i < 16; ++i)
+					bits |= (uint32_t)indices[i] << (2 * i);
+				Write16(output, color0);
+				Write16(output + 2, color1);
+				for (uint32_t i = 0; i < 4; ++i)
+					output[4 + i] = (uint8_t)(bits >> (8 * i));
+			}
+
+			// BC4, one channel of 8 bytes ---------------------------------------
+
+			void EncodeChannel(const uint8_t* pixels, uint32_t channel, uint8_t* output)
+			{
+				uint8_t minimum = 255, maximum = 0;
+				for (uint32_t i = 0; i < 16; ++i) {
+					minimum = std::min(minimum, pixels[i * 4 + channel]);
+					maximum = std::max(maximum, pixels[i * 4 + channel]);
+				}
+				memset(output, 0, 8);
+				output[0] = maximum;
+				output[1] = minimum;
+				// equal endpoints decode in six value mode, index 0 is still the value
+				if (minimum == maximum)
+					return;
+
+				// eight value mode, endpoint 0 above endpoint 1
+				PaletteEntry palette[8] = {};
+				palette[0][0] = maximum;
+				palette[1][0] = minimum;
+				for (int i = 2; i < 8; ++i)
+					palette[i][0] = (int16_t)(((8 - i) * maximum + (i - 1) * minimum) / 7);
+				Block block;
+				Widen(pixels, channel, 1, block);
+				uint8_t indices[16];
+				FindIndices(block, palette, 8, indices);
+
+				uint64_t bits = 0;
+				for (uint32_t i = 0; i < 16; ++i)
+					bits |= (uint64_t)indices[i] << (3 * i);
+				for (uint32_t i = 0; i < 6; ++i)
+					output[2 + i] = (uint8_t)(bits >> (8 * i));
+			}
+
+			// BC7 mode 6 ---------------------------------------------------------
+
+			const int BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+			struct BC7Endpoint
+			{
+				uint8_t Value[4]; // 7 bits
+				uint8_t PBit;
+			};
+
+			// The 7 bit values and shared low bit closest to color
+			BC7Endpoint QuantizeBC7(const float color[4])
+			{
+				BC7Endpoint best = {};
+				float bestError = 1e30f;
+				for (uint8_t pBit = 0; pBit < 2; ++pBit) {
+					BC7Endpoint endpoint;
+					endpoint.PBit = pBit;
+					float error = 0.0f;
+					for (uint32_t c = 0; c < 4; ++c) {
+						int value = (int)((color[c] - pBit) / 2.0f + 0.5f);
+						value = std::min(std::max(value, 0), 127);
+						endpoint.Value[c] = (uint8_t)value;
+						float d = (float)(value * 2 + pBit) - color[c];
+						error += d * d;
+					}
+					if (error < bestError) {
+						bestError = error;
+						best = endpoint;
+					}
+				}
+				return best;
+			}
+
+			uint32_t FitBC7(const Block& block, const BC7Endpoint& endpoint0, const BC7Endpoint& endpoint1, uint8_t* indices)
+			{
+				PaletteEntry palette[16];
+				for (uint32_t c = 0; c < 4; ++c) {
+					int e0 = (endpoint0.Value[c] << 1) | endpoint0.PBit;
+					int e1 = (endpoint1.Value[c] << 1) | endpoint1.PBit;
+					for (uint32_t i = 0; i < 16; ++i)
+						palette[i][c] = (int16_t)(((64 - BC7Weights[i]) * e0 + BC7Weights[i] * e1 + 32) >> 6);
+				}
+				return FindIndices(block, palette, 16, indices);
+			}
+
+			struct BitWriter
+			{
+				uint8_t* Data;
+				uint32_t Position;
+
+				void Write(uint32_t value, uint32_t bits)
+				{
+					for (uint32_t i = 0; i < bits; ++i, ++Position) {
+						if (value & (1u << i))
+							Data[Position >> 3] |= (uint8_t)(1u << (Position & 7));
+					}
+				}
+			};
+		}
+
+		void EncodeBC1(const uint8_t* pixels, uint8_t* block)
+		{
+			EncodeColor(pixels, block);
+		}
+
+		void EncodeBC3(const uint8_t* pixels, uint8_t* block)
+		{
+			EncodeChannel(pixels, 3, block);
+			EncodeColor(pixels, block + 8);
+		}
+
+		void EncodeBC5(const uint8_t* pixels, uint8_t* block)
+		{
+			EncodeChannel(pixels, 0, block);
+			EncodeChannel(pixels, 1, block + 8);
+		}
+
+		void EncodeBC7(const uint8_t* pixels, uint8_t* output)
+		{
+			Block block;
+			Widen(pixels, 0, 4, block);
+			float low[4], high[4];
+			FitAxis(pixels, 4, low, high);
+			BC7Endpoint endpoint0 = QuantizeBC7(low), endpoint1 = QuantizeBC7(high);
+			uint8_t indices[16];
+			uint32_t error = FitBC7(block, endpoint0, endpoint1, indices);
+
+			if (error > 0) {
+				float weights[16];
+				for (uint32_t i = 0; i < 16; ++i)
+					weights[i] = BC7Weights[indices[i]] / 64.0f;
+				if (LeastSquares(pixels, 4, weights, low, high)) {
+					BC7Endpoint refined0 = QuantizeBC7(low), refined1 = QuantizeBC7(high);
+					uint8_t refinedIndices[16];
+					uint32_t refinedError = FitBC7(block, refined0, refined1, refinedIndices);
+					if (refinedError < error) {
+						endpoint0 = refined0;
+						endpoint1 = refined1;
+						memcpy(indices, refinedIndices, sizeof(indices));
+					}
+				}
+			}
+
+			// the first index is stored without its top bit, so it must be below 8
+			if (indices[0] >= 8) {
+				std::swap(endpoint0, endpoint1);
+				for (uint32_t i = 0; i < 16; ++i)
+					indices[i] = (uint8_t)(15 - indices[i]);
+			}
+
+			memset(output, 0, 16);
+			BitWriter writer = { output, 0 };
+			writer.Write(1 << 6, 7);
+			for (uint32_t c = 0; c < 4; ++c) {
+				writer.Write(endpoint0.Value[c], 7);
+				writer.Write(endpoint1.Value[c], 7);
+			}
+			writer.Write(endpoint0.PBit, 1);
+			writer.Write(endpoint1.PBit, 1);
+			writer.Write(indices[0], 3);
+			for (uint32_t i = 1; i < 16; ++i)
+				writer.Write(indices[i], 4);
+		}
+
+		void CompressImage(TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* output, unsigned int threads)
+		{
+			void (*encode)(const uint8_t*, uint8_t*);
+			switch (format) {
+			case TextureFormat::BC1: encode = EncodeBC1; break;
+			case TextureFormat::BC3: encode = EncodeBC3; break;
+			case TextureFormat::BC5: encode = EncodeBC5; break;
+			case TextureFormat::BC7: encode = EncodeBC7; break;
+			default: return;
+			}
+			uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+			size_t blockSize = GetFormatUnitSize(format);
+
+			std::atomic<uint32_t> nextRow(0);
+			auto work = [&]() {
+				uint8_t pixels[64];
+				for (uint32_t by = nextRow++; by < blocksY; by = nextRow++) {
+					uint8_t* destination = output + (size_t)by * blocksX * blockSize;
+					for (uint32_t bx = 0; bx < blocksX; ++bx) {
+						for (uint32_t y = 0; y < 4; ++y) {
+							uint32_t sourceY = std::min(by * 4 + y, height - 1);
+							for (uint32_t x = 0; x < 4; ++x) {
+								uint32_t sourceX = std::min(bx * 4 + x, width - 1);
+								memcpy(pixels + (y * 4 + x) * 4, rgba + ((size_t)sourceY * width + sourceX) * 4, 4);
+							}
+						}
+						encode(pixels, destination);
+						destination += blockSize;
+					}
+				}
+			};
+
+			threads = std::min<unsigned int>(std::max(threads, 1u), blocksY);
+			std::vector<std::thread> workers;
+			for (unsigned int i = 1; i < threads; ++i)
+				workers.emplace_back(work);
+			work();
+			for (std::thread& worker : workers)
+				worker.join();
+		}
+
+	}
+}
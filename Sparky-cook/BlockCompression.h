@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "TextureFormat.h"
+
+namespace sparky {
+	namespace cook {
+
+		// 4x4 block encoders for the BC formats in TextureFormat.h. BC1 and BC3
+		// fit endpoints along the principal axis of the block and refine them
+		// once by least squares, BC5 encodes red and green as two BC4 blocks and
+		// BC7 uses mode 6 (one RGBA subset, 4 bit indices) only. The palette
+		// search runs on SSE2 when simd.h enables it.
+		//
+		// rgba is width by height RGBA8, rows tightly packed. Edge blocks repeat
+		// the last row and column. Block rows are split over threads.
+		void CompressImage(TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* output, unsigned int threads);
+
+		// Single blocks, pixels are 16 RGBA8 texels in row order
+		void EncodeBC1(const uint8_t* pixels, uint8_t* block);
+		void EncodeBC3(const uint8_t* pixels, uint8_t* block);
+		void EncodeBC5(const uint8_t* pixels, uint8_t* block);
+		void EncodeBC7(const uint8_t* pixels, uint8_t* block);
+
+	}
+}
@@ -0,0 +1,70 @@
+#include "AssetCookers.h"
+#include <string.h>
+
+namespace sparky {
+	namespace cook {
+
+		bool CookShader(const std::string&, const uint8_t* data, size_t size, const CookSettings&, std::vector<uint8_t>& output, std::string& error)
+		{
+			const char* source = reinterpret_cast<const char*>(data);
+			const char* end = source + size;
+			std::string result;
+			result.reserve(size);
+			std::string line;
+			bool inComment = false;
+
+			while (source < end) {
+				const char* newline = static_cast<const char*>(memchr(source, '\n', end - source));
+				const char* lineEnd = newline ? newline : end;
+
+				line.clear();
+				for (const char* c = source; c < lineEnd; ++c) {
+					if (inComment) {
+						if (c + 1 < lineEnd && c[0] == '*' && c[1] == '/') {
+							inComment = false;
+							++c;
+						}
+					}
+					else if (c + 1 < lineEnd && c[0] == '/' && c[1] == '/') {
+						break;
+					}
+					else if (c + 1 < lineEnd && c[0] == '/' && c[1] == '*') {
+						inComment = true;
+						++c;
+						// a comment separates tokens like a space does
+						line += ' ';
+					}
+					else {
+						line += *c == '\t' || *c == '\r' ? ' ' : *c;
+					}
+				}
+
+				// emptied lines stay as bare newlines, so compiler errors keep the
+				// line numbers of the source file
+				size_t first = line.find_first_not_of(' ');
+				if (first != std::string::npos) {
+					size_t last = line.find_last_not_of(' ');
+					result.append(line, first, last - first + 1);
+				}
+				result += '\n';
+				source = newline ? newline + 1 : end;
+			}
+
+			if (inComment) {
+				error = "unterminated comment";
+				return false;
+			}
+			// only the trailing blank lines can go
+			size_t last = result.find_last_not_of('\n');
+			result.resize(last == std::string::npos ? 0 : last + 2);
+			size_t first = result.find_first_not_of('\n');
+			if (first == std::string::npos || result.compare(first, 8, "#version") != 0) {
+				error = "does not start with #version";
+				return false;
+			}
+			output.assign(result.begin(), result.end());
+			return true;
+		}
+
+	}
+}
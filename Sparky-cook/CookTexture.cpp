@@ -0,0 +1,135 @@
+#include "AssetCookers.h"
+#include <ctype.h>
+#include <string.h>
+#include "BlockCompression.h"
+#include "CookedTexture.h"
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image/stb_image.h"
+
+namespace sparky {
+	namespace cook {
+
+		namespace {
+			// 2x2 box filter, the last row or column is repeated for odd extents
+			void Downsample(const uint8_t* source, uint32_t width, uint32_t height, uint32_t channels, uint8_t* destination)
+			{
+				uint32_t outWidth = CookedTextureHeader::LevelExtent(width, 1);
+				uint32_t outHeight = CookedTextureHeader::LevelExtent(height, 1);
+				size_t rowSize = (size_t)width * channels;
+				for (uint32_t y = 0; y < outHeight; ++y) {
+					const uint8_t* row0 = source + (size_t)(2 * y) * rowSize;
+					const uint8_t* row1 = 2 * y + 1 < height ? row0 + rowSize : row0;
+					for (uint32_t x = 0; x < outWidth; ++x) {
+						uint32_t x0 = 2 * x * channels;
+						uint32_t x1 = 2 * x + 1 < width ? x0 + channels : x0;
+						for (uint32_t c = 0; c < channels; ++c)
+							*destination++ = (uint8_t)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+					}
+				}
+			}
+
+			bool IsNormalMap(const std::string& path)
+			{
+				std::string name = path.substr(path.find_last_of('/') + 1);
+				for (char& c : name)
+					c = (char)tolower((unsigned char)c);
+				return name.find("_n.") != std::string::npos || name.find("_normal") != std::string::npos || name.find("_nrm") != std::string::npos;
+			}
+
+			TextureFormat ChooseFormat(const std::string& path, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, TextureEncoding encoding)
+			{
+				if (encoding == TextureEncoding::Raw)
+					return channels == 3 ? TextureFormat::RGB8 : TextureFormat::RGBA8;
+				if (IsNormalMap(path))
+					return TextureFormat::BC5;
+				if (encoding == TextureEncoding::BC7)
+					return TextureFormat::BC7;
+				// images with an alpha channel that is opaque everywhere fit BC1
+				for (size_t i = 0; i < (size_t)width * height; ++i) {
+					if (pixels[i * 4 + 3] != 255)
+						return TextureFormat::BC3;
+				}
+				return TextureFormat::BC1;
+			}
+		}
+
+		uint32_t TextureVariant(const CookSettings& settings)
+		{
+			return (uint32_t)settings.Textures;
+		}
+
+		bool CookTexture(const std::string& path, const uint8_t* data, size_t size, const CookSettings& settings, std::vector<uint8_t>& output, std::string& error)
+		{
+			int width, height, channels;
+			if (!stbi_info_from_memory(data, (int)size, &width, &height, &channels)) {
+				error = stbi_failure_reason();
+				return false;
+			}
+			// the encoders take RGBA, raw textures are stored RGB or RGBA
+			bool raw = settings.Textures == TextureEncoding::Raw;
+			uint32_t wanted = raw && channels == 3 ? 3 : 4;
+			// stbi_set_flip_vertically_on_load is global state, so flip here
+			// rather than race the other workers over it
+			stbi_uc* pixels = stbi_load_from_memory(data, (int)size, &width, &height, &channels, (int)wanted);
+			if (!pixels) {
+				error = stbi_failure_reason();
+				return false;
+			}
+
+			CookedTextureHeader header;
+			memset(&header, 0, sizeof(header));
+			header.Magic = CookedTextureHeader::MagicValue;
+			header.Version = CookedTextureHeader::CurrentVersion;
+			header.Width = (uint32_t)width;
+			header.Height = (uint32_t)height;
+			header.Format = ChooseFormat(path, pixels, header.Width, header.Height, wanted, settings.Textures);
+			header.Flags = CookedTextureHeader::FlippedVertically;
+			header.MipCount = 1;
+			while (CookedTextureHeader::LevelExtent(header.Width, header.MipCount - 1) > 1 || CookedTextureHeader::LevelExtent(header.Height, header.MipCount - 1) > 1)
+				header.MipCount++;
+
+			// the uncompressed chain first, compressed level by level after
+			std::vector<uint8_t> levels;
+			size_t levelsSize = 0;
+			for (uint32_t level = 0; level < header.MipCount; ++level)
+				levelsSize += GetImageSize(wanted == 3 ? TextureFormat::RGB8 : TextureFormat::RGBA8, CookedTextureHeader::LevelExtent(header.Width, level), CookedTextureHeader::LevelExtent(header.Height, level));
+			levels.resize(levelsSize);
+
+			size_t rowSize = (size_t)width * wanted;
+			for (int row = 0; row < height; ++row)
+				memcpy(levels.data() + row * rowSize, pixels + (size_t)(height - 1 - row) * rowSize, rowSize);
+			stbi_image_free(pixels);
+
+			uint8_t* previous = levels.data();
+			for (uint32_t level = 1; level < header.MipCount; ++level) {
+				uint32_t previousWidth = CookedTextureHeader::LevelExtent(header.Width, level - 1);
+				uint32_t previousHeight = CookedTextureHeader::LevelExtent(header.Height, level - 1);
+				uint8_t* current = previous + (size_t)previousWidth * previousHeight * wanted;
+				Downsample(previous, previousWidth, previousHeight, wanted, current);
+				previous = current;
+			}
+
+			size_t total = sizeof(header);
+			for (uint32_t level = 0; level < header.MipCount; ++level)
+				total += header.LevelSize(level);
+			output.resize(total);
+			memcpy(output.data(), &header, sizeof(header));
+			if (!IsBlockCompressed(header.Format)) {
+				memcpy(output.data() + sizeof(header), levels.data(), levels.size());
+				return true;
+			}
+
+			const uint8_t* source = levels.data();
+			uint8_t* destination = output.data() + sizeof(header);
+			for (uint32_t level = 0; level < header.MipCount; ++level) {
+				uint32_t levelWidth = CookedTextureHeader::LevelExtent(header.Width, level);
+				uint32_t levelHeight = CookedTextureHeader::LevelExtent(header.Height, level);
+				CompressImage(header.Format, source, levelWidth, levelHeight, destination, settings.EncoderThreads);
+				source += (size_t)levelWidth * levelHeight * 4;
+				destination += header.LevelSize(level);
+			}
+			return true;
+		}
+
+	}
+}
@@ -0,0 +1,373 @@
+#include "Cooker.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+#include "AssetCookers.h"
+#include "FileData.h"
+#include "PackFile.h"
+#include "VirtualFileSystem.h"
+#include "Log.h"
+
+#ifdef _WIN32
+	#include <Windows.h>
+	#include <direct.h>
+#else
+	#include <dirent.h>
+#endif
+
+namespace sparky {
+	namespace cook {
+
+		namespace {
+			// Bump when the cache or the pipeline changes in a way that affects every entry
+			const uint32_t CookerVersion = 1;
+			const char* const ManifestHeader = "sparky-cook-cache 1";
+
+			struct FileInfo
+			{
+				uint64_t Size;
+				// nanoseconds, as fine as the platform reports
+				int64_t ModifiedTime;
+			};
+
+			const int64_t NanosecondsPerSecond = 1000000000;
+
+			struct CacheRecord
+			{
+				uint64_t Size = 0;
+				int64_t ModifiedTime = 0;
+				uint64_t InputHash = 0;
+				uint32_t Version = 0;
+				// of the cooked output, and of the bytes stored for it in the pack
+				uint64_t CookedSize = 0;
+				uint64_t CookedHash = 0;
+				uint64_t StoredSize = 0;
+				bool Compressed = false;
+			};
+
+			enum class JobState { Unchanged, Cooked, Failed };
+
+			struct Job
+			{
+				std::string Path;
+				const AssetCooker* Cooker;
+				bool HasRecord;
+				CacheRecord Record;
+				JobState State;
+				std::string Error;
+				// encoded output, only kept for freshly cooked entries
+				std::vector<uint8_t> Stored;
+			};
+
+			bool GetFileInfo(const std::string& path, FileInfo& info)
+			{
+#ifdef _WIN32
+				WIN32_FILE_ATTRIBUTE_DATA data;
+				if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data) || (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+					return false;
+				info.Size = ((uint64_t)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+				// FILETIME counts 100 ns intervals
+				info.ModifiedTime = (int64_t)(((uint64_t)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime) * 100;
+#else
+				struct stat result;
+				if (stat(path.c_str(), &result) != 0 || !S_ISREG(result.st_mode))
+					return false;
+				info.Size = (uint64_t)result.st_size;
+	#ifdef __APPLE__
+				info.ModifiedTime = (int64_t)result.st_mtimespec.tv_sec * NanosecondsPerSecond + result.st_mtimespec.tv_nsec;
+	#else
+				info.ModifiedTime = (int64_t)result.st_mtim.tv_sec * NanosecondsPerSecond + result.st_mtim.tv_nsec;
+	#endif
+#endif
+				return true;
+			}
+
+			void MakeDirectory(const std::string& path)
+			{
+#ifdef _WIN32
+				_mkdir(path.c_str());
+#else
+				mkdir(path.c_str(), 0755);
+#endif
+			}
+
+			// Files below directory as paths starting with prefix, hidden entries skipped
+			void ListFiles(const std::string& directory, const std::string& prefix, std::vector<std::string>& files)
+			{
+#ifdef _WIN32
+				WIN32_FIND_DATAA data;
+				HANDLE find = FindFirstFileA((directory + "\\*").c_str(), &data);
+				if (find == INVALID_HANDLE_VALUE)
+					return;
+				do {
+					std::string name = data.cFileName;
+					if (name[0] == '.')
+						continue;
+					if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+						ListFiles(directory + "/" + name, prefix + name + "/", files);
+					else
+						files.push_back(prefix + name);
+				} while (FindNextFileA(find, &data));
+				FindClose(find);
+#else
+				DIR* dir = opendir(directory.c_str());
+				if (!dir)
+					return;
+				while (dirent* entry = readdir(dir)) {
+					std::string name = entry->d_name;
+					if (name[0] == '.')
+						continue;
+					struct stat info;
+					if (stat((directory + "/" + name).c_str(), &info) != 0)
+						continue;
+					if (S_ISDIR(info.st_mode))
+						ListFiles(directory + "/" + name, prefix + name + "/", files);
+					else if (S_ISREG(info.st_mode))
+						files.push_back(prefix + name);
+				}
+				closedir(dir);
+#endif
+			}
+
+			std::string BlobPath(const std::string& cacheDirectory, const std::string& path)
+			{
+				char name[32];
+				snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)PackFile::HashPath(path));
+				return cacheDirectory + "/" + name;
+			}
+
+			std::unordered_map<std::string, CacheRecord> LoadManifest(const std::string& cacheDirectory)
+			{
+				std::unordered_map<std::string, CacheRecord> records;
+				FILE* file = fopen((cacheDirectory + "/manifest").c_str(), "r");
+				if (!file)
+					return records;
+
+				char line[4096];
+				if (!fgets(line, sizeof(line), file) || strncmp(line, ManifestHeader, strlen(ManifestHeader)) != 0) {
+					fclose(file);
+					return records;
+				}
+				while (fgets(line, sizeof(line), file)) {
+					char* tab = strchr(line, '\t');
+					if (!tab)
+						continue;
+					CacheRecord record;
+					unsigned long long size, cookedSize, storedSize, inputHash, cookedHash;
+					long long modifiedTime;
+					unsigned int version, compressed;
+					if (sscanf(tab + 1, "%llu %lld %llx %u %llu %llx %llu %u", &size, &modifiedTime, &inputHash, &version, &cookedSize, &cookedHash, &storedSize, &compressed) != 8)
+						continue;
+					record.Size = size;
+					record.ModifiedTime = modifiedTime;
+					record.InputHash = inputHash;
+					record.Version = version;
+					record.CookedSize = cookedSize;
+					record.CookedHash = cookedHash;
+					record.StoredSize = storedSize;
+					record.Compressed = compressed != 0;
+					records[std::string(line, tab)] = record;
+				}
+				fclose(file);
+				return records;
+			}
+
+			bool SaveManifest(const std::string& cacheDirectory, const std::vector<Job>& jobs)
+			{
+				FILE* file = fopen((cacheDirectory + "/manifest").c_str(), "w");
+				if (!file)
+					return false;
+				fprintf(file, "%s\n", ManifestHeader);
+				for (const Job& job : jobs) {
+					if (job.State == JobState::Failed)
+						continue;
+					const CacheRecord& record = job.Record;
+					fprintf(file, "%s\t%llu %lld %016llx %u %llu %016llx %llu %u\n", job.Path.c_str(),
+						(unsigned long long)record.Size, (long long)record.ModifiedTime, (unsigned long long)record.InputHash, record.Version,
+						(unsigned long long)record.CookedSize, (unsigned long long)record.CookedHash, (unsigned long long)record.StoredSize,
+						record.Compressed ? 1u : 0u);
+				}
+				return fclose(file) == 0;
+			}
+
+			bool WriteBlob(const std::string& path, const std::vector<uint8_t>& data)
+			{
+				FILE* file = fopen(path.c_str(), "wb");
+				if (!file)
+					return false;
+				bool ok = data.empty() || fwrite(data.data(), 1, data.size(), file) == data.size();
+				return fclose(file) == 0 && ok;
+			}
+
+			bool ReadBlob(const std::string& path, uint64_t size, std::vector<uint8_t>& data)
+			{
+				MappedFile file;
+				if (!file.Open(path) || file.GetSize() != size)
+					return false;
+				data.assign(file.GetData(), file.GetData() + file.GetSize());
+				return true;
+			}
+
+			// manifestTime is when the cache records were written, 0 without a manifest
+			void RunJob(Job& job, const std::string& cacheDirectory, const CookSettings& settings, bool force, int64_t manifestTime)
+			{
+				uint32_t variant = job.Cooker->Variant ? job.Cooker->Variant(settings) : 0;
+				uint32_t version = (CookerVersion << 24) | (variant << 16) | job.Cooker->Version;
+				std::string blob = BlobPath(cacheDirectory, job.Path);
+				FileInfo info, blobInfo;
+				if (!GetFileInfo(job.Path, info)) {
+					job.State = JobState::Failed;
+					job.Error = "cannot stat";
+					return;
+				}
+				bool reusable = !force && job.HasRecord && job.Record.Version == version
+					&& GetFileInfo(blob, blobInfo) && blobInfo.Size == job.Record.StoredSize;
+
+				// untouched since the last cook, not even read. A file modified within a
+				// second of the manifest may have been edited again in the same clock
+				// tick on a file system with coarse times, so it is hashed.
+				bool settled = info.ModifiedTime < manifestTime - NanosecondsPerSecond;
+				if (reusable && settled && job.Record.Size == info.Size && job.Record.ModifiedTime == info.ModifiedTime) {
+					job.State = JobState::Unchanged;
+					return;
+				}
+
+				MappedFile file;
+				if (!file.Open(job.Path)) {
+					job.State = JobState::Failed;
+					job.Error = "cannot open";
+					return;
+				}
+				uint64_t inputHash = PackFile::HashContent(file.GetData(), file.GetSize());
+				job.Record.Size = info.Size;
+				job.Record.ModifiedTime = info.ModifiedTime;
+				// touched but the same contents
+				if (reusable && job.Record.InputHash == inputHash) {
+					job.State = JobState::Unchanged;
+					return;
+				}
+
+				std::vector<uint8_t> output;
+				if (!job.Cooker->Cook(job.Path, file.GetData(), file.GetSize(), settings, output, job.Error)) {
+					job.State = JobState::Failed;
+					return;
+				}
+				job.Record.InputHash = inputHash;
+				job.Record.Version = version;
+				job.Record.CookedSize = output.size();
+				job.Record.CookedHash = PackFile::HashContent(output.data(), output.size());
+				job.Record.Compressed = PackWriter::Encode(output.data(), output.size(), job.Cooker->Compress, job.Stored);
+				job.Record.StoredSize = job.Stored.size();
+				if (!WriteBlob(blob, job.Stored))
+					SPARKY_CORE_WARN("Could not cache {0}", job.Path);
+				job.State = JobState::Cooked;
+			}
+		}
+
+		int Cook(const CookOptions& options)
+		{
+			using clock = std::chrono::steady_clock;
+			clock::time_point start = clock::now();
+
+			std::string output = VirtualFileSystem::CanonicalPath(options.Output);
+			std::string cacheDirectory = VirtualFileSystem::CanonicalPath(options.CacheDirectory);
+			std::vector<std::string> files;
+			for (const std::string& root : options.Roots) {
+				std::string canonical = VirtualFileSystem::CanonicalPath(root);
+				ListFiles(canonical, canonical.empty() ? std::string() : canonical + "/", files);
+			}
+			// never cook our own output
+			files.erase(std::remove_if(files.begin(), files.end(), [&](const std::string& path) {
+				return path == output || path.compare(0, cacheDirectory.size() + 1, cacheDirectory + "/") == 0;
+			}), files.end());
+			std::sort(files.begin(), files.end());
+			files.erase(std::unique(files.begin(), files.end()), files.end());
+
+			MakeDirectory(cacheDirectory);
+			std::unordered_map<std::string, CacheRecord> records = LoadManifest(cacheDirectory);
+			FileInfo manifestInfo;
+			int64_t manifestTime = GetFileInfo(cacheDirectory + "/manifest", manifestInfo) ? manifestInfo.ModifiedTime : 0;
+			size_t removed = records.size();
+
+			std::vector<Job> jobs(files.size());
+			for (size_t i = 0; i < files.size(); ++i) {
+				Job& job = jobs[i];
+				job.Path = files[i];
+				job.Cooker = &FindCooker(files[i]);
+				auto it = records.find(files[i]);
+				job.HasRecord = it != records.end();
+				if (job.HasRecord) {
+					job.Record = it->second;
+					removed--;
+				}
+				job.State = JobState::Failed;
+			}
+
+			unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+			unsigned int workers = options.Jobs ? options.Jobs : hardwareThreads;
+			workers = (unsigned int)std::min<size_t>(workers, std::max<size_t>(jobs.size(), 1));
+			std::atomic<size_t> next(0);
+			// workers that ran out of jobs leave their share of the hardware to
+			// the assets still cooking, so one large texture at the end is
+			// encoded on every core
+			std::atomic<unsigned int> busy(workers);
+			auto work = [&]() {
+				for (size_t i = next++; i < jobs.size(); i = next++) {
+					CookSettings settings = options.Settings;
+					settings.EncoderThreads = std::max(1u, hardwareThreads / std::max(1u, busy.load()));
+					RunJob(jobs[i], cacheDirectory, settings, options.Force, manifestTime);
+				}
+				busy--;
+			};
+			std::vector<std::thread> threads;
+			for (unsigned int i = 1; i < workers; ++i)
+				threads.emplace_back(work);
+			work();
+			for (std::thread& thread : threads)
+				thread.join();
+
+			size_t cooked = 0, failed = 0;
+			for (const Job& job : jobs) {
+				if (job.State == JobState::Cooked) {
+					cooked++;
+				}
+				else if (job.State == JobState::Failed) {
+					failed++;
+					SPARKY_CORE_ERROR("{0} ({1}): {2}", job.Path, job.Cooker->Name, job.Error);
+				}
+			}
+
+			FileInfo outputInfo;
+			bool rewrite = cooked || failed || removed || !GetFileInfo(output, outputInfo);
+			if (rewrite) {
+				PackWriter writer;
+				for (Job& job : jobs) {
+					if (job.State == JobState::Failed)
+						continue;
+					if (job.State == JobState::Unchanged && !ReadBlob(BlobPath(cacheDirectory, job.Path), job.Record.StoredSize, job.Stored)) {
+						SPARKY_CORE_ERROR("Cache entry for {0} is unreadable, cook again with --force", job.Path);
+						return 1;
+					}
+					writer.AddStored(job.Path, std::move(job.Stored), job.Record.CookedSize, job.Record.CookedHash, job.Record.Compressed);
+				}
+				if (!writer.Write(output))
+					return 1;
+			}
+			// after the pack, so a failed write leaves the old manifest pointing at the old pack
+			if (!SaveManifest(cacheDirectory, jobs))
+				SPARKY_CORE_WARN("Could not write the cook cache manifest in {0}", cacheDirectory);
+
+			double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+			SPARKY_CORE_INFO("{0}: {1} files, {2} cooked, {3} up to date, {4} failed, {5} workers, {6:.1f} ms{7}",
+				output, jobs.size(), cooked, jobs.size() - cooked - failed, failed, workers, ms, rewrite ? "" : " (pack unchanged)");
+			return failed ? 1 : 0;
+		}
+
+	}
+}
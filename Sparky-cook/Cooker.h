@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "AssetCookers.h"
+
+// Sparky-cook pipeline. Every file under the roots goes through the cooker
+// its extension picks (AssetCookers.h) on a pool of worker threads, and the
+// results are written to one pack under their source paths, so the engine
+// finds them with --pack and no code changes.
+//
+// The cache directory keeps each cooked entry, already encoded for the pack,
+// next to a manifest of source size, timestamp, content hash and cooker
+// version and settings. A file whose size and timestamp are unchanged is not even read; a
+// touched file is hashed and only cooked again when its contents or its
+// cooker changed. The pack is rewritten only when some entry changed.
+
+namespace sparky {
+	namespace cook {
+
+		struct CookOptions
+		{
+			// Directories relative to the working directory, their paths inside
+			// the pack are the same
+			std::vector<std::string> Roots;
+			std::string Output = "assets.pak";
+			std::string CacheDirectory = ".cook-cache";
+			// 0 for one worker per hardware thread
+			unsigned int Jobs = 0;
+			// ignore the cache and cook everything
+			bool Force = false;
+			CookSettings Settings;
+		};
+
+		// Returns the process exit code
+		int Cook(const CookOptions& options);
+
+	}
+}
@@ -0,0 +1,46 @@
+#include <stdlib.h>
+#include "Cooker.h"
+#include "Log.h"
+
+// Sparky-cook: offline asset cooker, see Cooker.h. Run from Sparky-core/:
+//   Sparky-cook [--out <pack>] [--cache <dir>] [--jobs <n>] [--force] [--textures bc|bc7|raw] [roots...]
+// Roots default to res and shaders, the pack to assets.pak; the engine reads
+// it with --pack assets.pak. Textures are BC compressed unless raw is
+// asked for, bc7 trades cook time for quality. On Linux it builds with the
+// following command, given on one line:
+//   g++ -O2 -std=c++14 -pthread -ISparky-core -ISparky-core/vendor -ISparky-core/vendor/spdlog/include
+//       Sparky-cook/*.cpp Sparky-core/{Log,Profiler,Compression,FileData,PackFile,VirtualFileSystem}.cpp -o sparky-cook
+
+int main(int argc, char** argv)
+{
+	using namespace sparky;
+
+	Log::Init();
+
+	cook::CookOptions options;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--out" && hasValue) options.Output = argv[++i];
+		else if (arg == "--cache" && hasValue) options.CacheDirectory = argv[++i];
+		else if (arg == "--jobs" && hasValue) options.Jobs = (unsigned int)atoi(argv[++i]);
+		else if (arg == "--force") options.Force = true;
+		else if (arg == "--textures" && hasValue) {
+			std::string encoding = argv[++i];
+			if (encoding == "bc") options.Settings.Textures = cook::TextureEncoding::BC;
+			else if (encoding == "bc7") options.Settings.Textures = cook::TextureEncoding::BC7;
+			else if (encoding == "raw") options.Settings.Textures = cook::TextureEncoding::Raw;
+			else SPARKY_CORE_WARN("Unknown texture encoding {0}, expected bc, bc7 or raw", encoding);
+		}
+		else if (arg.compare(0, 2, "--") == 0) SPARKY_CORE_WARN("Unknown argument {0}", arg);
+		else options.Roots.push_back(arg);
+	}
+	if (options.Roots.empty()) {
+		options.Roots.push_back("res");
+		options.Roots.push_back("shaders");
+	}
+
+	int result = cook::Cook(options);
+	Log::Shutdown();
+	return result;
+}
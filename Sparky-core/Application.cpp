@@ -2,22 +2,44 @@
 #include "IndexBuffer.h"
 #include "VertexArray.h"
 #include "Texture.h"
+#include "AssetManager.h"
 #include "ExampleLayer.h"
 #include "ImGuiLayer.h"
+#include "simd_math.h"
+#include "PerfOverlay.h"
+#include "GLIntercept.h"
+#include "Memory.h"
+#include "MemoryTracker.h"
+#include "TextureStreamer.h"
+#include "MeshBuffer.h"
+#include "PostProcess.h"
+#include "DynamicResolution.h"
+#include "FrameContext.h"
+#include "FrameCapture.h"
 
 namespace sparky {
 
-	#define BIND_EVENT_FN(x) std::bind(&Application::x, this, std::placeholders::_1)
+	#define BIND_EVENT_FN(x) [this](auto& e) { return this->x(e); }
 
 	Application* Application::s_Instance = nullptr;
 
-	Application::Application()
+	Application::Application(const WindowProps& props)
 	{
 		SPARKY_CORE_ASSERT(!s_Instance, "Application already exists!");
 		s_Instance = this;
 
-		m_Window = std::unique_ptr<Sparky_Window>(Sparky_Window::Create());
-		m_Window->SetEventCallback(BIND_EVENT_FN(OnEvent));
+		m_Window = std::unique_ptr<Sparky_Window>(Sparky_Window::Create(props));
+		// Window events are queued while polling and dispatched once per frame in EndFrame,
+		// live input is dropped while a recording is replayed
+		m_Window->SetEventCallback([this](Event& e) {
+			if (!m_Player.IsPlaying() || !e.IsInCategory(EventCategoryInput))
+				m_EventQueue.Push(e);
+		});
+		m_Time = m_LastFrameTime = glfwGetTime();
+		m_FrameBegin = Profiler::Now();
+		PerfOverlay::Get().Init();
+		PerfOverlay::Get().BeginGpuFrame();
+		graphics::FrameContext::Init();
 
 		// OpenGL specification
 		int nrAttributes;
@@ -43,6 +65,65 @@ namespace sparky {
 
 	Application::~Application()
 	{
+		m_Recorder.Stop();
+		AssetManager::Clear();
+		TextureStreamer::Shutdown();
+		graphics::MeshBuffer::Shutdown();
+		PerfOverlay::Get().Shutdown();
+		graphics::FrameCapture::Shutdown();
+		graphics::FrameContext::Shutdown();
+	}
+
+	bool Application::StartRecording(const std::string& path)
+	{
+		if (m_Player.IsPlaying()) {
+			SPARKY_CORE_ERROR("Cannot record input while replaying");
+			return false;
+		}
+		return m_Recorder.Start(path);
+	}
+
+	bool Application::StartReplay(const std::string& path, float fixedTimestep)
+	{
+		if (m_Recorder.IsRecording()) {
+			SPARKY_CORE_ERROR("Cannot replay input while recording");
+			return false;
+		}
+		if (!m_Player.Open(path) || !m_Player.NextFrame())
+			return false;
+		m_FixedTimestep = fixedTimestep;
+		m_Timestep = m_FixedTimestep > 0.0f ? Timestep(m_FixedTimestep) : m_Player.GetTimestep();
+		m_Time = m_Player.GetTime();
+		m_ReplayFrameTimes.clear();
+		m_ReplayFrameTimes.reserve(m_Player.GetFrameCount());
+		return true;
+	}
+
+	void Application::CreateSceneTarget(int samples)
+	{
+		SPARKY_MEMORY_TAG(Renderer);
+		graphics::FramebufferSpec spec;
+		spec.Width = (GLsizei)m_Window->GetWidth();
+		spec.Height = (GLsizei)m_Window->GetHeight();
+		spec.ColorFormat = GL_RGBA16F;
+		spec.Samples = samples;
+		m_SceneTarget.reset(new graphics::Framebuffer(spec));
+		m_PostProcess.reset(new graphics::PostProcessChain());
+	}
+
+	void Application::EnablePostProcessing(int samples)
+	{
+		CreateSceneTarget(samples);
+		m_PostProcess->AddBloomTonemap();
+	}
+
+	void Application::EnableDynamicResolution(float budgetMilliseconds)
+	{
+		if (!m_SceneTarget)
+			CreateSceneTarget(1);
+		DynamicResolution::Settings settings;
+		settings.BudgetMilliseconds = budgetMilliseconds;
+		m_Resolution.reset(new DynamicResolution(settings));
 	}
 
 	void Application::PushLayer(Layer* layer)
@@ -59,8 +140,13 @@ namespace sparky {
 
 	void Application::OnEvent(Event& e)
 	{
+		m_Recorder.Record(e);
+		// Input sees every event, before a layer can mark it handled
+		Input::OnEvent(e);
+
 		EventDispatcher dispatcher(e);
-		dispatcher.Dispatch<WindowCloseEvent>(BIND_EVENT_FN(OnWindowClose));
+		dispatcher.Dispatch(this, &Application::OnWindowClose);
+		dispatcher.Dispatch(this, &Application::OnWindowResize);
 
 		for (auto it = m_LayerStack.end(); it != m_LayerStack.begin(); )
 		{
@@ -70,31 +156,156 @@ namespace sparky {
 		}
 	}
 
+	void Application::EndFrame()
+	{
+		// everything from the end of the last frame up to here is the demo's own rendering
+		Profiler::Record("Application::Render", m_FrameBegin, Profiler::Now());
+		PerfOverlay& perf = PerfOverlay::Get();
+		if (m_SceneTarget) {
+			SPARKY_PROFILE_SCOPE("PostProcessChain::Apply");
+			m_SceneTarget->Resolve(m_RenderWidth, m_RenderHeight);
+			m_PostProcess->Apply(*m_SceneTarget, m_RenderWidth, m_RenderHeight, nullptr, (GLsizei)m_Window->GetWidth(), (GLsizei)m_Window->GetHeight());
+		}
+		// before the layers, so the overlay stays out of captures
+		graphics::FrameCapture::CaptureBackbuffer((GLsizei)m_Window->GetWidth(), (GLsizei)m_Window->GetHeight());
+		{
+			SPARKY_PROFILE_SCOPE("LayerStack::OnUpdate");
+			for (Layer* layer : m_LayerStack) {
+				PerfOverlay::Clock::time_point begin = PerfOverlay::Clock::now();
+				layer->OnUpdate();
+				perf.RecordLayer(layer, begin);
+			}
+		}
+		perf.EndGpuFrame();
+		{
+			SPARKY_PROFILE_SCOPE("Window::OnUpdate (poll, swap)");
+			PerfOverlay::Clock::time_point begin = PerfOverlay::Clock::now();
+			m_Window->OnUpdate();
+			perf.RecordSwap(begin);
+		}
+		// waits here if the GPU is FramesInFlight frames behind
+		graphics::FrameContext::EndFrame();
+		graphics::FrameCapture::Update();
+		{
+			SPARKY_PROFILE_SCOPE("EventQueue::Flush");
+			if (m_Player.IsPlaying())
+				m_Player.QueueEvents(m_EventQueue);
+			m_EventQueue.Flush(BIND_EVENT_FN(OnEvent));
+			Input::EndFrame();
+		}
+
+		AdvanceClock();
+		TextureStreamer::Update();
+		GLIntercept::EndFrame();
+		Memory::EndFrame();
+		MemoryTracker::EndFrame();
+		perf.EndFrame();
+		perf.BeginGpuFrame();
+		float gpuMilliseconds;
+		if (m_Resolution && perf.GetGpuFrameTime(gpuMilliseconds))
+			m_Resolution->Update(gpuMilliseconds);
+
+		uint64_t now = Profiler::Now();
+		Profiler::Record("Frame", m_FrameBegin, now);
+		m_FrameBegin = now;
+		BeginFrame();
+	}
+
+	void Application::BeginFrame()
+	{
+		if (!m_SceneTarget)
+			return;
+		// the target keeps its full size, only the part rendered to shrinks
+		float scale = m_Resolution ? m_Resolution->GetScale() : 1.0f;
+		m_RenderWidth = std::max(1, (int)(m_SceneTarget->GetWidth() * scale + 0.5f));
+		m_RenderHeight = std::max(1, (int)(m_SceneTarget->GetHeight() * scale + 0.5f));
+		m_SceneTarget->bind(m_RenderWidth, m_RenderHeight);
+	}
+
+	void Application::AdvanceClock()
+	{
+		double now = glfwGetTime();
+		float frameTime = (float)(now - m_LastFrameTime);
+		m_LastFrameTime = now;
+
+		m_Recorder.EndFrame(m_Time, m_Timestep);
+
+		if (m_Player.IsPlaying()) {
+			m_ReplayFrameTimes.push_back(frameTime);
+			if (m_Player.NextFrame()) {
+				m_Timestep = m_FixedTimestep > 0.0f ? Timestep(m_FixedTimestep) : m_Player.GetTimestep();
+				m_Time = m_FixedTimestep > 0.0f ? m_Time + m_FixedTimestep : m_Player.GetTime();
+			}
+			else {
+				FinishReplay();
+			}
+			return;
+		}
+
+		m_Timestep = frameTime;
+		m_Time += frameTime;
+	}
+
+	void Application::FinishReplay()
+	{
+		m_Running = false;
+		// the first frame also covers the demo's setup
+		if (m_ReplayFrameTimes.size() < 2)
+			return;
+		std::vector<float> times(m_ReplayFrameTimes.begin() + 1, m_ReplayFrameTimes.end());
+		std::sort(times.begin(), times.end());
+		auto percentile = [&times](float p) { return times[(size_t)(p * (times.size() - 1))] * 1000.0f; };
+		SPARKY_CORE_INFO("Replay finished: {0} frames, frame time p50 {1:.3f} ms, p95 {2:.3f} ms, p99 {3:.3f} ms, max {4:.3f} ms",
+			times.size(), percentile(0.5f), percentile(0.95f), percentile(0.99f), times.back() * 1000.0f);
+	}
+
 	void Application::clear() const {
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	}
 
 	void Application::update() {
-		GLenum error = glGetError();
-		if (error != GL_NO_ERROR) {
-			std::cout << "OpenGL Error: " << error << std::endl;
-		}
-
 		glfwPollEvents();
 		// glfwGetFramebufferSize(m_Window, &m_Width, &m_Height);
 		// glViewport(0, 0, m_Width, m_Height);
 		glfwSwapBuffers(static_cast<GLFWwindow*>(m_Window->GetNativeWindow()));
 	}
 
+	namespace {
+		// std140 layout of the Camera block in Going-3D.vert
+		struct CameraUniforms {
+			glm::mat4 View;
+			glm::mat4 Proj;
+		};
+		const GLuint CameraBinding = 0;
+
+		// The block only lives in this frame's slice of the transient buffer, so it
+		// is written and bound again every frame. Skipped when the slice is full,
+		// the overlay counts those overflows.
+		void BindCamera(const glm::mat4& view, const glm::mat4& proj) {
+			graphics::TransientAllocation camera = graphics::FrameContext::AllocateUniforms(sizeof(CameraUniforms));
+			if (!camera)
+				return;
+			CameraUniforms uniforms = { view, proj };
+			memcpy(camera.Data, &uniforms, sizeof(uniforms));
+			graphics::FrameContext::Commit(camera);
+			glBindBufferRange(GL_UNIFORM_BUFFER, CameraBinding, camera.Buffer, camera.Offset, camera.Size);
+		}
+	}
+
 	void Application::Run()
 	{
+		SPARKY_PROFILE_FUNCTION();
+		m_FrameBegin = Profiler::Now();
+		BeginFrame();
 		using namespace graphics;
 		using namespace maths;
 
 		while (m_Running)
 		{
 			int InterDemoIndex;
-			
+			// the demo's setup allocates, its frames should not once it runs
+			MemoryTracker::BeginWarmup();
+
 			switch (DemoIndex)
 			{
 			case 1:
@@ -108,10 +319,7 @@ namespace sparky {
 					glClearColor(1, 0, 1, 1);
 					glClear(GL_COLOR_BUFFER_BIT);
 
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
 			}
 			break;
@@ -144,8 +352,8 @@ namespace sparky {
 				glBindVertexArray(0);
 
 				// 2. use our shader program when we want to render an object
-				Shader shader("shaders/Getting-started/hello-triangle.vert", "shaders/Getting-started/hello-triangle.frag");
-				shader.enable();
+				AssetRef<Shader> shader = AssetManager::LoadShader("shaders/Getting-started/hello-triangle.vert", "shaders/Getting-started/hello-triangle.frag");
+				shader->enable();
 
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
@@ -153,16 +361,13 @@ namespace sparky {
 					glBindVertexArray(vao);
 					glDrawArrays(GL_TRIANGLES, 0, 3);
 
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
 
 				glDeleteVertexArrays(1, &vao);
 				glDeleteBuffers(1, &vbo);
 
-				shader.disable();
+				shader->disable();
 			}
 			break;
 			case 3:
@@ -189,8 +394,8 @@ namespace sparky {
 				VertexArray vao;
 				vao.AddBuffers(new Buffer(vertices, 4 * 3, 3), 0);
 				IndexBuffer ibo(indeces, 6);
-				Shader shader("shaders/Getting-started/hello-triangle.vert", "shaders/Getting-started/hello-triangle.frag");
-				shader.enable();
+				AssetRef<Shader> shader = AssetManager::LoadShader("shaders/Getting-started/hello-triangle.vert", "shaders/Getting-started/hello-triangle.frag");
+				shader->enable();
 
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
@@ -201,13 +406,10 @@ namespace sparky {
 					vao.unbind();
 					ibo.unbind();
 
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
 				
-				shader.disable();
+				shader->disable();
 			}
 			break;
 			case 4:
@@ -232,16 +434,16 @@ namespace sparky {
 				VertexArray vao;
 				vao.AddBuffers(new Buffer(vertices, 3 * 3, 3), 0);
 				IndexBuffer ibo(indeces, 3);
-				Shader shader("shaders/Getting-started/hello-triangle.vert", "shaders/Getting-started/time_triangle.frag");
-				shader.enable();
+				AssetRef<Shader> shader = AssetManager::LoadShader("shaders/Getting-started/hello-triangle.vert", "shaders/Getting-started/time_triangle.frag");
+				shader->enable();
 				float ourColor;
 				vao.bind();
 				ibo.bind();
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
 
-					ourColor = (float)abs(sin(2.0f * glfwGetTime()));
-					shader.setUniform4f("ourColor", vec4(0.0f, ourColor, 0.0f, 1.0f));
+					ourColor = (float)abs(sin(2.0f * GetTime()));
+					shader->setUniform4f("ourColor", vec4(0.0f, ourColor, 0.0f, 1.0f));
 
 					// vao.bind();
 					// ibo.bind();
@@ -249,15 +451,12 @@ namespace sparky {
 					// vao.unbind();
 					// ibo.unbind();
 
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
 				vao.unbind();
 				ibo.unbind();
 
-				shader.disable();
+				shader->disable();
 			}
 			break;
 			case 5:
@@ -286,17 +485,14 @@ namespace sparky {
 				vao.AddBuffers(new Buffer(vertices, 3 * 3, 3), 0);
 				vao.AddBuffers(new Buffer(colors, 3 * 3, 3), 1);
 				IndexBuffer ibo(indices, 3);
-				Shader shader("shaders/Getting-started/space_color.vert", "shaders/Getting-started/space_color.frag");
-				shader.enable();
+				AssetRef<Shader> shader = AssetManager::LoadShader("shaders/Getting-started/space_color.vert", "shaders/Getting-started/space_color.frag");
+				shader->enable();
 				vao.bind();
 				ibo.bind();
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
 					glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_SHORT, 0);
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
 				vao.unbind();
 				ibo.unbind();
@@ -342,24 +538,21 @@ namespace sparky {
 				vao.AddBuffers(new Buffer(texcoords, 4 * 2, 2), 2);
 				
 				IndexBuffer ibo(indices, 6);
-				Shader shader("shaders/Getting-started/simple_texture.vert", "shaders/Getting-started/simple_texture.frag");
-				Texture texture("res/Textures/wall.jpg");
-				shader.enable();
+				AssetRef<Shader> shader = AssetManager::LoadShader("shaders/Getting-started/simple_texture.vert", "shaders/Getting-started/simple_texture.frag");
+				AssetRef<Texture> texture = AssetManager::LoadTexture("res/Textures/wall.jpg");
+				shader->enable();
 				vao.bind();
 				ibo.bind();
-				texture.bind();
+				texture->bind();
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
 					glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
-				texture.unbind();
+				texture->unbind();
 				vao.unbind();
 				ibo.unbind();
-				shader.disable();
+				shader->disable();
 			}
 			break;
 			case 7:
@@ -402,30 +595,27 @@ namespace sparky {
 				vao.AddBuffers(new Buffer(texcoords, 4 * 2, 2), 2);
 
 				IndexBuffer ibo(indices, 6);
-				Shader shader("shaders/Getting-started/Mixed_tex.vert", "shaders/Getting-started/Mixed_tex.frag");
-				Texture texture2("res/Textures/wall.jpg");
-				Texture texture1("res/Textures/awesomeface.png");
-				shader.enable();
+				AssetRef<Shader> shader = AssetManager::LoadShader("shaders/Getting-started/Mixed_tex.vert", "shaders/Getting-started/Mixed_tex.frag");
+				AssetRef<Texture> texture2 = AssetManager::LoadTexture("res/Textures/wall.jpg");
+				AssetRef<Texture> texture1 = AssetManager::LoadTexture("res/Textures/awesomeface.png");
+				shader->enable();
 				vao.bind();
 				ibo.bind();
-				shader.setUniform1i("texture1", 0);
-				shader.setUniform1i("texture2", 1);
-				texture1.bind(0);
-				texture2.bind(1);
+				shader->setUniform1i("texture1", 0);
+				shader->setUniform1i("texture2", 1);
+				texture1->bind(0);
+				texture2->bind(1);
 				glfwSetWindowSize(static_cast<GLFWwindow*>(m_Window->GetNativeWindow()), 720, 720);
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
 					glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
-				texture2.unbind();
-				texture1.unbind();
+				texture2->unbind();
+				texture1->unbind();
 				vao.unbind();
 				ibo.unbind();
-				shader.disable();
+				shader->disable();
 				glfwSetWindowSize(static_cast<GLFWwindow*>(m_Window->GetNativeWindow()), scr_width, scr_height);
 			}
 			break;
@@ -477,16 +667,16 @@ namespace sparky {
 				vao.AddBuffers(new Buffer(texcoords, 4 * 2, 2), 2);
 
 				IndexBuffer ibo(indices, 6);
-				Shader shader("shaders/Getting-started/transform.vert", "shaders/Getting-started/transform.frag");
-				Texture texture1("res/Textures/awesomeface.png");
-				Texture texture2("res/Textures/wall.jpg");
-				shader.enable();
+				AssetRef<Shader> shader = AssetManager::LoadShader("shaders/Getting-started/transform.vert", "shaders/Getting-started/transform.frag");
+				AssetRef<Texture> texture1 = AssetManager::LoadTexture("res/Textures/awesomeface.png");
+				AssetRef<Texture> texture2 = AssetManager::LoadTexture("res/Textures/wall.jpg");
+				shader->enable();
 				vao.bind();
 				ibo.bind();
-				shader.setUniform1i("texture1", 0);
-				shader.setUniform1i("texture2", 1);
-				texture1.bind(0);
-				texture2.bind(1);
+				shader->setUniform1i("texture1", 0);
+				shader->setUniform1i("texture2", 1);
+				texture1->bind(0);
+				texture2->bind(1);
 				glfwSetWindowSize(static_cast<GLFWwindow*>(m_Window->GetNativeWindow()), 720, 720);
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
@@ -494,26 +684,23 @@ namespace sparky {
 					glm::mat4 trans = glm::mat4(1.0f);
 					if (case_8_order) {
 						trans = glm::translate(trans, glm::vec3(0.5f, -0.5f, 0.0f));
-						trans = glm::rotate(trans, (float)glfwGetTime(), glm::vec3(0.0f, 0.0f, 1.0f));
+						trans = glm::rotate(trans, GetTime(), glm::vec3(0.0f, 0.0f, 1.0f));
 					}
 					else {
-						trans = glm::rotate(trans, (float)glfwGetTime(), glm::vec3(0.0f, 0.0f, 1.0f));
+						trans = glm::rotate(trans, GetTime(), glm::vec3(0.0f, 0.0f, 1.0f));
 						trans = glm::translate(trans, glm::vec3(0.5f, -0.5f, 0.0f));
 					}
-					shader.setUniformMat4("transform", trans);
+					shader->setUniformMat4("transform", trans);
 
 					glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
 
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
-				texture2.unbind();
-				texture1.unbind();
+				texture2->unbind();
+				texture1->unbind();
 				vao.unbind();
 				ibo.unbind();
-				shader.disable();
+				shader->disable();
 				glfwSetWindowSize(static_cast<GLFWwindow*>(m_Window->GetNativeWindow()), scr_width, scr_height);
 			}
 			break;
@@ -656,17 +843,20 @@ namespace sparky {
 
 				IndexBuffer ibo(indices, 36);
 
-				Shader shader("shaders/Getting-started/Going-3D.vert", "shaders/Getting-started/Going-3D.frag");
-				Texture texture1("res/Textures/awesomeface.png");
-				Texture texture2("res/Textures/wall.jpg");
+				AssetRef<Shader> shader = AssetManager::LoadShader("shaders/Getting-started/Going-3D.vert", "shaders/Getting-started/Going-3D.frag");
+				// streamed when cooked, each cube asks for the mips its size on screen needs
+				TextureSettings streamed;
+				streamed.Streamed = true;
+				AssetRef<Texture> texture1 = AssetManager::LoadTexture("res/Textures/awesomeface.png", streamed);
+				AssetRef<Texture> texture2 = AssetManager::LoadTexture("res/Textures/wall.jpg", streamed);
 
-				shader.enable();
+				shader->enable();
 				vao.bind();
 				ibo.bind();
-				shader.setUniform1i("texture1", 0);
-				shader.setUniform1i("texture2", 1);
-				texture1.bind(0);
-				texture2.bind(1);
+				shader->setUniform1i("texture1", 0);
+				shader->setUniform1i("texture2", 1);
+				texture1->bind(0);
+				texture2->bind(1);
 
 				// glm::mat4 model = glm::mat4(1.0f);
 				// model = glm::rotate(model, glm::radians(-55.0f), glm::vec3(1.0f, 0.0f, 0.0f));
@@ -677,11 +867,17 @@ namespace sparky {
 				glm::mat4 proj = glm::mat4(1.0f);
 				proj = glm::perspective(glm::radians(45.0f), (float)scr_width / (float)scr_height, 0.1f, 100.0f);
 
-				shader.setUniformMat4("view", view);
-				shader.setUniformMat4("proj", proj);
+				shader->setUniformBlockBinding("Camera", CameraBinding);
+				// pixels a unit long object covers at distance 1
+				float pixelsPerUnit = (float)scr_height / (2.0f * tanf(glm::radians(22.5f)));
+				glm::vec3 cameraPosition(0.0f, 0.0f, 3.0f);
 
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
+					BindCamera(view, proj);
+					// streaming replaces the GL names as mips come and go
+					texture1->bind(0);
+					texture2->bind(1);
 
 					if (case_9_multi) {
 						for (unsigned int i = 0; i < 10; ++i) {
@@ -689,30 +885,32 @@ namespace sparky {
 							model = glm::translate(model, cubePositions[i]);
 							float angle = 2.0f * (i + 1);
 							// float angle = (i % 3 == 0) ? (2.0f * (i + 1)) : 45.0f;
-							model = glm::rotate(model, (float)glfwGetTime() * glm::radians(angle), cubePositions[i]);
-							shader.setUniformMat4("model", model);
+							model = glm::rotate(model, GetTime() * glm::radians(angle), cubePositions[i]);
+							shader->setUniformMat4("model", model);
 							glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, 0);
+							float pixels = pixelsPerUnit / glm::length(cubePositions[i] - cameraPosition);
+							texture1->RequestScreenSize(pixels);
+							texture2->RequestScreenSize(pixels);
 						}
 					}
 					else {
 						glm::mat4 model = glm::mat4(1.0f);
-						model = glm::rotate(model, (float)glfwGetTime() * glm::radians(45.0f), glm::vec3(0.5f, 1.0f, 0.0f));
-						shader.setUniformMat4("model", model);
+						model = glm::rotate(model, GetTime() * glm::radians(45.0f), glm::vec3(0.5f, 1.0f, 0.0f));
+						shader->setUniformMat4("model", model);
 						glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, 0);
+						texture1->RequestScreenSize(pixelsPerUnit / 3.0f);
+						texture2->RequestScreenSize(pixelsPerUnit / 3.0f);
 					}
 
 
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
 
-				texture2.unbind();
-				texture1.unbind();
+				texture2->unbind();
+				texture1->unbind();
 				ibo.unbind();
 				vao.unbind();
-				shader.disable();
+				shader->disable();
 			}
 			break;
 			case 10:
@@ -846,17 +1044,17 @@ namespace sparky {
 
 				IndexBuffer ibo(indices, 36);
 
-				Shader shader("shaders/Getting-started/Going-3D.vert", "shaders/Getting-started/Going-3D.frag");
-				Texture texture1("res/Textures/awesomeface.png");
-				Texture texture2("res/Textures/wall.jpg");
+				AssetRef<Shader> shader = AssetManager::LoadShader("shaders/Getting-started/Going-3D.vert", "shaders/Getting-started/Going-3D.frag");
+				AssetRef<Texture> texture1 = AssetManager::LoadTexture("res/Textures/awesomeface.png");
+				AssetRef<Texture> texture2 = AssetManager::LoadTexture("res/Textures/wall.jpg");
 
-				shader.enable();
+				shader->enable();
 				vao.bind();
 				ibo.bind();
-				shader.setUniform1i("texture1", 0);
-				shader.setUniform1i("texture2", 1);
-				texture1.bind(0);
-				texture2.bind(1);
+				shader->setUniform1i("texture1", 0);
+				shader->setUniform1i("texture2", 1);
+				texture1->bind(0);
+				texture2->bind(1);
 
 				// glm::mat4 model = glm::mat4(1.0f);
 				// model = glm::rotate(model, glm::radians(-55.0f), glm::vec3(1.0f, 0.0f, 0.0f));
@@ -867,13 +1065,13 @@ namespace sparky {
 				glm::mat4 proj = glm::mat4(1.0f);
 				proj = glm::perspective(glm::radians(45.0f), (float)scr_width / (float)scr_height, 0.1f, 100.0f);
 
-				shader.setUniformMat4("proj", proj);
+				shader->setUniformBlockBinding("Camera", CameraBinding);
 
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
 					
 					// Just one line lol !!!
-					shader.setUniformMat4("view", camera->view);
+					BindCamera(camera->view, proj);
 
 					for (unsigned int i = 0; i < 10; ++i) {
 						glm::mat4 model = glm::mat4(1.0f);
@@ -881,21 +1079,18 @@ namespace sparky {
 						float angle = 20.0f * i;
 						// float angle = (i % 3 == 0) ? (2.0f * (i + 1)) : 45.0f;
 						model = glm::rotate(model, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
-						shader.setUniformMat4("model", model);
+						shader->setUniformMat4("model", model);
 						glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, 0);
 					}
 
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
 
-				texture2.unbind();
-				texture1.unbind();
+				texture2->unbind();
+				texture1->unbind();
 				ibo.unbind();
 				vao.unbind();
-				shader.disable();
+				shader->disable();
 			}
 			break;
 			case 11:
@@ -957,13 +1152,13 @@ namespace sparky {
 
 				// mat4 ortho = mat4::Transpose(mat4::orthographic(0.0f, 16.0f, 0.0f, 9.0f, -1.0f, 1.0f));
 				glm::mat4 proj = glm::ortho(0.0f, 16.0f, 0.0f, 9.0f, -1.0f, 1.0f);
-				Shader shader("shaders/Lighting/basic.vert", "shaders/Lighting/basic.frag");
-				shader.enable();
+				AssetRef<Shader> shader = AssetManager::LoadShader("shaders/Lighting/basic.vert", "shaders/Lighting/basic.frag");
+				shader->enable();
 
-				shader.setUniformMat4("pr_matrix", proj);
-				// shader.setUniformMat4("ml_matrix", mat4::translation(vec3(4, 3, 0)));
-				shader.setUniform4f("colour", vec4(0.2f, 0.3f, 0.8f, 1.0f));
-				shader.setUniform2f("light_pos", vec2(4.0f, 1.5f));
+				shader->setUniformMat4("pr_matrix", proj);
+				// shader->setUniformMat4("ml_matrix", mat4::translation(vec3(4, 3, 0)));
+				shader->setUniform4f("colour", vec4(0.2f, 0.3f, 0.8f, 1.0f));
+				shader->setUniform2f("light_pos", vec2(4.0f, 1.5f));
 				auto window = static_cast<GLFWwindow*>(s_Instance->Get().GetWindow().GetNativeWindow());
 
 				double x, y;
@@ -974,35 +1169,32 @@ namespace sparky {
 
 					glfwGetCursorPos(window, &x, &y);
 
-					shader.setUniform2f("light_pos", vec2((float)(x * 16.0f / 1280.0f), (float)(9.0f - y * 9.0f / 720.0f)));
+					shader->setUniform2f("light_pos", vec2((float)(x * 16.0f / 1280.0f), (float)(9.0f - y * 9.0f / 720.0f)));
 
 					sprite1.bind();
 					ibo.bind();
-					shader.setUniformMat4("ml_matrix", mat4::translation(vec3(0, 0, 0)));
+					shader->setUniformMat4("ml_matrix", mat4::translation(vec3(0, 0, 0)));
 					glDrawElements(GL_TRIANGLES, ibo.getCount(), GL_UNSIGNED_SHORT, 0);
 					ibo.unbind();
 					sprite1.unbind();
 
 					sprite2.bind();
 					ibo.bind();
-					shader.setUniformMat4("ml_matrix", mat4::translation(vec3(4, 3, 0)));
+					shader->setUniformMat4("ml_matrix", mat4::translation(vec3(4, 3, 0)));
 					glDrawElements(GL_TRIANGLES, ibo.getCount(), GL_UNSIGNED_SHORT, 0);
 					ibo.unbind();
 					sprite2.unbind();
 
 					sprite3.bind();
 					ibo.bind();
-					shader.setUniformMat4("ml_matrix", mat4::translation(vec3(8, 6, 0)));
+					shader->setUniformMat4("ml_matrix", mat4::translation(vec3(8, 6, 0)));
 					glDrawElements(GL_TRIANGLES, ibo.getCount(), GL_UNSIGNED_SHORT, 0);
 					ibo.unbind();
 					sprite3.unbind();
 
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
-				shader.disable();
+				shader->disable();
 			}
 			break;
 			case 12:
@@ -1043,19 +1235,18 @@ namespace sparky {
 					1, 5, 7
 				};
 
-				VertexArray cubeVAO;
-				IndexBuffer ibo(indices, 36);
-				cubeVAO.AddBuffers(new Buffer(vertices, 8 * 3, 3), 0);
+				// carved out of the shared position-only buffer, drawn with its base vertex
+				MeshBuffer& meshes = MeshBuffer::Get({ 3 });
+				GLuint cube = meshes.Add(vertices, 8, indices, 36);
 
-				Shader shaderColor("shaders/Lighting/1.Colors.vert", "shaders/Lighting/1.Colors.frag");
-				Shader shaderLight("shaders/Lighting/1.Light.vert", "shaders/Lighting/1.Light.frag");
+				AssetRef<Shader> shaderColor = AssetManager::LoadShader("shaders/Lighting/1.Colors.vert", "shaders/Lighting/1.Colors.frag");
+				AssetRef<Shader> shaderLight = AssetManager::LoadShader("shaders/Lighting/1.Light.vert", "shaders/Lighting/1.Light.frag");
 				
 				glm::mat4 proj = glm::mat4(1.0f);
 				proj = glm::perspective(glm::radians(45.0f), (float)scr_width / (float)scr_height, 0.1f, 100.0f);
 				glm::mat4 model;
 				
-				cubeVAO.bind();
-				ibo.bind();
+				meshes.bind();
 
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
@@ -1063,35 +1254,32 @@ namespace sparky {
 					model = glm::mat4(1.0f);
 					lightColor = glm::vec4(color_r, color_g, color_b, color_a);
 
-					shaderColor.enable();
-					shaderColor.setUniform4f("lightColor", lightColor);
-					shaderColor.setUniform4f("objectColor", objectColor);
-					shaderColor.setUniformMat4("model", model);
-					shaderColor.setUniformMat4("view", camera->view);
-					shaderColor.setUniformMat4("proj", proj);
-					glDrawElements(GL_TRIANGLES, ibo.getCount(), GL_UNSIGNED_SHORT, 0);
+					shaderColor->enable();
+					shaderColor->setUniform4f("lightColor", lightColor);
+					shaderColor->setUniform4f("objectColor", objectColor);
+					shaderColor->setUniformMat4("model", model);
+					shaderColor->setUniformMat4("view", camera->view);
+					shaderColor->setUniformMat4("proj", proj);
+					meshes.Draw(cube);
 
 					model = glm::mat4(1.0f);
 					model = glm::translate(model, lightPos);
 					model = glm::scale(model, glm::vec3(0.2f));
 					
-					shaderLight.enable();
-					shaderLight.setUniform4f("lightColor", lightColor);
-					shaderLight.setUniformMat4("model", model);
-					shaderLight.setUniformMat4("view", camera->view);
-					shaderLight.setUniformMat4("proj", proj);
-					glDrawElements(GL_TRIANGLES, ibo.getCount(), GL_UNSIGNED_SHORT, 0);
-					// shaderLight.disable();
-
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					shaderLight->enable();
+					shaderLight->setUniform4f("lightColor", lightColor);
+					shaderLight->setUniformMat4("model", model);
+					shaderLight->setUniformMat4("view", camera->view);
+					shaderLight->setUniformMat4("proj", proj);
+					meshes.Draw(cube);
+					// shaderLight->disable();
+
+					EndFrame();
 				}
 
-				ibo.unbind();
-				cubeVAO.unbind();
-				shaderLight.disable();
+				meshes.unbind();
+				meshes.Remove(cube);
+				shaderLight->disable();
 			}
 			break;
 			case 13:
@@ -1213,8 +1401,8 @@ namespace sparky {
 				cubeVAO.AddBuffers(new Buffer(normals,  36 * 3, 3), 1);
 				IndexBuffer ibo(indices, 36);
 
-				Shader shaderColor("shaders/Lighting/2.Colors.vert", "shaders/Lighting/2.Colors.frag");
-				Shader shaderLight("shaders/Lighting/2.Light.vert", "shaders/Lighting/2.Light.frag");
+				AssetRef<Shader> shaderColor = AssetManager::LoadShader("shaders/Lighting/2.Colors.vert", "shaders/Lighting/2.Colors.frag");
+				AssetRef<Shader> shaderLight = AssetManager::LoadShader("shaders/Lighting/2.Light.vert", "shaders/Lighting/2.Light.frag");
 
 				glm::mat4 proj = glm::mat4(1.0f);
 				proj = glm::perspective(glm::radians(45.0f), (float)scr_width / (float)scr_height, 0.1f, 100.0f);
@@ -1229,33 +1417,34 @@ namespace sparky {
 				float theta;
 				case_13_speed = 15.0f;// 10.0f;
 				float lastTime, deltaTime;
-				lastTime = (float)glfwGetTime();
+				lastTime = GetTime();
 				float x, y, z;
+				floatx4 angles, s, c;
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
 
 					model = glm::mat4(1.0f);
 					lightColor = glm::vec4(color_r, color_g, color_b, color_a);
 
-					shaderColor.enable();
-					shaderColor.setUniform3f("viewPos", camera->cameraPos);
-					shaderColor.setUniform3f("lightPos", lightPos);
-					shaderColor.setUniform4f("lightColor", lightColor);
-					shaderColor.setUniform4f("objectColor", objectColor);
-					shaderColor.setUniformMat4("model", model);
-					shaderColor.setUniformMat4("view", camera->view);
-					shaderColor.setUniformMat4("proj", proj);
+					shaderColor->enable();
+					shaderColor->setUniform3f("viewPos", camera->cameraPos);
+					shaderColor->setUniform3f("lightPos", lightPos);
+					shaderColor->setUniform4f("lightColor", lightColor);
+					shaderColor->setUniform4f("objectColor", objectColor);
+					shaderColor->setUniformMat4("model", model);
+					shaderColor->setUniformMat4("view", camera->view);
+					shaderColor->setUniformMat4("proj", proj);
 					glDrawElements(GL_TRIANGLES, ibo.getCount(), GL_UNSIGNED_SHORT, 0);
 
 					// model = glm::mat4(1.0f);
 					
 					if (case_13_rotate) {
-						deltaTime = (float)glfwGetTime() - lastTime;
+						deltaTime = GetTime() - lastTime;
 						case_13_theta += deltaTime * case_13_speed * 10;
 						case_13_theta = (case_13_theta > 180.0f) ? -180.0f : case_13_theta;
 						lastTime += deltaTime;
 						// flash
-						// deltaTime = (float)glfwGetTime() - lastTime;
+						// deltaTime = GetTime() - lastTime;
 						// case_13_theta += deltaTime * case_13_speed;
 						// case_13_theta = (float)((int)case_13_theta % 360 - 180);
 						// std::cout << case_13_theta << std::endl;
@@ -1263,31 +1452,31 @@ namespace sparky {
 					}
 
 					theta = (float)(((int)(case_13_theta + 180) % 360) - 180);
-					x = glm::cos(glm::radians(case_13_phi)) * glm::sin(glm::radians(theta));
-					y = glm::sin(glm::radians(case_13_phi));
-					z = glm::cos(glm::radians(case_13_phi)) * glm::cos(glm::radians(theta));
+					angles[0] = glm::radians(case_13_phi);
+					angles[1] = glm::radians(theta);
+					simd::sincos(angles, s, c);
+					x = c[0] * s[1];
+					y = s[0];
+					z = c[0] * c[1];
 					lightPos = case_13_radius * glm::vec3(x, y, z);
 					
 					model = glm::translate(model, lightPos);
 					model = glm::scale(model, glm::vec3(0.1f));
 
-					shaderLight.enable();
-					shaderLight.setUniform4f("lightColor", lightColor);
-					shaderLight.setUniformMat4("model", model);
-					shaderLight.setUniformMat4("view", camera->view);
-					shaderLight.setUniformMat4("proj", proj);
+					shaderLight->enable();
+					shaderLight->setUniform4f("lightColor", lightColor);
+					shaderLight->setUniformMat4("model", model);
+					shaderLight->setUniformMat4("view", camera->view);
+					shaderLight->setUniformMat4("proj", proj);
 					glDrawElements(GL_TRIANGLES, ibo.getCount(), GL_UNSIGNED_SHORT, 0);
-					// shaderLight.disable();
-
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
+					// shaderLight->disable();
 
-					m_Window->OnUpdate();
+					EndFrame();
 				}
 
 				ibo.unbind();
 				cubeVAO.unbind();
-				shaderLight.disable();
+				shaderLight->disable();
 			}
 			break;
 			case 14:
@@ -1408,8 +1597,8 @@ namespace sparky {
 				cubeVAO.AddBuffers(new Buffer(normals, 36 * 3, 3), 1);
 				IndexBuffer ibo(indices, 36);
 
-				Shader shaderMaterial("shaders/Lighting/3.Material.vert", "shaders/Lighting/3.Material.frag");
-				Shader shaderLight("shaders/Lighting/2.Light.vert", "shaders/Lighting/2.Light.frag");
+				AssetRef<Shader> shaderMaterial = AssetManager::LoadShader("shaders/Lighting/3.Material.vert", "shaders/Lighting/3.Material.frag");
+				AssetRef<Shader> shaderLight = AssetManager::LoadShader("shaders/Lighting/2.Light.vert", "shaders/Lighting/2.Light.frag");
 
 				glm::mat4 proj = glm::mat4(1.0f);
 				proj = glm::perspective(glm::radians(45.0f), (float)scr_width / (float)scr_height, 0.1f, 100.0f);
@@ -1424,8 +1613,9 @@ namespace sparky {
 				float theta;
 				case_13_speed = 15.0f;// 10.0f;
 				float lastTime, deltaTime;
-				lastTime = (float)glfwGetTime();
+				lastTime = GetTime();
 				float x, y, z;
+				floatx4 angles, s, c;
 				case_14_mat = 0;
 				while (m_Running && DemoIndex == InterDemoIndex) {
 					clear();
@@ -1433,275 +1623,275 @@ namespace sparky {
 					model = glm::mat4(1.0f);
 					lightColor = glm::vec4(color_r, color_g, color_b, color_a);
 
-					shaderMaterial.enable();
-					shaderMaterial.setUniform3f("viewPos", camera->cameraPos);
-					shaderMaterial.setUniform3f("light.position", lightPos);
-					shaderMaterial.setUniform3f("light.diffuse", glm::vec3(lightColor) * glm::vec3(0.5f));
-					shaderMaterial.setUniform3f("light.ambient", glm::vec3(lightColor) * glm::vec3(0.1f));
-					shaderMaterial.setUniform3f("light.specular", glm::vec3(1.0f));
+					shaderMaterial->enable();
+					shaderMaterial->setUniform3f("viewPos", camera->cameraPos);
+					shaderMaterial->setUniform3f("light.position", lightPos);
+					shaderMaterial->setUniform3f("light.diffuse", glm::vec3(lightColor) * glm::vec3(0.5f));
+					shaderMaterial->setUniform3f("light.ambient", glm::vec3(lightColor) * glm::vec3(0.1f));
+					shaderMaterial->setUniform3f("light.specular", glm::vec3(1.0f));
 					// material properties
 					switch (case_14_mat)
 					{
 					case 0:
 					{
 						// emerald
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.0215, 0.1745, 0.0215));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.07568, 0.61424, 0.07568));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.633, 0.727811, 0.633));
-						shaderMaterial.setUniform1f("material.shininess", (float)76.8);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.0215, 0.1745, 0.0215));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.07568, 0.61424, 0.07568));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.633, 0.727811, 0.633));
+						shaderMaterial->setUniform1f("material.shininess", (float)76.8);
 					}
 					break;
 					case 1:
 					{
 						// jade
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.135, 0.2225, 0.1575));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.54, 0.89, 0.63));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.316228, 0.316228, 0.316228));
-						shaderMaterial.setUniform1f("material.shininess", (float)12.8);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.135, 0.2225, 0.1575));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.54, 0.89, 0.63));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.316228, 0.316228, 0.316228));
+						shaderMaterial->setUniform1f("material.shininess", (float)12.8);
 					}
 					break;
 					case 2:
 					{
 						// obsidian
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.05375, 0.05, 0.06625));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.18275, 0.17, 0.22525));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.332741, 0.328634, 0.346435));
-						shaderMaterial.setUniform1f("material.shininess", (float)38.4);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.05375, 0.05, 0.06625));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.18275, 0.17, 0.22525));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.332741, 0.328634, 0.346435));
+						shaderMaterial->setUniform1f("material.shininess", (float)38.4);
 					}
 					break;
 					case 3:
 					{
 						// pearl
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.25, 0.20725, 0.20725));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(1, 0.829, 0.829));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.296648, 0.296648, 0.296648));
-						shaderMaterial.setUniform1f("material.shininess", (float)11.264);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.25, 0.20725, 0.20725));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(1, 0.829, 0.829));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.296648, 0.296648, 0.296648));
+						shaderMaterial->setUniform1f("material.shininess", (float)11.264);
 					}
 					break;
 					case 4:
 					{
 						// ruby
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.1745, 0.01175, 0.01175));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.61424, 0.04136, 0.04136));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.727811, 0.626959, 0.626959));
-						shaderMaterial.setUniform1f("material.shininess", (float)76.8);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.1745, 0.01175, 0.01175));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.61424, 0.04136, 0.04136));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.727811, 0.626959, 0.626959));
+						shaderMaterial->setUniform1f("material.shininess", (float)76.8);
 					}
 					break;
 					case 5:
 					{
 						// turquoise
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.1, 0.18725, 0.1745));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.396, 0.74151, 0.69102));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.297254, 0.30829, 0.306678));
-						shaderMaterial.setUniform1f("material.shininess", (float)12.8);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.1, 0.18725, 0.1745));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.396, 0.74151, 0.69102));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.297254, 0.30829, 0.306678));
+						shaderMaterial->setUniform1f("material.shininess", (float)12.8);
 					}
 					break;
 					case 6:
 					{
 						// brass
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.329412, 0.223529, 0.027451));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.780392, 0.568627, 0.113725));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.992157, 0.941176, 0.807843));
-						shaderMaterial.setUniform1f("material.shininess", (float)27.897);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.329412, 0.223529, 0.027451));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.780392, 0.568627, 0.113725));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.992157, 0.941176, 0.807843));
+						shaderMaterial->setUniform1f("material.shininess", (float)27.897);
 					}
 					break;
 					case 7:
 					{
 						// bronze
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.2125, 0.1275, 0.054));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.714, 0.4284, 0.18144));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.393548, 0.271906, 0.166721));
-						shaderMaterial.setUniform1f("material.shininess", (float)25.6);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.2125, 0.1275, 0.054));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.714, 0.4284, 0.18144));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.393548, 0.271906, 0.166721));
+						shaderMaterial->setUniform1f("material.shininess", (float)25.6);
 					}
 					break;
 					case 8:
 					{
 						// chrome
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.25, 0.25, 0.25));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.4, 0.4, 0.4));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.774597, 0.774597, 0.774597));
-						shaderMaterial.setUniform1f("material.shininess", (float)76.8);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.25, 0.25, 0.25));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.4, 0.4, 0.4));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.774597, 0.774597, 0.774597));
+						shaderMaterial->setUniform1f("material.shininess", (float)76.8);
 					}
 					break;
 					case 9:
 					{
 						// copper
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.19125, 0.0735, 0.0225));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.7038, 0.27048, 0.0828));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.256777, 0.137622, 0.086014));
-						shaderMaterial.setUniform1f("material.shininess", (float)12.8);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.19125, 0.0735, 0.0225));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.7038, 0.27048, 0.0828));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.256777, 0.137622, 0.086014));
+						shaderMaterial->setUniform1f("material.shininess", (float)12.8);
 					}
 					break;
 					case 10:
 					{
 						// gold
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.24725, 0.1995, 0.0745));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.75164, 0.60648, 0.22648));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.628281, 0.555802, 0.366065));
-						shaderMaterial.setUniform1f("material.shininess", (float)51.2);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.24725, 0.1995, 0.0745));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.75164, 0.60648, 0.22648));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.628281, 0.555802, 0.366065));
+						shaderMaterial->setUniform1f("material.shininess", (float)51.2);
 					}
 					break;
 					case 11:
 					{
 						// silver
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.19225, 0.19225, 0.19225));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.50754, 0.50754, 0.50754));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.508273, 0.508273, 0.508273));
-						shaderMaterial.setUniform1f("material.shininess", (float)51.2);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.19225, 0.19225, 0.19225));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.50754, 0.50754, 0.50754));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.508273, 0.508273, 0.508273));
+						shaderMaterial->setUniform1f("material.shininess", (float)51.2);
 					}
 					break;
 					case 12:
 					{
 						// black plastic
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.0, 0.0, 0.0));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.01, 0.01, 0.01));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.50, 0.50, 0.50));
-						shaderMaterial.setUniform1f("material.shininess", (float)32);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.0, 0.0, 0.0));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.01, 0.01, 0.01));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.50, 0.50, 0.50));
+						shaderMaterial->setUniform1f("material.shininess", (float)32);
 					}
 					break;
 					case 13:
 					{
 						// cyan plastic
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.0, 0.1, 0.06));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.0, 0.50980392, 0.50980392));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.501961, 0.501961, 0.501961));
-						shaderMaterial.setUniform1f("material.shininess", (float)32);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.0, 0.1, 0.06));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.0, 0.50980392, 0.50980392));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.501961, 0.501961, 0.501961));
+						shaderMaterial->setUniform1f("material.shininess", (float)32);
 					}
 					break;
 					case 14:
 					{
 						// green plastic
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.0, 0.0, 0.0));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.1, 0.35, 0.1));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.45, 0.55, 0.45));
-						shaderMaterial.setUniform1f("material.shininess", (float)32);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.0, 0.0, 0.0));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.1, 0.35, 0.1));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.45, 0.55, 0.45));
+						shaderMaterial->setUniform1f("material.shininess", (float)32);
 					}
 					break;
 					case 15:
 					{
 						// red plastic
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.0, 0.0, 0.0));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.5, 0.0, 0.0));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.7, 0.6, 0.6));
-						shaderMaterial.setUniform1f("material.shininess", (float)32);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.0, 0.0, 0.0));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.5, 0.0, 0.0));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.7, 0.6, 0.6));
+						shaderMaterial->setUniform1f("material.shininess", (float)32);
 					}
 					break;
 					case 16:
 					{
 						// white plastic
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.0, 0.0, 0.0));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.55, 0.55, 0.55));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.70, 0.70, 0.70));
-						shaderMaterial.setUniform1f("material.shininess", (float)32);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.0, 0.0, 0.0));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.55, 0.55, 0.55));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.70, 0.70, 0.70));
+						shaderMaterial->setUniform1f("material.shininess", (float)32);
 					}
 					break;
 					case 17:
 					{
 						// yellow plastic
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.0, 0.0, 0.0));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.5, 0.5, 0.0));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.60, 0.60, 0.50));
-						shaderMaterial.setUniform1f("material.shininess", (float)32);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.0, 0.0, 0.0));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.5, 0.5, 0.0));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.60, 0.60, 0.50));
+						shaderMaterial->setUniform1f("material.shininess", (float)32);
 					}
 					break;
 					case 18:
 					{
 						// black rubber
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.02, 0.02, 0.02));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.01, 0.01, 0.01));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.4, 0.4, 0.4));
-						shaderMaterial.setUniform1f("material.shininess", (float)10);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.02, 0.02, 0.02));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.01, 0.01, 0.01));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.4, 0.4, 0.4));
+						shaderMaterial->setUniform1f("material.shininess", (float)10);
 					}
 					break;
 					case 19:
 					{
 						// cyan rubber
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.0, 0.05, 0.05));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.4, 0.5, 0.5));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.04, 0.7, 0.7));
-						shaderMaterial.setUniform1f("material.shininess", (float)10);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.0, 0.05, 0.05));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.4, 0.5, 0.5));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.04, 0.7, 0.7));
+						shaderMaterial->setUniform1f("material.shininess", (float)10);
 					}
 					break;
 					case 20:
 					{
 						// green rubber
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.0, 0.05, 0.0));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.4, 0.5, 0.4));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.04, 0.7, 0.04));
-						shaderMaterial.setUniform1f("material.shininess", (float)10);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.0, 0.05, 0.0));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.4, 0.5, 0.4));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.04, 0.7, 0.04));
+						shaderMaterial->setUniform1f("material.shininess", (float)10);
 					}
 					break;
 					case 21:
 					{
 						// red rubber
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.05, 0.0, 0.0));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.5, 0.4, 0.4));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.7, 0.04, 0.04));
-						shaderMaterial.setUniform1f("material.shininess", (float)10);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.05, 0.0, 0.0));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.5, 0.4, 0.4));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.7, 0.04, 0.04));
+						shaderMaterial->setUniform1f("material.shininess", (float)10);
 					}
 					break;
 					case 22:
 					{
 						// white rubber
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.05, 0.05, 0.05));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.5, 0.5, 0.5));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.7, 0.7, 0.7));
-						shaderMaterial.setUniform1f("material.shininess", (float)10);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.05, 0.05, 0.05));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.5, 0.5, 0.5));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.7, 0.7, 0.7));
+						shaderMaterial->setUniform1f("material.shininess", (float)10);
 					}
 					break;
 					case 23:
 					{
 						// yellow rubber
-						shaderMaterial.setUniform3f("material.ambient", glm::vec3(0.05, 0.05, 0.0));
-						shaderMaterial.setUniform3f("material.diffuse", glm::vec3(0.5, 0.5, 0.4));
-						shaderMaterial.setUniform3f("material.specular", glm::vec3(0.7, 0.7, 0.04));
-						shaderMaterial.setUniform1f("material.shininess", (float)10);
+						shaderMaterial->setUniform3f("material.ambient", glm::vec3(0.05, 0.05, 0.0));
+						shaderMaterial->setUniform3f("material.diffuse", glm::vec3(0.5, 0.5, 0.4));
+						shaderMaterial->setUniform3f("material.specular", glm::vec3(0.7, 0.7, 0.04));
+						shaderMaterial->setUniform1f("material.shininess", (float)10);
 					}
 					break;
 					default:
 						break;
 					}
 
-					shaderMaterial.setUniformMat4("model", model);
-					shaderMaterial.setUniformMat4("view", camera->view);
-					shaderMaterial.setUniformMat4("proj", proj);
+					shaderMaterial->setUniformMat4("model", model);
+					shaderMaterial->setUniformMat4("view", camera->view);
+					shaderMaterial->setUniformMat4("proj", proj);
 					glDrawElements(GL_TRIANGLES, ibo.getCount(), GL_UNSIGNED_SHORT, 0);
 
 					// model = glm::mat4(1.0f);
 
 					if (case_13_rotate) {
-						deltaTime = (float)glfwGetTime() - lastTime;
+						deltaTime = GetTime() - lastTime;
 						case_13_theta += deltaTime * case_13_speed * 10;
 						case_13_theta = (case_13_theta > 180.0f) ? -180.0f : case_13_theta;
 						lastTime += deltaTime;
 					}
 
 					theta = (float)(((int)(case_13_theta + 180) % 360) - 180);
-					x = glm::cos(glm::radians(case_13_phi)) * glm::sin(glm::radians(theta));
-					y = glm::sin(glm::radians(case_13_phi));
-					z = glm::cos(glm::radians(case_13_phi)) * glm::cos(glm::radians(theta));
+					angles[0] = glm::radians(case_13_phi);
+					angles[1] = glm::radians(theta);
+					simd::sincos(angles, s, c);
+					x = c[0] * s[1];
+					y = s[0];
+					z = c[0] * c[1];
 					lightPos = case_13_radius * glm::vec3(x, y, z);
 
 					model = glm::translate(model, lightPos);
 					model = glm::scale(model, glm::vec3(0.1f));
 
-					shaderLight.enable();
-					shaderLight.setUniform4f("lightColor", lightColor);
-					shaderLight.setUniformMat4("model", model);
-					shaderLight.setUniformMat4("view", camera->view);
-					shaderLight.setUniformMat4("proj", proj);
+					shaderLight->enable();
+					shaderLight->setUniform4f("lightColor", lightColor);
+					shaderLight->setUniformMat4("model", model);
+					shaderLight->setUniformMat4("view", camera->view);
+					shaderLight->setUniformMat4("proj", proj);
 					glDrawElements(GL_TRIANGLES, ibo.getCount(), GL_UNSIGNED_SHORT, 0);
-					// shaderLight.disable();
+					// shaderLight->disable();
 
-					for (Layer* layer : m_LayerStack)
-						layer->OnUpdate();
-
-					m_Window->OnUpdate();
+					EndFrame();
 				}
 
 				ibo.unbind();
 				cubeVAO.unbind();
-				shaderLight.disable();
+				shaderLight->disable();
 			}
 			break;
 			default:
@@ -1717,6 +1907,19 @@ namespace sparky {
 		return true;
 	}
 
+	bool Application::OnWindowResize(WindowResizeEvent& e)
+	{
+		// minimized windows report 0 x 0
+		if (!e.GetWidth() || !e.GetHeight())
+			return false;
+		// the scene target is bound again by BeginFrame
+		if (m_SceneTarget)
+			m_SceneTarget->Resize((GLsizei)e.GetWidth(), (GLsizei)e.GetHeight());
+		else
+			graphics::Framebuffer::BindDefault((GLsizei)e.GetWidth(), (GLsizei)e.GetHeight());
+		return false;
+	}
+
 	void Application::next_demo() {
 		glClearColor(0, 0, 0, 1);
 		if (resetCamera) {
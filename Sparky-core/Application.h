@@ -1,15 +1,25 @@
 #pragma once
 
 #include "LayerStack.h"
+#include "Events/EventQueue.h"
+#include "InputRecording.h"
+#include "Timestep.h"
+#include "Profiler.h"
 #include "Camera.h"
 
 namespace sparky {
 
+	namespace graphics {
+		class Framebuffer;
+		class PostProcessChain;
+	}
+	class DynamicResolution;
+
 	// Application class
 	class Application
 	{
 	public:
-		Application();
+		Application(const WindowProps& props = WindowProps());
 		virtual ~Application();
 
 		void Run();
@@ -23,12 +33,59 @@ namespace sparky {
 
 		inline Sparky_Window& GetWindow() { return *m_Window; }
 
+		// Length of the current frame and the time at its start in seconds. While
+		// replaying both come from the recording instead of the wall clock.
+		inline Timestep GetTimestep() const { return m_Timestep; }
+		inline float GetTime() const { return (float)m_Time; }
+
+		// Records the input and timestep of every frame until the application exits
+		bool StartRecording(const std::string& path);
+		// Feeds a recording back instead of the live input and quits at its end,
+		// fixedTimestep > 0 replaces the recorded timesteps
+		bool StartReplay(const std::string& path, float fixedTimestep = 0.0f);
+
+		// Renders the demos into an offscreen HDR target that gets bloom and
+		// tonemapping on its way to the window, ImGui still draws on top at
+		// native resolution. samples > 1 multisamples the target.
+		void EnablePostProcessing(int samples = 1);
+		inline graphics::PostProcessChain* GetPostProcess() { return m_PostProcess.get(); }
+		// Scales the offscreen target between 50 and 100% every frame to keep the
+		// measured GPU frame time within budgetMilliseconds. The chain upscales
+		// it to the window, an empty one when post-processing is off.
+		void EnableDynamicResolution(float budgetMilliseconds);
+		inline DynamicResolution* GetDynamicResolution() { return m_Resolution.get(); }
+		// Size the demos render at this frame
+		inline int GetRenderWidth() const { return m_RenderWidth; }
+		inline int GetRenderHeight() const { return m_RenderHeight; }
+
 		inline static Application& Get() { return *s_Instance; }
 		inline void quitApplication() { m_Running = false; }
 	private:
 		bool OnWindowClose(WindowCloseEvent& e);
+		bool OnWindowResize(WindowResizeEvent& e);
+		// Points rendering at the scene target, when there is one, at the current scale
+		void BeginFrame();
+		void CreateSceneTarget(int samples);
+		// Updates the layers, swaps and polls the window and dispatches the queued events
+		void EndFrame();
+		// Picks the timestep of the next frame
+		void AdvanceClock();
+		void FinishReplay();
 
 		std::unique_ptr<Sparky_Window> m_Window;
+		// declared after the window so they are destroyed while its context lives
+		std::unique_ptr<graphics::Framebuffer> m_SceneTarget;
+		std::unique_ptr<graphics::PostProcessChain> m_PostProcess;
+		std::unique_ptr<DynamicResolution> m_Resolution;
+		int m_RenderWidth = 0, m_RenderHeight = 0;
+		EventQueue m_EventQueue;
+		InputRecorder m_Recorder;
+		InputPlayer m_Player;
+		Timestep m_Timestep;
+		double m_Time = 0.0, m_LastFrameTime = 0.0;
+		float m_FixedTimestep = 0.0f;
+		std::vector<float> m_ReplayFrameTimes;
+		uint64_t m_FrameBegin = 0;
 		bool m_Running = true;
 		LayerStack m_LayerStack;
 	public:
@@ -59,6 +116,6 @@ namespace sparky {
 	};
 
 	// To be defined in CLIENT
-	inline Application* CreateApplication() { return new Application(); }
+	inline Application* CreateApplication(const WindowProps& props = WindowProps()) { return new Application(props); }
 
 }
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "AssetManager.h"
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Log.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "VirtualFileSystem.h"
+
+namespace sparky {
+
+	using graphics::Texture;
+	using graphics::Shader;
+
+	namespace {
+		enum class AssetType : uint8_t { Texture, Shader };
+
+		struct CacheEntry
+		{
+			AssetType Type;
+			uint32_t Index;
+		};
+
+		template<typename T>
+		struct AssetStorage
+		{
+			struct Slot
+			{
+				std::unique_ptr<T> Asset;
+				std::string Key;
+				// starts at 1 so a default handle never resolves
+				uint32_t Generation = 1;
+				uint32_t RefCount = 0;
+				size_t Bytes = 0;
+				// did not load, kept out of ByKey and never cached so the next load retries
+				bool Failed = false;
+				// position in s_Cache while unreferenced
+				std::list<CacheEntry>::iterator CachePosition;
+			};
+
+			std::vector<Slot> Slots;
+			std::vector<uint32_t> FreeSlots;
+			std::unordered_map<std::string, uint32_t> ByKey;
+		};
+
+		AssetStorage<Texture> s_Textures;
+		AssetStorage<Shader> s_Shaders;
+		// unreferenced assets, least recently released at the front
+		std::list<CacheEntry> s_Cache;
+		size_t s_CacheBudget = 256 << 20;
+		AssetManager::Stats s_Stats;
+
+		inline AssetStorage<Texture>& StorageOf(Texture*) { return s_Textures; }
+		inline AssetStorage<Shader>& StorageOf(Shader*) { return s_Shaders; }
+		inline AssetType TypeOf(Texture*) { return AssetType::Texture; }
+		inline AssetType TypeOf(Shader*) { return AssetType::Shader; }
+
+		template<typename T>
+		typename AssetStorage<T>::Slot* Lookup(AssetHandle<T> handle)
+		{
+			AssetStorage<T>& storage = StorageOf((T*)nullptr);
+			if (!handle.IsValid() || handle.Index >= storage.Slots.size())
+				return nullptr;
+			typename AssetStorage<T>::Slot& slot = storage.Slots[handle.Index];
+			return slot.Generation == handle.Generation && slot.Asset ? &slot : nullptr;
+		}
+
+		template<typename T>
+		void Destroy(uint32_t index)
+		{
+			AssetStorage<T>& storage = StorageOf((T*)nullptr);
+			typename AssetStorage<T>::Slot& slot = storage.Slots[index];
+			if (!slot.Failed)
+				storage.ByKey.erase(slot.Key);
+			s_Stats.ResidentBytes -= slot.Bytes;
+			slot.Asset.reset();
+			slot.Key.clear();
+			slot.RefCount = 0;
+			slot.Bytes = 0;
+			slot.Failed = false;
+			if (++slot.Generation == 0)
+				slot.Generation = 1;
+			storage.FreeSlots.push_back(index);
+		}
+
+		void TrimCache()
+		{
+			while (s_Stats.CachedBytes > s_CacheBudget && !s_Cache.empty()) {
+				CacheEntry entry = s_Cache.front();
+				s_Cache.pop_front();
+				size_t bytes;
+				if (entry.Type == AssetType::Texture) {
+					bytes = s_Textures.Slots[entry.Index].Bytes;
+					Destroy<Texture>(entry.Index);
+				}
+				else {
+					bytes = s_Shaders.Slots[entry.Index].Bytes;
+					Destroy<Shader>(entry.Index);
+				}
+				s_Stats.CachedBytes -= bytes;
+				s_Stats.Cached--;
+				s_Stats.Evictions++;
+			}
+		}
+
+		// Finds the asset under key and takes a reference, reviving it from the cache
+		template<typename T>
+		AssetHandle<T> Acquire(const std::string& key)
+		{
+			AssetStorage<T>& storage = StorageOf((T*)nullptr);
+			auto it = storage.ByKey.find(key);
+			if (it == storage.ByKey.end())
+				return AssetHandle<T>();
+
+			typename AssetStorage<T>::Slot& slot = storage.Slots[it->second];
+			if (slot.RefCount++ == 0) {
+				s_Cache.erase(slot.CachePosition);
+				s_Stats.CachedBytes -= slot.Bytes;
+				s_Stats.Cached--;
+				s_Stats.Referenced++;
+			}
+			s_Stats.CacheHits++;
+			AssetHandle<T> handle;
+			handle.Index = it->second;
+			handle.Generation = slot.Generation;
+			return handle;
+		}
+
+		// A failed asset still gets a handle, so callers keep a valid object, but
+		// it is not shared and is destroyed with its last reference
+		template<typename T>
+		AssetHandle<T> Insert(const std::string& key, std::unique_ptr<T> asset, size_t bytes, bool failed)
+		{
+			AssetStorage<T>& storage = StorageOf((T*)nullptr);
+			uint32_t index;
+			if (!storage.FreeSlots.empty()) {
+				index = storage.FreeSlots.back();
+				storage.FreeSlots.pop_back();
+			}
+			else {
+				index = (uint32_t)storage.Slots.size();
+				storage.Slots.emplace_back();
+			}
+			typename AssetStorage<T>::Slot& slot = storage.Slots[index];
+			slot.Asset = std::move(asset);
+			slot.Key = key;
+			slot.RefCount = 1;
+			slot.Bytes = bytes;
+			slot.Failed = failed;
+			if (!failed)
+				storage.ByKey[key] = index;
+
+			s_Stats.Loads++;
+			s_Stats.Referenced++;
+			s_Stats.ResidentBytes += bytes;
+			AssetHandle<T> handle;
+			handle.Index = index;
+			handle.Generation = slot.Generation;
+			return handle;
+		}
+
+		template<typename T>
+		void AddRefSlot(AssetHandle<T> handle)
+		{
+			if (typename AssetStorage<T>::Slot* slot = Lookup(handle))
+				slot->RefCount++;
+		}
+
+		template<typename T>
+		void ReleaseSlot(AssetHandle<T> handle)
+		{
+			typename AssetStorage<T>::Slot* slot = Lookup(handle);
+			if (!slot || --slot->RefCount > 0)
+				return;
+			s_Stats.Referenced--;
+			if (slot->Failed) {
+				Destroy<T>(handle.Index);
+				return;
+			}
+			slot->CachePosition = s_Cache.insert(s_Cache.end(), { TypeOf((T*)nullptr), handle.Index });
+			s_Stats.Cached++;
+			s_Stats.CachedBytes += slot->Bytes;
+			TrimCache();
+		}
+	}
+
+	AssetRef<Texture> AssetManager::LoadTexture(const std::string& path, const graphics::TextureSettings& settings)
+	{
+		std::string key = CanonicalPath(path);
+		key += settings.FlipVertically ? "|flip" : "|noflip";
+		key += settings.GenerateMipmaps ? "|mips" : "|nomips";
+		if (settings.Streamed)
+			key += "|streamed";
+		AssetHandle<Texture> handle = Acquire<Texture>(key);
+		if (handle.IsValid())
+			return AssetRef<Texture>(handle);
+
+		SPARKY_PROFILE_SCOPE("AssetManager::LoadTexture");
+		SPARKY_MEMORY_TAG(Assets);
+		std::unique_ptr<Texture> texture(new Texture(path, settings));
+		size_t bytes = texture->GetSizeInBytes();
+		bool loaded = texture->IsLoaded();
+		return AssetRef<Texture>(Insert(key, std::move(texture), bytes, !loaded));
+	}
+
+	AssetRef<Shader> AssetManager::LoadShader(const std::string& vertPath, const std::string& fragPath)
+	{
+		std::string key = CanonicalPath(vertPath) + "|" + CanonicalPath(fragPath);
+		AssetHandle<Shader> handle = Acquire<Shader>(key);
+		if (handle.IsValid())
+			return AssetRef<Shader>(handle);
+
+		SPARKY_PROFILE_SCOPE("AssetManager::LoadShader");
+		SPARKY_MEMORY_TAG(Assets);
+		std::unique_ptr<Shader> shader(new Shader(vertPath.c_str(), fragPath.c_str()));
+		GLint binaryLength = 0;
+		if (shader->m_ShaderID)
+			glGetProgramiv(shader->m_ShaderID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+		bool failed = shader->m_ShaderID == 0;
+		return AssetRef<Shader>(Insert(key, std::move(shader), (size_t)binaryLength, failed));
+	}
+
+	Texture* AssetManager::Resolve(AssetHandle<Texture> handle)
+	{
+		AssetStorage<Texture>::Slot* slot = Lookup(handle);
+		return slot ? slot->Asset.get() : nullptr;
+	}
+
+	Shader* AssetManager::Resolve(AssetHandle<Shader> handle)
+	{
+		AssetStorage<Shader>::Slot* slot = Lookup(handle);
+		return slot ? slot->Asset.get() : nullptr;
+	}
+
+	void AssetManager::AddRef(AssetHandle<Texture> handle) { AddRefSlot(handle); }
+	void AssetManager::AddRef(AssetHandle<Shader> handle) { AddRefSlot(handle); }
+	void AssetManager::Release(AssetHandle<Texture> handle) { ReleaseSlot(handle); }
+	void AssetManager::Release(AssetHandle<Shader> handle) { ReleaseSlot(handle); }
+
+	void AssetManager::SetCacheBudget(size_t bytes)
+	{
+		s_CacheBudget = bytes;
+		TrimCache();
+	}
+
+	void AssetManager::Clear()
+	{
+		if (s_Stats.Referenced)
+			SPARKY_CORE_WARN("AssetManager cleared with {0} assets still referenced", s_Stats.Referenced);
+		for (uint32_t i = 0; i < s_Textures.Slots.size(); ++i) {
+			if (s_Textures.Slots[i].Asset)
+				Destroy<Texture>(i);
+		}
+		for (uint32_t i = 0; i < s_Shaders.Slots.size(); ++i) {
+			if (s_Shaders.Slots[i].Asset)
+				Destroy<Shader>(i);
+		}
+		s_Cache.clear();
+		s_Stats.Referenced = s_Stats.Cached = 0;
+		s_Stats.CachedBytes = 0;
+	}
+
+	AssetManager::Stats AssetManager::GetStats()
+	{
+		return s_Stats;
+	}
+
+	std::string AssetManager::CanonicalPath(const std::string& path)
+	{
+		std::string result = VirtualFileSystem::CanonicalPath(path);
+#ifdef _WIN32
+		// NTFS paths are case insensitive
+		for (char& c : result)
+			c = (char)tolower((unsigned char)c);
+#endif
+		return result;
+	}
+
+}
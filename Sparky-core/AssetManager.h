@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include "Texture.h"
+#include "Shader.h"
+
+namespace sparky {
+
+	// Slot index plus the generation of the asset in it. Once the slot is
+	// reused the old handle resolves to nullptr instead of another asset.
+	template<typename T>
+	struct AssetHandle
+	{
+		uint32_t Index = 0, Generation = 0;
+
+		inline bool IsValid() const { return Generation != 0; }
+		inline bool operator==(const AssetHandle& other) const { return Index == other.Index && Generation == other.Generation; }
+		inline bool operator!=(const AssetHandle& other) const { return !(*this == other); }
+	};
+
+	template<typename T>
+	class AssetRef;
+
+	// Loads every file once. Assets are keyed by canonical path (plus settings)
+	// and reference counted through AssetRef. An asset nobody references stays
+	// resident in an LRU cache, so loading it again is a lookup. The cache is
+	// trimmed to a byte budget, least recently released first. An asset that
+	// failed to load is neither shared nor cached, so loading it again retries.
+	// Main thread only, it owns GL objects.
+	class AssetManager
+	{
+	public:
+		struct Stats
+		{
+			uint32_t Loads = 0, CacheHits = 0, Evictions = 0;
+			uint32_t Referenced = 0, Cached = 0;
+			size_t ResidentBytes = 0, CachedBytes = 0;
+		};
+
+		static AssetRef<graphics::Texture> LoadTexture(const std::string& path, const graphics::TextureSettings& settings = graphics::TextureSettings());
+		static AssetRef<graphics::Shader> LoadShader(const std::string& vertPath, const std::string& fragPath);
+
+		static graphics::Texture* Resolve(AssetHandle<graphics::Texture> handle);
+		static graphics::Shader* Resolve(AssetHandle<graphics::Shader> handle);
+		static void AddRef(AssetHandle<graphics::Texture> handle);
+		static void AddRef(AssetHandle<graphics::Shader> handle);
+		static void Release(AssetHandle<graphics::Texture> handle);
+		static void Release(AssetHandle<graphics::Shader> handle);
+
+		// Bytes of unreferenced assets kept resident, shaders count as their program binary
+		static void SetCacheBudget(size_t bytes);
+		// Destroys every asset, handles still around go stale. Needs the GL context.
+		static void Clear();
+		static Stats GetStats();
+
+		static std::string CanonicalPath(const std::string& path);
+	};
+
+	// Owns one reference to an asset
+	template<typename T>
+	class AssetRef
+	{
+	public:
+		AssetRef() {}
+		// Takes over a reference the caller already holds
+		explicit AssetRef(AssetHandle<T> handle) : m_Handle(handle) {}
+		AssetRef(const AssetRef& other) : m_Handle(other.m_Handle) { AssetManager::AddRef(m_Handle); }
+		AssetRef(AssetRef&& other) : m_Handle(other.m_Handle) { other.m_Handle = AssetHandle<T>(); }
+		~AssetRef() { AssetManager::Release(m_Handle); }
+
+		AssetRef& operator=(AssetRef other)
+		{
+			std::swap(m_Handle, other.m_Handle);
+			return *this;
+		}
+
+		inline T* Get() const { return AssetManager::Resolve(m_Handle); }
+		inline T* operator->() const { return Get(); }
+		inline explicit operator bool() const { return Get() != nullptr; }
+		inline AssetHandle<T> GetHandle() const { return m_Handle; }
+	private:
+		AssetHandle<T> m_Handle;
+	};
+
+}
@@ -1,4 +1,6 @@
 #include "Camera.h"
+#include "simd_math.h"
+#include "Input.h"
 
 namespace sparky {
 
@@ -16,34 +18,30 @@ namespace sparky {
 		sense_look = 0.2f;
 		lastX = lastY = 0.0f;
 		yaw = pitch = 0.0f;
-		lastFrame = (float)glfwGetTime();
 		cameraPos = glm::vec3(0.0f, 0.0f, 3.0f);
 		cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
 		cameraUp = glm::vec3(0.0f, 1.0f, 0.0f);
 		lookaroundEnabled = false;
 		view = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
 	}
-	void Camera::updateCamera() {
+	void Camera::updateCamera(Timestep ts) {
 
-		currFrame = (float)glfwGetTime();
-		float deltaTime = currFrame - lastFrame;
-		lastFrame = currFrame;
-		if (deltaTime > 0.03f) {
-			currFrame = (float)glfwGetTime();
-			deltaTime = currFrame - lastFrame;
-			lastFrame = currFrame;
-		}
-		// std::cout << deltaTime << std::endl;
+		// a long frame (loading a demo, dragging the window) should not move the camera
+		float deltaTime = ts.GetSeconds();
+		if (deltaTime > 0.03f)
+			deltaTime = 0.0f;
 
 		float cameraSpeed = sense_move * deltaTime; // adjust accordingly
 
-		if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+		const InputSnapshot& input = Input::GetSnapshot();
+
+		if (input.IsKeyDown(SP_KEY_W))
 			cameraPos += cameraSpeed * cameraFront;
-		if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+		if (input.IsKeyDown(SP_KEY_S))
 			cameraPos -= cameraSpeed * cameraFront;
-		if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+		if (input.IsKeyDown(SP_KEY_A))
 			cameraPos -= glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraSpeed;
-		if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+		if (input.IsKeyDown(SP_KEY_D))
 			cameraPos += glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraSpeed;
 
 		view = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
@@ -62,9 +60,14 @@ namespace sparky {
 		pitch += pitchDiff * sense_look;
 		pitch = (pitch > 75.0f) ? 75.0f : pitch;
 		pitch = (pitch < -75.0f) ? -75.0f : pitch;
-		front.x = cos(glm::radians(pitch)) * cos(glm::radians(yaw - 90.0f));
-		front.y = sin(glm::radians(pitch));
-		front.z = cos(glm::radians(pitch)) * sin(glm::radians(yaw - 90.0f));
+		// one vectorised sincos for both angles instead of four libm calls
+		maths::floatx4 angles, s, c;
+		angles[0] = glm::radians(pitch);
+		angles[1] = glm::radians(yaw - 90.0f);
+		maths::simd::sincos(angles, s, c);
+		front.x = c[0] * c[1];
+		front.y = s[0];
+		front.z = c[0] * s[1];
 		cameraFront = glm::normalize(front);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "window.h"
+#include "Timestep.h"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
@@ -13,8 +14,6 @@ namespace sparky {
 		Camera();
 		~Camera();
 	private:
-		float lastFrame;
-		float currFrame;
 		glm::vec3 front;
 	public:
 		GLFWwindow* window;
@@ -27,7 +26,7 @@ namespace sparky {
 		glm::vec3 cameraPos, cameraFront, cameraUp;
 		glm::mat4 getView();
 		void resetCamera();
-		void updateCamera();
+		void updateCamera(Timestep ts);
 		void updateYawPitch(float yaw_i, float pitch_i);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include "Compression.h"
+#include <string.h>
+#include <vector>
+
+namespace sparky {
+
+	namespace {
+		const int HashBits = 16;
+		const size_t MinMatch = 4;
+		// the format ends every block with literals: the last match starts at
+		// least 12 bytes and ends at least 5 bytes before the end
+		const size_t MatchStartMargin = 12;
+		const size_t LastLiterals = 5;
+		const size_t MaxOffset = 65535;
+
+		inline uint32_t Read32(const uint8_t* p)
+		{
+			uint32_t value;
+			memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		inline uint32_t Hash(uint32_t sequence)
+		{
+			return (sequence * 2654435761u) >> (32 - HashBits);
+		}
+
+		class Writer
+		{
+		public:
+			Writer(uint8_t* dst, size_t capacity) : m_Dst(dst), m_End(dst + capacity), m_Out(dst) {}
+
+			bool Length(size_t length)
+			{
+				for (; length >= 255; length -= 255) {
+					if (!Byte(255))
+						return false;
+				}
+				return Byte((uint8_t)length);
+			}
+			bool Byte(uint8_t value)
+			{
+				if (m_Out == m_End)
+					return false;
+				*m_Out++ = value;
+				return true;
+			}
+			bool Bytes(const uint8_t* src, size_t size)
+			{
+				if ((size_t)(m_End - m_Out) < size)
+					return false;
+				if (size)
+					memcpy(m_Out, src, size);
+				m_Out += size;
+				return true;
+			}
+
+			// literals followed by a match, matchLength 0 for the final literals
+			bool Sequence(const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+			{
+				size_t matchCode = matchLength ? matchLength - MinMatch : 0;
+				uint8_t token = (uint8_t)(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+				if (!Byte(token))
+					return false;
+				if (literalLength >= 15 && !Length(literalLength - 15))
+					return false;
+				if (!Bytes(literals, literalLength))
+					return false;
+				if (!matchLength)
+					return true;
+				if (!Byte((uint8_t)(offset & 0xFF)) || !Byte((uint8_t)(offset >> 8)))
+					return false;
+				return matchCode < 15 || Length(matchCode - 15);
+			}
+
+			inline size_t GetSize() const { return m_Out - m_Dst; }
+		private:
+			uint8_t* m_Dst;
+			uint8_t* m_End;
+			uint8_t* m_Out;
+		};
+	}
+
+	size_t LZ4::Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+	{
+		Writer writer(dst, dstCapacity);
+		size_t anchor = 0;
+		if (srcSize > MatchStartMargin) {
+			// positions are stored plus one, zero marks an empty bucket
+			std::vector<uint32_t> table((size_t)1 << HashBits, 0);
+			size_t matchStartLimit = srcSize - MatchStartMargin;
+			size_t matchEndLimit = srcSize - LastLiterals;
+			size_t ip = 0;
+			while (ip < matchStartLimit) {
+				uint32_t sequence = Read32(src + ip);
+				uint32_t& bucket = table[Hash(sequence)];
+				size_t candidate = bucket;
+				bucket = (uint32_t)(ip + 1);
+				if (!candidate || ip - (candidate - 1) > MaxOffset || Read32(src + candidate - 1) != sequence) {
+					++ip;
+					continue;
+				}
+
+				size_t ref = candidate - 1;
+				size_t length = MinMatch;
+				while (ip + length < matchEndLimit && src[ref + length] == src[ip + length])
+					++length;
+				while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+					--ip;
+					--ref;
+					++length;
+				}
+				if (!writer.Sequence(src + anchor, ip - anchor, ip - ref, length))
+					return 0;
+				ip += length;
+				anchor = ip;
+			}
+		}
+		if (!writer.Sequence(src + anchor, srcSize - anchor, 0, 0))
+			return 0;
+		return writer.GetSize();
+	}
+
+	bool LZ4::Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+	{
+		size_t ip = 0, op = 0;
+		while (ip < srcSize) {
+			uint8_t token = src[ip++];
+
+			size_t literalLength = token >> 4;
+			if (literalLength == 15) {
+				uint8_t extra;
+				do {
+					if (ip >= srcSize)
+						return false;
+					extra = src[ip++];
+					literalLength += extra;
+				} while (extra == 255);
+			}
+			if (literalLength > srcSize - ip || literalLength > dstSize - op)
+				return false;
+			if (literalLength)
+				memcpy(dst + op, src + ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+			if (ip == srcSize)
+				break;
+
+			if (srcSize - ip < 2)
+				return false;
+			size_t offset = src[ip] | ((size_t)src[ip + 1] << 8);
+			ip += 2;
+			if (offset == 0 || offset > op)
+				return false;
+
+			size_t matchLength = (token & 15);
+			if (matchLength == 15) {
+				uint8_t extra;
+				do {
+					if (ip >= srcSize)
+						return false;
+					extra = src[ip++];
+					matchLength += extra;
+				} while (extra == 255);
+			}
+			matchLength += MinMatch;
+			if (matchLength > dstSize - op)
+				return false;
+			// may overlap the bytes it produces, copied front to back on purpose
+			const uint8_t* match = dst + op - offset;
+			for (size_t i = 0; i < matchLength; ++i)
+				dst[op + i] = match[i];
+			op += matchLength;
+		}
+		return op == dstSize;
+	}
+
+	namespace {
+		const int DeflateHashBits = 15;
+		const size_t DeflateMinMatch = 3;
+		const size_t DeflateMaxMatch = 258;
+		const size_t DeflateWindow = 32768;
+
+		const uint16_t LengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+		const uint8_t LengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+		const uint16_t DistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+		const uint8_t DistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+		inline uint32_t Hash3(const uint8_t* p)
+		{
+			uint32_t sequence = p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+			return (sequence * 2654435761u) >> (32 - DeflateHashBits);
+		}
+
+		// deflate packs bits from the least significant end, Huffman codes most significant bit first
+		class BitWriter
+		{
+		public:
+			BitWriter(std::vector<uint8_t>& dst) : m_Dst(dst) {}
+
+			void Bits(uint32_t value, int count)
+			{
+				m_Bits |= value << m_Count;
+				m_Count += count;
+				for (; m_Count >= 8; m_Count -= 8) {
+					m_Dst.push_back((uint8_t)m_Bits);
+					m_Bits >>= 8;
+				}
+			}
+			void Code(uint32_t code, int length)
+			{
+				uint32_t reversed = 0;
+				for (int i = 0; i < length; ++i, code >>= 1)
+					reversed = (reversed << 1) | (code & 1);
+				Bits(reversed, length);
+			}
+			void Literal(uint32_t symbol)
+			{
+				if (symbol < 144)
+					Code(0x30 + symbol, 8);
+				else if (symbol < 256)
+					Code(0x190 + symbol - 144, 9);
+				else if (symbol < 280)
+					Code(symbol - 256, 7);
+				else
+					Code(0xC0 + symbol - 280, 8);
+			}
+			void Match(size_t length, size_t distance)
+			{
+				int code = 28;
+				while (LengthBase[code] > length)
+					--code;
+				Literal(257 + code);
+				Bits((uint32_t)(length - LengthBase[code]), LengthExtra[code]);
+				code = 29;
+				while (DistanceBase[code] > distance)
+					--code;
+				Code(code, 5);
+				Bits((uint32_t)(distance - DistanceBase[code]), DistanceExtra[code]);
+			}
+			void Flush()
+			{
+				if (m_Count)
+					m_Dst.push_back((uint8_t)m_Bits);
+				m_Bits = 0;
+				m_Count = 0;
+			}
+		private:
+			std::vector<uint8_t>& m_Dst;
+			uint32_t m_Bits = 0;
+			int m_Count = 0;
+		};
+	}
+
+	void Zlib::Compress(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& dst)
+	{
+		// 32K window, no dictionary, fastest compression level
+		dst.push_back(0x78);
+		dst.push_back(0x01);
+		BitWriter writer(dst);
+		// final block, fixed codes
+		writer.Bits(1, 1);
+		writer.Bits(1, 2);
+
+		std::vector<uint32_t> table((size_t)1 << DeflateHashBits, 0);
+		size_t ip = 0;
+		while (ip + DeflateMinMatch <= srcSize) {
+			uint32_t& bucket = table[Hash3(src + ip)];
+			size_t candidate = bucket;
+			bucket = (uint32_t)(ip + 1);
+			size_t length = 0;
+			if (candidate && ip - (candidate - 1) <= DeflateWindow) {
+				const uint8_t* ref = src + candidate - 1;
+				size_t maxLength = srcSize - ip < DeflateMaxMatch ? srcSize - ip : DeflateMaxMatch;
+				while (length < maxLength && ref[length] == src[ip + length])
+					++length;
+			}
+			if (length < DeflateMinMatch) {
+				writer.Literal(src[ip++]);
+				continue;
+			}
+			writer.Match(length, ip - (candidate - 1));
+			ip += length;
+		}
+		for (; ip < srcSize; ++ip)
+			writer.Literal(src[ip]);
+		writer.Literal(256);
+		writer.Flush();
+
+		uint32_t adler = Adler32(src, srcSize);
+		for (int shift = 24; shift >= 0; shift -= 8)
+			dst.push_back((uint8_t)(adler >> shift));
+	}
+
+	uint32_t Zlib::Adler32(const uint8_t* data, size_t size, uint32_t adler)
+	{
+		uint32_t a = adler & 0xFFFF, b = adler >> 16;
+		while (size) {
+			// the largest run before b can overflow 32 bits
+			size_t run = size < 5552 ? size : 5552;
+			size -= run;
+			for (; run; --run) {
+				a += *data++;
+				b += a;
+			}
+			a %= 65521;
+			b %= 65521;
+		}
+		return (b << 16) | a;
+	}
+
+}
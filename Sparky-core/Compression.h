@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace sparky {
+
+	// LZ4 block format, compatible with the reference decoder. The compressor is
+	// the plain greedy single hash variant, fast rather than tight; it runs
+	// offline when packs are built. Decompression checks every bound and fails
+	// instead of reading or writing outside its buffers.
+	class LZ4
+	{
+	public:
+		// Worst case compressed size of size bytes
+		static inline size_t CompressBound(size_t size) { return size + size / 255 + 16; }
+
+		// Returns the compressed size, 0 when dst is too small
+		static size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+		// dstSize is the exact decompressed size, as stored next to the block
+		static bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+	};
+
+	// zlib stream (RFC 1950) of one deflate block with the fixed Huffman codes
+	// and the same greedy single hash matching, for writing PNG files at
+	// runtime. Readable by any inflater; there is no decompressor here.
+	class Zlib
+	{
+	public:
+		// Appends the compressed stream to dst
+		static void Compress(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& dst);
+		static uint32_t Adler32(const uint8_t* data, size_t size, uint32_t adler = 1);
+	};
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "TextureFormat.h"
+
+namespace sparky {
+
+	// Texture as written by sparky-cook: this header, then MipCount levels
+	// largest first. Level i is max(1, Width >> i) by max(1, Height >> i)
+	// pixels in Format, tightly packed rows or 4x4 blocks, bottom row first
+	// when FlippedVertically is set. Levels upload straight from the pack
+	// mapping.
+	struct CookedTextureHeader
+	{
+		static const uint32_t MagicValue = 0x58545053; // "SPTX"
+		static const uint32_t CurrentVersion = 2;
+		static const uint32_t FlippedVertically = 1;
+
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t Width;
+		uint32_t Height;
+		TextureFormat Format;
+		uint32_t MipCount;
+		uint32_t Flags;
+		uint32_t Reserved;
+
+		static inline uint32_t LevelExtent(uint32_t extent, uint32_t level)
+		{
+			uint32_t result = extent >> level;
+			return result ? result : 1;
+		}
+
+		inline size_t LevelSize(uint32_t level) const
+		{
+			return GetImageSize(Format, LevelExtent(Width, level), LevelExtent(Height, level));
+		}
+
+		// The header at the front of data when it is a complete cooked texture
+		static inline const CookedTextureHeader* Parse(const uint8_t* data, size_t size)
+		{
+			if (!data || size < sizeof(CookedTextureHeader))
+				return nullptr;
+			const CookedTextureHeader* header = reinterpret_cast<const CookedTextureHeader*>(data);
+			if (header->Magic != MagicValue || header->Version != CurrentVersion)
+				return nullptr;
+			if (header->Format >= TextureFormat::Count || header->MipCount == 0 || header->MipCount > 17)
+				return nullptr;
+			if (header->Width == 0 || header->Height == 0 || header->Width > 65536 || header->Height > 65536)
+				return nullptr;
+			size_t required = sizeof(CookedTextureHeader);
+			for (uint32_t level = 0; level < header->MipCount; ++level)
+				required += header->LevelSize(level);
+			return required <= size ? header : nullptr;
+		}
+	};
+
+}
@@ -1,8 +1,8 @@
 #pragma once
 
 #ifdef SPARKY_ENABLE_ASSERTS
-#define SPARKY_ASSERT(x, ...) { if(!(x)) { SPARKY_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
-#define SPARKY_CORE_ASSERT(x, ...) { if(!(x)) { SPARKY_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
+#define SPARKY_ASSERT(x, ...) { if(!(x)) { SPARKY_ERROR("Assertion Failed: {0}", __VA_ARGS__); ::sparky::Log::Flush(); __debugbreak(); } }
+#define SPARKY_CORE_ASSERT(x, ...) { if(!(x)) { SPARKY_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); ::sparky::Log::Flush(); __debugbreak(); } }
 #else
 #define SPARKY_ASSERT(x, ...)
 #define SPARKY_CORE_ASSERT(x, ...)
@@ -10,4 +10,5 @@
 
 #define BIT(x) (1 << x)
 
-#define SPARKY_BIND_EVENT_FN(fn) std::bind(&fn, this, std::placeholders::_1)
\ No newline at end of file
+// Binds a member function to this without std::bind or std::function
+#define SPARKY_BIND_EVENT_FN(fn) [this](auto& e) { return this->fn(e); }
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <math.h>
+
+namespace sparky {
+
+	DynamicResolution::DynamicResolution()
+	{
+		Reset();
+	}
+
+	DynamicResolution::DynamicResolution(const Settings& settings)
+		: m_Settings(settings)
+	{
+		Reset();
+	}
+
+	void DynamicResolution::Reset()
+	{
+		m_Scale = m_Settings.MaxScale;
+		// with no error the output is the integral term alone
+		m_Integral = m_Settings.MaxScale / m_Settings.Ki;
+		m_LastError = 0.0f;
+	}
+
+	float DynamicResolution::Update(float gpuMilliseconds)
+	{
+		const Settings& s = m_Settings;
+		float error = (s.BudgetMilliseconds - gpuMilliseconds) / s.BudgetMilliseconds;
+		if (fabsf(error) < s.Deadband)
+			error = 0.0f;
+		// a hitch many times the budget is no reason to drop further than a long overrun
+		error = std::max(-1.0f, std::min(error, 1.0f));
+
+		float derivative = error - m_LastError;
+		m_LastError = error;
+		float integral = m_Integral + error;
+		float output = s.Kp * error + s.Ki * integral + s.Kd * derivative;
+		m_Scale = std::max(s.MinScale, std::min(output, s.MaxScale));
+
+		// anti windup: the integral only follows errors the scale can still act on
+		if (output == m_Scale || (output > s.MaxScale && error < 0.0f) || (output < s.MinScale && error > 0.0f))
+			m_Integral = integral;
+		return m_Scale;
+	}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+namespace sparky {
+
+	// Picks the render scale of the next frame from measured GPU frame times,
+	// with a PID controller on the relative error against a time budget. The
+	// integral settles the scale where the budget is just met, the small
+	// proportional and derivative terms react to spikes without the overshoot
+	// that the few frames of GPU timer latency would otherwise turn into
+	// oscillation. Gains are per update, one update per measured frame.
+	class DynamicResolution
+	{
+	public:
+		struct Settings
+		{
+			// leaves headroom below the 16.7 ms of a 60 Hz frame
+			float BudgetMilliseconds = 14.0f;
+			float MinScale = 0.5f, MaxScale = 1.0f;
+			float Kp = 0.05f, Ki = 0.08f, Kd = 0.02f;
+			// relative errors this small count as on budget, so noise does not move the scale
+			float Deadband = 0.03f;
+		};
+
+		DynamicResolution();
+		explicit DynamicResolution(const Settings& settings);
+
+		// Feeds one GPU frame time and returns the scale to render at
+		float Update(float gpuMilliseconds);
+		// Back to MaxScale with no history
+		void Reset();
+
+		inline float GetScale() const { return m_Scale; }
+		inline const Settings& GetSettings() const { return m_Settings; }
+		inline void SetBudget(float milliseconds) { m_Settings.BudgetMilliseconds = milliseconds; }
+	private:
+		Settings m_Settings;
+		float m_Scale = 1.0f;
+		float m_Integral = 0.0f, m_LastError = 0.0f;
+	};
+
+}
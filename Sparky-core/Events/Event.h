@@ -2,15 +2,19 @@
 
 #include <string>
 #include <functional>
+#include <utility>
 #include <sstream>
 #include "Input.h"
 
 namespace sparky {
 
-	// Events in Sparky are currently blocking, meaning when an event occurs it
-	// immediately gets dispatched and must be dealt with right then an there.
-	// For the future, a better strategy might be to buffer events in an event
-	// bus and process them during the "event" part of the update stage.
+	// Window events are buffered in an EventQueue while GLFW polls and are
+	// dispatched once per frame by Application::EndFrame. An EventDispatcher
+	// still handles them synchronously once they come out of the queue.
+	//
+	// Every event stores its EventType, a dense index, so checking the type is a
+	// load instead of a virtual call. Handlers are called through templates and
+	// member function pointers, nothing is allocated per dispatch.
 
 	enum class EventType
 	{
@@ -18,7 +22,8 @@ namespace sparky {
 		WindowClose, WindowResize, WindowFocus, WindowLostFocus, WindowMoved,
 		AppTick, AppUpdate, AppRender,
 		KeyPressed, KeyReleased, KeyTyped,
-		MouseButtonPressed, MouseButtonReleased, MouseMoved, MouseScrolled
+		MouseButtonPressed, MouseButtonReleased, MouseMoved, MouseScrolled,
+		Count // number of event types, not an event
 	};
 
 	enum EventCategory
@@ -31,45 +36,59 @@ namespace sparky {
 		EventCategoryMouseButton = BIT(4)
 	};
 
-	#define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::##type; }\
-								virtual EventType GetEventType() const override { return GetStaticType(); }\
+	#define EVENT_CLASS_TYPE(type) static constexpr EventType GetStaticType() { return EventType::type; }\
 								virtual const char* GetName() const override { return #type; }
 
 	#define EVENT_CLASS_CATEGORY(category) virtual int GetCategoryFlags() const override { return category; }
 
 	class Event
 	{
-		// friend class EventDispatcher;
 	public:
 		bool Handled = false;
 
-		virtual EventType GetEventType() const = 0;
+		inline EventType GetEventType() const { return m_Type; }
 		virtual const char* GetName() const = 0;
 		virtual int GetCategoryFlags() const = 0;
 		virtual std::string ToString() const { return GetName(); }
 
-		inline bool IsInCategory(EventCategory category)
+		inline bool IsInCategory(EventCategory category) const
 		{
 			return ((GetCategoryFlags() & category) > 0);
 		}
+	protected:
+		Event(EventType type)
+			: m_Type(type) {}
+	private:
+		EventType m_Type;
 	};
 
 	class EventDispatcher
 	{
-		template<typename T>
-		using EventFn = std::function<bool(T&)>;
 	public:
 		EventDispatcher(Event& event)
 			: m_Event(event)
 		{
 		}
 
-		template<typename T>
-		bool Dispatch(EventFn<T> func)
+		// func is any callable taking T&, a lambda or SPARKY_BIND_EVENT_FN
+		template<typename T, typename F>
+		bool Dispatch(const F& func)
 		{
 			if (m_Event.GetEventType() == T::GetStaticType())
 			{
-				m_Event.Handled = func(*(T*)&m_Event);
+				m_Event.Handled = func(static_cast<T&>(m_Event));
+				return true;
+			}
+			return false;
+		}
+
+		// Member function delegate: dispatcher.Dispatch(this, &Layer::OnMouseMoved)
+		template<typename T, typename C>
+		bool Dispatch(C* self, bool (C::*func)(T&))
+		{
+			if (m_Event.GetEventType() == T::GetStaticType())
+			{
+				m_Event.Handled = (self->*func)(static_cast<T&>(m_Event));
 				return true;
 			}
 			return false;
@@ -78,8 +97,63 @@ namespace sparky {
 		Event& m_Event;
 	};
 
+	// One handler of an EventHandlers table, declared with SPARKY_EVENT_HANDLER
+	template<typename Fn, Fn F>
+	struct EventHandler;
+
+	template<typename C, typename T, bool (C::*F)(T&)>
+	struct EventHandler<bool (C::*)(T&), F>
+	{
+		typedef C Class;
+		typedef T EventClass;
+
+		template<typename Self>
+		static bool Call(void* self, Event& e) { return (static_cast<Self*>(self)->*F)(static_cast<T&>(e)); }
+	};
+
+	#define SPARKY_EVENT_HANDLER(fn) ::sparky::EventHandler<decltype(&fn), &fn>
+
+	// Handler table built at compile time and indexed by EventType, so dispatch
+	// is one table load and one direct call whatever the number of handlers:
+	//
+	//   typedef EventHandlers<
+	//       SPARKY_EVENT_HANDLER(MyLayer::OnMouseMoved),
+	//       SPARKY_EVENT_HANDLER(MyLayer::OnKeyPressed)> Handlers;
+	//   Handlers::Dispatch(this, event);
+	//
+	// Needs C++14: the table is expanded over std::integer_sequence.
+	template<typename... Handlers>
+	class EventHandlers
+	{
+		typedef bool(*Thunk)(void*, Event&);
+
+		template<typename C, int Type>
+		static constexpr Thunk Find() { return nullptr; }
+		template<typename C, int Type, typename H, typename... Rest>
+		static constexpr Thunk Find() { return (int)H::EventClass::GetStaticType() == Type ? &H::template Call<C> : Find<C, Type, Rest...>(); }
+
+		template<typename C, int... Types>
+		static Thunk Lookup(std::integer_sequence<int, Types...>, EventType type)
+		{
+			// constant initialised, one entry per EventType
+			static const Thunk thunks[] = { Find<C, Types, Handlers...>()... };
+			return thunks[(int)type];
+		}
+	public:
+		// Returns true if one of the handlers took the event
+		template<typename C>
+		static bool Dispatch(C* self, Event& e)
+		{
+			Thunk thunk = Lookup<C>(std::make_integer_sequence<int, (int)EventType::Count>(), e.GetEventType());
+			if (!thunk)
+				return false;
+			e.Handled = thunk(self, e);
+			return true;
+		}
+	};
+
 	inline std::ostream& operator<<(std::ostream& os, const Event& e)
 	{
 		return os << e.ToString();
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,94 @@
+#include "EventQueue.h"
+#include <new>
+#include "MemoryTracker.h"
+
+namespace sparky {
+
+	EventQueue::EventQueue(size_t capacity)
+	{
+		SPARKY_MEMORY_TAG(Events);
+		// power of two so that a running counter maps to a slot with a mask
+		size_t size = 16;
+		while (size < capacity)
+			size *= 2;
+		m_Slots.resize(size);
+	}
+
+	Event& EventQueue::CopyEvent(Slot* slot, const Event& e)
+	{
+		// Every event class is a few ints or floats, none of them needs a destructor
+		#define SPARKY_COPY_EVENT(type) case EventType::type:\
+			static_assert(std::is_trivially_destructible<type##Event>::value, #type "Event must be trivially destructible");\
+			return *new (slot) type##Event(static_cast<const type##Event&>(e));
+
+		switch (e.GetEventType())
+		{
+			SPARKY_COPY_EVENT(WindowResize)
+			SPARKY_COPY_EVENT(WindowClose)
+			SPARKY_COPY_EVENT(AppTick)
+			SPARKY_COPY_EVENT(AppUpdate)
+			SPARKY_COPY_EVENT(AppRender)
+			SPARKY_COPY_EVENT(KeyPressed)
+			SPARKY_COPY_EVENT(KeyReleased)
+			SPARKY_COPY_EVENT(KeyTyped)
+			SPARKY_COPY_EVENT(MouseMoved)
+			SPARKY_COPY_EVENT(MouseScrolled)
+			SPARKY_COPY_EVENT(MouseButtonPressed)
+			SPARKY_COPY_EVENT(MouseButtonReleased)
+		default:
+			break;
+		}
+		#undef SPARKY_COPY_EVENT
+
+		SPARKY_CORE_ASSERT(false, "EventQueue cannot copy this event type");
+		return *new (slot) AppTickEvent();
+	}
+
+	void EventQueue::Push(const Event& e)
+	{
+		EventType type = e.GetEventType();
+
+		if (type == EventType::MouseMoved) {
+			if (m_LastMoved != s_NoSlot && m_LastMoved >= m_Head) {
+				CopyEvent(reinterpret_cast<Slot*>(At(m_LastMoved)), e);
+				++m_Coalesced;
+				return;
+			}
+			m_LastMoved = m_Tail;
+			m_LastResize = s_NoSlot;
+		}
+		else if (type == EventType::WindowResize) {
+			if (m_LastResize != s_NoSlot && m_LastResize >= m_Head) {
+				CopyEvent(reinterpret_cast<Slot*>(At(m_LastResize)), e);
+				++m_Coalesced;
+				return;
+			}
+			m_LastResize = m_Tail;
+			m_LastMoved = s_NoSlot;
+		}
+		else {
+			m_LastMoved = m_LastResize = s_NoSlot;
+		}
+
+		if (m_Tail - m_Head == m_Slots.size())
+			Grow();
+		CopyEvent(reinterpret_cast<Slot*>(At(m_Tail++)), e);
+	}
+
+	void EventQueue::Grow()
+	{
+		SPARKY_MEMORY_TAG(Events);
+		std::vector<Slot> slots(m_Slots.size() * 2);
+		size_t count = m_Tail - m_Head;
+		for (size_t i = 0; i < count; ++i)
+			CopyEvent(&slots[i], *At(m_Head + i));
+
+		// a run whose slot was already dispatched cannot be coalesced into any more
+		m_LastMoved = (m_LastMoved != s_NoSlot && m_LastMoved >= m_Head) ? m_LastMoved - m_Head : s_NoSlot;
+		m_LastResize = (m_LastResize != s_NoSlot && m_LastResize >= m_Head) ? m_LastResize - m_Head : s_NoSlot;
+		m_Slots.swap(slots);
+		m_Head = 0;
+		m_Tail = count;
+	}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <type_traits>
+#include <vector>
+#include "ApplicationEvent.h"
+#include "KeyEvent.h"
+#include "MouseEvent.h"
+
+namespace sparky {
+
+	// Buffers the events GLFW reports while polling and hands them out once per
+	// frame. Events are copied by value into fixed size slots of a ring buffer,
+	// so queueing does not allocate once the ring has grown to the frame's peak.
+	//
+	// Back to back MouseMoved and WindowResize events are coalesced into the
+	// latest one; any other event ends the run so that, for example, a button
+	// press is still seen at the cursor position it happened at.
+	class EventQueue
+	{
+	public:
+		EventQueue(size_t capacity = 256);
+
+		// Copies e, which must be one of the concrete event classes
+		void Push(const Event& e);
+
+		// Calls fn(Event&) for every queued event in the order they were pushed.
+		// Events pushed from inside fn are dispatched in the same flush.
+		template<typename F>
+		void Flush(F&& fn)
+		{
+			m_LastMoved = m_LastResize = s_NoSlot;
+			while (m_Head != m_Tail) {
+				// handlers may push and grow the ring, so dispatch a copy
+				Slot current;
+				Event& e = CopyEvent(&current, *At(m_Head++));
+				fn(e);
+			}
+		}
+
+		inline size_t GetSize() const { return m_Tail - m_Head; }
+		inline bool IsEmpty() const { return m_Head == m_Tail; }
+		// Events folded into a later one since the queue was created
+		inline size_t GetCoalescedCount() const { return m_Coalesced; }
+	private:
+		// only used for the size and alignment of a slot
+		union AnyEvent
+		{
+			WindowResizeEvent WindowResize; WindowCloseEvent WindowClose;
+			AppTickEvent AppTick; AppUpdateEvent AppUpdate; AppRenderEvent AppRender;
+			KeyPressedEvent KeyPressed; KeyReleasedEvent KeyReleased; KeyTypedEvent KeyTyped;
+			MouseMovedEvent MouseMoved; MouseScrolledEvent MouseScrolled;
+			MouseButtonPressedEvent MouseButtonPressed; MouseButtonReleasedEvent MouseButtonReleased;
+		};
+		typedef std::aligned_storage<sizeof(AnyEvent), alignof(AnyEvent)>::type Slot;
+
+		static Event& CopyEvent(Slot* slot, const Event& e);
+
+		inline Event* At(size_t index) { return reinterpret_cast<Event*>(&m_Slots[index & (m_Slots.size() - 1)]); }
+		void Grow();
+	private:
+		static const size_t s_NoSlot = ~(size_t)0;
+
+		std::vector<Slot> m_Slots;
+		// running counters, the slot is the counter masked by the capacity
+		size_t m_Head = 0, m_Tail = 0;
+		size_t m_LastMoved = s_NoSlot, m_LastResize = s_NoSlot;
+		size_t m_Coalesced = 0;
+	};
+
+}
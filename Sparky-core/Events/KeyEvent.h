@@ -11,8 +11,8 @@ namespace sparky {
 
 		EVENT_CLASS_CATEGORY(EventCategoryKeyboard | EventCategoryInput)
 	protected:
-		KeyEvent(int keycode)
-			: m_KeyCode(keycode) {}
+		KeyEvent(EventType type, int keycode)
+			: Event(type), m_KeyCode(keycode) {}
 
 		int m_KeyCode;
 	};
@@ -21,7 +21,7 @@ namespace sparky {
 	{
 	public:
 		KeyPressedEvent(int keycode, int repeatCount)
-			: KeyEvent(keycode), m_RepeatCount(repeatCount) {}
+			: KeyEvent(EventType::KeyPressed, keycode), m_RepeatCount(repeatCount) {}
 
 		inline int GetRepeatCount() const { return m_RepeatCount; }
 
@@ -41,7 +41,7 @@ namespace sparky {
 	{
 	public:
 		KeyReleasedEvent(int keycode)
-			: KeyEvent(keycode) {}
+			: KeyEvent(EventType::KeyReleased, keycode) {}
 
 		std::string ToString() const override
 		{
@@ -57,7 +57,7 @@ namespace sparky {
 	{
 	public:
 		KeyTypedEvent(int keycode)
-			: KeyEvent(keycode) {}
+			: KeyEvent(EventType::KeyTyped, keycode) {}
 
 		std::string ToString() const override
 		{
@@ -8,7 +8,7 @@ namespace sparky {
 	{
 	public:
 		MouseMovedEvent(float x, float y)
-			: m_MouseX(x), m_MouseY(y) {}
+			: Event(EventType::MouseMoved), m_MouseX(x), m_MouseY(y) {}
 
 		inline float GetX() const { return m_MouseX; }
 		inline float GetY() const { return m_MouseY; }
@@ -30,7 +30,7 @@ namespace sparky {
 	{
 	public:
 		MouseScrolledEvent(float xOffset, float yOffset)
-			: m_XOffset(xOffset), m_YOffset(yOffset) {}
+			: Event(EventType::MouseScrolled), m_XOffset(xOffset), m_YOffset(yOffset) {}
 
 		inline float GetXOffset() const { return m_XOffset; }
 		inline float GetYOffset() const { return m_YOffset; }
@@ -55,8 +55,8 @@ namespace sparky {
 
 		EVENT_CLASS_CATEGORY(EventCategoryMouse | EventCategoryInput)
 	protected:
-		MouseButtonEvent(int button)
-			: m_Button(button) {}
+		MouseButtonEvent(EventType type, int button)
+			: Event(type), m_Button(button) {}
 
 		int m_Button;
 	};
@@ -65,7 +65,7 @@ namespace sparky {
 	{
 	public:
 		MouseButtonPressedEvent(int button)
-			: MouseButtonEvent(button) {}
+			: MouseButtonEvent(EventType::MouseButtonPressed, button) {}
 
 		std::string ToString() const override
 		{
@@ -81,7 +81,7 @@ namespace sparky {
 	{
 	public:
 		MouseButtonReleasedEvent(int button)
-			: MouseButtonEvent(button) {}
+			: MouseButtonEvent(EventType::MouseButtonReleased, button) {}
 
 		std::string ToString() const override
 		{
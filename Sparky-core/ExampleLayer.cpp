@@ -11,7 +11,7 @@ void ExampleLayer::OnUpdate()
 	// SPARKY_INFO("ExampleLayer::Update");
 	if (sparky::Input::IsKeyPressed(SP_KEY_TAB))
 		SPARKY_TRACE("Tab key is pressed (poll)!");
-		app_Instance->camera->updateCamera();
+		app_Instance->camera->updateCamera(app_Instance->GetTimestep());
 	if (sparky::Input::IsKeyPressed(SP_KEY_W) || sparky::Input::IsKeyPressed(SP_KEY_A) || sparky::Input::IsKeyPressed(SP_KEY_S) || sparky::Input::IsKeyPressed(SP_KEY_D)) {
 	}
 }
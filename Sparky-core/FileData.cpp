@@ -0,0 +1,163 @@
+#include "FileData.h"
+#include <utility>
+
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace sparky {
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other)
+	{
+		Swap(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other)
+	{
+		if (this != &other) {
+			Close();
+			Swap(other);
+		}
+		return *this;
+	}
+
+	void MappedFile::Swap(MappedFile& other)
+	{
+		std::swap(m_Data, other.m_Data);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Open, other.m_Open);
+#ifdef _WIN32
+		std::swap(m_File, other.m_File);
+		std::swap(m_Mapping, other.m_Mapping);
+#endif
+	}
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size)) {
+			CloseHandle(file);
+			return false;
+		}
+		m_File = file;
+		m_Size = (size_t)size.QuadPart;
+		m_Open = true;
+		// an empty file cannot be mapped, it is open with no data
+		if (m_Size == 0)
+			return true;
+		m_Mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (m_Mapping)
+			m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat info;
+		if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+			::close(fd);
+			return false;
+		}
+		m_Size = (size_t)info.st_size;
+		m_Open = true;
+		if (m_Size) {
+			void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+			m_Data = data == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(data);
+		}
+		// the mapping keeps the file alive
+		::close(fd);
+#endif
+		if (m_Size && !m_Data) {
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+#ifdef _WIN32
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_Mapping)
+			CloseHandle(m_Mapping);
+		if (m_File)
+			CloseHandle(m_File);
+		m_File = m_Mapping = nullptr;
+#else
+		if (m_Data)
+			munmap(const_cast<uint8_t*>(m_Data), m_Size);
+#endif
+		m_Data = nullptr;
+		m_Size = 0;
+		m_Open = false;
+	}
+
+	FileData::FileData(FileData&& other)
+		: m_Data(other.m_Data), m_Size(other.m_Size), m_Found(other.m_Found),
+		m_Buffer(std::move(other.m_Buffer)), m_Mapping(std::move(other.m_Mapping))
+	{
+		other.m_Data = nullptr;
+		other.m_Size = 0;
+		other.m_Found = false;
+	}
+
+	FileData& FileData::operator=(FileData&& other)
+	{
+		if (this != &other) {
+			m_Data = other.m_Data;
+			m_Size = other.m_Size;
+			m_Found = other.m_Found;
+			m_Buffer = std::move(other.m_Buffer);
+			m_Mapping = std::move(other.m_Mapping);
+			other.m_Data = nullptr;
+			other.m_Size = 0;
+			other.m_Found = false;
+		}
+		return *this;
+	}
+
+	FileData FileData::View(const uint8_t* data, size_t size)
+	{
+		FileData file;
+		file.m_Data = data;
+		file.m_Size = size;
+		file.m_Found = true;
+		return file;
+	}
+
+	FileData FileData::Own(std::unique_ptr<uint8_t[]> buffer, size_t size)
+	{
+		FileData file;
+		file.m_Buffer = std::move(buffer);
+		file.m_Data = file.m_Buffer.get();
+		file.m_Size = size;
+		file.m_Found = true;
+		return file;
+	}
+
+	FileData FileData::Own(MappedFile&& mapping)
+	{
+		FileData file;
+		file.m_Mapping = std::move(mapping);
+		file.m_Data = file.m_Mapping.GetData();
+		file.m_Size = file.m_Mapping.GetSize();
+		file.m_Found = file.m_Mapping.IsOpen();
+		return file;
+	}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+
+namespace sparky {
+
+	// Read only memory mapping of a whole file
+	class MappedFile
+	{
+	public:
+		MappedFile() {}
+		~MappedFile();
+		MappedFile(MappedFile&& other);
+		MappedFile& operator=(MappedFile&& other);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const std::string& path);
+		void Close();
+
+		inline bool IsOpen() const { return m_Open; }
+		inline const uint8_t* GetData() const { return m_Data; }
+		inline size_t GetSize() const { return m_Size; }
+	private:
+		void Swap(MappedFile& other);
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+		bool m_Open = false;
+#ifdef _WIN32
+		void* m_File = nullptr;
+		void* m_Mapping = nullptr;
+#endif
+	};
+
+	// Contents of a file as a span of bytes. Usually a view straight into a
+	// mapped pack, which stays mapped for as long as it is mounted; decompressed
+	// entries and loose files carry their own storage. Move only.
+	class FileData
+	{
+	public:
+		FileData() {}
+		FileData(FileData&& other);
+		FileData& operator=(FileData&& other);
+		FileData(const FileData&) = delete;
+		FileData& operator=(const FileData&) = delete;
+
+		// Borrows memory that outlives the view
+		static FileData View(const uint8_t* data, size_t size);
+		static FileData Own(std::unique_ptr<uint8_t[]> buffer, size_t size);
+		static FileData Own(MappedFile&& file);
+
+		inline const uint8_t* data() const { return m_Data; }
+		inline size_t size() const { return m_Size; }
+		inline const uint8_t* begin() const { return m_Data; }
+		inline const uint8_t* end() const { return m_Data + m_Size; }
+		inline bool empty() const { return m_Size == 0; }
+		// False when the file was not found, an empty file is still found
+		inline explicit operator bool() const { return m_Found; }
+
+		inline std::string AsString() const { return std::string(reinterpret_cast<const char*>(m_Data), m_Size); }
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+		bool m_Found = false;
+		std::unique_ptr<uint8_t[]> m_Buffer;
+		MappedFile m_Mapping;
+	};
+
+}
@@ -0,0 +1,560 @@
+#include "FrameCapture.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Compression.h"
+#include "FrameContext.h"
+#include "Framebuffer.h"
+#include "Log.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+
+namespace sparky {
+	namespace graphics {
+		namespace {
+			// one more than the frames the CPU may run ahead, so a readback is
+			// normally done by the time its buffer comes around again
+			const uint32_t RingSize = FrameContext::FramesInFlight + 1;
+
+			enum class CaptureFormat : uint8_t { PNG, Y4M, RGBA };
+
+			std::atomic<size_t> s_QueuedBytes(0);
+
+			// A captured frame, top down RGBA8
+			struct Image {
+				std::vector<uint8_t> Pixels;
+				GLsizei Width = 0, Height = 0;
+
+				~Image() { s_QueuedBytes -= Pixels.size(); }
+			};
+
+			// Where the frames of a screenshot or recording go. Streams are
+			// written in capture order whichever encoder finishes first.
+			struct Sink {
+				std::string Path;
+				CaptureFormat Format;
+				uint32_t Fps;
+				bool Sequence;
+				// main thread: a stream keeps the size of its first frame
+				GLsizei Width = 0, Height = 0;
+				uint64_t Frames = 0;
+
+				std::mutex Mutex;
+				FILE* File = nullptr;
+				uint64_t NextWrite = 0;
+				std::map<uint64_t, std::vector<uint8_t>> Reordered;
+				std::atomic<uint64_t> Written;
+
+				Sink() : Written(0) {}
+				~Sink()
+				{
+					if (File)
+						fclose(File);
+					if (Sequence)
+						SPARKY_CORE_INFO("FrameCapture: wrote {0} frames to {1}", Written.load(), Path);
+					else if (Written)
+						SPARKY_CORE_INFO("FrameCapture: saved {0}", Path);
+				}
+			};
+
+			struct Job {
+				std::shared_ptr<Image> Frame;
+				std::shared_ptr<Sink> Target;
+				uint64_t Sequence;
+			};
+
+			struct Readback {
+				GLuint Buffer = 0;
+				GLsizeiptr Capacity = 0;
+				GLsync Fence = nullptr;
+				GLsizei Width = 0, Height = 0;
+				std::vector<std::shared_ptr<Sink>> Sinks;
+			};
+
+			std::shared_ptr<Sink> s_Screenshot, s_Recording;
+			Readback s_Ring[RingSize];
+			// ring slots in capture order
+			std::deque<uint32_t> s_InFlight;
+			uint32_t s_Next = 0;
+			size_t s_MaxQueuedBytes = 256 << 20;
+			FrameCapture::Stats s_Stats;
+			std::atomic<uint32_t> s_Encoded(0);
+
+			std::vector<std::thread> s_Encoders;
+			std::mutex s_Mutex;
+			std::condition_variable s_Wake;
+			std::deque<Job> s_Jobs;
+			bool s_Stop = false;
+
+			bool EndsWith(const std::string& text, const char* suffix)
+			{
+				size_t length = strlen(suffix);
+				return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+			}
+
+			CaptureFormat FormatOf(const std::string& path)
+			{
+				if (EndsWith(path, ".y4m"))
+					return CaptureFormat::Y4M;
+				if (EndsWith(path, ".rgba"))
+					return CaptureFormat::RGBA;
+				return CaptureFormat::PNG;
+			}
+
+			// name.png -> name_000042.png
+			std::string SequencePath(const std::string& path, uint64_t frame)
+			{
+				size_t separator = path.find_last_of("/\\");
+				size_t extension = path.find_last_of('.');
+				if (extension == std::string::npos || (separator != std::string::npos && extension < separator))
+					extension = path.size();
+				char number[32];
+				snprintf(number, sizeof(number), "_%06llu", (unsigned long long)frame);
+				return path.substr(0, extension) + number + path.substr(extension);
+			}
+
+			std::shared_ptr<Sink> CreateSink(const std::string& path, uint32_t fps, bool sequence)
+			{
+				std::shared_ptr<Sink> sink = std::make_shared<Sink>();
+				sink->Path = path;
+				sink->Format = FormatOf(path);
+				sink->Fps = fps;
+				sink->Sequence = sequence;
+				if (sink->Format != CaptureFormat::PNG) {
+					sink->File = fopen(path.c_str(), "wb");
+					if (!sink->File) {
+						SPARKY_CORE_ERROR("FrameCapture: cannot open {0}", path);
+						// nothing to report when it goes away
+						sink->Sequence = false;
+						return nullptr;
+					}
+				}
+				return sink;
+			}
+
+			uint32_t Crc32(const uint8_t* data, size_t size)
+			{
+				static const struct Table {
+					uint32_t Entries[256];
+					Table()
+					{
+						for (uint32_t i = 0; i < 256; ++i) {
+							uint32_t crc = i;
+							for (int bit = 0; bit < 8; ++bit)
+								crc = (crc >> 1) ^ (crc & 1 ? 0xEDB88320u : 0u);
+							Entries[i] = crc;
+						}
+					}
+				} table;
+				uint32_t crc = 0xFFFFFFFFu;
+				for (size_t i = 0; i < size; ++i)
+					crc = table.Entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+				return crc ^ 0xFFFFFFFFu;
+			}
+
+			void Put32(std::vector<uint8_t>& out, uint32_t value)
+			{
+				for (int shift = 24; shift >= 0; shift -= 8)
+					out.push_back((uint8_t)(value >> shift));
+			}
+
+			void PutChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size)
+			{
+				Put32(out, (uint32_t)size);
+				size_t start = out.size();
+				out.insert(out.end(), type, type + 4);
+				out.insert(out.end(), data, data + size);
+				Put32(out, Crc32(out.data() + start, size + 4));
+			}
+
+			inline uint8_t Paeth(int a, int b, int c)
+			{
+				int p = a + b - c;
+				int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+				if (pa <= pb && pa <= pc)
+					return (uint8_t)a;
+				return (uint8_t)(pb <= pc ? b : c);
+			}
+
+			// RGB, every row with the filter that leaves the smallest residuals
+			void EncodePNG(const Image& image, std::vector<uint8_t>& out)
+			{
+				size_t rowBytes = (size_t)image.Width * 3;
+				std::vector<uint8_t> filtered;
+				filtered.reserve((rowBytes + 1) * image.Height);
+				std::vector<uint8_t> previous(rowBytes, 0), current(rowBytes), candidate(rowBytes), best(rowBytes);
+				for (GLsizei y = 0; y < image.Height; ++y) {
+					const uint8_t* rgba = image.Pixels.data() + (size_t)y * image.Width * 4;
+					for (GLsizei x = 0; x < image.Width; ++x)
+						memcpy(&current[x * 3], rgba + x * 4, 3);
+
+					uint8_t bestFilter = 0;
+					uint32_t bestCost = UINT32_MAX;
+					static const uint8_t Filters[] = { 0, 1, 2, 4 };
+					for (uint8_t filter : Filters) {
+						uint32_t cost = 0;
+						for (size_t i = 0; i < rowBytes; ++i) {
+							int a = i >= 3 ? current[i - 3] : 0, b = previous[i], c = i >= 3 ? previous[i - 3] : 0;
+							uint8_t predicted = filter == 0 ? 0 : filter == 1 ? (uint8_t)a : filter == 2 ? (uint8_t)b : Paeth(a, b, c);
+							candidate[i] = (uint8_t)(current[i] - predicted);
+							cost += (uint32_t)abs((int8_t)candidate[i]);
+						}
+						if (cost < bestCost) {
+							bestCost = cost;
+							bestFilter = filter;
+							best.swap(candidate);
+						}
+					}
+					filtered.push_back(bestFilter);
+					filtered.insert(filtered.end(), best.begin(), best.end());
+					previous.swap(current);
+				}
+
+				static const uint8_t Signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+				out.insert(out.end(), Signature, Signature + sizeof(Signature));
+				std::vector<uint8_t> header;
+				Put32(header, (uint32_t)image.Width);
+				Put32(header, (uint32_t)image.Height);
+				// 8 bit RGB, deflate, adaptive filtering, not interlaced
+				const uint8_t format[] = { 8, 2, 0, 0, 0 };
+				header.insert(header.end(), format, format + sizeof(format));
+				PutChunk(out, "IHDR", header.data(), header.size());
+				std::vector<uint8_t> compressed;
+				Zlib::Compress(filtered.data(), filtered.size(), compressed);
+				PutChunk(out, "IDAT", compressed.data(), compressed.size());
+				PutChunk(out, "IEND", nullptr, 0);
+			}
+
+			// Full range BT.601, flagged with XCOLORRANGE=FULL as players assume limited range otherwise.
+			// C420jpeg sites chroma at the center of each 2x2 block, averaged here.
+			void EncodeY4M(const Image& image, const Sink& sink, bool header, std::vector<uint8_t>& out)
+			{
+				if (header) {
+					char text[96];
+					int length = snprintf(text, sizeof(text), "YUV4MPEG2 W%d H%d F%u:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n", image.Width, image.Height, sink.Fps);
+					out.insert(out.end(), text, text + length);
+				}
+				static const char Frame[] = "FRAME\n";
+				out.insert(out.end(), Frame, Frame + sizeof(Frame) - 1);
+
+				GLsizei width = image.Width, height = image.Height;
+				GLsizei chromaWidth = (width + 1) / 2, chromaHeight = (height + 1) / 2;
+				size_t start = out.size();
+				out.resize(start + (size_t)width * height + (size_t)chromaWidth * chromaHeight * 2);
+				uint8_t* luma = out.data() + start;
+				uint8_t* cb = luma + (size_t)width * height;
+				uint8_t* cr = cb + (size_t)chromaWidth * chromaHeight;
+				const uint8_t* pixels = image.Pixels.data();
+				for (size_t i = 0, count = (size_t)width * height; i < count; ++i) {
+					const uint8_t* p = pixels + i * 4;
+					luma[i] = (uint8_t)((19595 * p[0] + 38470 * p[1] + 7471 * p[2] + 32768) >> 16);
+				}
+				for (GLsizei cy = 0; cy < chromaHeight; ++cy) {
+					for (GLsizei cx = 0; cx < chromaWidth; ++cx) {
+						int r = 0, g = 0, b = 0, n = 0;
+						for (GLsizei y = cy * 2; y < std::min(cy * 2 + 2, height); ++y) {
+							for (GLsizei x = cx * 2; x < std::min(cx * 2 + 2, width); ++x, ++n) {
+								const uint8_t* p = pixels + ((size_t)y * width + x) * 4;
+								r += p[0];
+								g += p[1];
+								b += p[2];
+							}
+						}
+						r /= n;
+						g /= n;
+						b /= n;
+						// the offset keeps the sums positive before the shift
+						size_t i = (size_t)cy * chromaWidth + cx;
+						cb[i] = (uint8_t)std::min((-11059 * r - 21709 * g + 32768 * b + (128 << 16) + 32768) >> 16, 255);
+						cr[i] = (uint8_t)std::min((32768 * r - 27439 * g - 5329 * b + (128 << 16) + 32768) >> 16, 255);
+					}
+				}
+			}
+
+			// Writes the frames of a stream that are next in order
+			void Append(Sink& sink, uint64_t sequence, std::vector<uint8_t> data)
+			{
+				std::lock_guard<std::mutex> lock(sink.Mutex);
+				sink.Reordered.emplace(sequence, std::move(data));
+				while (!sink.Reordered.empty() && sink.Reordered.begin()->first == sink.NextWrite) {
+					const std::vector<uint8_t>& frame = sink.Reordered.begin()->second;
+					if (fwrite(frame.data(), 1, frame.size(), sink.File) == frame.size())
+						sink.Written++;
+					sink.Reordered.erase(sink.Reordered.begin());
+					sink.NextWrite++;
+				}
+			}
+
+			void Encode(const Job& job)
+			{
+				Sink& sink = *job.Target;
+				const Image& image = *job.Frame;
+				std::vector<uint8_t> data;
+				switch (sink.Format) {
+				case CaptureFormat::PNG: {
+					SPARKY_PROFILE_SCOPE("FrameCapture::EncodePNG");
+					EncodePNG(image, data);
+					std::string path = sink.Sequence ? SequencePath(sink.Path, job.Sequence) : sink.Path;
+					FILE* file = fopen(path.c_str(), "wb");
+					if (file && fwrite(data.data(), 1, data.size(), file) == data.size())
+						sink.Written++;
+					else
+						SPARKY_CORE_ERROR("FrameCapture: cannot write {0}", path);
+					if (file)
+						fclose(file);
+					return;
+				}
+				case CaptureFormat::Y4M: {
+					SPARKY_PROFILE_SCOPE("FrameCapture::EncodeY4M");
+					EncodeY4M(image, sink, job.Sequence == 0, data);
+					break;
+				}
+				case CaptureFormat::RGBA:
+					data = image.Pixels;
+					break;
+				}
+				Append(sink, job.Sequence, std::move(data));
+			}
+
+			void EncoderThread()
+			{
+				Profiler::SetThreadName("Capture encoder");
+				SPARKY_MEMORY_TAG(Renderer);
+				std::unique_lock<std::mutex> lock(s_Mutex);
+				while (true) {
+					s_Wake.wait(lock, [] { return s_Stop || !s_Jobs.empty(); });
+					// finish what is queued before stopping
+					if (s_Jobs.empty())
+						return;
+					Job job = std::move(s_Jobs.front());
+					s_Jobs.pop_front();
+					lock.unlock();
+
+					Encode(job);
+					s_Encoded++;
+					// drop the image outside the lock
+					job = Job();
+					lock.lock();
+				}
+			}
+
+			void StartEncoders()
+			{
+				if (!s_Encoders.empty())
+					return;
+				unsigned int count = std::max(1u, std::min(std::thread::hardware_concurrency() / 2, 4u));
+				for (unsigned int i = 0; i < count; ++i)
+					s_Encoders.emplace_back(EncoderThread);
+			}
+
+			void ReadPixels(GLuint framebuffer, GLsizei width, GLsizei height)
+			{
+				if ((!s_Screenshot && !s_Recording) || width <= 0 || height <= 0)
+					return;
+				SPARKY_PROFILE_FUNCTION();
+				Readback& slot = s_Ring[s_Next];
+				if (slot.Fence) {
+					// a pending screenshot waits for the next frame
+					s_Stats.Dropped++;
+					return;
+				}
+
+				SPARKY_MEMORY_TAG(Renderer);
+				if (s_Recording) {
+					Sink& sink = *s_Recording;
+					if (!sink.Width) {
+						sink.Width = width;
+						sink.Height = height;
+					}
+					if (sink.Format == CaptureFormat::PNG || (sink.Width == width && sink.Height == height))
+						slot.Sinks.push_back(s_Recording);
+					else
+						s_Stats.Dropped++;
+				}
+				if (s_Screenshot)
+					slot.Sinks.push_back(std::move(s_Screenshot));
+				if (slot.Sinks.empty())
+					return;
+
+				GLsizeiptr size = (GLsizeiptr)width * height * 4;
+				GLint previousRead;
+				glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousRead);
+				if (!slot.Buffer)
+					glGenBuffers(1, &slot.Buffer);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+				if (slot.Capacity < size) {
+					glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+					slot.Capacity = size;
+				}
+				glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+				// RGBA8 rows are 4 byte aligned, the default pack alignment
+				glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+				slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+				glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)previousRead);
+
+				slot.Width = width;
+				slot.Height = height;
+				s_InFlight.push_back(s_Next);
+				s_Next = (s_Next + 1) % RingSize;
+				s_Stats.Captured++;
+			}
+
+			// The readback in slot has finished, or failed when complete is false
+			void Retire(Readback& slot, bool complete)
+			{
+				glDeleteSync(slot.Fence);
+				slot.Fence = nullptr;
+				std::vector<std::shared_ptr<Sink>> sinks;
+				sinks.swap(slot.Sinks);
+
+				size_t size = (size_t)slot.Width * slot.Height * 4;
+				if (!complete || s_QueuedBytes + size > s_MaxQueuedBytes) {
+					s_Stats.Dropped++;
+					for (const std::shared_ptr<Sink>& sink : sinks) {
+						if (!sink->Sequence)
+							SPARKY_CORE_WARN("FrameCapture: dropped {0}, the encoders are behind", sink->Path);
+					}
+					return;
+				}
+
+				SPARKY_MEMORY_TAG(Renderer);
+				std::shared_ptr<Image> image = std::make_shared<Image>();
+				image->Width = slot.Width;
+				image->Height = slot.Height;
+				image->Pixels.resize(size);
+				s_QueuedBytes += size;
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+				const uint8_t* mapped = static_cast<const uint8_t*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_READ_BIT));
+				if (mapped) {
+					// GL rows run bottom up
+					size_t rowBytes = (size_t)slot.Width * 4;
+					for (GLsizei y = 0; y < slot.Height; ++y)
+						memcpy(&image->Pixels[(size_t)(slot.Height - 1 - y) * rowBytes], mapped + (size_t)y * rowBytes, rowBytes);
+					glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+				}
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+				if (!mapped) {
+					s_Stats.Dropped++;
+					return;
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(s_Mutex);
+					for (const std::shared_ptr<Sink>& sink : sinks)
+						s_Jobs.push_back({ image, sink, sink->Frames++ });
+				}
+				s_Wake.notify_all();
+			}
+		}
+
+		void FrameCapture::Screenshot(const std::string& path)
+		{
+			StartEncoders();
+			s_Screenshot = CreateSink(path, 60, false);
+		}
+
+		bool FrameCapture::StartRecording(const std::string& path, uint32_t fps)
+		{
+			StopRecording();
+			std::shared_ptr<Sink> sink = CreateSink(path, std::max(fps, 1u), true);
+			if (!sink)
+				return false;
+			StartEncoders();
+			s_Recording = std::move(sink);
+			SPARKY_CORE_INFO("FrameCapture: recording to {0}", path);
+			return true;
+		}
+
+		void FrameCapture::StopRecording()
+		{
+			// frames still in flight or queued keep the sink until they are written
+			s_Recording.reset();
+		}
+
+		bool FrameCapture::IsRecording()
+		{
+			return s_Recording != nullptr;
+		}
+
+		void FrameCapture::CaptureBackbuffer(GLsizei width, GLsizei height)
+		{
+			ReadPixels(0, width, height);
+		}
+
+		void FrameCapture::Capture(const Framebuffer& source, GLsizei width, GLsizei height)
+		{
+			ReadPixels(source.GetReadFramebuffer(), width, height);
+		}
+
+		void FrameCapture::Update()
+		{
+			while (!s_InFlight.empty()) {
+				Readback& slot = s_Ring[s_InFlight.front()];
+				GLenum result = glClientWaitSync(slot.Fence, 0, 0);
+				if (result == GL_TIMEOUT_EXPIRED)
+					break;
+				SPARKY_PROFILE_SCOPE("FrameCapture::Retire");
+				Retire(slot, result != GL_WAIT_FAILED);
+				s_InFlight.pop_front();
+			}
+		}
+
+		void FrameCapture::Shutdown()
+		{
+			s_Screenshot.reset();
+			s_Recording.reset();
+			while (!s_InFlight.empty()) {
+				Readback& slot = s_Ring[s_InFlight.front()];
+				GLenum result;
+				do {
+					result = glClientWaitSync(slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+				} while (result == GL_TIMEOUT_EXPIRED);
+				Retire(slot, result != GL_WAIT_FAILED);
+				s_InFlight.pop_front();
+			}
+			if (!s_Encoders.empty()) {
+				{
+					std::lock_guard<std::mutex> lock(s_Mutex);
+					s_Stop = true;
+				}
+				s_Wake.notify_all();
+				for (std::thread& encoder : s_Encoders)
+					encoder.join();
+				s_Encoders.clear();
+				s_Stop = false;
+			}
+			for (Readback& slot : s_Ring) {
+				FrameContext::DeleteBuffer(slot.Buffer);
+				slot = Readback();
+			}
+			s_Next = 0;
+		}
+
+		void FrameCapture::SetMaxQueuedBytes(size_t bytes)
+		{
+			s_MaxQueuedBytes = bytes;
+		}
+
+		FrameCapture::Stats FrameCapture::GetStats()
+		{
+			Stats stats = s_Stats;
+			stats.Encoded = s_Encoded;
+			stats.InFlight = (uint32_t)s_InFlight.size();
+			stats.QueuedBytes = s_QueuedBytes;
+			stats.Recording = s_Recording != nullptr;
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			stats.Queued = (uint32_t)s_Jobs.size();
+			return stats;
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <glad/glad.h>
+
+namespace sparky {
+	namespace graphics {
+		class Framebuffer;
+
+		// Screenshots and recordings without stalling the pipeline. A captured
+		// frame is read into one of a ring of pixel pack buffers and fenced;
+		// Update maps the buffers whose fences have signaled, a frame or two
+		// later, and hands the pixels to encoder threads. When every buffer is
+		// still in flight, or the encoders are too far behind, the frame is
+		// dropped rather than waited for.
+		//
+		// The format follows the extension of the path:
+		//   .png   one image per frame, a recording appends _000000 and up to
+		//          the name
+		//   .y4m   YUV 4:2:0 video in one file, ffmpeg and most players read it
+		//   .rgba  raw top down RGBA8 frames in one file
+		// A recording takes every frame, so its rate is the frame rate: vsync
+		// or a fixed step replay keep it at the fps written to the header.
+		//
+		// Main thread only, apart from the encoders.
+		class FrameCapture {
+		public:
+			struct Stats {
+				uint32_t Captured = 0, Encoded = 0, Dropped = 0;
+				uint32_t InFlight = 0, Queued = 0;
+				size_t QueuedBytes = 0;
+				bool Recording = false;
+			};
+
+			// The next captured frame, one image whatever the extension
+			static void Screenshot(const std::string& path);
+			static bool StartRecording(const std::string& path, uint32_t fps = 60);
+			static void StopRecording();
+			static bool IsRecording();
+
+			// Reads the bottom left width x height of the window's framebuffer or
+			// of source's color attachment, if a screenshot or recording wants
+			// this frame. Call it once the frame is drawn.
+			static void CaptureBackbuffer(GLsizei width, GLsizei height);
+			static void Capture(const Framebuffer& source, GLsizei width, GLsizei height);
+			// Once per frame: queues the readbacks that have finished for encoding
+			static void Update();
+			// Waits for every readback and encode, then stops the encoders
+			static void Shutdown();
+
+			// Memory held by frames waiting for an encoder, 256 MB by default
+			static void SetMaxQueuedBytes(size_t bytes);
+			static Stats GetStats();
+		};
+	}
+}
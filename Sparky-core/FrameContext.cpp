@@ -0,0 +1,202 @@
+#include "FrameContext.h"
+#include <chrono>
+#include <vector>
+#include "Log.h"
+#include "Memory.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+
+namespace sparky {
+	namespace graphics {
+		namespace {
+			enum class ObjectType : uint8_t { Buffer, Texture, Program, VertexArray, Framebuffer, Renderbuffer };
+
+			struct Deletion {
+				ObjectType Type;
+				GLuint Name;
+			};
+
+			struct Frame {
+				GLsync Fence = nullptr;
+				std::vector<Deletion> Deletions;
+				GLsizeiptr TransientUsed = 0;
+			};
+
+			bool s_Initialized = false;
+			Frame s_Frames[FrameContext::FramesInFlight];
+			uint32_t s_Current = 0;
+			uint64_t s_FrameNumber = 0;
+
+			GLuint s_TransientBuffer = 0;
+			GLsizeiptr s_TransientBytes = 0;
+			// the whole buffer when persistently mapped
+			char* s_Mapping = nullptr;
+			GLint s_UniformAlignment = 256;
+			FrameContext::Stats s_Stats;
+
+			void DeleteNow(ObjectType type, GLuint name) {
+				switch (type) {
+				case ObjectType::Buffer: glDeleteBuffers(1, &name); break;
+				case ObjectType::Texture: glDeleteTextures(1, &name); break;
+				case ObjectType::Program: glDeleteProgram(name); break;
+				case ObjectType::VertexArray: glDeleteVertexArrays(1, &name); break;
+				case ObjectType::Framebuffer: glDeleteFramebuffers(1, &name); break;
+				case ObjectType::Renderbuffer: glDeleteRenderbuffers(1, &name); break;
+				}
+			}
+
+			void Queue(ObjectType type, GLuint name) {
+				if (!name)
+					return;
+				if (!s_Initialized) {
+					DeleteNow(type, name);
+					return;
+				}
+				SPARKY_MEMORY_TAG(Renderer);
+				s_Frames[s_Current].Deletions.push_back({ type, name });
+			}
+
+			// Blocks until the GPU has passed fence, true unless the wait failed
+			bool Wait(GLsync fence) {
+				if (glClientWaitSync(fence, 0, 0) != GL_TIMEOUT_EXPIRED)
+					return true;
+				s_Stats.Stalls++;
+				SPARKY_PROFILE_SCOPE("FrameContext::Wait");
+				auto begin = std::chrono::steady_clock::now();
+				GLenum result;
+				do {
+					result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+				} while (result == GL_TIMEOUT_EXPIRED);
+				s_Stats.WaitMilliseconds += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - begin).count();
+				return result != GL_WAIT_FAILED;
+			}
+
+			// The GPU is done with frame, recycle what it held
+			void Retire(Frame& frame) {
+				if (frame.Fence) {
+					Wait(frame.Fence);
+					glDeleteSync(frame.Fence);
+					frame.Fence = nullptr;
+				}
+				for (const Deletion& deletion : frame.Deletions)
+					DeleteNow(deletion.Type, deletion.Name);
+				s_Stats.Deletions += (uint32_t)frame.Deletions.size();
+				frame.Deletions.clear();
+				frame.TransientUsed = 0;
+			}
+		}
+
+		void FrameContext::Init(GLsizeiptr transientBytes) {
+			if (s_Initialized)
+				return;
+			SPARKY_MEMORY_TAG(Renderer);
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &s_UniformAlignment);
+			s_TransientBytes = transientBytes;
+			GLsizeiptr total = transientBytes * FramesInFlight;
+
+			glGenBuffers(1, &s_TransientBuffer);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, s_TransientBuffer);
+			if (GLAD_GL_VERSION_4_4 && glBufferStorage) {
+				GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+				glBufferStorage(GL_COPY_WRITE_BUFFER, total, nullptr, flags);
+				s_Mapping = static_cast<char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, total, flags));
+			}
+			if (!s_Mapping)
+				glBufferData(GL_COPY_WRITE_BUFFER, total, nullptr, GL_STREAM_DRAW);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+			s_Stats = Stats();
+			s_Stats.TransientCapacity = transientBytes;
+			s_Stats.Persistent = s_Mapping != nullptr;
+			s_Initialized = true;
+		}
+
+		void FrameContext::Shutdown() {
+			if (!s_Initialized)
+				return;
+			// oldest first, the current frame has no fence yet and goes last
+			for (uint32_t i = 1; i <= FramesInFlight; ++i)
+				Retire(s_Frames[(s_Current + i) % FramesInFlight]);
+			if (s_Mapping) {
+				glBindBuffer(GL_COPY_WRITE_BUFFER, s_TransientBuffer);
+				glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+				s_Mapping = nullptr;
+			}
+			glDeleteBuffers(1, &s_TransientBuffer);
+			s_TransientBuffer = 0;
+			s_Initialized = false;
+		}
+
+		void FrameContext::EndFrame() {
+			if (!s_Initialized)
+				return;
+			SPARKY_PROFILE_FUNCTION();
+			s_Frames[s_Current].Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+			s_FrameNumber++;
+			s_Current = (uint32_t)(s_FrameNumber % FramesInFlight);
+			s_Stats.Deletions = 0;
+			s_Stats.Overflows = 0;
+			s_Stats.WaitMilliseconds = 0.0f;
+			// the frame that last used this context, FramesInFlight frames ago
+			Retire(s_Frames[s_Current]);
+		}
+
+		TransientAllocation FrameContext::AllocateTransient(GLsizeiptr size, GLsizeiptr alignment) {
+			TransientAllocation allocation;
+			if (!s_Initialized || size <= 0)
+				return allocation;
+			Frame& frame = s_Frames[s_Current];
+			GLsizeiptr offset = (frame.TransientUsed + alignment - 1) / alignment * alignment;
+			if (offset + size > s_TransientBytes) {
+				s_Stats.Overflows++;
+				return allocation;
+			}
+			frame.TransientUsed = offset + size;
+
+			allocation.Buffer = s_TransientBuffer;
+			allocation.Offset = (GLintptr)s_Current * s_TransientBytes + offset;
+			allocation.Size = size;
+			if (s_Mapping)
+				allocation.Data = s_Mapping + allocation.Offset;
+			else
+				allocation.Data = Memory::GetFrameArena().Allocate((size_t)size, 16);
+			return allocation;
+		}
+
+		TransientAllocation FrameContext::AllocateUniforms(GLsizeiptr size) {
+			return AllocateTransient(size, s_UniformAlignment);
+		}
+
+		TransientAllocation FrameContext::AllocateVertices(GLsizeiptr size) {
+			return AllocateTransient(size, 16);
+		}
+
+		void FrameContext::Commit(const TransientAllocation& allocation) {
+			// coherent mappings need nothing, the range is idle on the GPU either way
+			if (s_Mapping || !allocation)
+				return;
+			glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.Buffer);
+			glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.Offset, allocation.Size, allocation.Data);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		}
+
+		void FrameContext::DeleteBuffer(GLuint name) { Queue(ObjectType::Buffer, name); }
+		void FrameContext::DeleteTexture(GLuint name) { Queue(ObjectType::Texture, name); }
+		void FrameContext::DeleteProgram(GLuint name) { Queue(ObjectType::Program, name); }
+		void FrameContext::DeleteVertexArray(GLuint name) { Queue(ObjectType::VertexArray, name); }
+		void FrameContext::DeleteFramebuffer(GLuint name) { Queue(ObjectType::Framebuffer, name); }
+		void FrameContext::DeleteRenderbuffer(GLuint name) { Queue(ObjectType::Renderbuffer, name); }
+
+		FrameContext::Stats FrameContext::GetStats() {
+			Stats stats = s_Stats;
+			stats.Frame = s_FrameNumber;
+			stats.TransientUsed = s_Frames[s_Current].TransientUsed;
+			stats.PendingDeletions = 0;
+			for (const Frame& frame : s_Frames)
+				stats.PendingDeletions += (uint32_t)frame.Deletions.size();
+			return stats;
+		}
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdint.h>
+#include <glad/glad.h>
+
+namespace sparky {
+	namespace graphics {
+		// A range of the current frame's transient buffer. Write Data, Commit, then
+		// source Buffer at Offset; the range is only valid until the frame ends.
+		struct TransientAllocation {
+			GLuint Buffer = 0;
+			GLintptr Offset = 0;
+			GLsizeiptr Size = 0;
+			void* Data = nullptr;
+
+			explicit operator bool() const { return Data != nullptr; }
+		};
+
+		// Frames in flight. The CPU may run up to FramesInFlight frames ahead of
+		// the GPU; each of those frames owns a context with a fence inserted after
+		// its swap, a slice of one transient buffer for per frame uniform and
+		// vertex data, and the GL objects released while it was recorded.
+		//
+		// When a context comes around again, its fence is waited on. That wait
+		// is what bounds the run-ahead and normally returns at once. Only then
+		// is its slice handed out again and its objects deleted, so nothing the
+		// GPU may still read is overwritten or deleted, and the driver never has
+		// to synchronize implicitly.
+		//
+		// The transient buffer is persistently mapped with GL 4.4 and written
+		// through a staging copy from the frame arena otherwise. Main thread only.
+		class FrameContext {
+		public:
+			static const uint32_t FramesInFlight = 3;
+
+			struct Stats {
+				uint64_t Frame = 0;
+				uint32_t PendingDeletions = 0;
+				uint32_t Deletions = 0; // this frame
+				uint32_t Overflows = 0; // this frame
+				uint32_t Stalls = 0;
+				float WaitMilliseconds = 0.0f; // this frame
+				GLsizeiptr TransientUsed = 0, TransientCapacity = 0;
+				bool Persistent = false;
+			};
+
+			// transientBytes is the slice of every frame
+			static void Init(GLsizeiptr transientBytes = 4 << 20);
+			// Waits for the GPU and deletes everything still queued
+			static void Shutdown();
+			// Right after the swap: fences this frame and starts the next one
+			static void EndFrame();
+
+			// Empty when the frame's slice is full
+			static TransientAllocation AllocateTransient(GLsizeiptr size, GLsizeiptr alignment);
+			// Aligned for glBindBufferRange(GL_UNIFORM_BUFFER, ...)
+			static TransientAllocation AllocateUniforms(GLsizeiptr size);
+			static TransientAllocation AllocateVertices(GLsizeiptr size);
+			// Makes what was written to Data visible to the GPU
+			static void Commit(const TransientAllocation& allocation);
+
+			// Deleted once the frames that may use the object have finished on the
+			// GPU; right away before Init and after Shutdown. Name 0 is ignored.
+			static void DeleteBuffer(GLuint name);
+			static void DeleteTexture(GLuint name);
+			static void DeleteProgram(GLuint name);
+			static void DeleteVertexArray(GLuint name);
+			static void DeleteFramebuffer(GLuint name);
+			static void DeleteRenderbuffer(GLuint name);
+
+			static Stats GetStats();
+		};
+	}
+}
@@ -0,0 +1,135 @@
+#include "Framebuffer.h"
+#include "FrameContext.h"
+#include "Log.h"
+
+namespace sparky {
+	namespace graphics {
+		namespace {
+			inline bool HasStencil(GLenum format) {
+				return format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+			}
+		}
+
+		Framebuffer::Framebuffer(const FramebufferSpec& spec)
+			: m_Spec(spec)
+		{
+			Create();
+		}
+
+		Framebuffer::~Framebuffer() {
+			Destroy();
+		}
+
+		void Framebuffer::Create() {
+			if (m_Spec.Width <= 0 || m_Spec.Height <= 0)
+				return;
+			// only ever created at startup or on a resize, so the bindings it
+			// disturbs are worth two queries
+			GLint lastTexture, lastFramebuffer;
+			glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+			glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &lastFramebuffer);
+
+			bool multisampled = m_Spec.Samples > 1;
+			if (m_Spec.ColorFormat) {
+				glGenTextures(1, &m_ColorTexture);
+				glBindTexture(GL_TEXTURE_2D, m_ColorTexture);
+				glTexImage2D(GL_TEXTURE_2D, 0, m_Spec.ColorFormat, m_Spec.Width, m_Spec.Height, 0, GL_RGBA, GL_FLOAT, nullptr);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			}
+
+			glGenFramebuffers(1, &m_FramebufferID);
+			glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
+			if (m_Spec.ColorFormat) {
+				if (multisampled) {
+					glGenRenderbuffers(1, &m_ColorRenderbuffer);
+					glBindRenderbuffer(GL_RENDERBUFFER, m_ColorRenderbuffer);
+					glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_Spec.Samples, m_Spec.ColorFormat, m_Spec.Width, m_Spec.Height);
+					glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_ColorRenderbuffer);
+				}
+				else {
+					glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorTexture, 0);
+				}
+			}
+			else {
+				glDrawBuffer(GL_NONE);
+				glReadBuffer(GL_NONE);
+			}
+			if (m_Spec.DepthFormat) {
+				glGenRenderbuffers(1, &m_DepthRenderbuffer);
+				glBindRenderbuffer(GL_RENDERBUFFER, m_DepthRenderbuffer);
+				if (multisampled)
+					glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_Spec.Samples, m_Spec.DepthFormat, m_Spec.Width, m_Spec.Height);
+				else
+					glRenderbufferStorage(GL_RENDERBUFFER, m_Spec.DepthFormat, m_Spec.Width, m_Spec.Height);
+				GLenum attachment = HasStencil(m_Spec.DepthFormat) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+				glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, m_DepthRenderbuffer);
+			}
+			glBindRenderbuffer(GL_RENDERBUFFER, 0);
+			GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+			if (status != GL_FRAMEBUFFER_COMPLETE)
+				SPARKY_CORE_ERROR("Framebuffer: {0}x{1} with {2} samples is incomplete (0x{3:x})", m_Spec.Width, m_Spec.Height, m_Spec.Samples, status);
+
+			if (multisampled && m_Spec.ColorFormat) {
+				glGenFramebuffers(1, &m_ResolveID);
+				glBindFramebuffer(GL_FRAMEBUFFER, m_ResolveID);
+				glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorTexture, 0);
+			}
+
+			glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)lastFramebuffer);
+			glBindTexture(GL_TEXTURE_2D, (GLuint)lastTexture);
+		}
+
+		void Framebuffer::Destroy() {
+			FrameContext::DeleteFramebuffer(m_FramebufferID);
+			FrameContext::DeleteFramebuffer(m_ResolveID);
+			FrameContext::DeleteRenderbuffer(m_ColorRenderbuffer);
+			FrameContext::DeleteRenderbuffer(m_DepthRenderbuffer);
+			FrameContext::DeleteTexture(m_ColorTexture);
+			m_FramebufferID = m_ResolveID = 0;
+			m_ColorRenderbuffer = m_DepthRenderbuffer = m_ColorTexture = 0;
+		}
+
+		void Framebuffer::Resize(GLsizei width, GLsizei height) {
+			if (width == m_Spec.Width && height == m_Spec.Height)
+				return;
+			Destroy();
+			m_Spec.Width = width;
+			m_Spec.Height = height;
+			Create();
+		}
+
+		void Framebuffer::bind() const {
+			bind(m_Spec.Width, m_Spec.Height);
+		}
+
+		void Framebuffer::bind(GLsizei width, GLsizei height) const {
+			glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
+			glViewport(0, 0, width, height);
+		}
+
+		void Framebuffer::unbind() const {
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		}
+
+		void Framebuffer::Resolve() const {
+			Resolve(m_Spec.Width, m_Spec.Height);
+		}
+
+		void Framebuffer::Resolve(GLsizei width, GLsizei height) const {
+			if (!m_ResolveID)
+				return;
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, m_FramebufferID);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_ResolveID);
+			glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+			glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
+		}
+
+		void Framebuffer::BindDefault(GLsizei width, GLsizei height) {
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glViewport(0, 0, width, height);
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace sparky {
+	namespace graphics {
+		struct FramebufferSpec {
+			GLsizei Width = 0, Height = 0;
+			// internal formats, 0 leaves the attachment out
+			GLenum ColorFormat = GL_RGBA8;
+			GLenum DepthFormat = GL_DEPTH24_STENCIL8;
+			// above 1 the attachments are multisampled renderbuffers
+			GLsizei Samples = 1;
+		};
+
+		// An offscreen render target. The color attachment ends up in a texture
+		// with linear filtering that can be sampled; a multisampled target
+		// renders into renderbuffers and Resolve blits them into that texture.
+		// Depth is always a renderbuffer since nothing samples it.
+		class Framebuffer {
+		public:
+			Framebuffer(const FramebufferSpec& spec);
+			~Framebuffer();
+			Framebuffer(const Framebuffer&) = delete;
+			Framebuffer& operator=(const Framebuffer&) = delete;
+
+			// Recreates the attachments, contents are lost
+			void Resize(GLsizei width, GLsizei height);
+
+			// Binds for drawing with the viewport over the whole target
+			void bind() const;
+			// Binds with the viewport over the bottom left width x height, to render
+			// below full size without reallocating
+			void bind(GLsizei width, GLsizei height) const;
+			void unbind() const;
+			// Multisampled targets only, single sampled ones render into the texture directly
+			void Resolve() const;
+			void Resolve(GLsizei width, GLsizei height) const;
+
+			inline GLuint GetColorAttachment() const { return m_ColorTexture; }
+			// The framebuffer with the color texture attached, for glReadPixels and blits
+			inline GLuint GetReadFramebuffer() const { return m_ResolveID ? m_ResolveID : m_FramebufferID; }
+			inline GLsizei GetWidth() const { return m_Spec.Width; }
+			inline GLsizei GetHeight() const { return m_Spec.Height; }
+			inline const FramebufferSpec& GetSpec() const { return m_Spec; }
+
+			// The window's framebuffer with the viewport over width x height
+			static void BindDefault(GLsizei width, GLsizei height);
+		private:
+			void Create();
+			void Destroy();
+		private:
+			FramebufferSpec m_Spec;
+			GLuint m_FramebufferID = 0, m_ResolveID = 0;
+			GLuint m_ColorTexture = 0, m_ColorRenderbuffer = 0, m_DepthRenderbuffer = 0;
+		};
+	}
+}
@@ -0,0 +1,143 @@
+#include "GLDebug.h"
+#include <glad/glad.h>
+#include <atomic>
+#include "Log.h"
+
+namespace sparky {
+
+	namespace {
+		std::atomic<bool> s_Installed{ false };
+		std::atomic<uint64_t> s_Messages{ 0 };
+
+		// Open addressed table of the message IDs seen so far, filled from whatever
+		// thread the driver calls back on. Once full every message is logged.
+		const uint32_t SeenCapacity = 512;
+		std::atomic<uint64_t> s_SeenKeys[SeenCapacity];
+		std::atomic<uint32_t> s_SeenCounts[SeenCapacity];
+
+		// Returns how often the message was seen, this one included
+		uint32_t CountMessage(GLenum source, GLenum type, GLuint id)
+		{
+			uint64_t key = (1ull << 63) | ((uint64_t)(source & 0xFFFF) << 48) | ((uint64_t)(type & 0xFFFF) << 32) | id;
+			uint32_t slot = (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32) % SeenCapacity;
+			for (uint32_t probe = 0; probe < SeenCapacity; ++probe) {
+				std::atomic<uint64_t>& entry = s_SeenKeys[(slot + probe) % SeenCapacity];
+				uint64_t current = entry.load(std::memory_order_acquire);
+				if (current == 0 && entry.compare_exchange_strong(current, key, std::memory_order_acq_rel))
+					current = key;
+				if (current == key)
+					return s_SeenCounts[(slot + probe) % SeenCapacity].fetch_add(1, std::memory_order_relaxed) + 1;
+			}
+			return 1;
+		}
+
+		bool ShouldLog(uint32_t count)
+		{
+			while (count % 10 == 0)
+				count /= 10;
+			return count == 1;
+		}
+
+		const char* SourceName(GLenum source)
+		{
+			switch (source)
+			{
+			case GL_DEBUG_SOURCE_API: return "api";
+			case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+			case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+			case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+			case GL_DEBUG_SOURCE_APPLICATION: return "application";
+			default: return "other";
+			}
+		}
+
+		const char* TypeName(GLenum type)
+		{
+			switch (type)
+			{
+			case GL_DEBUG_TYPE_ERROR: return "error";
+			case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated";
+			case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+			case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+			case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+			case GL_DEBUG_TYPE_MARKER: return "marker";
+			default: return "other";
+			}
+		}
+
+		void APIENTRY DebugCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei /*length*/, const GLchar* message, const void* /*userParam*/)
+		{
+			s_Messages.fetch_add(1, std::memory_order_relaxed);
+			if (type == GL_DEBUG_TYPE_PUSH_GROUP || type == GL_DEBUG_TYPE_POP_GROUP)
+				return;
+			uint32_t count = CountMessage(source, type, id);
+			if (!ShouldLog(count))
+				return;
+
+			switch (severity)
+			{
+			case GL_DEBUG_SEVERITY_HIGH:
+				SPARKY_CORE_ERROR("[OpenGL {0} {1}] ({2}) x{3}: {4}", SourceName(source), TypeName(type), id, count, message);
+				break;
+			case GL_DEBUG_SEVERITY_MEDIUM:
+				SPARKY_CORE_WARN("[OpenGL {0} {1}] ({2}) x{3}: {4}", SourceName(source), TypeName(type), id, count, message);
+				break;
+			case GL_DEBUG_SEVERITY_LOW:
+				SPARKY_CORE_INFO("[OpenGL {0} {1}] ({2}) x{3}: {4}", SourceName(source), TypeName(type), id, count, message);
+				break;
+			default:
+				SPARKY_CORE_TRACE("[OpenGL {0} {1}] ({2}) x{3}: {4}", SourceName(source), TypeName(type), id, count, message);
+				break;
+			}
+		}
+	}
+
+	bool GLDebug::Install(Severity minimum, bool synchronous)
+	{
+		if (s_Installed)
+			return true;
+		if (!GLAD_GL_VERSION_4_3 || !glDebugMessageCallback) {
+			SPARKY_CORE_WARN("OpenGL debug output unavailable, the context is older than 4.3");
+			return false;
+		}
+		GLint flags = 0;
+		glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+		if (!(flags & GL_CONTEXT_FLAG_DEBUG_BIT))
+			SPARKY_CORE_WARN("OpenGL context is not a debug context, the driver may report little");
+
+		glEnable(GL_DEBUG_OUTPUT);
+		if (synchronous)
+			glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+		else
+			glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+		glDebugMessageCallback(DebugCallback, nullptr);
+
+		// let the driver drop what we would not log
+		const GLenum severities[] = { GL_DEBUG_SEVERITY_NOTIFICATION, GL_DEBUG_SEVERITY_LOW, GL_DEBUG_SEVERITY_MEDIUM, GL_DEBUG_SEVERITY_HIGH };
+		for (int i = 0; i < 4; ++i)
+			glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, severities[i], 0, nullptr, i >= (int)minimum ? GL_TRUE : GL_FALSE);
+
+		s_Installed = true;
+		return true;
+	}
+
+	void GLDebug::Uninstall()
+	{
+		if (!s_Installed)
+			return;
+		glDebugMessageCallback(nullptr, nullptr);
+		glDisable(GL_DEBUG_OUTPUT);
+		s_Installed = false;
+	}
+
+	bool GLDebug::IsInstalled()
+	{
+		return s_Installed.load(std::memory_order_relaxed);
+	}
+
+	uint64_t GLDebug::GetMessageCount()
+	{
+		return s_Messages.load(std::memory_order_relaxed);
+	}
+
+}
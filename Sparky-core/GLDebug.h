@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace sparky {
+
+	// Routes KHR_debug output (core since GL 4.3) to the log instead of polling
+	// glGetError. The driver filters messages below the minimum severity before
+	// they reach the callback. Without synchronous output the driver may call
+	// back on its own threads, so the callback only formats into the log ring.
+	// A message ID is logged the first time it shows up and again after 10, 100,
+	// 1000... repeats, with the repeat count attached.
+	class GLDebug
+	{
+	public:
+		enum class Severity { Notification, Low, Medium, High };
+
+		// Needs a current context, ideally created with WindowProps::DebugContext.
+		// Returns false when the context has no debug output.
+		static bool Install(Severity minimum = Severity::Low, bool synchronous = false);
+		static void Uninstall();
+		static bool IsInstalled();
+
+		// Messages received since Install, duplicates included
+		static uint64_t GetMessageCount();
+	};
+
+}
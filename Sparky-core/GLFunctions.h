@@ -0,0 +1,707 @@
+#pragma once
+
+// X-macro list of every OpenGL 4.6 core entry point glad loads, generated
+// from Dependencies/GLAD/include/glad/glad.h. Regenerate together with glad.
+//
+//   SPARKY_GL_FUNCTION(name, return type, (parameters), (arguments))
+
+#define SPARKY_GL_FUNCTIONS \
+	SPARKY_GL_FUNCTION(glCullFace, void, (GLenum mode), (mode)) \
+	SPARKY_GL_FUNCTION(glFrontFace, void, (GLenum mode), (mode)) \
+	SPARKY_GL_FUNCTION(glHint, void, (GLenum target, GLenum mode), (target, mode)) \
+	SPARKY_GL_FUNCTION(glLineWidth, void, (GLfloat width), (width)) \
+	SPARKY_GL_FUNCTION(glPointSize, void, (GLfloat size), (size)) \
+	SPARKY_GL_FUNCTION(glPolygonMode, void, (GLenum face, GLenum mode), (face, mode)) \
+	SPARKY_GL_FUNCTION(glScissor, void, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height)) \
+	SPARKY_GL_FUNCTION(glTexParameterf, void, (GLenum target, GLenum pname, GLfloat param), (target, pname, param)) \
+	SPARKY_GL_FUNCTION(glTexParameterfv, void, (GLenum target, GLenum pname, const GLfloat *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glTexParameteri, void, (GLenum target, GLenum pname, GLint param), (target, pname, param)) \
+	SPARKY_GL_FUNCTION(glTexParameteriv, void, (GLenum target, GLenum pname, const GLint *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glTexImage1D, void, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const void *pixels), (target, level, internalformat, width, border, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glTexImage2D, void, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels), (target, level, internalformat, width, height, border, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glDrawBuffer, void, (GLenum buf), (buf)) \
+	SPARKY_GL_FUNCTION(glClear, void, (GLbitfield mask), (mask)) \
+	SPARKY_GL_FUNCTION(glClearColor, void, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha)) \
+	SPARKY_GL_FUNCTION(glClearStencil, void, (GLint s), (s)) \
+	SPARKY_GL_FUNCTION(glClearDepth, void, (GLdouble depth), (depth)) \
+	SPARKY_GL_FUNCTION(glStencilMask, void, (GLuint mask), (mask)) \
+	SPARKY_GL_FUNCTION(glColorMask, void, (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha), (red, green, blue, alpha)) \
+	SPARKY_GL_FUNCTION(glDepthMask, void, (GLboolean flag), (flag)) \
+	SPARKY_GL_FUNCTION(glDisable, void, (GLenum cap), (cap)) \
+	SPARKY_GL_FUNCTION(glEnable, void, (GLenum cap), (cap)) \
+	SPARKY_GL_FUNCTION(glFinish, void, (), ()) \
+	SPARKY_GL_FUNCTION(glFlush, void, (), ()) \
+	SPARKY_GL_FUNCTION(glBlendFunc, void, (GLenum sfactor, GLenum dfactor), (sfactor, dfactor)) \
+	SPARKY_GL_FUNCTION(glLogicOp, void, (GLenum opcode), (opcode)) \
+	SPARKY_GL_FUNCTION(glStencilFunc, void, (GLenum func, GLint ref, GLuint mask), (func, ref, mask)) \
+	SPARKY_GL_FUNCTION(glStencilOp, void, (GLenum fail, GLenum zfail, GLenum zpass), (fail, zfail, zpass)) \
+	SPARKY_GL_FUNCTION(glDepthFunc, void, (GLenum func), (func)) \
+	SPARKY_GL_FUNCTION(glPixelStoref, void, (GLenum pname, GLfloat param), (pname, param)) \
+	SPARKY_GL_FUNCTION(glPixelStorei, void, (GLenum pname, GLint param), (pname, param)) \
+	SPARKY_GL_FUNCTION(glReadBuffer, void, (GLenum src), (src)) \
+	SPARKY_GL_FUNCTION(glReadPixels, void, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels), (x, y, width, height, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glGetBooleanv, void, (GLenum pname, GLboolean *data), (pname, data)) \
+	SPARKY_GL_FUNCTION(glGetDoublev, void, (GLenum pname, GLdouble *data), (pname, data)) \
+	SPARKY_GL_FUNCTION(glGetError, GLenum, (), ()) \
+	SPARKY_GL_FUNCTION(glGetFloatv, void, (GLenum pname, GLfloat *data), (pname, data)) \
+	SPARKY_GL_FUNCTION(glGetIntegerv, void, (GLenum pname, GLint *data), (pname, data)) \
+	SPARKY_GL_FUNCTION(glGetString, const GLubyte *, (GLenum name), (name)) \
+	SPARKY_GL_FUNCTION(glGetTexImage, void, (GLenum target, GLint level, GLenum format, GLenum type, void *pixels), (target, level, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glGetTexParameterfv, void, (GLenum target, GLenum pname, GLfloat *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetTexParameteriv, void, (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetTexLevelParameterfv, void, (GLenum target, GLint level, GLenum pname, GLfloat *params), (target, level, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetTexLevelParameteriv, void, (GLenum target, GLint level, GLenum pname, GLint *params), (target, level, pname, params)) \
+	SPARKY_GL_FUNCTION(glIsEnabled, GLboolean, (GLenum cap), (cap)) \
+	SPARKY_GL_FUNCTION(glDepthRange, void, (GLdouble n, GLdouble f), (n, f)) \
+	SPARKY_GL_FUNCTION(glViewport, void, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height)) \
+	SPARKY_GL_FUNCTION(glDrawArrays, void, (GLenum mode, GLint first, GLsizei count), (mode, first, count)) \
+	SPARKY_GL_FUNCTION(glDrawElements, void, (GLenum mode, GLsizei count, GLenum type, const void *indices), (mode, count, type, indices)) \
+	SPARKY_GL_FUNCTION(glPolygonOffset, void, (GLfloat factor, GLfloat units), (factor, units)) \
+	SPARKY_GL_FUNCTION(glCopyTexImage1D, void, (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLint border), (target, level, internalformat, x, y, width, border)) \
+	SPARKY_GL_FUNCTION(glCopyTexImage2D, void, (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border), (target, level, internalformat, x, y, width, height, border)) \
+	SPARKY_GL_FUNCTION(glCopyTexSubImage1D, void, (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width), (target, level, xoffset, x, y, width)) \
+	SPARKY_GL_FUNCTION(glCopyTexSubImage2D, void, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height), (target, level, xoffset, yoffset, x, y, width, height)) \
+	SPARKY_GL_FUNCTION(glTexSubImage1D, void, (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels), (target, level, xoffset, width, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glTexSubImage2D, void, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels), (target, level, xoffset, yoffset, width, height, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glBindTexture, void, (GLenum target, GLuint texture), (target, texture)) \
+	SPARKY_GL_FUNCTION(glDeleteTextures, void, (GLsizei n, const GLuint *textures), (n, textures)) \
+	SPARKY_GL_FUNCTION(glGenTextures, void, (GLsizei n, GLuint *textures), (n, textures)) \
+	SPARKY_GL_FUNCTION(glIsTexture, GLboolean, (GLuint texture), (texture)) \
+	SPARKY_GL_FUNCTION(glDrawRangeElements, void, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices), (mode, start, end, count, type, indices)) \
+	SPARKY_GL_FUNCTION(glTexImage3D, void, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels), (target, level, internalformat, width, height, depth, border, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glTexSubImage3D, void, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glCopyTexSubImage3D, void, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height), (target, level, xoffset, yoffset, zoffset, x, y, width, height)) \
+	SPARKY_GL_FUNCTION(glActiveTexture, void, (GLenum texture), (texture)) \
+	SPARKY_GL_FUNCTION(glSampleCoverage, void, (GLfloat value, GLboolean invert), (value, invert)) \
+	SPARKY_GL_FUNCTION(glCompressedTexImage3D, void, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, height, depth, border, imageSize, data)) \
+	SPARKY_GL_FUNCTION(glCompressedTexImage2D, void, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, height, border, imageSize, data)) \
+	SPARKY_GL_FUNCTION(glCompressedTexImage1D, void, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, border, imageSize, data)) \
+	SPARKY_GL_FUNCTION(glCompressedTexSubImage3D, void, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data)) \
+	SPARKY_GL_FUNCTION(glCompressedTexSubImage2D, void, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data), (target, level, xoffset, yoffset, width, height, format, imageSize, data)) \
+	SPARKY_GL_FUNCTION(glCompressedTexSubImage1D, void, (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data), (target, level, xoffset, width, format, imageSize, data)) \
+	SPARKY_GL_FUNCTION(glGetCompressedTexImage, void, (GLenum target, GLint level, void *img), (target, level, img)) \
+	SPARKY_GL_FUNCTION(glBlendFuncSeparate, void, (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha), (sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha)) \
+	SPARKY_GL_FUNCTION(glMultiDrawArrays, void, (GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawcount), (mode, first, count, drawcount)) \
+	SPARKY_GL_FUNCTION(glMultiDrawElements, void, (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount), (mode, count, type, indices, drawcount)) \
+	SPARKY_GL_FUNCTION(glPointParameterf, void, (GLenum pname, GLfloat param), (pname, param)) \
+	SPARKY_GL_FUNCTION(glPointParameterfv, void, (GLenum pname, const GLfloat *params), (pname, params)) \
+	SPARKY_GL_FUNCTION(glPointParameteri, void, (GLenum pname, GLint param), (pname, param)) \
+	SPARKY_GL_FUNCTION(glPointParameteriv, void, (GLenum pname, const GLint *params), (pname, params)) \
+	SPARKY_GL_FUNCTION(glBlendColor, void, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha)) \
+	SPARKY_GL_FUNCTION(glBlendEquation, void, (GLenum mode), (mode)) \
+	SPARKY_GL_FUNCTION(glGenQueries, void, (GLsizei n, GLuint *ids), (n, ids)) \
+	SPARKY_GL_FUNCTION(glDeleteQueries, void, (GLsizei n, const GLuint *ids), (n, ids)) \
+	SPARKY_GL_FUNCTION(glIsQuery, GLboolean, (GLuint id), (id)) \
+	SPARKY_GL_FUNCTION(glBeginQuery, void, (GLenum target, GLuint id), (target, id)) \
+	SPARKY_GL_FUNCTION(glEndQuery, void, (GLenum target), (target)) \
+	SPARKY_GL_FUNCTION(glGetQueryiv, void, (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetQueryObjectiv, void, (GLuint id, GLenum pname, GLint *params), (id, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetQueryObjectuiv, void, (GLuint id, GLenum pname, GLuint *params), (id, pname, params)) \
+	SPARKY_GL_FUNCTION(glBindBuffer, void, (GLenum target, GLuint buffer), (target, buffer)) \
+	SPARKY_GL_FUNCTION(glDeleteBuffers, void, (GLsizei n, const GLuint *buffers), (n, buffers)) \
+	SPARKY_GL_FUNCTION(glGenBuffers, void, (GLsizei n, GLuint *buffers), (n, buffers)) \
+	SPARKY_GL_FUNCTION(glIsBuffer, GLboolean, (GLuint buffer), (buffer)) \
+	SPARKY_GL_FUNCTION(glBufferData, void, (GLenum target, GLsizeiptr size, const void *data, GLenum usage), (target, size, data, usage)) \
+	SPARKY_GL_FUNCTION(glBufferSubData, void, (GLenum target, GLintptr offset, GLsizeiptr size, const void *data), (target, offset, size, data)) \
+	SPARKY_GL_FUNCTION(glGetBufferSubData, void, (GLenum target, GLintptr offset, GLsizeiptr size, void *data), (target, offset, size, data)) \
+	SPARKY_GL_FUNCTION(glMapBuffer, void *, (GLenum target, GLenum access), (target, access)) \
+	SPARKY_GL_FUNCTION(glUnmapBuffer, GLboolean, (GLenum target), (target)) \
+	SPARKY_GL_FUNCTION(glGetBufferParameteriv, void, (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetBufferPointerv, void, (GLenum target, GLenum pname, void **params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glBlendEquationSeparate, void, (GLenum modeRGB, GLenum modeAlpha), (modeRGB, modeAlpha)) \
+	SPARKY_GL_FUNCTION(glDrawBuffers, void, (GLsizei n, const GLenum *bufs), (n, bufs)) \
+	SPARKY_GL_FUNCTION(glStencilOpSeparate, void, (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass), (face, sfail, dpfail, dppass)) \
+	SPARKY_GL_FUNCTION(glStencilFuncSeparate, void, (GLenum face, GLenum func, GLint ref, GLuint mask), (face, func, ref, mask)) \
+	SPARKY_GL_FUNCTION(glStencilMaskSeparate, void, (GLenum face, GLuint mask), (face, mask)) \
+	SPARKY_GL_FUNCTION(glAttachShader, void, (GLuint program, GLuint shader), (program, shader)) \
+	SPARKY_GL_FUNCTION(glBindAttribLocation, void, (GLuint program, GLuint index, const GLchar *name), (program, index, name)) \
+	SPARKY_GL_FUNCTION(glCompileShader, void, (GLuint shader), (shader)) \
+	SPARKY_GL_FUNCTION(glCreateProgram, GLuint, (), ()) \
+	SPARKY_GL_FUNCTION(glCreateShader, GLuint, (GLenum type), (type)) \
+	SPARKY_GL_FUNCTION(glDeleteProgram, void, (GLuint program), (program)) \
+	SPARKY_GL_FUNCTION(glDeleteShader, void, (GLuint shader), (shader)) \
+	SPARKY_GL_FUNCTION(glDetachShader, void, (GLuint program, GLuint shader), (program, shader)) \
+	SPARKY_GL_FUNCTION(glDisableVertexAttribArray, void, (GLuint index), (index)) \
+	SPARKY_GL_FUNCTION(glEnableVertexAttribArray, void, (GLuint index), (index)) \
+	SPARKY_GL_FUNCTION(glGetActiveAttrib, void, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name), (program, index, bufSize, length, size, type, name)) \
+	SPARKY_GL_FUNCTION(glGetActiveUniform, void, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name), (program, index, bufSize, length, size, type, name)) \
+	SPARKY_GL_FUNCTION(glGetAttachedShaders, void, (GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders), (program, maxCount, count, shaders)) \
+	SPARKY_GL_FUNCTION(glGetAttribLocation, GLint, (GLuint program, const GLchar *name), (program, name)) \
+	SPARKY_GL_FUNCTION(glGetProgramiv, void, (GLuint program, GLenum pname, GLint *params), (program, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetProgramInfoLog, void, (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (program, bufSize, length, infoLog)) \
+	SPARKY_GL_FUNCTION(glGetShaderiv, void, (GLuint shader, GLenum pname, GLint *params), (shader, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetShaderInfoLog, void, (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (shader, bufSize, length, infoLog)) \
+	SPARKY_GL_FUNCTION(glGetShaderSource, void, (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source), (shader, bufSize, length, source)) \
+	SPARKY_GL_FUNCTION(glGetUniformLocation, GLint, (GLuint program, const GLchar *name), (program, name)) \
+	SPARKY_GL_FUNCTION(glGetUniformfv, void, (GLuint program, GLint location, GLfloat *params), (program, location, params)) \
+	SPARKY_GL_FUNCTION(glGetUniformiv, void, (GLuint program, GLint location, GLint *params), (program, location, params)) \
+	SPARKY_GL_FUNCTION(glGetVertexAttribdv, void, (GLuint index, GLenum pname, GLdouble *params), (index, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetVertexAttribfv, void, (GLuint index, GLenum pname, GLfloat *params), (index, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetVertexAttribiv, void, (GLuint index, GLenum pname, GLint *params), (index, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetVertexAttribPointerv, void, (GLuint index, GLenum pname, void **pointer), (index, pname, pointer)) \
+	SPARKY_GL_FUNCTION(glIsProgram, GLboolean, (GLuint program), (program)) \
+	SPARKY_GL_FUNCTION(glIsShader, GLboolean, (GLuint shader), (shader)) \
+	SPARKY_GL_FUNCTION(glLinkProgram, void, (GLuint program), (program)) \
+	SPARKY_GL_FUNCTION(glShaderSource, void, (GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length), (shader, count, string, length)) \
+	SPARKY_GL_FUNCTION(glUseProgram, void, (GLuint program), (program)) \
+	SPARKY_GL_FUNCTION(glUniform1f, void, (GLint location, GLfloat v0), (location, v0)) \
+	SPARKY_GL_FUNCTION(glUniform2f, void, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1)) \
+	SPARKY_GL_FUNCTION(glUniform3f, void, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (location, v0, v1, v2)) \
+	SPARKY_GL_FUNCTION(glUniform4f, void, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3)) \
+	SPARKY_GL_FUNCTION(glUniform1i, void, (GLint location, GLint v0), (location, v0)) \
+	SPARKY_GL_FUNCTION(glUniform2i, void, (GLint location, GLint v0, GLint v1), (location, v0, v1)) \
+	SPARKY_GL_FUNCTION(glUniform3i, void, (GLint location, GLint v0, GLint v1, GLint v2), (location, v0, v1, v2)) \
+	SPARKY_GL_FUNCTION(glUniform4i, void, (GLint location, GLint v0, GLint v1, GLint v2, GLint v3), (location, v0, v1, v2, v3)) \
+	SPARKY_GL_FUNCTION(glUniform1fv, void, (GLint location, GLsizei count, const GLfloat *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform2fv, void, (GLint location, GLsizei count, const GLfloat *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform3fv, void, (GLint location, GLsizei count, const GLfloat *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform4fv, void, (GLint location, GLsizei count, const GLfloat *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform1iv, void, (GLint location, GLsizei count, const GLint *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform2iv, void, (GLint location, GLsizei count, const GLint *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform3iv, void, (GLint location, GLsizei count, const GLint *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform4iv, void, (GLint location, GLsizei count, const GLint *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix2fv, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix3fv, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix4fv, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glValidateProgram, void, (GLuint program), (program)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib1d, void, (GLuint index, GLdouble x), (index, x)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib1dv, void, (GLuint index, const GLdouble *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib1f, void, (GLuint index, GLfloat x), (index, x)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib1fv, void, (GLuint index, const GLfloat *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib1s, void, (GLuint index, GLshort x), (index, x)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib1sv, void, (GLuint index, const GLshort *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib2d, void, (GLuint index, GLdouble x, GLdouble y), (index, x, y)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib2dv, void, (GLuint index, const GLdouble *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib2f, void, (GLuint index, GLfloat x, GLfloat y), (index, x, y)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib2fv, void, (GLuint index, const GLfloat *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib2s, void, (GLuint index, GLshort x, GLshort y), (index, x, y)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib2sv, void, (GLuint index, const GLshort *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib3d, void, (GLuint index, GLdouble x, GLdouble y, GLdouble z), (index, x, y, z)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib3dv, void, (GLuint index, const GLdouble *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib3f, void, (GLuint index, GLfloat x, GLfloat y, GLfloat z), (index, x, y, z)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib3fv, void, (GLuint index, const GLfloat *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib3s, void, (GLuint index, GLshort x, GLshort y, GLshort z), (index, x, y, z)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib3sv, void, (GLuint index, const GLshort *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4Nbv, void, (GLuint index, const GLbyte *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4Niv, void, (GLuint index, const GLint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4Nsv, void, (GLuint index, const GLshort *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4Nub, void, (GLuint index, GLubyte x, GLubyte y, GLubyte z, GLubyte w), (index, x, y, z, w)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4Nubv, void, (GLuint index, const GLubyte *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4Nuiv, void, (GLuint index, const GLuint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4Nusv, void, (GLuint index, const GLushort *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4bv, void, (GLuint index, const GLbyte *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4d, void, (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w), (index, x, y, z, w)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4dv, void, (GLuint index, const GLdouble *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4f, void, (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w), (index, x, y, z, w)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4fv, void, (GLuint index, const GLfloat *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4iv, void, (GLuint index, const GLint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4s, void, (GLuint index, GLshort x, GLshort y, GLshort z, GLshort w), (index, x, y, z, w)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4sv, void, (GLuint index, const GLshort *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4ubv, void, (GLuint index, const GLubyte *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4uiv, void, (GLuint index, const GLuint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttrib4usv, void, (GLuint index, const GLushort *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribPointer, void, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer), (index, size, type, normalized, stride, pointer)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix2x3fv, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix3x2fv, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix2x4fv, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix4x2fv, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix3x4fv, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix4x3fv, void, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glColorMaski, void, (GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a), (index, r, g, b, a)) \
+	SPARKY_GL_FUNCTION(glGetBooleani_v, void, (GLenum target, GLuint index, GLboolean *data), (target, index, data)) \
+	SPARKY_GL_FUNCTION(glGetIntegeri_v, void, (GLenum target, GLuint index, GLint *data), (target, index, data)) \
+	SPARKY_GL_FUNCTION(glEnablei, void, (GLenum target, GLuint index), (target, index)) \
+	SPARKY_GL_FUNCTION(glDisablei, void, (GLenum target, GLuint index), (target, index)) \
+	SPARKY_GL_FUNCTION(glIsEnabledi, GLboolean, (GLenum target, GLuint index), (target, index)) \
+	SPARKY_GL_FUNCTION(glBeginTransformFeedback, void, (GLenum primitiveMode), (primitiveMode)) \
+	SPARKY_GL_FUNCTION(glEndTransformFeedback, void, (), ()) \
+	SPARKY_GL_FUNCTION(glBindBufferRange, void, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, index, buffer, offset, size)) \
+	SPARKY_GL_FUNCTION(glBindBufferBase, void, (GLenum target, GLuint index, GLuint buffer), (target, index, buffer)) \
+	SPARKY_GL_FUNCTION(glTransformFeedbackVaryings, void, (GLuint program, GLsizei count, const GLchar *const*varyings, GLenum bufferMode), (program, count, varyings, bufferMode)) \
+	SPARKY_GL_FUNCTION(glGetTransformFeedbackVarying, void, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLsizei *size, GLenum *type, GLchar *name), (program, index, bufSize, length, size, type, name)) \
+	SPARKY_GL_FUNCTION(glClampColor, void, (GLenum target, GLenum clamp), (target, clamp)) \
+	SPARKY_GL_FUNCTION(glBeginConditionalRender, void, (GLuint id, GLenum mode), (id, mode)) \
+	SPARKY_GL_FUNCTION(glEndConditionalRender, void, (), ()) \
+	SPARKY_GL_FUNCTION(glVertexAttribIPointer, void, (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer), (index, size, type, stride, pointer)) \
+	SPARKY_GL_FUNCTION(glGetVertexAttribIiv, void, (GLuint index, GLenum pname, GLint *params), (index, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetVertexAttribIuiv, void, (GLuint index, GLenum pname, GLuint *params), (index, pname, params)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI1i, void, (GLuint index, GLint x), (index, x)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI2i, void, (GLuint index, GLint x, GLint y), (index, x, y)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI3i, void, (GLuint index, GLint x, GLint y, GLint z), (index, x, y, z)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI4i, void, (GLuint index, GLint x, GLint y, GLint z, GLint w), (index, x, y, z, w)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI1ui, void, (GLuint index, GLuint x), (index, x)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI2ui, void, (GLuint index, GLuint x, GLuint y), (index, x, y)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI3ui, void, (GLuint index, GLuint x, GLuint y, GLuint z), (index, x, y, z)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI4ui, void, (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w), (index, x, y, z, w)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI1iv, void, (GLuint index, const GLint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI2iv, void, (GLuint index, const GLint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI3iv, void, (GLuint index, const GLint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI4iv, void, (GLuint index, const GLint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI1uiv, void, (GLuint index, const GLuint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI2uiv, void, (GLuint index, const GLuint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI3uiv, void, (GLuint index, const GLuint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI4uiv, void, (GLuint index, const GLuint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI4bv, void, (GLuint index, const GLbyte *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI4sv, void, (GLuint index, const GLshort *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI4ubv, void, (GLuint index, const GLubyte *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribI4usv, void, (GLuint index, const GLushort *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glGetUniformuiv, void, (GLuint program, GLint location, GLuint *params), (program, location, params)) \
+	SPARKY_GL_FUNCTION(glBindFragDataLocation, void, (GLuint program, GLuint color, const GLchar *name), (program, color, name)) \
+	SPARKY_GL_FUNCTION(glGetFragDataLocation, GLint, (GLuint program, const GLchar *name), (program, name)) \
+	SPARKY_GL_FUNCTION(glUniform1ui, void, (GLint location, GLuint v0), (location, v0)) \
+	SPARKY_GL_FUNCTION(glUniform2ui, void, (GLint location, GLuint v0, GLuint v1), (location, v0, v1)) \
+	SPARKY_GL_FUNCTION(glUniform3ui, void, (GLint location, GLuint v0, GLuint v1, GLuint v2), (location, v0, v1, v2)) \
+	SPARKY_GL_FUNCTION(glUniform4ui, void, (GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3), (location, v0, v1, v2, v3)) \
+	SPARKY_GL_FUNCTION(glUniform1uiv, void, (GLint location, GLsizei count, const GLuint *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform2uiv, void, (GLint location, GLsizei count, const GLuint *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform3uiv, void, (GLint location, GLsizei count, const GLuint *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform4uiv, void, (GLint location, GLsizei count, const GLuint *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glTexParameterIiv, void, (GLenum target, GLenum pname, const GLint *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glTexParameterIuiv, void, (GLenum target, GLenum pname, const GLuint *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetTexParameterIiv, void, (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetTexParameterIuiv, void, (GLenum target, GLenum pname, GLuint *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glClearBufferiv, void, (GLenum buffer, GLint drawbuffer, const GLint *value), (buffer, drawbuffer, value)) \
+	SPARKY_GL_FUNCTION(glClearBufferuiv, void, (GLenum buffer, GLint drawbuffer, const GLuint *value), (buffer, drawbuffer, value)) \
+	SPARKY_GL_FUNCTION(glClearBufferfv, void, (GLenum buffer, GLint drawbuffer, const GLfloat *value), (buffer, drawbuffer, value)) \
+	SPARKY_GL_FUNCTION(glClearBufferfi, void, (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil), (buffer, drawbuffer, depth, stencil)) \
+	SPARKY_GL_FUNCTION(glGetStringi, const GLubyte *, (GLenum name, GLuint index), (name, index)) \
+	SPARKY_GL_FUNCTION(glIsRenderbuffer, GLboolean, (GLuint renderbuffer), (renderbuffer)) \
+	SPARKY_GL_FUNCTION(glBindRenderbuffer, void, (GLenum target, GLuint renderbuffer), (target, renderbuffer)) \
+	SPARKY_GL_FUNCTION(glDeleteRenderbuffers, void, (GLsizei n, const GLuint *renderbuffers), (n, renderbuffers)) \
+	SPARKY_GL_FUNCTION(glGenRenderbuffers, void, (GLsizei n, GLuint *renderbuffers), (n, renderbuffers)) \
+	SPARKY_GL_FUNCTION(glRenderbufferStorage, void, (GLenum target, GLenum internalformat, GLsizei width, GLsizei height), (target, internalformat, width, height)) \
+	SPARKY_GL_FUNCTION(glGetRenderbufferParameteriv, void, (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glIsFramebuffer, GLboolean, (GLuint framebuffer), (framebuffer)) \
+	SPARKY_GL_FUNCTION(glBindFramebuffer, void, (GLenum target, GLuint framebuffer), (target, framebuffer)) \
+	SPARKY_GL_FUNCTION(glDeleteFramebuffers, void, (GLsizei n, const GLuint *framebuffers), (n, framebuffers)) \
+	SPARKY_GL_FUNCTION(glGenFramebuffers, void, (GLsizei n, GLuint *framebuffers), (n, framebuffers)) \
+	SPARKY_GL_FUNCTION(glCheckFramebufferStatus, GLenum, (GLenum target), (target)) \
+	SPARKY_GL_FUNCTION(glFramebufferTexture1D, void, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level)) \
+	SPARKY_GL_FUNCTION(glFramebufferTexture2D, void, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level)) \
+	SPARKY_GL_FUNCTION(glFramebufferTexture3D, void, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset), (target, attachment, textarget, texture, level, zoffset)) \
+	SPARKY_GL_FUNCTION(glFramebufferRenderbuffer, void, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), (target, attachment, renderbuffertarget, renderbuffer)) \
+	SPARKY_GL_FUNCTION(glGetFramebufferAttachmentParameteriv, void, (GLenum target, GLenum attachment, GLenum pname, GLint *params), (target, attachment, pname, params)) \
+	SPARKY_GL_FUNCTION(glGenerateMipmap, void, (GLenum target), (target)) \
+	SPARKY_GL_FUNCTION(glBlitFramebuffer, void, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter), (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter)) \
+	SPARKY_GL_FUNCTION(glRenderbufferStorageMultisample, void, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height), (target, samples, internalformat, width, height)) \
+	SPARKY_GL_FUNCTION(glFramebufferTextureLayer, void, (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer), (target, attachment, texture, level, layer)) \
+	SPARKY_GL_FUNCTION(glMapBufferRange, void *, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access), (target, offset, length, access)) \
+	SPARKY_GL_FUNCTION(glFlushMappedBufferRange, void, (GLenum target, GLintptr offset, GLsizeiptr length), (target, offset, length)) \
+	SPARKY_GL_FUNCTION(glBindVertexArray, void, (GLuint array), (array)) \
+	SPARKY_GL_FUNCTION(glDeleteVertexArrays, void, (GLsizei n, const GLuint *arrays), (n, arrays)) \
+	SPARKY_GL_FUNCTION(glGenVertexArrays, void, (GLsizei n, GLuint *arrays), (n, arrays)) \
+	SPARKY_GL_FUNCTION(glIsVertexArray, GLboolean, (GLuint array), (array)) \
+	SPARKY_GL_FUNCTION(glDrawArraysInstanced, void, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount), (mode, first, count, instancecount)) \
+	SPARKY_GL_FUNCTION(glDrawElementsInstanced, void, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount), (mode, count, type, indices, instancecount)) \
+	SPARKY_GL_FUNCTION(glTexBuffer, void, (GLenum target, GLenum internalformat, GLuint buffer), (target, internalformat, buffer)) \
+	SPARKY_GL_FUNCTION(glPrimitiveRestartIndex, void, (GLuint index), (index)) \
+	SPARKY_GL_FUNCTION(glCopyBufferSubData, void, (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readTarget, writeTarget, readOffset, writeOffset, size)) \
+	SPARKY_GL_FUNCTION(glGetUniformIndices, void, (GLuint program, GLsizei uniformCount, const GLchar *const*uniformNames, GLuint *uniformIndices), (program, uniformCount, uniformNames, uniformIndices)) \
+	SPARKY_GL_FUNCTION(glGetActiveUniformsiv, void, (GLuint program, GLsizei uniformCount, const GLuint *uniformIndices, GLenum pname, GLint *params), (program, uniformCount, uniformIndices, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetActiveUniformName, void, (GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformName), (program, uniformIndex, bufSize, length, uniformName)) \
+	SPARKY_GL_FUNCTION(glGetUniformBlockIndex, GLuint, (GLuint program, const GLchar *uniformBlockName), (program, uniformBlockName)) \
+	SPARKY_GL_FUNCTION(glGetActiveUniformBlockiv, void, (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params), (program, uniformBlockIndex, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetActiveUniformBlockName, void, (GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName), (program, uniformBlockIndex, bufSize, length, uniformBlockName)) \
+	SPARKY_GL_FUNCTION(glUniformBlockBinding, void, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding), (program, uniformBlockIndex, uniformBlockBinding)) \
+	SPARKY_GL_FUNCTION(glDrawElementsBaseVertex, void, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex), (mode, count, type, indices, basevertex)) \
+	SPARKY_GL_FUNCTION(glDrawRangeElementsBaseVertex, void, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices, GLint basevertex), (mode, start, end, count, type, indices, basevertex)) \
+	SPARKY_GL_FUNCTION(glDrawElementsInstancedBaseVertex, void, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex), (mode, count, type, indices, instancecount, basevertex)) \
+	SPARKY_GL_FUNCTION(glMultiDrawElementsBaseVertex, void, (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount, const GLint *basevertex), (mode, count, type, indices, drawcount, basevertex)) \
+	SPARKY_GL_FUNCTION(glProvokingVertex, void, (GLenum mode), (mode)) \
+	SPARKY_GL_FUNCTION(glFenceSync, GLsync, (GLenum condition, GLbitfield flags), (condition, flags)) \
+	SPARKY_GL_FUNCTION(glIsSync, GLboolean, (GLsync sync), (sync)) \
+	SPARKY_GL_FUNCTION(glDeleteSync, void, (GLsync sync), (sync)) \
+	SPARKY_GL_FUNCTION(glClientWaitSync, GLenum, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout)) \
+	SPARKY_GL_FUNCTION(glWaitSync, void, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout)) \
+	SPARKY_GL_FUNCTION(glGetInteger64v, void, (GLenum pname, GLint64 *data), (pname, data)) \
+	SPARKY_GL_FUNCTION(glGetSynciv, void, (GLsync sync, GLenum pname, GLsizei bufSize, GLsizei *length, GLint *values), (sync, pname, bufSize, length, values)) \
+	SPARKY_GL_FUNCTION(glGetInteger64i_v, void, (GLenum target, GLuint index, GLint64 *data), (target, index, data)) \
+	SPARKY_GL_FUNCTION(glGetBufferParameteri64v, void, (GLenum target, GLenum pname, GLint64 *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glFramebufferTexture, void, (GLenum target, GLenum attachment, GLuint texture, GLint level), (target, attachment, texture, level)) \
+	SPARKY_GL_FUNCTION(glTexImage2DMultisample, void, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, fixedsamplelocations)) \
+	SPARKY_GL_FUNCTION(glTexImage3DMultisample, void, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, depth, fixedsamplelocations)) \
+	SPARKY_GL_FUNCTION(glGetMultisamplefv, void, (GLenum pname, GLuint index, GLfloat *val), (pname, index, val)) \
+	SPARKY_GL_FUNCTION(glSampleMaski, void, (GLuint maskNumber, GLbitfield mask), (maskNumber, mask)) \
+	SPARKY_GL_FUNCTION(glBindFragDataLocationIndexed, void, (GLuint program, GLuint colorNumber, GLuint index, const GLchar *name), (program, colorNumber, index, name)) \
+	SPARKY_GL_FUNCTION(glGetFragDataIndex, GLint, (GLuint program, const GLchar *name), (program, name)) \
+	SPARKY_GL_FUNCTION(glGenSamplers, void, (GLsizei count, GLuint *samplers), (count, samplers)) \
+	SPARKY_GL_FUNCTION(glDeleteSamplers, void, (GLsizei count, const GLuint *samplers), (count, samplers)) \
+	SPARKY_GL_FUNCTION(glIsSampler, GLboolean, (GLuint sampler), (sampler)) \
+	SPARKY_GL_FUNCTION(glBindSampler, void, (GLuint unit, GLuint sampler), (unit, sampler)) \
+	SPARKY_GL_FUNCTION(glSamplerParameteri, void, (GLuint sampler, GLenum pname, GLint param), (sampler, pname, param)) \
+	SPARKY_GL_FUNCTION(glSamplerParameteriv, void, (GLuint sampler, GLenum pname, const GLint *param), (sampler, pname, param)) \
+	SPARKY_GL_FUNCTION(glSamplerParameterf, void, (GLuint sampler, GLenum pname, GLfloat param), (sampler, pname, param)) \
+	SPARKY_GL_FUNCTION(glSamplerParameterfv, void, (GLuint sampler, GLenum pname, const GLfloat *param), (sampler, pname, param)) \
+	SPARKY_GL_FUNCTION(glSamplerParameterIiv, void, (GLuint sampler, GLenum pname, const GLint *param), (sampler, pname, param)) \
+	SPARKY_GL_FUNCTION(glSamplerParameterIuiv, void, (GLuint sampler, GLenum pname, const GLuint *param), (sampler, pname, param)) \
+	SPARKY_GL_FUNCTION(glGetSamplerParameteriv, void, (GLuint sampler, GLenum pname, GLint *params), (sampler, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetSamplerParameterIiv, void, (GLuint sampler, GLenum pname, GLint *params), (sampler, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetSamplerParameterfv, void, (GLuint sampler, GLenum pname, GLfloat *params), (sampler, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetSamplerParameterIuiv, void, (GLuint sampler, GLenum pname, GLuint *params), (sampler, pname, params)) \
+	SPARKY_GL_FUNCTION(glQueryCounter, void, (GLuint id, GLenum target), (id, target)) \
+	SPARKY_GL_FUNCTION(glGetQueryObjecti64v, void, (GLuint id, GLenum pname, GLint64 *params), (id, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetQueryObjectui64v, void, (GLuint id, GLenum pname, GLuint64 *params), (id, pname, params)) \
+	SPARKY_GL_FUNCTION(glVertexAttribDivisor, void, (GLuint index, GLuint divisor), (index, divisor)) \
+	SPARKY_GL_FUNCTION(glVertexAttribP1ui, void, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value)) \
+	SPARKY_GL_FUNCTION(glVertexAttribP1uiv, void, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value)) \
+	SPARKY_GL_FUNCTION(glVertexAttribP2ui, void, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value)) \
+	SPARKY_GL_FUNCTION(glVertexAttribP2uiv, void, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value)) \
+	SPARKY_GL_FUNCTION(glVertexAttribP3ui, void, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value)) \
+	SPARKY_GL_FUNCTION(glVertexAttribP3uiv, void, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value)) \
+	SPARKY_GL_FUNCTION(glVertexAttribP4ui, void, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value)) \
+	SPARKY_GL_FUNCTION(glVertexAttribP4uiv, void, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value)) \
+	SPARKY_GL_FUNCTION(glVertexP2ui, void, (GLenum type, GLuint value), (type, value)) \
+	SPARKY_GL_FUNCTION(glVertexP2uiv, void, (GLenum type, const GLuint *value), (type, value)) \
+	SPARKY_GL_FUNCTION(glVertexP3ui, void, (GLenum type, GLuint value), (type, value)) \
+	SPARKY_GL_FUNCTION(glVertexP3uiv, void, (GLenum type, const GLuint *value), (type, value)) \
+	SPARKY_GL_FUNCTION(glVertexP4ui, void, (GLenum type, GLuint value), (type, value)) \
+	SPARKY_GL_FUNCTION(glVertexP4uiv, void, (GLenum type, const GLuint *value), (type, value)) \
+	SPARKY_GL_FUNCTION(glTexCoordP1ui, void, (GLenum type, GLuint coords), (type, coords)) \
+	SPARKY_GL_FUNCTION(glTexCoordP1uiv, void, (GLenum type, const GLuint *coords), (type, coords)) \
+	SPARKY_GL_FUNCTION(glTexCoordP2ui, void, (GLenum type, GLuint coords), (type, coords)) \
+	SPARKY_GL_FUNCTION(glTexCoordP2uiv, void, (GLenum type, const GLuint *coords), (type, coords)) \
+	SPARKY_GL_FUNCTION(glTexCoordP3ui, void, (GLenum type, GLuint coords), (type, coords)) \
+	SPARKY_GL_FUNCTION(glTexCoordP3uiv, void, (GLenum type, const GLuint *coords), (type, coords)) \
+	SPARKY_GL_FUNCTION(glTexCoordP4ui, void, (GLenum type, GLuint coords), (type, coords)) \
+	SPARKY_GL_FUNCTION(glTexCoordP4uiv, void, (GLenum type, const GLuint *coords), (type, coords)) \
+	SPARKY_GL_FUNCTION(glMultiTexCoordP1ui, void, (GLenum texture, GLenum type, GLuint coords), (texture, type, coords)) \
+	SPARKY_GL_FUNCTION(glMultiTexCoordP1uiv, void, (GLenum texture, GLenum type, const GLuint *coords), (texture, type, coords)) \
+	SPARKY_GL_FUNCTION(glMultiTexCoordP2ui, void, (GLenum texture, GLenum type, GLuint coords), (texture, type, coords)) \
+	SPARKY_GL_FUNCTION(glMultiTexCoordP2uiv, void, (GLenum texture, GLenum type, const GLuint *coords), (texture, type, coords)) \
+	SPARKY_GL_FUNCTION(glMultiTexCoordP3ui, void, (GLenum texture, GLenum type, GLuint coords), (texture, type, coords)) \
+	SPARKY_GL_FUNCTION(glMultiTexCoordP3uiv, void, (GLenum texture, GLenum type, const GLuint *coords), (texture, type, coords)) \
+	SPARKY_GL_FUNCTION(glMultiTexCoordP4ui, void, (GLenum texture, GLenum type, GLuint coords), (texture, type, coords)) \
+	SPARKY_GL_FUNCTION(glMultiTexCoordP4uiv, void, (GLenum texture, GLenum type, const GLuint *coords), (texture, type, coords)) \
+	SPARKY_GL_FUNCTION(glNormalP3ui, void, (GLenum type, GLuint coords), (type, coords)) \
+	SPARKY_GL_FUNCTION(glNormalP3uiv, void, (GLenum type, const GLuint *coords), (type, coords)) \
+	SPARKY_GL_FUNCTION(glColorP3ui, void, (GLenum type, GLuint color), (type, color)) \
+	SPARKY_GL_FUNCTION(glColorP3uiv, void, (GLenum type, const GLuint *color), (type, color)) \
+	SPARKY_GL_FUNCTION(glColorP4ui, void, (GLenum type, GLuint color), (type, color)) \
+	SPARKY_GL_FUNCTION(glColorP4uiv, void, (GLenum type, const GLuint *color), (type, color)) \
+	SPARKY_GL_FUNCTION(glSecondaryColorP3ui, void, (GLenum type, GLuint color), (type, color)) \
+	SPARKY_GL_FUNCTION(glSecondaryColorP3uiv, void, (GLenum type, const GLuint *color), (type, color)) \
+	SPARKY_GL_FUNCTION(glMinSampleShading, void, (GLfloat value), (value)) \
+	SPARKY_GL_FUNCTION(glBlendEquationi, void, (GLuint buf, GLenum mode), (buf, mode)) \
+	SPARKY_GL_FUNCTION(glBlendEquationSeparatei, void, (GLuint buf, GLenum modeRGB, GLenum modeAlpha), (buf, modeRGB, modeAlpha)) \
+	SPARKY_GL_FUNCTION(glBlendFunci, void, (GLuint buf, GLenum src, GLenum dst), (buf, src, dst)) \
+	SPARKY_GL_FUNCTION(glBlendFuncSeparatei, void, (GLuint buf, GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha), (buf, srcRGB, dstRGB, srcAlpha, dstAlpha)) \
+	SPARKY_GL_FUNCTION(glDrawArraysIndirect, void, (GLenum mode, const void *indirect), (mode, indirect)) \
+	SPARKY_GL_FUNCTION(glDrawElementsIndirect, void, (GLenum mode, GLenum type, const void *indirect), (mode, type, indirect)) \
+	SPARKY_GL_FUNCTION(glUniform1d, void, (GLint location, GLdouble x), (location, x)) \
+	SPARKY_GL_FUNCTION(glUniform2d, void, (GLint location, GLdouble x, GLdouble y), (location, x, y)) \
+	SPARKY_GL_FUNCTION(glUniform3d, void, (GLint location, GLdouble x, GLdouble y, GLdouble z), (location, x, y, z)) \
+	SPARKY_GL_FUNCTION(glUniform4d, void, (GLint location, GLdouble x, GLdouble y, GLdouble z, GLdouble w), (location, x, y, z, w)) \
+	SPARKY_GL_FUNCTION(glUniform1dv, void, (GLint location, GLsizei count, const GLdouble *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform2dv, void, (GLint location, GLsizei count, const GLdouble *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform3dv, void, (GLint location, GLsizei count, const GLdouble *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniform4dv, void, (GLint location, GLsizei count, const GLdouble *value), (location, count, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix2dv, void, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix3dv, void, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix4dv, void, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix2x3dv, void, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix2x4dv, void, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix3x2dv, void, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix3x4dv, void, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix4x2dv, void, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glUniformMatrix4x3dv, void, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glGetUniformdv, void, (GLuint program, GLint location, GLdouble *params), (program, location, params)) \
+	SPARKY_GL_FUNCTION(glGetSubroutineUniformLocation, GLint, (GLuint program, GLenum shadertype, const GLchar *name), (program, shadertype, name)) \
+	SPARKY_GL_FUNCTION(glGetSubroutineIndex, GLuint, (GLuint program, GLenum shadertype, const GLchar *name), (program, shadertype, name)) \
+	SPARKY_GL_FUNCTION(glGetActiveSubroutineUniformiv, void, (GLuint program, GLenum shadertype, GLuint index, GLenum pname, GLint *values), (program, shadertype, index, pname, values)) \
+	SPARKY_GL_FUNCTION(glGetActiveSubroutineUniformName, void, (GLuint program, GLenum shadertype, GLuint index, GLsizei bufsize, GLsizei *length, GLchar *name), (program, shadertype, index, bufsize, length, name)) \
+	SPARKY_GL_FUNCTION(glGetActiveSubroutineName, void, (GLuint program, GLenum shadertype, GLuint index, GLsizei bufsize, GLsizei *length, GLchar *name), (program, shadertype, index, bufsize, length, name)) \
+	SPARKY_GL_FUNCTION(glUniformSubroutinesuiv, void, (GLenum shadertype, GLsizei count, const GLuint *indices), (shadertype, count, indices)) \
+	SPARKY_GL_FUNCTION(glGetUniformSubroutineuiv, void, (GLenum shadertype, GLint location, GLuint *params), (shadertype, location, params)) \
+	SPARKY_GL_FUNCTION(glGetProgramStageiv, void, (GLuint program, GLenum shadertype, GLenum pname, GLint *values), (program, shadertype, pname, values)) \
+	SPARKY_GL_FUNCTION(glPatchParameteri, void, (GLenum pname, GLint value), (pname, value)) \
+	SPARKY_GL_FUNCTION(glPatchParameterfv, void, (GLenum pname, const GLfloat *values), (pname, values)) \
+	SPARKY_GL_FUNCTION(glBindTransformFeedback, void, (GLenum target, GLuint id), (target, id)) \
+	SPARKY_GL_FUNCTION(glDeleteTransformFeedbacks, void, (GLsizei n, const GLuint *ids), (n, ids)) \
+	SPARKY_GL_FUNCTION(glGenTransformFeedbacks, void, (GLsizei n, GLuint *ids), (n, ids)) \
+	SPARKY_GL_FUNCTION(glIsTransformFeedback, GLboolean, (GLuint id), (id)) \
+	SPARKY_GL_FUNCTION(glPauseTransformFeedback, void, (), ()) \
+	SPARKY_GL_FUNCTION(glResumeTransformFeedback, void, (), ()) \
+	SPARKY_GL_FUNCTION(glDrawTransformFeedback, void, (GLenum mode, GLuint id), (mode, id)) \
+	SPARKY_GL_FUNCTION(glDrawTransformFeedbackStream, void, (GLenum mode, GLuint id, GLuint stream), (mode, id, stream)) \
+	SPARKY_GL_FUNCTION(glBeginQueryIndexed, void, (GLenum target, GLuint index, GLuint id), (target, index, id)) \
+	SPARKY_GL_FUNCTION(glEndQueryIndexed, void, (GLenum target, GLuint index), (target, index)) \
+	SPARKY_GL_FUNCTION(glGetQueryIndexediv, void, (GLenum target, GLuint index, GLenum pname, GLint *params), (target, index, pname, params)) \
+	SPARKY_GL_FUNCTION(glReleaseShaderCompiler, void, (), ()) \
+	SPARKY_GL_FUNCTION(glShaderBinary, void, (GLsizei count, const GLuint *shaders, GLenum binaryformat, const void *binary, GLsizei length), (count, shaders, binaryformat, binary, length)) \
+	SPARKY_GL_FUNCTION(glGetShaderPrecisionFormat, void, (GLenum shadertype, GLenum precisiontype, GLint *range, GLint *precision), (shadertype, precisiontype, range, precision)) \
+	SPARKY_GL_FUNCTION(glDepthRangef, void, (GLfloat n, GLfloat f), (n, f)) \
+	SPARKY_GL_FUNCTION(glClearDepthf, void, (GLfloat d), (d)) \
+	SPARKY_GL_FUNCTION(glGetProgramBinary, void, (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary), (program, bufSize, length, binaryFormat, binary)) \
+	SPARKY_GL_FUNCTION(glProgramBinary, void, (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length), (program, binaryFormat, binary, length)) \
+	SPARKY_GL_FUNCTION(glProgramParameteri, void, (GLuint program, GLenum pname, GLint value), (program, pname, value)) \
+	SPARKY_GL_FUNCTION(glUseProgramStages, void, (GLuint pipeline, GLbitfield stages, GLuint program), (pipeline, stages, program)) \
+	SPARKY_GL_FUNCTION(glActiveShaderProgram, void, (GLuint pipeline, GLuint program), (pipeline, program)) \
+	SPARKY_GL_FUNCTION(glCreateShaderProgramv, GLuint, (GLenum type, GLsizei count, const GLchar *const*strings), (type, count, strings)) \
+	SPARKY_GL_FUNCTION(glBindProgramPipeline, void, (GLuint pipeline), (pipeline)) \
+	SPARKY_GL_FUNCTION(glDeleteProgramPipelines, void, (GLsizei n, const GLuint *pipelines), (n, pipelines)) \
+	SPARKY_GL_FUNCTION(glGenProgramPipelines, void, (GLsizei n, GLuint *pipelines), (n, pipelines)) \
+	SPARKY_GL_FUNCTION(glIsProgramPipeline, GLboolean, (GLuint pipeline), (pipeline)) \
+	SPARKY_GL_FUNCTION(glGetProgramPipelineiv, void, (GLuint pipeline, GLenum pname, GLint *params), (pipeline, pname, params)) \
+	SPARKY_GL_FUNCTION(glProgramUniform1i, void, (GLuint program, GLint location, GLint v0), (program, location, v0)) \
+	SPARKY_GL_FUNCTION(glProgramUniform1iv, void, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform1f, void, (GLuint program, GLint location, GLfloat v0), (program, location, v0)) \
+	SPARKY_GL_FUNCTION(glProgramUniform1fv, void, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform1d, void, (GLuint program, GLint location, GLdouble v0), (program, location, v0)) \
+	SPARKY_GL_FUNCTION(glProgramUniform1dv, void, (GLuint program, GLint location, GLsizei count, const GLdouble *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform1ui, void, (GLuint program, GLint location, GLuint v0), (program, location, v0)) \
+	SPARKY_GL_FUNCTION(glProgramUniform1uiv, void, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform2i, void, (GLuint program, GLint location, GLint v0, GLint v1), (program, location, v0, v1)) \
+	SPARKY_GL_FUNCTION(glProgramUniform2iv, void, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform2f, void, (GLuint program, GLint location, GLfloat v0, GLfloat v1), (program, location, v0, v1)) \
+	SPARKY_GL_FUNCTION(glProgramUniform2fv, void, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform2d, void, (GLuint program, GLint location, GLdouble v0, GLdouble v1), (program, location, v0, v1)) \
+	SPARKY_GL_FUNCTION(glProgramUniform2dv, void, (GLuint program, GLint location, GLsizei count, const GLdouble *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform2ui, void, (GLuint program, GLint location, GLuint v0, GLuint v1), (program, location, v0, v1)) \
+	SPARKY_GL_FUNCTION(glProgramUniform2uiv, void, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform3i, void, (GLuint program, GLint location, GLint v0, GLint v1, GLint v2), (program, location, v0, v1, v2)) \
+	SPARKY_GL_FUNCTION(glProgramUniform3iv, void, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform3f, void, (GLuint program, GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (program, location, v0, v1, v2)) \
+	SPARKY_GL_FUNCTION(glProgramUniform3fv, void, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform3d, void, (GLuint program, GLint location, GLdouble v0, GLdouble v1, GLdouble v2), (program, location, v0, v1, v2)) \
+	SPARKY_GL_FUNCTION(glProgramUniform3dv, void, (GLuint program, GLint location, GLsizei count, const GLdouble *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform3ui, void, (GLuint program, GLint location, GLuint v0, GLuint v1, GLuint v2), (program, location, v0, v1, v2)) \
+	SPARKY_GL_FUNCTION(glProgramUniform3uiv, void, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform4i, void, (GLuint program, GLint location, GLint v0, GLint v1, GLint v2, GLint v3), (program, location, v0, v1, v2, v3)) \
+	SPARKY_GL_FUNCTION(glProgramUniform4iv, void, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform4f, void, (GLuint program, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (program, location, v0, v1, v2, v3)) \
+	SPARKY_GL_FUNCTION(glProgramUniform4fv, void, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform4d, void, (GLuint program, GLint location, GLdouble v0, GLdouble v1, GLdouble v2, GLdouble v3), (program, location, v0, v1, v2, v3)) \
+	SPARKY_GL_FUNCTION(glProgramUniform4dv, void, (GLuint program, GLint location, GLsizei count, const GLdouble *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniform4ui, void, (GLuint program, GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3), (program, location, v0, v1, v2, v3)) \
+	SPARKY_GL_FUNCTION(glProgramUniform4uiv, void, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix2fv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix3fv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix4fv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix2dv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix3dv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix4dv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix2x3fv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix3x2fv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix2x4fv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix4x2fv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix3x4fv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix4x3fv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix2x3dv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix3x2dv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix2x4dv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix4x2dv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix3x4dv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glProgramUniformMatrix4x3dv, void, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value)) \
+	SPARKY_GL_FUNCTION(glValidateProgramPipeline, void, (GLuint pipeline), (pipeline)) \
+	SPARKY_GL_FUNCTION(glGetProgramPipelineInfoLog, void, (GLuint pipeline, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (pipeline, bufSize, length, infoLog)) \
+	SPARKY_GL_FUNCTION(glVertexAttribL1d, void, (GLuint index, GLdouble x), (index, x)) \
+	SPARKY_GL_FUNCTION(glVertexAttribL2d, void, (GLuint index, GLdouble x, GLdouble y), (index, x, y)) \
+	SPARKY_GL_FUNCTION(glVertexAttribL3d, void, (GLuint index, GLdouble x, GLdouble y, GLdouble z), (index, x, y, z)) \
+	SPARKY_GL_FUNCTION(glVertexAttribL4d, void, (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w), (index, x, y, z, w)) \
+	SPARKY_GL_FUNCTION(glVertexAttribL1dv, void, (GLuint index, const GLdouble *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribL2dv, void, (GLuint index, const GLdouble *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribL3dv, void, (GLuint index, const GLdouble *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribL4dv, void, (GLuint index, const GLdouble *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glVertexAttribLPointer, void, (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer), (index, size, type, stride, pointer)) \
+	SPARKY_GL_FUNCTION(glGetVertexAttribLdv, void, (GLuint index, GLenum pname, GLdouble *params), (index, pname, params)) \
+	SPARKY_GL_FUNCTION(glViewportArrayv, void, (GLuint first, GLsizei count, const GLfloat *v), (first, count, v)) \
+	SPARKY_GL_FUNCTION(glViewportIndexedf, void, (GLuint index, GLfloat x, GLfloat y, GLfloat w, GLfloat h), (index, x, y, w, h)) \
+	SPARKY_GL_FUNCTION(glViewportIndexedfv, void, (GLuint index, const GLfloat *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glScissorArrayv, void, (GLuint first, GLsizei count, const GLint *v), (first, count, v)) \
+	SPARKY_GL_FUNCTION(glScissorIndexed, void, (GLuint index, GLint left, GLint bottom, GLsizei width, GLsizei height), (index, left, bottom, width, height)) \
+	SPARKY_GL_FUNCTION(glScissorIndexedv, void, (GLuint index, const GLint *v), (index, v)) \
+	SPARKY_GL_FUNCTION(glDepthRangeArrayv, void, (GLuint first, GLsizei count, const GLdouble *v), (first, count, v)) \
+	SPARKY_GL_FUNCTION(glDepthRangeIndexed, void, (GLuint index, GLdouble n, GLdouble f), (index, n, f)) \
+	SPARKY_GL_FUNCTION(glGetFloati_v, void, (GLenum target, GLuint index, GLfloat *data), (target, index, data)) \
+	SPARKY_GL_FUNCTION(glGetDoublei_v, void, (GLenum target, GLuint index, GLdouble *data), (target, index, data)) \
+	SPARKY_GL_FUNCTION(glDrawArraysInstancedBaseInstance, void, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount, GLuint baseinstance), (mode, first, count, instancecount, baseinstance)) \
+	SPARKY_GL_FUNCTION(glDrawElementsInstancedBaseInstance, void, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLuint baseinstance), (mode, count, type, indices, instancecount, baseinstance)) \
+	SPARKY_GL_FUNCTION(glDrawElementsInstancedBaseVertexBaseInstance, void, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex, GLuint baseinstance), (mode, count, type, indices, instancecount, basevertex, baseinstance)) \
+	SPARKY_GL_FUNCTION(glGetInternalformativ, void, (GLenum target, GLenum internalformat, GLenum pname, GLsizei bufSize, GLint *params), (target, internalformat, pname, bufSize, params)) \
+	SPARKY_GL_FUNCTION(glGetActiveAtomicCounterBufferiv, void, (GLuint program, GLuint bufferIndex, GLenum pname, GLint *params), (program, bufferIndex, pname, params)) \
+	SPARKY_GL_FUNCTION(glBindImageTexture, void, (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format), (unit, texture, level, layered, layer, access, format)) \
+	SPARKY_GL_FUNCTION(glMemoryBarrier, void, (GLbitfield barriers), (barriers)) \
+	SPARKY_GL_FUNCTION(glTexStorage1D, void, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width), (target, levels, internalformat, width)) \
+	SPARKY_GL_FUNCTION(glTexStorage2D, void, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height), (target, levels, internalformat, width, height)) \
+	SPARKY_GL_FUNCTION(glTexStorage3D, void, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth), (target, levels, internalformat, width, height, depth)) \
+	SPARKY_GL_FUNCTION(glDrawTransformFeedbackInstanced, void, (GLenum mode, GLuint id, GLsizei instancecount), (mode, id, instancecount)) \
+	SPARKY_GL_FUNCTION(glDrawTransformFeedbackStreamInstanced, void, (GLenum mode, GLuint id, GLuint stream, GLsizei instancecount), (mode, id, stream, instancecount)) \
+	SPARKY_GL_FUNCTION(glClearBufferData, void, (GLenum target, GLenum internalformat, GLenum format, GLenum type, const void *data), (target, internalformat, format, type, data)) \
+	SPARKY_GL_FUNCTION(glClearBufferSubData, void, (GLenum target, GLenum internalformat, GLintptr offset, GLsizeiptr size, GLenum format, GLenum type, const void *data), (target, internalformat, offset, size, format, type, data)) \
+	SPARKY_GL_FUNCTION(glDispatchCompute, void, (GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z), (num_groups_x, num_groups_y, num_groups_z)) \
+	SPARKY_GL_FUNCTION(glDispatchComputeIndirect, void, (GLintptr indirect), (indirect)) \
+	SPARKY_GL_FUNCTION(glCopyImageSubData, void, (GLuint srcName, GLenum srcTarget, GLint srcLevel, GLint srcX, GLint srcY, GLint srcZ, GLuint dstName, GLenum dstTarget, GLint dstLevel, GLint dstX, GLint dstY, GLint dstZ, GLsizei srcWidth, GLsizei srcHeight, GLsizei srcDepth), (srcName, srcTarget, srcLevel, srcX, srcY, srcZ, dstName, dstTarget, dstLevel, dstX, dstY, dstZ, srcWidth, srcHeight, srcDepth)) \
+	SPARKY_GL_FUNCTION(glFramebufferParameteri, void, (GLenum target, GLenum pname, GLint param), (target, pname, param)) \
+	SPARKY_GL_FUNCTION(glGetFramebufferParameteriv, void, (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetInternalformati64v, void, (GLenum target, GLenum internalformat, GLenum pname, GLsizei bufSize, GLint64 *params), (target, internalformat, pname, bufSize, params)) \
+	SPARKY_GL_FUNCTION(glInvalidateTexSubImage, void, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth), (texture, level, xoffset, yoffset, zoffset, width, height, depth)) \
+	SPARKY_GL_FUNCTION(glInvalidateTexImage, void, (GLuint texture, GLint level), (texture, level)) \
+	SPARKY_GL_FUNCTION(glInvalidateBufferSubData, void, (GLuint buffer, GLintptr offset, GLsizeiptr length), (buffer, offset, length)) \
+	SPARKY_GL_FUNCTION(glInvalidateBufferData, void, (GLuint buffer), (buffer)) \
+	SPARKY_GL_FUNCTION(glInvalidateFramebuffer, void, (GLenum target, GLsizei numAttachments, const GLenum *attachments), (target, numAttachments, attachments)) \
+	SPARKY_GL_FUNCTION(glInvalidateSubFramebuffer, void, (GLenum target, GLsizei numAttachments, const GLenum *attachments, GLint x, GLint y, GLsizei width, GLsizei height), (target, numAttachments, attachments, x, y, width, height)) \
+	SPARKY_GL_FUNCTION(glMultiDrawArraysIndirect, void, (GLenum mode, const void *indirect, GLsizei drawcount, GLsizei stride), (mode, indirect, drawcount, stride)) \
+	SPARKY_GL_FUNCTION(glMultiDrawElementsIndirect, void, (GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride), (mode, type, indirect, drawcount, stride)) \
+	SPARKY_GL_FUNCTION(glGetProgramInterfaceiv, void, (GLuint program, GLenum programInterface, GLenum pname, GLint *params), (program, programInterface, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetProgramResourceIndex, GLuint, (GLuint program, GLenum programInterface, const GLchar *name), (program, programInterface, name)) \
+	SPARKY_GL_FUNCTION(glGetProgramResourceName, void, (GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize, GLsizei *length, GLchar *name), (program, programInterface, index, bufSize, length, name)) \
+	SPARKY_GL_FUNCTION(glGetProgramResourceiv, void, (GLuint program, GLenum programInterface, GLuint index, GLsizei propCount, const GLenum *props, GLsizei bufSize, GLsizei *length, GLint *params), (program, programInterface, index, propCount, props, bufSize, length, params)) \
+	SPARKY_GL_FUNCTION(glGetProgramResourceLocation, GLint, (GLuint program, GLenum programInterface, const GLchar *name), (program, programInterface, name)) \
+	SPARKY_GL_FUNCTION(glGetProgramResourceLocationIndex, GLint, (GLuint program, GLenum programInterface, const GLchar *name), (program, programInterface, name)) \
+	SPARKY_GL_FUNCTION(glShaderStorageBlockBinding, void, (GLuint program, GLuint storageBlockIndex, GLuint storageBlockBinding), (program, storageBlockIndex, storageBlockBinding)) \
+	SPARKY_GL_FUNCTION(glTexBufferRange, void, (GLenum target, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, internalformat, buffer, offset, size)) \
+	SPARKY_GL_FUNCTION(glTexStorage2DMultisample, void, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, fixedsamplelocations)) \
+	SPARKY_GL_FUNCTION(glTexStorage3DMultisample, void, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, depth, fixedsamplelocations)) \
+	SPARKY_GL_FUNCTION(glTextureView, void, (GLuint texture, GLenum target, GLuint origtexture, GLenum internalformat, GLuint minlevel, GLuint numlevels, GLuint minlayer, GLuint numlayers), (texture, target, origtexture, internalformat, minlevel, numlevels, minlayer, numlayers)) \
+	SPARKY_GL_FUNCTION(glBindVertexBuffer, void, (GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride), (bindingindex, buffer, offset, stride)) \
+	SPARKY_GL_FUNCTION(glVertexAttribFormat, void, (GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset), (attribindex, size, type, normalized, relativeoffset)) \
+	SPARKY_GL_FUNCTION(glVertexAttribIFormat, void, (GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset), (attribindex, size, type, relativeoffset)) \
+	SPARKY_GL_FUNCTION(glVertexAttribLFormat, void, (GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset), (attribindex, size, type, relativeoffset)) \
+	SPARKY_GL_FUNCTION(glVertexAttribBinding, void, (GLuint attribindex, GLuint bindingindex), (attribindex, bindingindex)) \
+	SPARKY_GL_FUNCTION(glVertexBindingDivisor, void, (GLuint bindingindex, GLuint divisor), (bindingindex, divisor)) \
+	SPARKY_GL_FUNCTION(glDebugMessageControl, void, (GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled), (source, type, severity, count, ids, enabled)) \
+	SPARKY_GL_FUNCTION(glDebugMessageInsert, void, (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *buf), (source, type, id, severity, length, buf)) \
+	SPARKY_GL_FUNCTION(glDebugMessageCallback, void, (GLDEBUGPROC callback, const void *userParam), (callback, userParam)) \
+	SPARKY_GL_FUNCTION(glGetDebugMessageLog, GLuint, (GLuint count, GLsizei bufSize, GLenum *sources, GLenum *types, GLuint *ids, GLenum *severities, GLsizei *lengths, GLchar *messageLog), (count, bufSize, sources, types, ids, severities, lengths, messageLog)) \
+	SPARKY_GL_FUNCTION(glPushDebugGroup, void, (GLenum source, GLuint id, GLsizei length, const GLchar *message), (source, id, length, message)) \
+	SPARKY_GL_FUNCTION(glPopDebugGroup, void, (), ()) \
+	SPARKY_GL_FUNCTION(glObjectLabel, void, (GLenum identifier, GLuint name, GLsizei length, const GLchar *label), (identifier, name, length, label)) \
+	SPARKY_GL_FUNCTION(glGetObjectLabel, void, (GLenum identifier, GLuint name, GLsizei bufSize, GLsizei *length, GLchar *label), (identifier, name, bufSize, length, label)) \
+	SPARKY_GL_FUNCTION(glObjectPtrLabel, void, (const void *ptr, GLsizei length, const GLchar *label), (ptr, length, label)) \
+	SPARKY_GL_FUNCTION(glGetObjectPtrLabel, void, (const void *ptr, GLsizei bufSize, GLsizei *length, GLchar *label), (ptr, bufSize, length, label)) \
+	SPARKY_GL_FUNCTION(glGetPointerv, void, (GLenum pname, void **params), (pname, params)) \
+	SPARKY_GL_FUNCTION(glBufferStorage, void, (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags), (target, size, data, flags)) \
+	SPARKY_GL_FUNCTION(glClearTexImage, void, (GLuint texture, GLint level, GLenum format, GLenum type, const void *data), (texture, level, format, type, data)) \
+	SPARKY_GL_FUNCTION(glClearTexSubImage, void, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *data), (texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, data)) \
+	SPARKY_GL_FUNCTION(glBindBuffersBase, void, (GLenum target, GLuint first, GLsizei count, const GLuint *buffers), (target, first, count, buffers)) \
+	SPARKY_GL_FUNCTION(glBindBuffersRange, void, (GLenum target, GLuint first, GLsizei count, const GLuint *buffers, const GLintptr *offsets, const GLsizeiptr *sizes), (target, first, count, buffers, offsets, sizes)) \
+	SPARKY_GL_FUNCTION(glBindTextures, void, (GLuint first, GLsizei count, const GLuint *textures), (first, count, textures)) \
+	SPARKY_GL_FUNCTION(glBindSamplers, void, (GLuint first, GLsizei count, const GLuint *samplers), (first, count, samplers)) \
+	SPARKY_GL_FUNCTION(glBindImageTextures, void, (GLuint first, GLsizei count, const GLuint *textures), (first, count, textures)) \
+	SPARKY_GL_FUNCTION(glBindVertexBuffers, void, (GLuint first, GLsizei count, const GLuint *buffers, const GLintptr *offsets, const GLsizei *strides), (first, count, buffers, offsets, strides)) \
+	SPARKY_GL_FUNCTION(glClipControl, void, (GLenum origin, GLenum depth), (origin, depth)) \
+	SPARKY_GL_FUNCTION(glCreateTransformFeedbacks, void, (GLsizei n, GLuint *ids), (n, ids)) \
+	SPARKY_GL_FUNCTION(glTransformFeedbackBufferBase, void, (GLuint xfb, GLuint index, GLuint buffer), (xfb, index, buffer)) \
+	SPARKY_GL_FUNCTION(glTransformFeedbackBufferRange, void, (GLuint xfb, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (xfb, index, buffer, offset, size)) \
+	SPARKY_GL_FUNCTION(glGetTransformFeedbackiv, void, (GLuint xfb, GLenum pname, GLint *param), (xfb, pname, param)) \
+	SPARKY_GL_FUNCTION(glGetTransformFeedbacki_v, void, (GLuint xfb, GLenum pname, GLuint index, GLint *param), (xfb, pname, index, param)) \
+	SPARKY_GL_FUNCTION(glGetTransformFeedbacki64_v, void, (GLuint xfb, GLenum pname, GLuint index, GLint64 *param), (xfb, pname, index, param)) \
+	SPARKY_GL_FUNCTION(glCreateBuffers, void, (GLsizei n, GLuint *buffers), (n, buffers)) \
+	SPARKY_GL_FUNCTION(glNamedBufferStorage, void, (GLuint buffer, GLsizeiptr size, const void *data, GLbitfield flags), (buffer, size, data, flags)) \
+	SPARKY_GL_FUNCTION(glNamedBufferData, void, (GLuint buffer, GLsizeiptr size, const void *data, GLenum usage), (buffer, size, data, usage)) \
+	SPARKY_GL_FUNCTION(glNamedBufferSubData, void, (GLuint buffer, GLintptr offset, GLsizeiptr size, const void *data), (buffer, offset, size, data)) \
+	SPARKY_GL_FUNCTION(glCopyNamedBufferSubData, void, (GLuint readBuffer, GLuint writeBuffer, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readBuffer, writeBuffer, readOffset, writeOffset, size)) \
+	SPARKY_GL_FUNCTION(glClearNamedBufferData, void, (GLuint buffer, GLenum internalformat, GLenum format, GLenum type, const void *data), (buffer, internalformat, format, type, data)) \
+	SPARKY_GL_FUNCTION(glClearNamedBufferSubData, void, (GLuint buffer, GLenum internalformat, GLintptr offset, GLsizeiptr size, GLenum format, GLenum type, const void *data), (buffer, internalformat, offset, size, format, type, data)) \
+	SPARKY_GL_FUNCTION(glMapNamedBuffer, void *, (GLuint buffer, GLenum access), (buffer, access)) \
+	SPARKY_GL_FUNCTION(glMapNamedBufferRange, void *, (GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access), (buffer, offset, length, access)) \
+	SPARKY_GL_FUNCTION(glUnmapNamedBuffer, GLboolean, (GLuint buffer), (buffer)) \
+	SPARKY_GL_FUNCTION(glFlushMappedNamedBufferRange, void, (GLuint buffer, GLintptr offset, GLsizeiptr length), (buffer, offset, length)) \
+	SPARKY_GL_FUNCTION(glGetNamedBufferParameteriv, void, (GLuint buffer, GLenum pname, GLint *params), (buffer, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetNamedBufferParameteri64v, void, (GLuint buffer, GLenum pname, GLint64 *params), (buffer, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetNamedBufferPointerv, void, (GLuint buffer, GLenum pname, void **params), (buffer, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetNamedBufferSubData, void, (GLuint buffer, GLintptr offset, GLsizeiptr size, void *data), (buffer, offset, size, data)) \
+	SPARKY_GL_FUNCTION(glCreateFramebuffers, void, (GLsizei n, GLuint *framebuffers), (n, framebuffers)) \
+	SPARKY_GL_FUNCTION(glNamedFramebufferRenderbuffer, void, (GLuint framebuffer, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), (framebuffer, attachment, renderbuffertarget, renderbuffer)) \
+	SPARKY_GL_FUNCTION(glNamedFramebufferParameteri, void, (GLuint framebuffer, GLenum pname, GLint param), (framebuffer, pname, param)) \
+	SPARKY_GL_FUNCTION(glNamedFramebufferTexture, void, (GLuint framebuffer, GLenum attachment, GLuint texture, GLint level), (framebuffer, attachment, texture, level)) \
+	SPARKY_GL_FUNCTION(glNamedFramebufferTextureLayer, void, (GLuint framebuffer, GLenum attachment, GLuint texture, GLint level, GLint layer), (framebuffer, attachment, texture, level, layer)) \
+	SPARKY_GL_FUNCTION(glNamedFramebufferDrawBuffer, void, (GLuint framebuffer, GLenum buf), (framebuffer, buf)) \
+	SPARKY_GL_FUNCTION(glNamedFramebufferDrawBuffers, void, (GLuint framebuffer, GLsizei n, const GLenum *bufs), (framebuffer, n, bufs)) \
+	SPARKY_GL_FUNCTION(glNamedFramebufferReadBuffer, void, (GLuint framebuffer, GLenum src), (framebuffer, src)) \
+	SPARKY_GL_FUNCTION(glInvalidateNamedFramebufferData, void, (GLuint framebuffer, GLsizei numAttachments, const GLenum *attachments), (framebuffer, numAttachments, attachments)) \
+	SPARKY_GL_FUNCTION(glInvalidateNamedFramebufferSubData, void, (GLuint framebuffer, GLsizei numAttachments, const GLenum *attachments, GLint x, GLint y, GLsizei width, GLsizei height), (framebuffer, numAttachments, attachments, x, y, width, height)) \
+	SPARKY_GL_FUNCTION(glClearNamedFramebufferiv, void, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLint *value), (framebuffer, buffer, drawbuffer, value)) \
+	SPARKY_GL_FUNCTION(glClearNamedFramebufferuiv, void, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLuint *value), (framebuffer, buffer, drawbuffer, value)) \
+	SPARKY_GL_FUNCTION(glClearNamedFramebufferfv, void, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLfloat *value), (framebuffer, buffer, drawbuffer, value)) \
+	SPARKY_GL_FUNCTION(glClearNamedFramebufferfi, void, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil), (framebuffer, buffer, drawbuffer, depth, stencil)) \
+	SPARKY_GL_FUNCTION(glBlitNamedFramebuffer, void, (GLuint readFramebuffer, GLuint drawFramebuffer, GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter), (readFramebuffer, drawFramebuffer, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter)) \
+	SPARKY_GL_FUNCTION(glCheckNamedFramebufferStatus, GLenum, (GLuint framebuffer, GLenum target), (framebuffer, target)) \
+	SPARKY_GL_FUNCTION(glGetNamedFramebufferParameteriv, void, (GLuint framebuffer, GLenum pname, GLint *param), (framebuffer, pname, param)) \
+	SPARKY_GL_FUNCTION(glGetNamedFramebufferAttachmentParameteriv, void, (GLuint framebuffer, GLenum attachment, GLenum pname, GLint *params), (framebuffer, attachment, pname, params)) \
+	SPARKY_GL_FUNCTION(glCreateRenderbuffers, void, (GLsizei n, GLuint *renderbuffers), (n, renderbuffers)) \
+	SPARKY_GL_FUNCTION(glNamedRenderbufferStorage, void, (GLuint renderbuffer, GLenum internalformat, GLsizei width, GLsizei height), (renderbuffer, internalformat, width, height)) \
+	SPARKY_GL_FUNCTION(glNamedRenderbufferStorageMultisample, void, (GLuint renderbuffer, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height), (renderbuffer, samples, internalformat, width, height)) \
+	SPARKY_GL_FUNCTION(glGetNamedRenderbufferParameteriv, void, (GLuint renderbuffer, GLenum pname, GLint *params), (renderbuffer, pname, params)) \
+	SPARKY_GL_FUNCTION(glCreateTextures, void, (GLenum target, GLsizei n, GLuint *textures), (target, n, textures)) \
+	SPARKY_GL_FUNCTION(glTextureBuffer, void, (GLuint texture, GLenum internalformat, GLuint buffer), (texture, internalformat, buffer)) \
+	SPARKY_GL_FUNCTION(glTextureBufferRange, void, (GLuint texture, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size), (texture, internalformat, buffer, offset, size)) \
+	SPARKY_GL_FUNCTION(glTextureStorage1D, void, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width), (texture, levels, internalformat, width)) \
+	SPARKY_GL_FUNCTION(glTextureStorage2D, void, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height), (texture, levels, internalformat, width, height)) \
+	SPARKY_GL_FUNCTION(glTextureStorage3D, void, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth), (texture, levels, internalformat, width, height, depth)) \
+	SPARKY_GL_FUNCTION(glTextureStorage2DMultisample, void, (GLuint texture, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations), (texture, samples, internalformat, width, height, fixedsamplelocations)) \
+	SPARKY_GL_FUNCTION(glTextureStorage3DMultisample, void, (GLuint texture, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations), (texture, samples, internalformat, width, height, depth, fixedsamplelocations)) \
+	SPARKY_GL_FUNCTION(glTextureSubImage1D, void, (GLuint texture, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels), (texture, level, xoffset, width, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glTextureSubImage2D, void, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels), (texture, level, xoffset, yoffset, width, height, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glTextureSubImage3D, void, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels), (texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels)) \
+	SPARKY_GL_FUNCTION(glCompressedTextureSubImage1D, void, (GLuint texture, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data), (texture, level, xoffset, width, format, imageSize, data)) \
+	SPARKY_GL_FUNCTION(glCompressedTextureSubImage2D, void, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data), (texture, level, xoffset, yoffset, width, height, format, imageSize, data)) \
+	SPARKY_GL_FUNCTION(glCompressedTextureSubImage3D, void, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data), (texture, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data)) \
+	SPARKY_GL_FUNCTION(glCopyTextureSubImage1D, void, (GLuint texture, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width), (texture, level, xoffset, x, y, width)) \
+	SPARKY_GL_FUNCTION(glCopyTextureSubImage2D, void, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height), (texture, level, xoffset, yoffset, x, y, width, height)) \
+	SPARKY_GL_FUNCTION(glCopyTextureSubImage3D, void, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height), (texture, level, xoffset, yoffset, zoffset, x, y, width, height)) \
+	SPARKY_GL_FUNCTION(glTextureParameterf, void, (GLuint texture, GLenum pname, GLfloat param), (texture, pname, param)) \
+	SPARKY_GL_FUNCTION(glTextureParameterfv, void, (GLuint texture, GLenum pname, const GLfloat *param), (texture, pname, param)) \
+	SPARKY_GL_FUNCTION(glTextureParameteri, void, (GLuint texture, GLenum pname, GLint param), (texture, pname, param)) \
+	SPARKY_GL_FUNCTION(glTextureParameterIiv, void, (GLuint texture, GLenum pname, const GLint *params), (texture, pname, params)) \
+	SPARKY_GL_FUNCTION(glTextureParameterIuiv, void, (GLuint texture, GLenum pname, const GLuint *params), (texture, pname, params)) \
+	SPARKY_GL_FUNCTION(glTextureParameteriv, void, (GLuint texture, GLenum pname, const GLint *param), (texture, pname, param)) \
+	SPARKY_GL_FUNCTION(glGenerateTextureMipmap, void, (GLuint texture), (texture)) \
+	SPARKY_GL_FUNCTION(glBindTextureUnit, void, (GLuint unit, GLuint texture), (unit, texture)) \
+	SPARKY_GL_FUNCTION(glGetTextureImage, void, (GLuint texture, GLint level, GLenum format, GLenum type, GLsizei bufSize, void *pixels), (texture, level, format, type, bufSize, pixels)) \
+	SPARKY_GL_FUNCTION(glGetCompressedTextureImage, void, (GLuint texture, GLint level, GLsizei bufSize, void *pixels), (texture, level, bufSize, pixels)) \
+	SPARKY_GL_FUNCTION(glGetTextureLevelParameterfv, void, (GLuint texture, GLint level, GLenum pname, GLfloat *params), (texture, level, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetTextureLevelParameteriv, void, (GLuint texture, GLint level, GLenum pname, GLint *params), (texture, level, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetTextureParameterfv, void, (GLuint texture, GLenum pname, GLfloat *params), (texture, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetTextureParameterIiv, void, (GLuint texture, GLenum pname, GLint *params), (texture, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetTextureParameterIuiv, void, (GLuint texture, GLenum pname, GLuint *params), (texture, pname, params)) \
+	SPARKY_GL_FUNCTION(glGetTextureParameteriv, void, (GLuint texture, GLenum pname, GLint *params), (texture, pname, params)) \
+	SPARKY_GL_FUNCTION(glCreateVertexArrays, void, (GLsizei n, GLuint *arrays), (n, arrays)) \
+	SPARKY_GL_FUNCTION(glDisableVertexArrayAttrib, void, (GLuint vaobj, GLuint index), (vaobj, index)) \
+	SPARKY_GL_FUNCTION(glEnableVertexArrayAttrib, void, (GLuint vaobj, GLuint index), (vaobj, index)) \
+	SPARKY_GL_FUNCTION(glVertexArrayElementBuffer, void, (GLuint vaobj, GLuint buffer), (vaobj, buffer)) \
+	SPARKY_GL_FUNCTION(glVertexArrayVertexBuffer, void, (GLuint vaobj, GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride), (vaobj, bindingindex, buffer, offset, stride)) \
+	SPARKY_GL_FUNCTION(glVertexArrayVertexBuffers, void, (GLuint vaobj, GLuint first, GLsizei count, const GLuint *buffers, const GLintptr *offsets, const GLsizei *strides), (vaobj, first, count, buffers, offsets, strides)) \
+	SPARKY_GL_FUNCTION(glVertexArrayAttribBinding, void, (GLuint vaobj, GLuint attribindex, GLuint bindingindex), (vaobj, attribindex, bindingindex)) \
+	SPARKY_GL_FUNCTION(glVertexArrayAttribFormat, void, (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset), (vaobj, attribindex, size, type, normalized, relativeoffset)) \
+	SPARKY_GL_FUNCTION(glVertexArrayAttribIFormat, void, (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset), (vaobj, attribindex, size, type, relativeoffset)) \
+	SPARKY_GL_FUNCTION(glVertexArrayAttribLFormat, void, (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset), (vaobj, attribindex, size, type, relativeoffset)) \
+	SPARKY_GL_FUNCTION(glVertexArrayBindingDivisor, void, (GLuint vaobj, GLuint bindingindex, GLuint divisor), (vaobj, bindingindex, divisor)) \
+	SPARKY_GL_FUNCTION(glGetVertexArrayiv, void, (GLuint vaobj, GLenum pname, GLint *param), (vaobj, pname, param)) \
+	SPARKY_GL_FUNCTION(glGetVertexArrayIndexediv, void, (GLuint vaobj, GLuint index, GLenum pname, GLint *param), (vaobj, index, pname, param)) \
+	SPARKY_GL_FUNCTION(glGetVertexArrayIndexed64iv, void, (GLuint vaobj, GLuint index, GLenum pname, GLint64 *param), (vaobj, index, pname, param)) \
+	SPARKY_GL_FUNCTION(glCreateSamplers, void, (GLsizei n, GLuint *samplers), (n, samplers)) \
+	SPARKY_GL_FUNCTION(glCreateProgramPipelines, void, (GLsizei n, GLuint *pipelines), (n, pipelines)) \
+	SPARKY_GL_FUNCTION(glCreateQueries, void, (GLenum target, GLsizei n, GLuint *ids), (target, n, ids)) \
+	SPARKY_GL_FUNCTION(glGetQueryBufferObjecti64v, void, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset), (id, buffer, pname, offset)) \
+	SPARKY_GL_FUNCTION(glGetQueryBufferObjectiv, void, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset), (id, buffer, pname, offset)) \
+	SPARKY_GL_FUNCTION(glGetQueryBufferObjectui64v, void, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset), (id, buffer, pname, offset)) \
+	SPARKY_GL_FUNCTION(glGetQueryBufferObjectuiv, void, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset), (id, buffer, pname, offset)) \
+	SPARKY_GL_FUNCTION(glMemoryBarrierByRegion, void, (GLbitfield barriers), (barriers)) \
+	SPARKY_GL_FUNCTION(glGetTextureSubImage, void, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, GLsizei bufSize, void *pixels), (texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, bufSize, pixels)) \
+	SPARKY_GL_FUNCTION(glGetCompressedTextureSubImage, void, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLsizei bufSize, void *pixels), (texture, level, xoffset, yoffset, zoffset, width, height, depth, bufSize, pixels)) \
+	SPARKY_GL_FUNCTION(glGetGraphicsResetStatus, GLenum, (), ()) \
+	SPARKY_GL_FUNCTION(glGetnCompressedTexImage, void, (GLenum target, GLint lod, GLsizei bufSize, void *pixels), (target, lod, bufSize, pixels)) \
+	SPARKY_GL_FUNCTION(glGetnTexImage, void, (GLenum target, GLint level, GLenum format, GLenum type, GLsizei bufSize, void *pixels), (target, level, format, type, bufSize, pixels)) \
+	SPARKY_GL_FUNCTION(glGetnUniformdv, void, (GLuint program, GLint location, GLsizei bufSize, GLdouble *params), (program, location, bufSize, params)) \
+	SPARKY_GL_FUNCTION(glGetnUniformfv, void, (GLuint program, GLint location, GLsizei bufSize, GLfloat *params), (program, location, bufSize, params)) \
+	SPARKY_GL_FUNCTION(glGetnUniformiv, void, (GLuint program, GLint location, GLsizei bufSize, GLint *params), (program, location, bufSize, params)) \
+	SPARKY_GL_FUNCTION(glGetnUniformuiv, void, (GLuint program, GLint location, GLsizei bufSize, GLuint *params), (program, location, bufSize, params)) \
+	SPARKY_GL_FUNCTION(glReadnPixels, void, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLsizei bufSize, void *data), (x, y, width, height, format, type, bufSize, data)) \
+	SPARKY_GL_FUNCTION(glGetnMapdv, void, (GLenum target, GLenum query, GLsizei bufSize, GLdouble *v), (target, query, bufSize, v)) \
+	SPARKY_GL_FUNCTION(glGetnMapfv, void, (GLenum target, GLenum query, GLsizei bufSize, GLfloat *v), (target, query, bufSize, v)) \
+	SPARKY_GL_FUNCTION(glGetnMapiv, void, (GLenum target, GLenum query, GLsizei bufSize, GLint *v), (target, query, bufSize, v)) \
+	SPARKY_GL_FUNCTION(glGetnPixelMapfv, void, (GLenum map, GLsizei bufSize, GLfloat *values), (map, bufSize, values)) \
+	SPARKY_GL_FUNCTION(glGetnPixelMapuiv, void, (GLenum map, GLsizei bufSize, GLuint *values), (map, bufSize, values)) \
+	SPARKY_GL_FUNCTION(glGetnPixelMapusv, void, (GLenum map, GLsizei bufSize, GLushort *values), (map, bufSize, values)) \
+	SPARKY_GL_FUNCTION(glGetnPolygonStipple, void, (GLsizei bufSize, GLubyte *pattern), (bufSize, pattern)) \
+	SPARKY_GL_FUNCTION(glGetnColorTable, void, (GLenum target, GLenum format, GLenum type, GLsizei bufSize, void *table), (target, format, type, bufSize, table)) \
+	SPARKY_GL_FUNCTION(glGetnConvolutionFilter, void, (GLenum target, GLenum format, GLenum type, GLsizei bufSize, void *image), (target, format, type, bufSize, image)) \
+	SPARKY_GL_FUNCTION(glGetnSeparableFilter, void, (GLenum target, GLenum format, GLenum type, GLsizei rowBufSize, void *row, GLsizei columnBufSize, void *column, void *span), (target, format, type, rowBufSize, row, columnBufSize, column, span)) \
+	SPARKY_GL_FUNCTION(glGetnHistogram, void, (GLenum target, GLboolean reset, GLenum format, GLenum type, GLsizei bufSize, void *values), (target, reset, format, type, bufSize, values)) \
+	SPARKY_GL_FUNCTION(glGetnMinmax, void, (GLenum target, GLboolean reset, GLenum format, GLenum type, GLsizei bufSize, void *values), (target, reset, format, type, bufSize, values)) \
+	SPARKY_GL_FUNCTION(glTextureBarrier, void, (), ()) \
+	SPARKY_GL_FUNCTION(glSpecializeShader, void, (GLuint shader, const GLchar *pEntryPoint, GLuint numSpecializationConstants, const GLuint *pConstantIndex, const GLuint *pConstantValue), (shader, pEntryPoint, numSpecializationConstants, pConstantIndex, pConstantValue)) \
+	SPARKY_GL_FUNCTION(glMultiDrawArraysIndirectCount, void, (GLenum mode, const void *indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride), (mode, indirect, drawcount, maxdrawcount, stride)) \
+	SPARKY_GL_FUNCTION(glMultiDrawElementsIndirectCount, void, (GLenum mode, GLenum type, const void *indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride), (mode, type, indirect, drawcount, maxdrawcount, stride)) \
+	SPARKY_GL_FUNCTION(glPolygonOffsetClamp, void, (GLfloat factor, GLfloat units, GLfloat clamp), (factor, units, clamp))
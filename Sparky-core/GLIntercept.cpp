@@ -0,0 +1,378 @@
+#include "GLIntercept.h"
+
+#if SPARKY_GL_INTERCEPT
+
+#include <glad/glad.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GLFunctions.h"
+#include "Profiler.h"
+#include "Log.h"
+
+#if defined(_WIN32)
+	#include <Windows.h>
+	#include <DbgHelp.h>
+	#include <intrin.h>
+	#pragma comment(lib, "Dbghelp.lib")
+	#define SPARKY_RETURN_ADDRESS() _ReturnAddress()
+#else
+	#include <dlfcn.h>
+	#define SPARKY_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+namespace sparky {
+
+	namespace {
+		enum FunctionId
+		{
+#define SPARKY_GL_FUNCTION(name, ret, params, args) Id_##name,
+			SPARKY_GL_FUNCTIONS
+#undef SPARKY_GL_FUNCTION
+			FunctionCount
+		};
+
+		const char* s_Names[FunctionCount] = {
+#define SPARKY_GL_FUNCTION(name, ret, params, args) #name,
+			SPARKY_GL_FUNCTIONS
+#undef SPARKY_GL_FUNCTION
+		};
+
+#define SPARKY_GL_FUNCTION(name, ret, params, args) decltype(glad_##name) s_Original_##name;
+		SPARKY_GL_FUNCTIONS
+#undef SPARKY_GL_FUNCTION
+
+		enum CallKind : uint8_t { Normal, StateQuery, Stall };
+
+		// Calls that wait for the GPU to catch up. Query results and buffer maps
+		// only wait in some modes, their wrappers below decide per call.
+		const char* s_StallFunctions[] = {
+			"glGetError", "glFinish", "glClientWaitSync", "glReadPixels", "glReadnPixels",
+			"glGetBufferSubData", "glGetNamedBufferSubData", "glGetTexImage", "glGetTextureImage",
+			"glGetTextureSubImage", "glGetnTexImage", "glGetCompressedTexImage", "glGetnCompressedTexImage",
+			"glGetCompressedTextureImage", "glGetCompressedTextureSubImage", "glMapBuffer", "glMapNamedBuffer",
+		};
+		// Round trips into the driver's state, cheap on most drivers but a sync point
+		// for threaded ones, and glGet*iv on shaders and programs waits for compiles
+		const char* s_StateQueryFunctions[] = {
+			"glGetIntegerv", "glGetFloatv", "glGetBooleanv", "glGetDoublev", "glGetInteger64v",
+			"glGetIntegeri_v", "glGetInteger64i_v", "glGetBooleani_v", "glGetFloati_v", "glGetDoublei_v",
+			"glIsEnabled", "glIsEnabledi", "glGetShaderiv", "glGetProgramiv",
+		};
+
+		bool s_Installed = false;
+		CallKind s_Kinds[FunctionCount];
+		uint32_t s_Calls[FunctionCount], s_LastCalls[FunctionCount];
+		uint64_t s_Ticks[FunctionCount], s_LastTicks[FunctionCount];
+		uint64_t s_TotalCalls[FunctionCount], s_TotalTicks[FunctionCount];
+		uint32_t s_Stalls = 0, s_LastStalls = 0;
+
+		struct StallSite
+		{
+			FunctionId Id;
+			void* Address;
+			uint64_t Count;
+		};
+		std::unordered_map<void*, std::vector<StallSite>> s_StallSites;
+
+		uint64_t s_InstallTicks = 0;
+		std::chrono::steady_clock::time_point s_InstallTime;
+		double s_TicksPerMicrosecond = 1.0;
+
+		std::string DescribeAddress(void* address)
+		{
+			char buffer[512];
+#if defined(_WIN32)
+			static bool s_SymbolsLoaded = SymInitialize(GetCurrentProcess(), NULL, TRUE) != FALSE;
+			if (s_SymbolsLoaded) {
+				char symbolBuffer[sizeof(SYMBOL_INFO) + 256];
+				SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(symbolBuffer);
+				symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+				symbol->MaxNameLen = 255;
+				DWORD64 displacement = 0;
+				if (SymFromAddr(GetCurrentProcess(), (DWORD64)address, &displacement, symbol)) {
+					IMAGEHLP_LINE64 line = { sizeof(IMAGEHLP_LINE64) };
+					DWORD lineDisplacement = 0;
+					if (SymGetLineFromAddr64(GetCurrentProcess(), (DWORD64)address, &lineDisplacement, &line))
+						snprintf(buffer, sizeof(buffer), "%s (%s:%lu)", symbol->Name, line.FileName, line.LineNumber);
+					else
+						snprintf(buffer, sizeof(buffer), "%s+0x%llx", symbol->Name, (unsigned long long)displacement);
+					return buffer;
+				}
+			}
+#else
+			Dl_info info;
+			if (dladdr(address, &info) && info.dli_sname) {
+				snprintf(buffer, sizeof(buffer), "%s+0x%lx", info.dli_sname, (unsigned long)((char*)address - (char*)info.dli_saddr));
+				return buffer;
+			}
+#endif
+			snprintf(buffer, sizeof(buffer), "%p", address);
+			return buffer;
+		}
+
+		void RecordStall(FunctionId id, void* site)
+		{
+			s_Stalls++;
+			std::vector<StallSite>& sites = s_StallSites[site];
+			for (StallSite& s : sites) {
+				if (s.Id == id) {
+					s.Count++;
+					return;
+				}
+			}
+			sites.push_back({ id, site, 1 });
+			SPARKY_CORE_WARN("GL sync point: {0} called from {1}", s_Names[id], DescribeAddress(site));
+		}
+
+		struct CallTimer
+		{
+			FunctionId Id;
+			bool Stalls;
+			void* Site;
+			uint64_t Begin;
+
+			CallTimer(FunctionId id, void* site)
+				: Id(id), Stalls(s_Kinds[id] == Stall), Site(site), Begin(Profiler::Now()) {}
+			CallTimer(FunctionId id, void* site, bool stalls)
+				: Id(id), Stalls(stalls), Site(site), Begin(Profiler::Now()) {}
+			~CallTimer()
+			{
+				s_Ticks[Id] += Profiler::Now() - Begin;
+				s_Calls[Id]++;
+				if (Stalls)
+					RecordStall(Id, Site);
+			}
+		};
+
+#define SPARKY_GL_FUNCTION(name, ret, params, args) \
+		ret APIENTRY Intercept_##name params \
+		{ \
+			CallTimer sparkyCallTimer(Id_##name, SPARKY_RETURN_ADDRESS()); \
+			return s_Original_##name args; \
+		}
+		SPARKY_GL_FUNCTIONS
+#undef SPARKY_GL_FUNCTION
+
+		// Reading GL_QUERY_RESULT waits for the GPU, polling GL_QUERY_RESULT_AVAILABLE
+		// does not. Neither does reading the result of the query whose last poll
+		// said it was available, which is how GpuTimer reads its timings.
+		GLuint s_AvailableQuery = 0;
+
+		bool QueryStalls(GLuint id, GLenum pname)
+		{
+			return pname != GL_QUERY_RESULT_AVAILABLE && pname != GL_QUERY_RESULT_NO_WAIT && id != s_AvailableQuery;
+		}
+
+#define SPARKY_GL_QUERY_OBJECT(name, type) \
+		void APIENTRY InterceptQuery_##name(GLuint id, GLenum pname, type* params) \
+		{ \
+			{ \
+				CallTimer sparkyCallTimer(Id_##name, SPARKY_RETURN_ADDRESS(), QueryStalls(id, pname)); \
+				s_Original_##name(id, pname, params); \
+			} \
+			s_AvailableQuery = pname == GL_QUERY_RESULT_AVAILABLE && *params ? id : 0; \
+		}
+		SPARKY_GL_QUERY_OBJECT(glGetQueryObjectiv, GLint)
+		SPARKY_GL_QUERY_OBJECT(glGetQueryObjectuiv, GLuint)
+		SPARKY_GL_QUERY_OBJECT(glGetQueryObjecti64v, GLint64)
+		SPARKY_GL_QUERY_OBJECT(glGetQueryObjectui64v, GLuint64)
+#undef SPARKY_GL_QUERY_OBJECT
+
+		// Mapping waits for the GPU to finish with the buffer unless asked not to
+		void* APIENTRY InterceptMap_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+		{
+			CallTimer sparkyCallTimer(Id_glMapBufferRange, SPARKY_RETURN_ADDRESS(), (access & GL_MAP_UNSYNCHRONIZED_BIT) == 0);
+			return s_Original_glMapBufferRange(target, offset, length, access);
+		}
+		void* APIENTRY InterceptMap_glMapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access)
+		{
+			CallTimer sparkyCallTimer(Id_glMapNamedBufferRange, SPARKY_RETURN_ADDRESS(), (access & GL_MAP_UNSYNCHRONIZED_BIT) == 0);
+			return s_Original_glMapNamedBufferRange(buffer, offset, length, access);
+		}
+
+		void ClassifyFunctions()
+		{
+			std::fill(s_Kinds, s_Kinds + FunctionCount, Normal);
+			for (int i = 0; i < FunctionCount; ++i) {
+				for (const char* name : s_StallFunctions) {
+					if (strcmp(s_Names[i], name) == 0)
+						s_Kinds[i] = Stall;
+				}
+				for (const char* name : s_StateQueryFunctions) {
+					if (strcmp(s_Names[i], name) == 0)
+						s_Kinds[i] = StateQuery;
+				}
+			}
+		}
+
+		float Microseconds(uint64_t ticks)
+		{
+			return (float)(ticks / s_TicksPerMicrosecond);
+		}
+	}
+
+	bool GLIntercept::Install()
+	{
+		if (s_Installed)
+			return true;
+		ClassifyFunctions();
+		memset(s_Calls, 0, sizeof(s_Calls));
+		memset(s_Ticks, 0, sizeof(s_Ticks));
+		memset(s_LastCalls, 0, sizeof(s_LastCalls));
+		memset(s_LastTicks, 0, sizeof(s_LastTicks));
+		memset(s_TotalCalls, 0, sizeof(s_TotalCalls));
+		memset(s_TotalTicks, 0, sizeof(s_TotalTicks));
+		s_StallSites.clear();
+		s_Stalls = s_LastStalls = 0;
+
+		// entry points the driver does not provide stay null
+#define SPARKY_GL_FUNCTION(name, ret, params, args) \
+		s_Original_##name = glad_##name; \
+		if (glad_##name) glad_##name = &Intercept_##name;
+		SPARKY_GL_FUNCTIONS
+#undef SPARKY_GL_FUNCTION
+		if (s_Original_glGetQueryObjectiv) glad_glGetQueryObjectiv = &InterceptQuery_glGetQueryObjectiv;
+		if (s_Original_glGetQueryObjectuiv) glad_glGetQueryObjectuiv = &InterceptQuery_glGetQueryObjectuiv;
+		if (s_Original_glGetQueryObjecti64v) glad_glGetQueryObjecti64v = &InterceptQuery_glGetQueryObjecti64v;
+		if (s_Original_glGetQueryObjectui64v) glad_glGetQueryObjectui64v = &InterceptQuery_glGetQueryObjectui64v;
+		if (s_Original_glMapBufferRange) glad_glMapBufferRange = &InterceptMap_glMapBufferRange;
+		if (s_Original_glMapNamedBufferRange) glad_glMapNamedBufferRange = &InterceptMap_glMapNamedBufferRange;
+
+		s_InstallTicks = Profiler::Now();
+		s_InstallTime = std::chrono::steady_clock::now();
+		s_Installed = true;
+		SPARKY_CORE_INFO("GL interception installed on {0} entry points", (int)FunctionCount);
+		return true;
+	}
+
+	void GLIntercept::Uninstall()
+	{
+		if (!s_Installed)
+			return;
+#define SPARKY_GL_FUNCTION(name, ret, params, args) glad_##name = s_Original_##name;
+		SPARKY_GL_FUNCTIONS
+#undef SPARKY_GL_FUNCTION
+		s_Installed = false;
+	}
+
+	bool GLIntercept::IsInstalled()
+	{
+		return s_Installed;
+	}
+
+	void GLIntercept::EndFrame()
+	{
+		if (!s_Installed)
+			return;
+		double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - s_InstallTime).count();
+		if (elapsed > 0.0)
+			s_TicksPerMicrosecond = (Profiler::Now() - s_InstallTicks) / elapsed;
+
+		for (int i = 0; i < FunctionCount; ++i) {
+			s_TotalCalls[i] += s_Calls[i];
+			s_TotalTicks[i] += s_Ticks[i];
+		}
+		memcpy(s_LastCalls, s_Calls, sizeof(s_Calls));
+		memcpy(s_LastTicks, s_Ticks, sizeof(s_Ticks));
+		memset(s_Calls, 0, sizeof(s_Calls));
+		memset(s_Ticks, 0, sizeof(s_Ticks));
+		s_LastStalls = s_Stalls;
+		s_Stalls = 0;
+	}
+
+	uint32_t GLIntercept::GetFrameCalls()
+	{
+		uint32_t calls = 0;
+		for (int i = 0; i < FunctionCount; ++i)
+			calls += s_LastCalls[i];
+		return calls;
+	}
+
+	uint32_t GLIntercept::GetFrameStalls()
+	{
+		return s_LastStalls;
+	}
+
+	uint32_t GLIntercept::GetFrameStateQueries()
+	{
+		uint32_t calls = 0;
+		for (int i = 0; i < FunctionCount; ++i) {
+			if (s_Kinds[i] == StateQuery)
+				calls += s_LastCalls[i];
+		}
+		return calls;
+	}
+
+	float GLIntercept::GetFrameDriverMilliseconds()
+	{
+		uint64_t ticks = 0;
+		for (int i = 0; i < FunctionCount; ++i)
+			ticks += s_LastTicks[i];
+		return Microseconds(ticks) / 1000.0f;
+	}
+
+	int GLIntercept::GetTopFunctions(CallStat* out, int max)
+	{
+		int count = 0;
+		for (int i = 0; i < FunctionCount; ++i) {
+			if (!s_LastCalls[i])
+				continue;
+			CallStat stat = { s_Names[i], s_LastCalls[i], Microseconds(s_LastTicks[i]) };
+			// insertion into the small sorted output
+			int at = count < max ? count++ : max;
+			while (at > 0 && out[at - 1].Microseconds < stat.Microseconds) {
+				if (at < max)
+					out[at] = out[at - 1];
+				--at;
+			}
+			if (at < max)
+				out[at] = stat;
+		}
+		return count;
+	}
+
+	void GLIntercept::Report()
+	{
+		std::vector<int> order;
+		for (int i = 0; i < FunctionCount; ++i) {
+			if (s_TotalCalls[i])
+				order.push_back(i);
+		}
+		std::sort(order.begin(), order.end(), [](int a, int b) { return s_TotalTicks[a] > s_TotalTicks[b]; });
+
+		SPARKY_CORE_INFO("GL calls by driver time:");
+		for (size_t i = 0; i < order.size() && i < 20; ++i) {
+			int f = order[i];
+			SPARKY_CORE_INFO("  {0:<28} {1:>10} calls {2:>10.1f} us", s_Names[f], s_TotalCalls[f], Microseconds(s_TotalTicks[f]));
+		}
+		for (auto& entry : s_StallSites) {
+			for (const StallSite& site : entry.second)
+				SPARKY_CORE_WARN("  sync point {0} x{1} from {2}", s_Names[site.Id], site.Count, DescribeAddress(site.Address));
+		}
+	}
+
+}
+
+#else
+
+namespace sparky {
+
+	bool GLIntercept::Install() { return false; }
+	void GLIntercept::Uninstall() {}
+	bool GLIntercept::IsInstalled() { return false; }
+	void GLIntercept::EndFrame() {}
+	uint32_t GLIntercept::GetFrameCalls() { return 0; }
+	uint32_t GLIntercept::GetFrameStalls() { return 0; }
+	uint32_t GLIntercept::GetFrameStateQueries() { return 0; }
+	float GLIntercept::GetFrameDriverMilliseconds() { return 0.0f; }
+	int GLIntercept::GetTopFunctions(CallStat*, int) { return 0; }
+	void GLIntercept::Report() {}
+
+}
+
+#endif
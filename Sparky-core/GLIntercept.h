@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+// Instrumented GL dispatch. Install swaps every glad function pointer for a
+// wrapper that counts the call, times it with rdtsc and forwards to the driver,
+// Uninstall puts the original pointers back. Nothing is wrapped until Install
+// is called, and SPARKY_GL_INTERCEPT=0 compiles the layer out.
+//
+// Calls that make the CPU wait for the GPU (glGetError, glReadPixels, query
+// results, buffer and texture readbacks, glFinish, synchronized maps) are
+// flagged with the return address of the caller. Every new call site is
+// logged once and listed again by Report.
+
+#ifndef SPARKY_GL_INTERCEPT
+	#define SPARKY_GL_INTERCEPT 1
+#endif
+
+namespace sparky {
+
+	class GLIntercept
+	{
+	public:
+		struct CallStat
+		{
+			const char* Name;
+			uint32_t Calls;
+			float Microseconds;
+		};
+
+		// Needs glad loaded, false when compiled out
+		static bool Install();
+		static void Uninstall();
+		static bool IsInstalled();
+
+		// Closes the frame, the Get functions below report the frame just closed
+		static void EndFrame();
+		static uint32_t GetFrameCalls();
+		static uint32_t GetFrameStalls();
+		static uint32_t GetFrameStateQueries();
+		static float GetFrameDriverMilliseconds();
+		// The most expensive functions of the last frame, returns how many were written
+		static int GetTopFunctions(CallStat* out, int max);
+
+		// Logs the call totals since Install and every stalling call site
+		static void Report();
+	};
+
+}
@@ -0,0 +1,85 @@
+#include "HdrHistogram.h"
+#include <algorithm>
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace sparky {
+
+	namespace {
+		inline uint32_t HighestBit(uint64_t value)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanReverse64(&index, value);
+			return (uint32_t)index;
+#else
+			return 63u - (uint32_t)__builtin_clzll(value);
+#endif
+		}
+	}
+
+	HdrHistogram::HdrHistogram(uint64_t maxValue)
+		: m_MaxValue(maxValue)
+	{
+		m_Counts.resize(IndexOf(maxValue) + 1);
+	}
+
+	uint32_t HdrHistogram::IndexOf(uint64_t value) const
+	{
+		if (value < SubBuckets)
+			return (uint32_t)value;
+		// value >> shift lands in [SubBuckets / 2, SubBuckets)
+		uint32_t shift = HighestBit(value) - SubBucketBits + 1;
+		uint32_t sub = (uint32_t)(value >> shift);
+		return SubBuckets + (shift - 1) * (SubBuckets / 2) + (sub - SubBuckets / 2);
+	}
+
+	uint64_t HdrHistogram::HighestValueAt(uint32_t index) const
+	{
+		if (index < SubBuckets)
+			return index;
+		uint32_t k = index - SubBuckets;
+		uint32_t shift = k / (SubBuckets / 2) + 1;
+		uint64_t sub = k % (SubBuckets / 2) + SubBuckets / 2;
+		return ((sub + 1) << shift) - 1;
+	}
+
+	void HdrHistogram::Record(uint64_t value)
+	{
+		if (value > m_MaxValue)
+			value = m_MaxValue;
+		m_Counts[IndexOf(value)]++;
+		m_Count++;
+		m_Sum += value;
+		if (value < m_Min) m_Min = value;
+		if (value > m_Max) m_Max = value;
+	}
+
+	void HdrHistogram::Reset()
+	{
+		std::fill(m_Counts.begin(), m_Counts.end(), 0);
+		m_Count = m_Sum = m_Max = 0;
+		m_Min = ~(uint64_t)0;
+	}
+
+	uint64_t HdrHistogram::GetPercentile(double p) const
+	{
+		if (m_Count == 0)
+			return 0;
+		uint64_t target = (uint64_t)(p / 100.0 * m_Count + 0.5);
+		if (target < 1) target = 1;
+		if (target > m_Count) target = m_Count;
+
+		uint64_t seen = 0;
+		for (uint32_t i = 0; i < (uint32_t)m_Counts.size(); ++i) {
+			seen += m_Counts[i];
+			if (seen >= target) {
+				uint64_t value = HighestValueAt(i);
+				return value < m_Max ? value : m_Max;
+			}
+		}
+		return m_Max;
+	}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace sparky {
+
+	// High dynamic range histogram of non negative integer values (microseconds
+	// for frame times). Values below SubBuckets are counted exactly, above that
+	// every power of two range is split into SubBuckets / 2 linear steps, so a
+	// value is reported within 2 / SubBuckets (1.6%) of itself no matter how
+	// large it is. Recording is O(1) and percentile queries walk the buckets.
+	class HdrHistogram
+	{
+	public:
+		static const uint32_t SubBucketBits = 7;
+		static const uint32_t SubBuckets = 1u << SubBucketBits;
+
+		// Values above maxValue are clamped to it
+		HdrHistogram(uint64_t maxValue = 60000000);
+
+		void Record(uint64_t value);
+		void Reset();
+
+		// p in [0, 100], returns the upper end of the bucket holding the percentile
+		uint64_t GetPercentile(double p) const;
+		inline uint64_t GetMax() const { return m_Max; }
+		inline uint64_t GetMin() const { return m_Count ? m_Min : 0; }
+		inline uint64_t GetCount() const { return m_Count; }
+		inline double GetMean() const { return m_Count ? (double)m_Sum / m_Count : 0.0; }
+	private:
+		uint32_t IndexOf(uint64_t value) const;
+		uint64_t HighestValueAt(uint32_t index) const;
+	private:
+		std::vector<uint32_t> m_Counts;
+		uint64_t m_MaxValue;
+		uint64_t m_Count = 0, m_Sum = 0, m_Min = ~(uint64_t)0, m_Max = 0;
+	};
+
+}
@@ -2,6 +2,8 @@
 #include "ImGuiLayer.h"
 #include "platform/OpenGL/imgui_impl_opengl3.h"
 #include "Application.h"
+#include "PerfOverlay.h"
+#include "MemoryTracker.h"
 
 namespace sparky {
 
@@ -16,6 +18,7 @@ namespace sparky {
 
 	void ImGuiLayer::OnAttach()
 	{
+		SPARKY_MEMORY_TAG(UI);
 		ImGui::CreateContext();
 		ImGui::StyleColorsDark();
 
@@ -56,6 +59,7 @@ namespace sparky {
 
 	void ImGuiLayer::OnUpdate()
 	{
+		SPARKY_MEMORY_TAG(UI);
 		ImGuiIO& io = ImGui::GetIO();
 		Application& app = Application::Get();
 		io.DisplaySize = ImVec2((float)app.GetWindow().GetWidth(), (float)app.GetWindow().GetHeight());
@@ -67,8 +71,7 @@ namespace sparky {
 		ImGui_ImplOpenGL3_NewFrame();
 		ImGui::NewFrame();
 
-		static bool show = true;
-		ImGui::ShowDemoWindow(&show);
+		PerfOverlay::Get().Draw();
 
 		ImGui::Render();
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
@@ -76,15 +79,16 @@ namespace sparky {
 
 	void ImGuiLayer::OnEvent(Event& event)
 	{
-		EventDispatcher dispatcher(event);
-		dispatcher.Dispatch<MouseButtonPressedEvent>(SPARKY_BIND_EVENT_FN(ImGuiLayer::OnMouseButtonPressedEvent));
-		dispatcher.Dispatch<MouseButtonReleasedEvent>(SPARKY_BIND_EVENT_FN(ImGuiLayer::OnMouseButtonReleasedEvent));
-		dispatcher.Dispatch<MouseMovedEvent>(SPARKY_BIND_EVENT_FN(ImGuiLayer::OnMouseMovedEvent));
-		dispatcher.Dispatch<MouseScrolledEvent>(SPARKY_BIND_EVENT_FN(ImGuiLayer::OnMouseScrolledEvent));
-		dispatcher.Dispatch<KeyPressedEvent>(SPARKY_BIND_EVENT_FN(ImGuiLayer::OnKeyPressedEvent));
-		dispatcher.Dispatch<KeyTypedEvent>(SPARKY_BIND_EVENT_FN(ImGuiLayer::OnKeyTypedEvent));
-		dispatcher.Dispatch<KeyReleasedEvent>(SPARKY_BIND_EVENT_FN(ImGuiLayer::OnKeyReleasedEvent));
-		dispatcher.Dispatch<WindowResizeEvent>(SPARKY_BIND_EVENT_FN(ImGuiLayer::OnWindowResizeEvent));
+		typedef EventHandlers<
+			SPARKY_EVENT_HANDLER(ImGuiLayer::OnMouseButtonPressedEvent),
+			SPARKY_EVENT_HANDLER(ImGuiLayer::OnMouseButtonReleasedEvent),
+			SPARKY_EVENT_HANDLER(ImGuiLayer::OnMouseMovedEvent),
+			SPARKY_EVENT_HANDLER(ImGuiLayer::OnMouseScrolledEvent),
+			SPARKY_EVENT_HANDLER(ImGuiLayer::OnKeyPressedEvent),
+			SPARKY_EVENT_HANDLER(ImGuiLayer::OnKeyTypedEvent),
+			SPARKY_EVENT_HANDLER(ImGuiLayer::OnKeyReleasedEvent),
+			SPARKY_EVENT_HANDLER(ImGuiLayer::OnWindowResizeEvent)> Handlers;
+		Handlers::Dispatch(this, event);
 	}
 
 	bool ImGuiLayer::OnMouseButtonPressedEvent(MouseButtonPressedEvent& e)
@@ -155,7 +159,6 @@ namespace sparky {
 		ImGuiIO& io = ImGui::GetIO();
 		io.DisplaySize = ImVec2((float)e.GetWidth(), (float)e.GetHeight());
 		io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
-		glViewport(0, 0, e.GetWidth(), e.GetHeight());
 
 		return false;
 	}
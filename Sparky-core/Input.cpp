@@ -1 +1,98 @@
-#include "Input.h"
\ No newline at end of file
+#include "Input.h"
+#include "Events/KeyEvent.h"
+#include "Events/MouseEvent.h"
+
+namespace sparky {
+
+	InputSnapshot Input::s_Snapshots[2];
+	std::atomic<int> Input::s_Front{ 0 };
+	bool Input::s_HasMousePosition = false;
+
+	namespace {
+		// State of the frame in progress, only seen by the main thread
+		InputSnapshot s_Current;
+	}
+
+	void Input::OnEvent(const Event& e)
+	{
+		switch (e.GetEventType())
+		{
+		case EventType::KeyPressed:
+		{
+			int keycode = static_cast<const KeyPressedEvent&>(e).GetKeyCode();
+			if (InputSnapshot::ValidKey(keycode)) {
+				// repeats keep the key down without producing another edge
+				if (!s_Current.KeysDown[keycode])
+					s_Current.KeysPressed[keycode] = true;
+				s_Current.KeysDown[keycode] = true;
+			}
+			break;
+		}
+		case EventType::KeyReleased:
+		{
+			int keycode = static_cast<const KeyReleasedEvent&>(e).GetKeyCode();
+			if (InputSnapshot::ValidKey(keycode)) {
+				s_Current.KeysDown[keycode] = false;
+				s_Current.KeysReleased[keycode] = true;
+			}
+			break;
+		}
+		case EventType::MouseButtonPressed:
+		{
+			int button = static_cast<const MouseButtonPressedEvent&>(e).GetMouseButton();
+			if (InputSnapshot::ValidButton(button)) {
+				s_Current.ButtonsDown[button] = true;
+				s_Current.ButtonsPressed[button] = true;
+			}
+			break;
+		}
+		case EventType::MouseButtonReleased:
+		{
+			int button = static_cast<const MouseButtonReleasedEvent&>(e).GetMouseButton();
+			if (InputSnapshot::ValidButton(button)) {
+				s_Current.ButtonsDown[button] = false;
+				s_Current.ButtonsReleased[button] = true;
+			}
+			break;
+		}
+		case EventType::MouseMoved:
+		{
+			const MouseMovedEvent& moved = static_cast<const MouseMovedEvent&>(e);
+			// the first position only sets the origin, GLFW does not report one before the first move
+			if (s_HasMousePosition) {
+				s_Current.MouseDeltaX += moved.GetX() - s_Current.MouseX;
+				s_Current.MouseDeltaY += moved.GetY() - s_Current.MouseY;
+			}
+			s_Current.MouseX = moved.GetX();
+			s_Current.MouseY = moved.GetY();
+			s_HasMousePosition = true;
+			break;
+		}
+		case EventType::MouseScrolled:
+		{
+			const MouseScrolledEvent& scrolled = static_cast<const MouseScrolledEvent&>(e);
+			s_Current.ScrollX += scrolled.GetXOffset();
+			s_Current.ScrollY += scrolled.GetYOffset();
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	void Input::EndFrame()
+	{
+		int back = 1 - s_Front.load(std::memory_order_relaxed);
+		s_Snapshots[back] = s_Current;
+		s_Front.store(back, std::memory_order_release);
+
+		s_Current.KeysPressed.reset();
+		s_Current.KeysReleased.reset();
+		s_Current.ButtonsPressed.reset();
+		s_Current.ButtonsReleased.reset();
+		s_Current.MouseDeltaX = s_Current.MouseDeltaY = 0.0f;
+		s_Current.ScrollX = s_Current.ScrollY = 0.0f;
+		s_Current.Frame++;
+	}
+
+}
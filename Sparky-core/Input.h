@@ -1,29 +1,69 @@
 #pragma once
 
 #include "sppch.h"
+#include <atomic>
+#include <bitset>
 #include "KeyCodes.h"
 #include "MouseButtonCodes.h"
 
 namespace sparky {
 
+	class Event;
+
+	// Keyboard and mouse state of one frame. Down bits are the held state at the
+	// end of the frame, Pressed and Released are the edges seen during it (a key
+	// tapped within one frame shows up in both), mouse deltas and scroll are
+	// accumulated over the frame.
+	struct InputSnapshot
+	{
+		static const int KeyCount = SP_KEY_LAST + 1;
+		static const int ButtonCount = SP_MOUSE_BUTTON_LAST + 1;
+
+		std::bitset<KeyCount> KeysDown, KeysPressed, KeysReleased;
+		std::bitset<ButtonCount> ButtonsDown, ButtonsPressed, ButtonsReleased;
+		float MouseX = 0.0f, MouseY = 0.0f;
+		float MouseDeltaX = 0.0f, MouseDeltaY = 0.0f;
+		float ScrollX = 0.0f, ScrollY = 0.0f;
+		uint64_t Frame = 0;
+
+		inline bool IsKeyDown(int keycode) const { return ValidKey(keycode) && KeysDown[keycode]; }
+		inline bool WasKeyPressed(int keycode) const { return ValidKey(keycode) && KeysPressed[keycode]; }
+		inline bool WasKeyReleased(int keycode) const { return ValidKey(keycode) && KeysReleased[keycode]; }
+		inline bool IsButtonDown(int button) const { return ValidButton(button) && ButtonsDown[button]; }
+		inline bool WasButtonPressed(int button) const { return ValidButton(button) && ButtonsPressed[button]; }
+		inline bool WasButtonReleased(int button) const { return ValidButton(button) && ButtonsReleased[button]; }
+
+		static inline bool ValidKey(int keycode) { return keycode >= 0 && keycode < KeyCount; }
+		static inline bool ValidButton(int button) { return button >= 0 && button < ButtonCount; }
+	};
+
+	// Input state built from the buffered window events. Application feeds every
+	// event through OnEvent while it flushes the queue and calls EndFrame once
+	// the queue is empty, which publishes the back snapshot and starts the next.
+	//
+	// Queries never touch GLFW and never lock. Snapshots are only written inside
+	// Application::EndFrame, so a snapshot returned by GetSnapshot stays unchanged
+	// until the end of the following frame; simulation workers can hold on to it
+	// for the frame they were started in.
 	class Input
 	{
 	public:
-		inline static bool IsKeyPressed(int keycode) { return s_Instance->IsKeyPressedImpl(keycode); }
-
-		inline static bool IsMouseButtonPressed(int button) { return s_Instance->IsMouseButtonPressedImpl(button); }
-		inline static std::pair<float, float> GetMousePosition() { return s_Instance->GetMousePositionImpl(); }
-		inline static float GetMouseX() { return s_Instance->GetMouseXImpl(); }
-		inline static float GetMouseY() { return s_Instance->GetMouseYImpl(); }
-	protected:
-		virtual bool IsKeyPressedImpl(int keycode) = 0;
-
-		virtual bool IsMouseButtonPressedImpl(int button) = 0;
-		virtual std::pair<float, float> GetMousePositionImpl() = 0;
-		virtual float GetMouseXImpl() = 0;
-		virtual float GetMouseYImpl() = 0;
+		inline static bool IsKeyPressed(int keycode) { return GetSnapshot().IsKeyDown(keycode); }
+
+		inline static bool IsMouseButtonPressed(int button) { return GetSnapshot().IsButtonDown(button); }
+		inline static std::pair<float, float> GetMousePosition() { const InputSnapshot& s = GetSnapshot(); return{ s.MouseX, s.MouseY }; }
+		inline static float GetMouseX() { return GetSnapshot().MouseX; }
+		inline static float GetMouseY() { return GetSnapshot().MouseY; }
+
+		inline static const InputSnapshot& GetSnapshot() { return s_Snapshots[s_Front.load(std::memory_order_acquire)]; }
+
+		// Main thread only, called by Application
+		static void OnEvent(const Event& e);
+		static void EndFrame();
 	private:
-		static Input* s_Instance;
+		static InputSnapshot s_Snapshots[2];
+		static std::atomic<int> s_Front;
+		static bool s_HasMousePosition;
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,306 @@
+#include "InputRecording.h"
+#include "Log.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace sparky {
+
+	namespace {
+		const char s_Magic[4] = { 'S', 'P', 'I', 'R' };
+		const uint32_t s_Version = 1;
+		const size_t s_HeaderSize = 12;
+	}
+
+	template<typename T>
+	void InputRecorder::Put(T value)
+	{
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+		m_FrameEvents.insert(m_FrameEvents.end(), bytes, bytes + sizeof(T));
+	}
+
+	InputRecorder::~InputRecorder()
+	{
+		Stop();
+	}
+
+	bool InputRecorder::Start(const std::string& path)
+	{
+		Stop();
+		m_File = fopen(path.c_str(), "wb");
+		if (!m_File) {
+			SPARKY_CORE_ERROR("Could not write input recording {0}", path);
+			return false;
+		}
+		m_Path = path;
+		m_Data.assign(s_Magic, s_Magic + 4);
+		m_Data.resize(s_HeaderSize);
+		memcpy(&m_Data[4], &s_Version, 4);
+		m_FrameEvents.clear();
+		m_FrameEventCount = m_FrameCount = 0;
+		m_Written = 0;
+		m_Recording = true;
+		SPARKY_CORE_INFO("Recording input to {0}", path);
+		// the header goes out right away with a frame count of 0
+		return Flush();
+	}
+
+	void InputRecorder::Record(const Event& e)
+	{
+		if (!m_Recording || !e.IsInCategory(EventCategoryInput))
+			return;
+
+		EventType type = e.GetEventType();
+		Put((uint8_t)type);
+		switch (type)
+		{
+		case EventType::KeyPressed:
+		{
+			const KeyPressedEvent& key = static_cast<const KeyPressedEvent&>(e);
+			Put((int16_t)key.GetKeyCode());
+			Put((uint16_t)key.GetRepeatCount());
+			break;
+		}
+		case EventType::KeyReleased:
+			Put((int16_t)static_cast<const KeyReleasedEvent&>(e).GetKeyCode());
+			break;
+		case EventType::KeyTyped:
+			Put((uint32_t)static_cast<const KeyTypedEvent&>(e).GetKeyCode());
+			break;
+		case EventType::MouseButtonPressed:
+		case EventType::MouseButtonReleased:
+			Put((uint8_t)static_cast<const MouseButtonEvent&>(e).GetMouseButton());
+			break;
+		case EventType::MouseMoved:
+		{
+			const MouseMovedEvent& moved = static_cast<const MouseMovedEvent&>(e);
+			Put(moved.GetX());
+			Put(moved.GetY());
+			break;
+		}
+		case EventType::MouseScrolled:
+		{
+			const MouseScrolledEvent& scrolled = static_cast<const MouseScrolledEvent&>(e);
+			Put(scrolled.GetXOffset());
+			Put(scrolled.GetYOffset());
+			break;
+		}
+		default:
+			// not an input event after all, drop the type byte again
+			m_FrameEvents.pop_back();
+			return;
+		}
+		m_FrameEventCount++;
+	}
+
+	void InputRecorder::EndFrame(double time, Timestep timestep)
+	{
+		if (!m_Recording)
+			return;
+
+		float seconds = timestep.GetSeconds();
+		size_t offset = m_Data.size();
+		m_Data.resize(offset + 16);
+		memcpy(&m_Data[offset], &time, 8);
+		memcpy(&m_Data[offset + 8], &seconds, 4);
+		memcpy(&m_Data[offset + 12], &m_FrameEventCount, 4);
+		m_Data.insert(m_Data.end(), m_FrameEvents.begin(), m_FrameEvents.end());
+
+		m_FrameEvents.clear();
+		m_FrameEventCount = 0;
+		m_FrameCount++;
+		if (m_FrameCount % FlushInterval == 0)
+			Flush();
+	}
+
+	bool InputRecorder::Flush()
+	{
+		if (!m_File)
+			return false;
+		bool written = fwrite(m_Data.data(), 1, m_Data.size(), m_File) == m_Data.size();
+		m_Written += m_Data.size();
+		m_Data.clear();
+		// frames first, then the count that makes them visible to the player
+		written = fflush(m_File) == 0 && written;
+		written = fseek(m_File, 8, SEEK_SET) == 0 && fwrite(&m_FrameCount, 4, 1, m_File) == 1 && written;
+		written = fseek(m_File, 0, SEEK_END) == 0 && fflush(m_File) == 0 && written;
+		if (!written) {
+			SPARKY_CORE_ERROR("Could not write input recording {0}, recording stopped", m_Path);
+			fclose(m_File);
+			m_File = nullptr;
+			m_Recording = false;
+		}
+		return written;
+	}
+
+	bool InputRecorder::Stop()
+	{
+		if (!m_Recording)
+			return false;
+		bool written = Flush();
+		m_Recording = false;
+		if (m_File) {
+			fclose(m_File);
+			m_File = nullptr;
+		}
+		if (written)
+			SPARKY_CORE_INFO("Recorded {0} frames of input to {1} ({2} bytes)", m_FrameCount, m_Path, m_Written);
+		return written;
+	}
+
+	template<typename T>
+	bool InputPlayer::Get(T& value)
+	{
+		if (m_Offset + sizeof(T) > m_Data.size())
+			return false;
+		memcpy(&value, &m_Data[m_Offset], sizeof(T));
+		m_Offset += sizeof(T);
+		return true;
+	}
+
+	bool InputPlayer::Open(const std::string& path)
+	{
+		Close();
+		FILE* file = fopen(path.c_str(), "rb");
+		if (!file) {
+			SPARKY_CORE_ERROR("Could not open input recording {0}", path);
+			return false;
+		}
+		fseek(file, 0, SEEK_END);
+		long size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+		m_Data.resize(size > 0 ? (size_t)size : 0);
+		size_t read = fread(m_Data.data(), 1, m_Data.size(), file);
+		fclose(file);
+
+		uint32_t version = 0;
+		if (read != m_Data.size() || m_Data.size() < s_HeaderSize || memcmp(m_Data.data(), s_Magic, 4) != 0) {
+			SPARKY_CORE_ERROR("{0} is not an input recording", path);
+			m_Data.clear();
+			return false;
+		}
+		m_Offset = 4;
+		Get(version);
+		Get(m_FrameCount);
+		if (version != s_Version) {
+			SPARKY_CORE_ERROR("Input recording {0} has version {1}, expected {2}", path, version, s_Version);
+			m_Data.clear();
+			return false;
+		}
+
+		m_FrameIndex = 0;
+		m_FrameEventCount = 0;
+		m_Playing = true;
+		SPARKY_CORE_INFO("Replaying {0} frames of input from {1}", m_FrameCount, path);
+		return true;
+	}
+
+	void InputPlayer::Close()
+	{
+		m_Data.clear();
+		m_Offset = 0;
+		m_FrameCount = m_FrameIndex = m_FrameEventCount = 0;
+		m_Playing = false;
+	}
+
+	bool InputPlayer::NextFrame()
+	{
+		if (!m_Playing)
+			return false;
+		// skip whatever was not queued from the previous frame
+		while (m_FrameEventCount > 0) {
+			if (!ReadEvent(nullptr))
+				break;
+		}
+
+		float seconds;
+		if (m_FrameIndex >= m_FrameCount || !Get(m_Time) || !Get(seconds) || !Get(m_FrameEventCount)) {
+			m_Playing = false;
+			return false;
+		}
+		m_Timestep = Timestep(seconds);
+		m_FrameIndex++;
+		return true;
+	}
+
+	void InputPlayer::QueueEvents(EventQueue& queue)
+	{
+		while (m_FrameEventCount > 0) {
+			if (!ReadEvent(&queue))
+				break;
+		}
+	}
+
+	bool InputPlayer::ReadEvent(EventQueue* queue)
+	{
+		m_FrameEventCount--;
+		uint8_t type;
+		if (!Get(type)) {
+			m_FrameEventCount = 0;
+			return false;
+		}
+
+		bool ok = true;
+		switch ((EventType)type)
+		{
+		case EventType::KeyPressed:
+		{
+			int16_t keycode; uint16_t repeat;
+			ok = Get(keycode) && Get(repeat);
+			if (ok && queue) queue->Push(KeyPressedEvent(keycode, repeat));
+			break;
+		}
+		case EventType::KeyReleased:
+		{
+			int16_t keycode;
+			ok = Get(keycode);
+			if (ok && queue) queue->Push(KeyReleasedEvent(keycode));
+			break;
+		}
+		case EventType::KeyTyped:
+		{
+			uint32_t codepoint;
+			ok = Get(codepoint);
+			if (ok && queue) queue->Push(KeyTypedEvent((int)codepoint));
+			break;
+		}
+		case EventType::MouseButtonPressed:
+		case EventType::MouseButtonReleased:
+		{
+			uint8_t button;
+			ok = Get(button);
+			if (ok && queue) {
+				if ((EventType)type == EventType::MouseButtonPressed)
+					queue->Push(MouseButtonPressedEvent(button));
+				else
+					queue->Push(MouseButtonReleasedEvent(button));
+			}
+			break;
+		}
+		case EventType::MouseMoved:
+		{
+			float x, y;
+			ok = Get(x) && Get(y);
+			if (ok && queue) queue->Push(MouseMovedEvent(x, y));
+			break;
+		}
+		case EventType::MouseScrolled:
+		{
+			float x, y;
+			ok = Get(x) && Get(y);
+			if (ok && queue) queue->Push(MouseScrolledEvent(x, y));
+			break;
+		}
+		default:
+			ok = false;
+			break;
+		}
+
+		if (!ok) {
+			SPARKY_CORE_ERROR("Input recording is corrupt at byte {0}", m_Offset);
+			m_FrameEventCount = 0;
+			m_Playing = false;
+		}
+		return ok;
+	}
+
+}
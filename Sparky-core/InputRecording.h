@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "Timestep.h"
+#include "Events/EventQueue.h"
+
+namespace sparky {
+
+	// Input recordings are a flat little endian binary file:
+	//
+	//   header  "SPIR", uint32 version, uint32 frame count
+	//   frame   double time, float timestep, uint32 event count, events
+	//   event   uint8 EventType followed by its payload
+	//             KeyPressed            int16 keycode, uint16 repeat count
+	//             KeyReleased           int16 keycode
+	//             KeyTyped              uint32 code point
+	//             MouseButton*          uint8 button
+	//             MouseMoved            float x, float y
+	//             MouseScrolled         float x offset, float y offset
+	//
+	// A frame holds the Timestep the frame ran with and the input events that
+	// were dispatched at its end, which is everything Input and the layers see,
+	// so replaying it reproduces the same camera path frame for frame.
+	//
+	// The recorder appends frames to the file every FlushInterval frames and
+	// then updates the frame count in the header, so a run that crashes still
+	// leaves a file that replays up to the last flush.
+
+	class InputRecorder
+	{
+	public:
+		static const uint32_t FlushInterval = 60;
+
+		~InputRecorder();
+
+		bool Start(const std::string& path);
+		// Ignores everything that is not an input event
+		void Record(const Event& e);
+		void EndFrame(double time, Timestep timestep);
+		// Writes the frames not flushed yet and closes the file
+		bool Stop();
+
+		inline bool IsRecording() const { return m_Recording; }
+	private:
+		template<typename T>
+		void Put(T value);
+		// Appends the buffered frames, then commits them in the header
+		bool Flush();
+	private:
+		std::string m_Path;
+		FILE* m_File = nullptr;
+		uint64_t m_Written = 0;
+		std::vector<uint8_t> m_Data;
+		std::vector<uint8_t> m_FrameEvents;
+		uint32_t m_FrameEventCount = 0;
+		uint32_t m_FrameCount = 0;
+		bool m_Recording = false;
+	};
+
+	class InputPlayer
+	{
+	public:
+		bool Open(const std::string& path);
+		void Close();
+
+		// Moves to the next recorded frame, false once the recording is done
+		bool NextFrame();
+		// Pushes the events of the current frame
+		void QueueEvents(EventQueue& queue);
+
+		inline bool IsPlaying() const { return m_Playing; }
+		inline Timestep GetTimestep() const { return m_Timestep; }
+		inline double GetTime() const { return m_Time; }
+		inline uint32_t GetFrameIndex() const { return m_FrameIndex; }
+		inline uint32_t GetFrameCount() const { return m_FrameCount; }
+	private:
+		template<typename T>
+		bool Get(T& value);
+		// Decodes one event and pushes it when queue is set
+		bool ReadEvent(EventQueue* queue);
+	private:
+		std::vector<uint8_t> m_Data;
+		size_t m_Offset = 0;
+		uint32_t m_FrameCount = 0, m_FrameIndex = 0;
+		uint32_t m_FrameEventCount = 0;
+		Timestep m_Timestep;
+		double m_Time = 0.0;
+		bool m_Playing = false;
+	};
+
+}
@@ -122,4 +122,6 @@
 #define SP_KEY_RIGHT_CONTROL      345
 #define SP_KEY_RIGHT_ALT          346
 #define SP_KEY_RIGHT_SUPER        347
-#define SP_KEY_MENU               348
\ No newline at end of file
+#define SP_KEY_MENU               348
+
+#define SP_KEY_LAST               SP_KEY_MENU
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "LayerStack.h"
+#include "Profiler.h"
 
 namespace sparky {
 
@@ -16,16 +17,19 @@ namespace sparky {
 
 	void LayerStack::PushLayer(Layer* layer)
 	{
+		SPARKY_PROFILE_FUNCTION();
 		m_LayerInsert = m_Layers.emplace(m_LayerInsert, layer);
 	}
 
 	void LayerStack::PushOverlay(Layer* overlay)
 	{
+		SPARKY_PROFILE_FUNCTION();
 		m_Layers.emplace_back(overlay);
 	}
 
 	void LayerStack::PopLayer(Layer* layer)
 	{
+		SPARKY_PROFILE_FUNCTION();
 		auto it = std::find(m_Layers.begin(), m_Layers.end(), layer);
 		if (it != m_Layers.end()) {
 			m_Layers.erase(it);
@@ -35,6 +39,7 @@ namespace sparky {
 
 	void LayerStack::PopOverlay(Layer* overlay)
 	{
+		SPARKY_PROFILE_FUNCTION();
 		auto it = std::find(m_Layers.begin(), m_Layers.end(), overlay);
 		if (it != m_Layers.end()) {
 			m_Layers.erase(it);
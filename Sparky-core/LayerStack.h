@@ -4,6 +4,8 @@
 
 namespace sparky {
 
+	// Owns the layers pushed onto it and deletes them with the stack. Popping
+	// hands ownership back to the caller.
 	class LayerStack {
 	public:
 		LayerStack();
@@ -1,10 +1,59 @@
 #include "Log.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+#include "Profiler.h"
 
 namespace sparky {
 
+	namespace {
+		// Producers claim slots at the tail with a CAS, the writer thread is the only
+		// consumer and owns the head. Slot i starts with Sequence = i, a producer
+		// publishes position p by storing p + 1 and the consumer frees it again by
+		// storing p + RingCapacity.
+		static_assert((Log::RingCapacity & (Log::RingCapacity - 1)) == 0, "Log::RingCapacity must be a power of two");
+
+		std::atomic<size_t> s_Tail{ 0 };
+		std::atomic<size_t> s_Head{ 0 };
+		std::atomic<bool> s_Running{ false };
+		uint64_t s_ReportedDropped = 0;
+
+		int64_t NowMilliseconds()
+		{
+			using namespace std::chrono;
+			return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+		}
+	}
+
 	std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
 	std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
+	std::atomic<uint64_t> Log::s_Dropped{ 0 };
+
+	namespace {
+		// Declared after the loggers so that it is destroyed first and the last
+		// records still have somewhere to go
+		struct WriterShutdown
+		{
+			std::thread Thread;
+			~WriterShutdown() { Log::Shutdown(); }
+		} s_Writer;
+	}
+
+	bool LogRateLimiter::Allow(uint32_t& suppressed)
+	{
+		int64_t now = NowMilliseconds();
+		int64_t start = m_WindowStart.load(std::memory_order_relaxed);
+		if (now - start >= 1000 && m_WindowStart.compare_exchange_strong(start, now, std::memory_order_relaxed))
+			m_Count.store(0, std::memory_order_relaxed);
+
+		if (m_Count.fetch_add(1, std::memory_order_relaxed) >= MaxPerSecond) {
+			m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		suppressed = m_Suppressed.exchange(0, std::memory_order_relaxed);
+		return true;
+	}
 
 	void Log::Init()
 	{
@@ -14,6 +63,113 @@ namespace sparky {
 
 		s_ClientLogger = spdlog::stderr_color_mt("App");
 		s_ClientLogger->set_level(spdlog::level::trace);
+
+		if (!s_Running.exchange(true))
+			s_Writer.Thread = std::thread(&Log::WriterThread);
+	}
+
+	void Log::Shutdown()
+	{
+		if (s_Running.exchange(false))
+			s_Writer.Thread.join();
+		if (s_CoreLogger)
+			Drain();
+	}
+
+	void Log::Flush()
+	{
+		size_t target = s_Tail.load(std::memory_order_acquire);
+		if (!s_Running.load(std::memory_order_acquire)) {
+			if (s_CoreLogger)
+				Drain();
+			return;
+		}
+		while (s_Head.load(std::memory_order_acquire) < target && s_Running.load(std::memory_order_relaxed))
+			std::this_thread::yield();
+	}
+
+	Log::Record* Log::BeginRecord()
+	{
+		Record* ring = GetRing();
+		size_t pos = s_Tail.load(std::memory_order_relaxed);
+		for (;;) {
+			Record& record = ring[pos & (RingCapacity - 1)];
+			size_t sequence = record.Sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+			if (diff == 0) {
+				if (s_Tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					return &record;
+			}
+			else if (diff < 0) {
+				// full, the writer is behind
+				s_Dropped.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			else {
+				pos = s_Tail.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void Log::EndRecord(Record* record)
+	{
+		size_t pos = record->Sequence.load(std::memory_order_relaxed);
+		record->Sequence.store(pos + 1, std::memory_order_release);
+	}
+
+	size_t Log::FormatError(char* text, size_t capacity, const char* format, const char* what)
+	{
+		int length = snprintf(text, capacity + 1, "log format error (%s) in \"%s\"", what, format);
+		if (length < 0)
+			return 0;
+		return (size_t)length < capacity ? (size_t)length : capacity;
+	}
+
+	bool Log::Drain()
+	{
+		Record* ring = GetRing();
+		size_t head = s_Head.load(std::memory_order_relaxed);
+		bool any = false;
+		for (;;) {
+			Record& record = ring[head & (RingCapacity - 1)];
+			if (record.Sequence.load(std::memory_order_acquire) != head + 1)
+				break;
+
+			SPARKY_PROFILE_SCOPE("Log::Write");
+			auto& logger = record.Logger == Core ? s_CoreLogger : s_ClientLogger;
+			logger->log((spdlog::level::level_enum)record.Level, "{}", fmt::string_view(record.Text, record.Length));
+
+			record.Sequence.store(head + RingCapacity, std::memory_order_release);
+			s_Head.store(++head, std::memory_order_release);
+			any = true;
+		}
+
+		uint64_t dropped = s_Dropped.load(std::memory_order_relaxed);
+		if (dropped != s_ReportedDropped) {
+			s_CoreLogger->warn("Log ring full, {} messages dropped", dropped - s_ReportedDropped);
+			s_ReportedDropped = dropped;
+		}
+		return any;
+	}
+
+	void Log::WriterThread()
+	{
+		Profiler::SetThreadName("Log writer");
+		while (s_Running.load(std::memory_order_acquire)) {
+			if (!Drain())
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	Log::Record* Log::GetRing()
+	{
+		struct Ring
+		{
+			Record Records[RingCapacity];
+			Ring() { for (size_t i = 0; i < RingCapacity; ++i) Records[i].Sequence.store(i, std::memory_order_relaxed); }
+		};
+		static Ring s_Ring;
+		return s_Ring.Records;
 	}
 
-}
\ No newline at end of file
+}
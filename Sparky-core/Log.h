@@ -1,35 +1,172 @@
-
+#pragma once
 #include <memory>
+#include <atomic>
+#include <stdint.h>
+#include <exception>
+#include <string.h>
 #include "Core.h"
 #include "spdlog/spdlog.h"
 #include "spdlog/fmt/ostr.h"
 
+// Compile time log level, calls below it expand to nothing and their arguments
+// are not evaluated. Debug builds keep everything, release builds drop trace.
+#define SPARKY_LOG_LEVEL_TRACE 0
+#define SPARKY_LOG_LEVEL_INFO  2
+#define SPARKY_LOG_LEVEL_WARN  3
+#define SPARKY_LOG_LEVEL_ERROR 4
+#define SPARKY_LOG_LEVEL_OFF   6
+
+#ifndef SPARKY_LOG_LEVEL
+	#ifdef NDEBUG
+		#define SPARKY_LOG_LEVEL SPARKY_LOG_LEVEL_INFO
+	#else
+		#define SPARKY_LOG_LEVEL SPARKY_LOG_LEVEL_TRACE
+	#endif
+#endif
+
 namespace sparky {
 
+	// Per call site limiter, every log macro below ERROR owns one. A call site
+	// may log MaxPerSecond messages per second, the rest are counted and the
+	// count is attached to the next message that gets through. Errors are never
+	// limited, dropping one silently would hide the failure.
+	class LogRateLimiter
+	{
+	public:
+		static const uint32_t MaxPerSecond = 20;
+
+		bool Allow(uint32_t& suppressed);
+	private:
+		std::atomic<int64_t> m_WindowStart{ 0 };
+		std::atomic<uint32_t> m_Count{ 0 };
+		std::atomic<uint32_t> m_Suppressed{ 0 };
+	};
+
+	// Logging goes through a lock-free ring of fixed size records. The calling
+	// thread formats the message straight into a ring slot and returns, a
+	// background thread drains the ring into the spdlog console sinks. When the
+	// ring is full the message is dropped and counted instead of waiting.
 	class Log
 	{
 	public:
+		enum LoggerId : uint8_t { Core = 0, Client = 1 };
+
+		static const size_t RecordSize = 512;
+		static const size_t RingCapacity = 1024;
+
 		static void Init();
+		// Drains what is left and stops the writer thread
+		static void Shutdown();
+		// Blocks until every record written so far reached the sinks, for asserts and crashes
+		static void Flush();
+
+		template<typename... Args>
+		static void Write(LoggerId logger, spdlog::level::level_enum level, uint32_t suppressed, const char* format, const Args&... args)
+		{
+			Record* record = BeginRecord();
+			if (!record)
+				return;
+			record->Logger = logger;
+			record->Level = (uint8_t)level;
+			size_t capacity = sizeof(record->Text) - 1;
+			size_t length;
+			// The slot is claimed, it has to be published whatever happens or the
+			// writer stalls on it for good
+			try {
+#if FMT_VERSION >= 80000
+				auto result = fmt::format_to_n(record->Text, capacity, fmt::runtime(format), args...);
+#else
+				auto result = fmt::format_to_n(record->Text, capacity, format, args...);
+#endif
+				length = result.size < capacity ? result.size : capacity;
+				if (result.size > capacity)
+					memcpy(record->Text + capacity - 3, "...", 3);
+				if (suppressed && length + 32 < capacity) {
+					auto tail = fmt::format_to_n(record->Text + length, capacity - length, " [{} suppressed]", suppressed);
+					length += tail.size;
+				}
+			}
+			catch (const std::exception& e) {
+				length = FormatError(record->Text, capacity, format, e.what());
+			}
+			record->Length = (uint16_t)length;
+			EndRecord(record);
+		}
+
+		static uint64_t GetDroppedCount() { return s_Dropped.load(std::memory_order_relaxed); }
 
 		inline static std::shared_ptr<spdlog::logger>& GetCoreLogger() { return s_CoreLogger; }
 		inline static std::shared_ptr<spdlog::logger>& GetClientLogger() { return s_ClientLogger; }
+	private:
+		// One ring slot. Sequence is the slot's position in the Vyukov bounded
+		// queue protocol, the rest is the record itself.
+		struct alignas(64) Record
+		{
+			std::atomic<size_t> Sequence;
+			uint8_t Logger;
+			uint8_t Level;
+			uint16_t Length;
+			char Text[RecordSize - sizeof(size_t) - 4];
+		};
+
+		static Record* GetRing();
+		static Record* BeginRecord();
+		static void EndRecord(Record* record);
+		// Replaces a message whose format threw, returns its length
+		static size_t FormatError(char* text, size_t capacity, const char* format, const char* what);
+		static void WriterThread();
+		static bool Drain();
 	private:
 		static std::shared_ptr<spdlog::logger> s_CoreLogger;
 		static std::shared_ptr<spdlog::logger> s_ClientLogger;
+		static std::atomic<uint64_t> s_Dropped;
 	};
 
 }
 
-// Core log macros
-#define SPARKY_CORE_TRACE(...)    ::sparky::Log::GetCoreLogger()->trace(__VA_ARGS__)
-#define SPARKY_CORE_INFO(...)     ::sparky::Log::GetCoreLogger()->info(__VA_ARGS__)
-#define SPARKY_CORE_WARN(...)     ::sparky::Log::GetCoreLogger()->warn(__VA_ARGS__)
-#define SPARKY_CORE_ERROR(...)    ::sparky::Log::GetCoreLogger()->error(__VA_ARGS__)
-// #define SP_CORE_FATAL(...)    ::sparky::Log::GetCoreLogger()->fatal(__VA_ARGS__)
-
-// Client log macros
-#define SPARKY_TRACE(...)	      ::sparky::Log::GetClientLogger()->trace(__VA_ARGS__)
-#define SPARKY_INFO(...)	      ::sparky::Log::GetClientLogger()->info(__VA_ARGS__)
-#define SPARKY_WARN(...)	      ::sparky::Log::GetClientLogger()->warn(__VA_ARGS__)
-#define SPARKY_ERROR(...)	      ::sparky::Log::GetClientLogger()->error(__VA_ARGS__)
-// #define SP__FATAL(...)	      ::sparky::Log::GetClientLogger()->fatal(__VA_ARGS__)
\ No newline at end of file
+#define SPARKY_LOG(logger, level, ...) \
+	do { \
+		static ::sparky::LogRateLimiter s_LogLimiter; \
+		uint32_t sparkySuppressed; \
+		if (s_LogLimiter.Allow(sparkySuppressed)) \
+			::sparky::Log::Write(logger, level, sparkySuppressed, __VA_ARGS__); \
+	} while (0)
+
+#define SPARKY_LOG_UNLIMITED(logger, level, ...) \
+	do { \
+		::sparky::Log::Write(logger, level, 0, __VA_ARGS__); \
+	} while (0)
+
+#define SPARKY_LOG_DISABLED(...) do {} while (0)
+
+#if SPARKY_LOG_LEVEL <= SPARKY_LOG_LEVEL_TRACE
+	#define SPARKY_CORE_TRACE(...)    SPARKY_LOG(::sparky::Log::Core, ::spdlog::level::trace, __VA_ARGS__)
+	#define SPARKY_TRACE(...)         SPARKY_LOG(::sparky::Log::Client, ::spdlog::level::trace, __VA_ARGS__)
+#else
+	#define SPARKY_CORE_TRACE(...)    SPARKY_LOG_DISABLED()
+	#define SPARKY_TRACE(...)         SPARKY_LOG_DISABLED()
+#endif
+
+#if SPARKY_LOG_LEVEL <= SPARKY_LOG_LEVEL_INFO
+	#define SPARKY_CORE_INFO(...)     SPARKY_LOG(::sparky::Log::Core, ::spdlog::level::info, __VA_ARGS__)
+	#define SPARKY_INFO(...)          SPARKY_LOG(::sparky::Log::Client, ::spdlog::level::info, __VA_ARGS__)
+#else
+	#define SPARKY_CORE_INFO(...)     SPARKY_LOG_DISABLED()
+	#define SPARKY_INFO(...)          SPARKY_LOG_DISABLED()
+#endif
+
+#if SPARKY_LOG_LEVEL <= SPARKY_LOG_LEVEL_WARN
+	#define SPARKY_CORE_WARN(...)     SPARKY_LOG(::sparky::Log::Core, ::spdlog::level::warn, __VA_ARGS__)
+	#define SPARKY_WARN(...)          SPARKY_LOG(::sparky::Log::Client, ::spdlog::level::warn, __VA_ARGS__)
+#else
+	#define SPARKY_CORE_WARN(...)     SPARKY_LOG_DISABLED()
+	#define SPARKY_WARN(...)          SPARKY_LOG_DISABLED()
+#endif
+
+#if SPARKY_LOG_LEVEL <= SPARKY_LOG_LEVEL_ERROR
+	#define SPARKY_CORE_ERROR(...)    SPARKY_LOG_UNLIMITED(::sparky::Log::Core, ::spdlog::level::err, __VA_ARGS__)
+	#define SPARKY_ERROR(...)         SPARKY_LOG_UNLIMITED(::sparky::Log::Client, ::spdlog::level::err, __VA_ARGS__)
+#else
+	#define SPARKY_CORE_ERROR(...)    SPARKY_LOG_DISABLED()
+	#define SPARKY_ERROR(...)         SPARKY_LOG_DISABLED()
+#endif
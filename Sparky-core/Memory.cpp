@@ -0,0 +1,129 @@
+#include "Memory.h"
+
+namespace sparky {
+
+	namespace {
+		inline size_t AlignUp(size_t value, size_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
+	LinearArena::LinearArena(size_t blockSize)
+		: m_BlockSize(blockSize)
+	{
+	}
+
+	LinearArena::~LinearArena()
+	{
+		FreeBlocks();
+	}
+
+	LinearArena::Block* LinearArena::NewBlock(size_t size)
+	{
+		Block* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+		block->Next = nullptr;
+		block->Size = size;
+		block->Offset = 0;
+		return block;
+	}
+
+	void LinearArena::FreeBlocks()
+	{
+		while (m_First) {
+			Block* next = m_First->Next;
+			::operator delete(m_First);
+			m_First = next;
+		}
+		m_Current = nullptr;
+		m_UsedBefore = 0;
+	}
+
+	void* LinearArena::Allocate(size_t size, size_t alignment)
+	{
+		if (!m_Current)
+			m_First = m_Current = NewBlock(size + alignment > m_BlockSize ? size + alignment : m_BlockSize);
+
+		for (;;) {
+			uintptr_t base = reinterpret_cast<uintptr_t>(m_Current->Data());
+			size_t offset = AlignUp(base + m_Current->Offset, alignment) - base;
+			if (offset + size <= m_Current->Size) {
+				m_Current->Offset = offset + size;
+				size_t used = m_UsedBefore + m_Current->Offset;
+				if (used > m_Peak)
+					m_Peak = used;
+				return m_Current->Data() + offset;
+			}
+
+			// continue in the next block, reusing the ones a Rewind left behind
+			m_UsedBefore += m_Current->Offset;
+			Block* next = m_Current->Next;
+			if (!next || next->Size < size + alignment) {
+				Block* block = NewBlock(size + alignment > m_BlockSize ? size + alignment : m_BlockSize);
+				block->Next = next;
+				m_Current->Next = block;
+				next = block;
+			}
+			next->Offset = 0;
+			m_Current = next;
+		}
+	}
+
+	LinearArena::Marker LinearArena::GetMarker() const
+	{
+		return { m_Current, m_Current ? m_Current->Offset : 0, m_UsedBefore };
+	}
+
+	void LinearArena::Rewind(const Marker& marker)
+	{
+		if (!marker.Block) {
+			if (m_First) {
+				m_Current = m_First;
+				m_Current->Offset = 0;
+			}
+			m_UsedBefore = 0;
+			return;
+		}
+		m_Current = static_cast<Block*>(marker.Block);
+		m_Current->Offset = marker.Offset;
+		m_UsedBefore = marker.UsedBefore;
+	}
+
+	void LinearArena::Reset()
+	{
+		if (m_First && m_First->Next) {
+			// this arena overflowed, merge into one block that fits the peak
+			size_t size = AlignUp(m_Peak + 256, m_BlockSize);
+			FreeBlocks();
+			m_First = m_Current = NewBlock(size);
+			return;
+		}
+		Rewind({ nullptr, 0, 0 });
+	}
+
+	size_t LinearArena::GetCapacity() const
+	{
+		size_t capacity = 0;
+		for (Block* block = m_First; block; block = block->Next)
+			capacity += block->Size;
+		return capacity;
+	}
+
+	LinearArena& Memory::GetFrameArena()
+	{
+		static LinearArena s_FrameArena(256 * 1024);
+		return s_FrameArena;
+	}
+
+	LinearArena& Memory::GetScratchArena()
+	{
+		static thread_local LinearArena s_ScratchArena(64 * 1024);
+		return s_ScratchArena;
+	}
+
+	void Memory::EndFrame()
+	{
+		GetFrameArena().Reset();
+	}
+
+}
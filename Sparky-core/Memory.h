@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <new>
+#include <utility>
+
+namespace sparky {
+
+	// Bump allocator over a chain of blocks. Allocating moves a pointer, freeing
+	// happens all at once with Reset or back to a marker with Rewind, and no
+	// destructors run. When a frame overflows the first block, Reset replaces the
+	// chain with one block big enough for the peak, so a steady state frame
+	// never touches the heap.
+	class LinearArena
+	{
+	public:
+		explicit LinearArena(size_t blockSize = 64 * 1024);
+		~LinearArena();
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		template<typename T>
+		T* AllocateArray(size_t count) { return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T))); }
+		// The destructor of T is never called
+		template<typename T, typename... Args>
+		T* New(Args&&... args) { return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...); }
+
+		struct Marker
+		{
+			void* Block;
+			size_t Offset, UsedBefore;
+		};
+		Marker GetMarker() const;
+		void Rewind(const Marker& marker);
+		void Reset();
+
+		inline size_t GetUsed() const { return m_UsedBefore + (m_Current ? m_Current->Offset : 0); }
+		inline size_t GetPeak() const { return m_Peak; }
+		size_t GetCapacity() const;
+	private:
+		struct Block
+		{
+			Block* Next;
+			size_t Size, Offset;
+			inline char* Data() { return reinterpret_cast<char*>(this + 1); }
+		};
+		static Block* NewBlock(size_t size);
+		void FreeBlocks();
+	private:
+		Block* m_First = nullptr;
+		Block* m_Current = nullptr;
+		size_t m_BlockSize;
+		// bytes handed out from the blocks before m_Current
+		size_t m_UsedBefore = 0;
+		size_t m_Peak = 0;
+	};
+
+	class Memory
+	{
+	public:
+		// Temporaries that live until the end of the frame, main thread only.
+		// Application::EndFrame resets it.
+		static LinearArena& GetFrameArena();
+		// Per thread arena for short lived work, use it through a ScratchScope
+		static LinearArena& GetScratchArena();
+		static void EndFrame();
+	};
+
+	// Gives everything allocated from the thread's scratch arena back when the
+	// scope ends. Scopes nest.
+	class ScratchScope
+	{
+	public:
+		ScratchScope()
+			: m_Arena(Memory::GetScratchArena()), m_Marker(m_Arena.GetMarker()) {}
+		~ScratchScope() { m_Arena.Rewind(m_Marker); }
+		ScratchScope(const ScratchScope&) = delete;
+		ScratchScope& operator=(const ScratchScope&) = delete;
+
+		inline LinearArena& GetArena() { return m_Arena; }
+		template<typename T>
+		T* AllocateArray(size_t count) { return m_Arena.AllocateArray<T>(count); }
+	private:
+		LinearArena& m_Arena;
+		LinearArena::Marker m_Marker;
+	};
+
+}
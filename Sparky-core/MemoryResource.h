@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Memory.h"
+#include "Pool.h"
+
+// Lets standard containers allocate from the engine allocators.
+//
+//   std::vector<int, ArenaAllocator<int>> v(ArenaAllocator<int>(Memory::GetFrameArena()));
+//
+// ArenaAllocator works with any C++11 library. Where <memory_resource> is
+// available the std::pmr resources below do the same for pmr containers.
+
+#if defined(__has_include)
+	#if __has_include(<memory_resource>) && ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L)
+		#define SPARKY_HAS_PMR 1
+	#endif
+#endif
+#ifndef SPARKY_HAS_PMR
+	#define SPARKY_HAS_PMR 0
+#endif
+
+#if SPARKY_HAS_PMR
+	#include <memory_resource>
+#endif
+
+namespace sparky {
+
+	// Deallocation is a no-op, the memory comes back when the arena resets
+	template<typename T>
+	class ArenaAllocator
+	{
+	public:
+		typedef T value_type;
+
+		explicit ArenaAllocator(LinearArena& arena) : m_Arena(&arena) {}
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other) : m_Arena(other.GetArena()) {}
+
+		T* allocate(size_t count) { return static_cast<T*>(m_Arena->Allocate(sizeof(T) * count, alignof(T))); }
+		void deallocate(T*, size_t) {}
+
+		inline LinearArena* GetArena() const { return m_Arena; }
+	private:
+		LinearArena* m_Arena;
+	};
+
+	template<typename T, typename U>
+	inline bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.GetArena() == b.GetArena(); }
+	template<typename T, typename U>
+	inline bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.GetArena() != b.GetArena(); }
+
+#if SPARKY_HAS_PMR
+	class ArenaResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit ArenaResource(LinearArena& arena) : m_Arena(arena) {}
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override { return m_Arena.Allocate(bytes, alignment); }
+		void do_deallocate(void*, size_t, size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	private:
+		LinearArena& m_Arena;
+	};
+
+	// Requests that fit a block come from the pool, the rest from upstream
+	class PoolResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit PoolResource(Pool& pool, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+			: m_Pool(pool), m_Upstream(upstream) {}
+	private:
+		inline bool Fits(size_t bytes, size_t alignment) const { return bytes <= m_Pool.GetBlockSize() && alignment <= m_Pool.GetAlignment(); }
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			return Fits(bytes, alignment) ? m_Pool.Allocate() : m_Upstream->allocate(bytes, alignment);
+		}
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override
+		{
+			if (Fits(bytes, alignment))
+				m_Pool.Free(p);
+			else
+				m_Upstream->deallocate(p, bytes, alignment);
+		}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	private:
+		Pool& m_Pool;
+		std::pmr::memory_resource* m_Upstream;
+	};
+#endif
+
+}
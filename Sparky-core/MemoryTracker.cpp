@@ -0,0 +1,254 @@
+#include "MemoryTracker.h"
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+#include "Log.h"
+
+namespace sparky {
+
+	namespace {
+		const char* s_TagNames[(int)MemoryTag::Count] = { "General", "Renderer", "Assets", "Events", "UI" };
+	}
+
+	const char* MemoryTracker::GetTagName(MemoryTag tag)
+	{
+		return tag < MemoryTag::Count ? s_TagNames[(int)tag] : "?";
+	}
+
+#if SPARKY_TRACK_MEMORY
+
+	namespace {
+		// In front of every allocation. Live allocations form one intrusive list
+		// so ReportLeaks can walk them.
+		struct Header
+		{
+			Header* Prev;
+			Header* Next;
+			size_t Size;
+			uint32_t Sequence;
+			MemoryTag Tag;
+		};
+		// keeps the user pointer as aligned as malloc's
+		const size_t HeaderSize = (sizeof(Header) + 15) & ~(size_t)15;
+
+		struct TagCounters
+		{
+			std::atomic<size_t> Live, Peak, Count;
+			std::atomic<uint64_t> Total;
+			std::atomic<size_t> Budget;
+		};
+		// zero initialized before any constructor runs, so allocations made by
+		// static initializers are counted too
+		TagCounters s_Tags[(int)MemoryTag::Count];
+		thread_local MemoryTag s_CurrentTag = MemoryTag::General;
+		thread_local uint64_t s_ThreadAllocations = 0;
+		bool s_OverBudget[(int)MemoryTag::Count];
+
+		// frame allocation check, main thread only
+		uint64_t s_FrameStartAllocations = 0;
+		uint32_t s_FrameAllocations = 0, s_AllocatingFrames = 0;
+		uint32_t s_WarmupLeft = MemoryTracker::WarmupFrames;
+
+		std::atomic_flag s_ListLock = ATOMIC_FLAG_INIT;
+		Header* s_Live = nullptr;
+		std::atomic<uint32_t> s_Sequence;
+
+		struct ListLock
+		{
+			ListLock() { while (s_ListLock.test_and_set(std::memory_order_acquire)); }
+			~ListLock() { s_ListLock.clear(std::memory_order_release); }
+		};
+
+		void* TrackedAllocate(size_t size)
+		{
+			Header* header = static_cast<Header*>(malloc(HeaderSize + size));
+			if (!header)
+				return nullptr;
+			MemoryTag tag = s_CurrentTag;
+			header->Size = size;
+			header->Tag = tag;
+			header->Sequence = s_Sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+			header->Prev = nullptr;
+			{
+				ListLock lock;
+				header->Next = s_Live;
+				if (s_Live)
+					s_Live->Prev = header;
+				s_Live = header;
+			}
+
+			TagCounters& counters = s_Tags[(int)tag];
+			size_t live = counters.Live.fetch_add(size, std::memory_order_relaxed) + size;
+			size_t peak = counters.Peak.load(std::memory_order_relaxed);
+			while (live > peak && !counters.Peak.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+			counters.Count.fetch_add(1, std::memory_order_relaxed);
+			counters.Total.fetch_add(1, std::memory_order_relaxed);
+			s_ThreadAllocations++;
+			return reinterpret_cast<char*>(header) + HeaderSize;
+		}
+
+		void TrackedFree(void* p)
+		{
+			if (!p)
+				return;
+			Header* header = reinterpret_cast<Header*>(static_cast<char*>(p) - HeaderSize);
+			{
+				ListLock lock;
+				if (header->Prev)
+					header->Prev->Next = header->Next;
+				else
+					s_Live = header->Next;
+				if (header->Next)
+					header->Next->Prev = header->Prev;
+			}
+			TagCounters& counters = s_Tags[(int)header->Tag];
+			counters.Live.fetch_sub(header->Size, std::memory_order_relaxed);
+			counters.Count.fetch_sub(1, std::memory_order_relaxed);
+			free(header);
+		}
+
+		void* TrackedNew(size_t size)
+		{
+			if (size == 0)
+				size = 1;
+			for (;;) {
+				if (void* p = TrackedAllocate(size))
+					return p;
+				std::new_handler handler = std::get_new_handler();
+				if (!handler)
+					throw std::bad_alloc();
+				handler();
+			}
+		}
+	}
+
+	MemoryTag MemoryTracker::SetCurrentTag(MemoryTag tag)
+	{
+		MemoryTag previous = s_CurrentTag;
+		s_CurrentTag = tag;
+		return previous;
+	}
+
+	MemoryTag MemoryTracker::GetCurrentTag()
+	{
+		return s_CurrentTag;
+	}
+
+	MemoryTagStats MemoryTracker::GetStats(MemoryTag tag)
+	{
+		const TagCounters& counters = s_Tags[(int)tag];
+		MemoryTagStats stats;
+		stats.LiveBytes = counters.Live.load(std::memory_order_relaxed);
+		stats.PeakBytes = counters.Peak.load(std::memory_order_relaxed);
+		stats.LiveCount = counters.Count.load(std::memory_order_relaxed);
+		stats.TotalCount = counters.Total.load(std::memory_order_relaxed);
+		stats.Budget = counters.Budget.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	void MemoryTracker::SetBudget(MemoryTag tag, size_t bytes)
+	{
+		s_Tags[(int)tag].Budget.store(bytes, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::EndFrame()
+	{
+		// checked here rather than in operator new, which must not log
+		for (int i = 0; i < (int)MemoryTag::Count; ++i) {
+			size_t budget = s_Tags[i].Budget.load(std::memory_order_relaxed);
+			size_t live = s_Tags[i].Live.load(std::memory_order_relaxed);
+			bool over = budget && live > budget;
+			if (over && !s_OverBudget[i])
+				SPARKY_CORE_WARN("{0} memory {1:.2f} MB is over its {2:.2f} MB budget", s_TagNames[i], live / 1048576.0, budget / 1048576.0);
+			s_OverBudget[i] = over;
+		}
+
+		s_FrameAllocations = (uint32_t)(s_ThreadAllocations - s_FrameStartAllocations);
+		if (s_WarmupLeft > 0) {
+			s_WarmupLeft--;
+		}
+		else if (s_FrameAllocations > 0) {
+			if (s_AllocatingFrames++ == 0)
+				SPARKY_CORE_WARN("Steady state frame made {0} heap allocations, expected none", s_FrameAllocations);
+		}
+		s_FrameStartAllocations = s_ThreadAllocations;
+	}
+
+	void MemoryTracker::BeginWarmup()
+	{
+		s_WarmupLeft = WarmupFrames;
+		s_AllocatingFrames = 0;
+	}
+
+	uint32_t MemoryTracker::GetFrameAllocations()
+	{
+		return s_FrameAllocations;
+	}
+
+	uint32_t MemoryTracker::GetAllocatingFrames()
+	{
+		return s_AllocatingFrames;
+	}
+
+	void MemoryTracker::ReportLeaks()
+	{
+		for (int i = 0; i < (int)MemoryTag::Count; ++i) {
+			MemoryTagStats stats = GetStats((MemoryTag)i);
+			if (stats.LiveCount)
+				SPARKY_CORE_WARN("{0}: {1} allocations, {2} bytes still live (peak {3} bytes)", s_TagNames[i], stats.LiveCount, stats.LiveBytes, stats.PeakBytes);
+		}
+
+		// Untagged memory still held by statics is expected, so only tagged
+		// allocations are listed one by one. Copied out first, logging allocates.
+		struct Leak { size_t Size; uint32_t Sequence; MemoryTag Tag; };
+		const int MaxListed = 64;
+		Leak leaks[MaxListed];
+		int count = 0, total = 0;
+		{
+			ListLock lock;
+			for (Header* header = s_Live; header; header = header->Next) {
+				if (header->Tag == MemoryTag::General)
+					continue;
+				if (count < MaxListed)
+					leaks[count++] = { header->Size, header->Sequence, header->Tag };
+				++total;
+			}
+		}
+		for (int i = 0; i < count; ++i)
+			SPARKY_CORE_WARN("  leak: {0} bytes, {1}, allocation #{2}", leaks[i].Size, s_TagNames[(int)leaks[i].Tag], leaks[i].Sequence);
+		if (total > count)
+			SPARKY_CORE_WARN("  ... and {0} more tagged allocations", total - count);
+	}
+
+#else
+
+	MemoryTag MemoryTracker::SetCurrentTag(MemoryTag) { return MemoryTag::General; }
+	MemoryTag MemoryTracker::GetCurrentTag() { return MemoryTag::General; }
+	MemoryTagStats MemoryTracker::GetStats(MemoryTag) { return MemoryTagStats(); }
+	void MemoryTracker::SetBudget(MemoryTag, size_t) {}
+	void MemoryTracker::EndFrame() {}
+	void MemoryTracker::BeginWarmup() {}
+	uint32_t MemoryTracker::GetFrameAllocations() { return 0; }
+	uint32_t MemoryTracker::GetAllocatingFrames() { return 0; }
+	void MemoryTracker::ReportLeaks() {}
+
+#endif
+
+}
+
+#if SPARKY_TRACK_MEMORY
+
+// Replacing these routes every C++ allocation of the program through the tracker.
+// The aligned (C++17) forms are left to the runtime.
+void* operator new(size_t size) { return sparky::TrackedNew(size); }
+void* operator new[](size_t size) { return sparky::TrackedNew(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return sparky::TrackedAllocate(size ? size : 1); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return sparky::TrackedAllocate(size ? size : 1); }
+void operator delete(void* p) noexcept { sparky::TrackedFree(p); }
+void operator delete[](void* p) noexcept { sparky::TrackedFree(p); }
+void operator delete(void* p, size_t) noexcept { sparky::TrackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { sparky::TrackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { sparky::TrackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { sparky::TrackedFree(p); }
+
+#endif
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Allocation tracking. With SPARKY_TRACK_MEMORY=1 (the default in debug
+// builds) the global operator new and delete put a small header in front of
+// every allocation and charge its size to the tag of the allocating thread.
+//
+//   SPARKY_MEMORY_TAG(Renderer);   charges the rest of the scope to Renderer
+//
+// Each tag keeps live and peak bytes and counts and an optional soft budget.
+// ReportLeaks lists what is still allocated at shutdown. With
+// SPARKY_TRACK_MEMORY=0 operator new is left alone, the tag macro expands to
+// nothing and the queries return zeros. malloc from C libraries (stb, GLFW)
+// is not seen either way.
+//
+// EndFrame also counts the heap allocations the main thread made during the
+// frame. Once a demo has run WarmupFrames frames it is expected to allocate
+// nothing per frame, and a frame that does is logged.
+
+#ifndef SPARKY_TRACK_MEMORY
+	#ifdef _DEBUG
+		#define SPARKY_TRACK_MEMORY 1
+	#else
+		#define SPARKY_TRACK_MEMORY 0
+	#endif
+#endif
+
+namespace sparky {
+
+	enum class MemoryTag : uint8_t
+	{
+		General = 0, Renderer, Assets, Events, UI,
+		Count
+	};
+
+	struct MemoryTagStats
+	{
+		size_t LiveBytes = 0, PeakBytes = 0, LiveCount = 0;
+		uint64_t TotalCount = 0;
+		size_t Budget = 0;
+	};
+
+	class MemoryTracker
+	{
+	public:
+		static const char* GetTagName(MemoryTag tag);
+		static MemoryTagStats GetStats(MemoryTag tag);
+
+		// Returns the tag it replaces
+		static MemoryTag SetCurrentTag(MemoryTag tag);
+		static MemoryTag GetCurrentTag();
+
+		static const uint32_t WarmupFrames = 120;
+
+		// A warning is logged from EndFrame when a tag goes over its budget, 0 removes it
+		static void SetBudget(MemoryTag tag, size_t bytes);
+		// Main thread only, ends the frame of the allocation count
+		static void EndFrame();
+		// Frames allocate freely until WarmupFrames more have ended, for loading
+		static void BeginWarmup();
+		// Heap allocations the main thread made in the last frame
+		static uint32_t GetFrameAllocations();
+		// Steady state frames that allocated since the last warm-up
+		static uint32_t GetAllocatingFrames();
+
+		// Logs every tag with live memory and the tagged allocations that are still live
+		static void ReportLeaks();
+	};
+
+	class MemoryTagScope
+	{
+	public:
+		MemoryTagScope(MemoryTag tag)
+			: m_Previous(MemoryTracker::SetCurrentTag(tag)) {}
+		~MemoryTagScope() { MemoryTracker::SetCurrentTag(m_Previous); }
+	private:
+		MemoryTag m_Previous;
+	};
+
+}
+
+#if SPARKY_TRACK_MEMORY
+	#define SPARKY_MEMORY_CONCAT2(a, b) a##b
+	#define SPARKY_MEMORY_CONCAT(a, b) SPARKY_MEMORY_CONCAT2(a, b)
+	#define SPARKY_MEMORY_TAG(tag) ::sparky::MemoryTagScope SPARKY_MEMORY_CONCAT(memoryTag, __LINE__)(::sparky::MemoryTag::tag)
+#else
+	#define SPARKY_MEMORY_TAG(tag)
+#endif
@@ -0,0 +1,210 @@
+#include "MeshBuffer.h"
+#include <stdint.h>
+#include <algorithm>
+#include <memory>
+#include "Log.h"
+#include "FrameContext.h"
+#include "MemoryTracker.h"
+
+namespace sparky {
+	namespace graphics {
+		namespace {
+			std::vector<std::unique_ptr<MeshBuffer>> s_Shared;
+		}
+
+		GLuint VertexFormat::GetStride() const {
+			GLuint stride = 0;
+			for (GLuint components : Components)
+				stride += components * sizeof(GLfloat);
+			return stride;
+		}
+
+		MeshBuffer& MeshBuffer::Get(const VertexFormat& format) {
+			for (auto& buffer : s_Shared) {
+				if (buffer->GetFormat() == format)
+					return *buffer;
+			}
+			SPARKY_MEMORY_TAG(Renderer);
+			s_Shared.emplace_back(new MeshBuffer(format));
+			return *s_Shared.back();
+		}
+
+		void MeshBuffer::Shutdown() {
+			s_Shared.clear();
+		}
+
+		MeshBuffer::MeshBuffer(const VertexFormat& format, GLuint vertexCapacity, GLuint indexCapacity)
+			: m_Format(format), m_Stride(format.GetStride()), m_Vertices(vertexCapacity), m_Indices(indexCapacity)
+		{
+			glGenVertexArrays(1, &m_ArrayID);
+			glGenBuffers(1, &m_VertexBufferID);
+			glGenBuffers(1, &m_IndexBufferID);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_VertexBufferID);
+			glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)vertexCapacity * m_Stride, nullptr, GL_STATIC_DRAW);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_IndexBufferID);
+			glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)indexCapacity * sizeof(GLushort), nullptr, GL_STATIC_DRAW);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			SetupVertexArray();
+		}
+
+		MeshBuffer::~MeshBuffer() {
+			FrameContext::DeleteVertexArray(m_ArrayID);
+			FrameContext::DeleteBuffer(m_VertexBufferID);
+			FrameContext::DeleteBuffer(m_IndexBufferID);
+		}
+
+		void MeshBuffer::SetupVertexArray() const {
+			glBindVertexArray(m_ArrayID);
+			glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID);
+			uintptr_t offset = 0;
+			for (GLuint i = 0; i < m_Format.Components.size(); ++i) {
+				glEnableVertexAttribArray(i);
+				glVertexAttribPointer(i, m_Format.Components[i], GL_FLOAT, GL_FALSE, m_Stride, (const void*)offset);
+				offset += m_Format.Components[i] * sizeof(GLfloat);
+			}
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID);
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
+		void MeshBuffer::Reallocate(RangeAllocator& allocator, GLuint& buffer, GLuint unitSize, GLuint newCapacity, bool compact) {
+			GLuint replacement;
+			glGenBuffers(1, &replacement);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, replacement);
+			glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)newCapacity * unitSize, nullptr, GL_STATIC_DRAW);
+			glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+			if (compact) {
+				// allocations before the first gap keep their offsets and are copied as one range
+				GLuint unmoved = RangeAllocator::InvalidNode;
+				allocator.Compact([&](uint32_t, uint32_t from, uint32_t to, uint32_t size) {
+					if (unmoved == RangeAllocator::InvalidNode)
+						unmoved = to;
+					glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)from * unitSize, (GLintptr)to * unitSize, (GLsizeiptr)size * unitSize);
+				});
+				if (unmoved == RangeAllocator::InvalidNode)
+					unmoved = allocator.GetStats().Used;
+				if (unmoved)
+					glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)unmoved * unitSize);
+			}
+			else {
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)allocator.GetCapacity() * unitSize);
+				allocator.Grow(newCapacity);
+			}
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			// draws of earlier frames may still read the old buffer
+			FrameContext::DeleteBuffer(buffer);
+			buffer = replacement;
+			SetupVertexArray();
+		}
+
+		GLuint MeshBuffer::Allocate(RangeAllocator& allocator, GLuint& buffer, GLuint unitSize, GLuint size) {
+			GLuint node = allocator.Allocate(size);
+			if (node == RangeAllocator::InvalidNode) {
+				GLuint capacity = allocator.GetCapacity();
+				Reallocate(allocator, buffer, unitSize, std::max(capacity * 2, capacity + size), false);
+				node = allocator.Allocate(size);
+			}
+			return node;
+		}
+
+		GLuint MeshBuffer::Add(const void* vertices, GLuint vertexCount, const GLushort* indices, GLuint indexCount) {
+			if (!vertexCount || !indexCount || vertexCount > 65536) {
+				SPARKY_CORE_ERROR("MeshBuffer: cannot add a mesh of {0} vertices and {1} indices", vertexCount, indexCount);
+				return InvalidMesh;
+			}
+			SPARKY_MEMORY_TAG(Renderer);
+			Mesh mesh;
+			mesh.VertexNode = Allocate(m_Vertices, m_VertexBufferID, m_Stride, vertexCount);
+			mesh.IndexNode = Allocate(m_Indices, m_IndexBufferID, sizeof(GLushort), indexCount);
+			mesh.IndexCount = indexCount;
+			if (mesh.VertexNode == RangeAllocator::InvalidNode || mesh.IndexNode == RangeAllocator::InvalidNode) {
+				SPARKY_CORE_ERROR("MeshBuffer: out of buffer space for a mesh of {0} vertices and {1} indices", vertexCount, indexCount);
+				m_Vertices.Free(mesh.VertexNode);
+				m_Indices.Free(mesh.IndexNode);
+				return InvalidMesh;
+			}
+
+			// the copy targets leave whatever VAO is bound alone
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_VertexBufferID);
+			glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)m_Vertices.GetOffset(mesh.VertexNode) * m_Stride, (GLsizeiptr)vertexCount * m_Stride, vertices);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_IndexBufferID);
+			glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)m_Indices.GetOffset(mesh.IndexNode) * sizeof(GLushort), (GLsizeiptr)indexCount * sizeof(GLushort), indices);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+			GLuint id;
+			if (!m_FreeMeshes.empty()) {
+				id = m_FreeMeshes.back();
+				m_FreeMeshes.pop_back();
+				m_Meshes[id - 1] = mesh;
+			}
+			else {
+				m_Meshes.push_back(mesh);
+				id = (GLuint)m_Meshes.size();
+			}
+			return id;
+		}
+
+		void MeshBuffer::Remove(GLuint mesh) {
+			if (mesh == InvalidMesh || mesh > m_Meshes.size() || m_Meshes[mesh - 1].IndexCount == 0)
+				return;
+			Mesh& entry = m_Meshes[mesh - 1];
+			m_Vertices.Free(entry.VertexNode);
+			m_Indices.Free(entry.IndexNode);
+			entry.IndexCount = 0;
+			m_FreeMeshes.push_back(mesh);
+		}
+
+		void MeshBuffer::Defragment() {
+			Reallocate(m_Vertices, m_VertexBufferID, m_Stride, m_Vertices.GetCapacity(), true);
+			Reallocate(m_Indices, m_IndexBufferID, sizeof(GLushort), m_Indices.GetCapacity(), true);
+		}
+
+		void MeshBuffer::bind() const {
+			glBindVertexArray(m_ArrayID);
+		}
+
+		void MeshBuffer::unbind() const {
+			glBindVertexArray(0);
+		}
+
+		DrawElementsIndirectCommand MeshBuffer::GetDrawCommand(GLuint mesh, GLuint instanceCount, GLuint baseInstance) const {
+			const Mesh& entry = m_Meshes[mesh - 1];
+			DrawElementsIndirectCommand command;
+			command.Count = entry.IndexCount;
+			command.InstanceCount = instanceCount;
+			command.FirstIndex = m_Indices.GetOffset(entry.IndexNode);
+			command.BaseVertex = (GLint)m_Vertices.GetOffset(entry.VertexNode);
+			command.BaseInstance = baseInstance;
+			return command;
+		}
+
+		void MeshBuffer::Draw(GLuint mesh, GLenum mode) const {
+			const Mesh& entry = m_Meshes[mesh - 1];
+			uintptr_t firstIndex = m_Indices.GetOffset(entry.IndexNode);
+			glDrawElementsBaseVertex(mode, (GLsizei)entry.IndexCount, GL_UNSIGNED_SHORT, (const void*)(firstIndex * sizeof(GLushort)), (GLint)m_Vertices.GetOffset(entry.VertexNode));
+		}
+
+		void MeshBuffer::Draw(const GLuint* meshes, GLsizei count, GLenum mode) const {
+			m_DrawCounts.resize(count);
+			m_DrawOffsets.resize(count);
+			m_DrawBaseVertices.resize(count);
+			for (GLsizei i = 0; i < count; ++i) {
+				const Mesh& entry = m_Meshes[meshes[i] - 1];
+				uintptr_t firstIndex = m_Indices.GetOffset(entry.IndexNode);
+				m_DrawCounts[i] = (GLsizei)entry.IndexCount;
+				m_DrawOffsets[i] = (const void*)(firstIndex * sizeof(GLushort));
+				m_DrawBaseVertices[i] = (GLint)m_Vertices.GetOffset(entry.VertexNode);
+			}
+			glMultiDrawElementsBaseVertex(mode, m_DrawCounts.data(), GL_UNSIGNED_SHORT, m_DrawOffsets.data(), count, m_DrawBaseVertices.data());
+		}
+
+		MeshBuffer::Stats MeshBuffer::GetStats() const {
+			Stats stats;
+			stats.Vertices = m_Vertices.GetStats();
+			stats.Indices = m_Indices.GetStats();
+			stats.Meshes = (GLuint)(m_Meshes.size() - m_FreeMeshes.size());
+			return stats;
+		}
+	}
+}
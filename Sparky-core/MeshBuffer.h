@@ -0,0 +1,96 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <initializer_list>
+#include <vector>
+#include "RangeAllocator.h"
+
+namespace sparky {
+	namespace graphics {
+		// Float attributes interleaved in one vertex, attribute i at location i
+		struct VertexFormat {
+			std::vector<GLuint> Components;
+
+			VertexFormat(std::initializer_list<GLuint> components) : Components(components) {}
+
+			GLuint GetStride() const;
+			inline bool operator==(const VertexFormat& other) const { return Components == other.Components; }
+		};
+
+		// Layout glMultiDrawElementsIndirect reads from GL_DRAW_INDIRECT_BUFFER
+		struct DrawElementsIndirectCommand {
+			GLuint Count;
+			GLuint InstanceCount;
+			GLuint FirstIndex;
+			GLint BaseVertex;
+			GLuint BaseInstance;
+		};
+
+		// Meshes of one vertex format carved out of a single vertex buffer and a
+		// single index buffer behind one VAO, so drawing any number of them needs
+		// one bind. Ranges come from a RangeAllocator each; a mesh is drawn at
+		// its firstIndex with its baseVertex, so its indices count from 0.
+		//
+		// Full buffers double, copying their contents on the GPU. Defragment
+		// packs the meshes together after many removals. Both move meshes, so
+		// look draw parameters up by mesh ID rather than keeping offsets.
+		class MeshBuffer {
+		public:
+			static const GLuint InvalidMesh = 0;
+
+			struct Stats {
+				RangeAllocator::Stats Vertices, Indices;
+				GLuint Meshes = 0;
+			};
+
+			// The buffer shared by every mesh of format, created on first use
+			static MeshBuffer& Get(const VertexFormat& format);
+			// Destroys the shared buffers, while the GL context is still current
+			static void Shutdown();
+
+			MeshBuffer(const VertexFormat& format, GLuint vertexCapacity = 1 << 16, GLuint indexCapacity = 1 << 18);
+			~MeshBuffer();
+			MeshBuffer(const MeshBuffer&) = delete;
+			MeshBuffer& operator=(const MeshBuffer&) = delete;
+
+			// vertices are vertexCount vertices of the format, at most 65536.
+			// Growing the buffers unbinds the current VAO.
+			GLuint Add(const void* vertices, GLuint vertexCount, const GLushort* indices, GLuint indexCount);
+			void Remove(GLuint mesh);
+			void Defragment();
+
+			void bind() const;
+			void unbind() const;
+
+			// With the buffer bound
+			void Draw(GLuint mesh, GLenum mode = GL_TRIANGLES) const;
+			// One driver call for all of meshes
+			void Draw(const GLuint* meshes, GLsizei count, GLenum mode = GL_TRIANGLES) const;
+			DrawElementsIndirectCommand GetDrawCommand(GLuint mesh, GLuint instanceCount = 1, GLuint baseInstance = 0) const;
+
+			inline const VertexFormat& GetFormat() const { return m_Format; }
+			Stats GetStats() const;
+		private:
+			struct Mesh {
+				GLuint VertexNode, IndexNode;
+				GLuint IndexCount;
+			};
+
+			GLuint Allocate(RangeAllocator& allocator, GLuint& buffer, GLuint unitSize, GLuint size);
+			// Moves the contents to a new buffer of newCapacity units, packed together when compact
+			void Reallocate(RangeAllocator& allocator, GLuint& buffer, GLuint unitSize, GLuint newCapacity, bool compact);
+			void SetupVertexArray() const;
+		private:
+			VertexFormat m_Format;
+			GLuint m_Stride;
+			GLuint m_ArrayID, m_VertexBufferID, m_IndexBufferID;
+			RangeAllocator m_Vertices, m_Indices;
+			std::vector<Mesh> m_Meshes;
+			std::vector<GLuint> m_FreeMeshes;
+			// reused by the multi-mesh Draw
+			mutable std::vector<GLsizei> m_DrawCounts;
+			mutable std::vector<const void*> m_DrawOffsets;
+			mutable std::vector<GLint> m_DrawBaseVertices;
+		};
+	}
+}
@@ -0,0 +1,224 @@
+#include "PackFile.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include "Compression.h"
+#include "Log.h"
+
+namespace sparky {
+
+	namespace {
+		const uint64_t FnvOffset = 14695981039346656037ull;
+		const uint64_t FnvPrime = 1099511628211ull;
+
+		inline char Lower(char c)
+		{
+			return c >= 'A' && c <= 'Z' ? (char)(c - 'A' + 'a') : c;
+		}
+
+		bool EqualIgnoringCase(const char* a, size_t length, const std::string& b)
+		{
+			if (length != b.size())
+				return false;
+			for (size_t i = 0; i < length; ++i) {
+				if (Lower(a[i]) != Lower(b[i]))
+					return false;
+			}
+			return true;
+		}
+	}
+
+	uint64_t PackFile::HashPath(const std::string& canonicalPath)
+	{
+		uint64_t hash = FnvOffset;
+		for (char c : canonicalPath)
+			hash = (hash ^ (uint8_t)Lower(c)) * FnvPrime;
+		return hash;
+	}
+
+	uint64_t PackFile::HashContent(const uint8_t* data, size_t size)
+	{
+		uint64_t hash = FnvOffset;
+		for (size_t i = 0; i < size; ++i)
+			hash = (hash ^ data[i]) * FnvPrime;
+		return hash;
+	}
+
+	bool PackReader::Open(const std::string& path)
+	{
+		Close();
+		if (!m_File.Open(path))
+			return false;
+
+		const uint8_t* data = m_File.GetData();
+		size_t size = m_File.GetSize();
+		const PackHeader* header = reinterpret_cast<const PackHeader*>(data);
+		if (size < sizeof(PackHeader) || header->Magic != PackHeader::MagicValue || header->Version != PackHeader::CurrentVersion) {
+			SPARKY_CORE_ERROR("{0} is not a pack file this build can read", path);
+			Close();
+			return false;
+		}
+		// every size below comes from the file, bounds are checked by subtraction so they cannot wrap
+		uint64_t tocEnd = sizeof(PackHeader) + (uint64_t)header->EntryCount * sizeof(PackEntry);
+		if (tocEnd > size || header->StringsOffset < tocEnd || header->StringsOffset > size || header->StringsSize > size - header->StringsOffset) {
+			SPARKY_CORE_ERROR("{0} has a truncated table of contents", path);
+			Close();
+			return false;
+		}
+
+		m_Entries = reinterpret_cast<const PackEntry*>(data + sizeof(PackHeader));
+		m_Strings = reinterpret_cast<const char*>(data + header->StringsOffset);
+		m_EntryCount = header->EntryCount;
+		for (uint32_t i = 0; i < m_EntryCount; ++i) {
+			const PackEntry& entry = m_Entries[i];
+			if (entry.Offset > size || entry.StoredSize > size - entry.Offset || (uint64_t)entry.PathOffset + entry.PathLength > header->StringsSize) {
+				SPARKY_CORE_ERROR("{0}: entry {1} points outside the file", path, i);
+				Close();
+				return false;
+			}
+			// raw entries are read in place, an LZ4 block expands at most 255 times
+			bool compressed = (entry.Flags & PackEntry::Compressed) != 0;
+			if (compressed ? entry.Size / 255 > entry.StoredSize : entry.Size != entry.StoredSize) {
+				SPARKY_CORE_ERROR("{0}: entry {1} has a corrupt size", path, i);
+				Close();
+				return false;
+			}
+		}
+		m_Path = path;
+		return true;
+	}
+
+	void PackReader::Close()
+	{
+		m_File.Close();
+		m_Entries = nullptr;
+		m_Strings = nullptr;
+		m_EntryCount = 0;
+		m_Path.clear();
+	}
+
+	const PackEntry* PackReader::Find(const std::string& canonicalPath) const
+	{
+		uint64_t hash = PackFile::HashPath(canonicalPath);
+		const PackEntry* end = m_Entries + m_EntryCount;
+		const PackEntry* it = std::lower_bound(m_Entries, end, hash, [](const PackEntry& entry, uint64_t value) { return entry.PathHash < value; });
+		for (; it != end && it->PathHash == hash; ++it) {
+			if (EqualIgnoringCase(m_Strings + it->PathOffset, it->PathLength, canonicalPath))
+				return it;
+		}
+		return nullptr;
+	}
+
+	FileData PackReader::Read(const PackEntry& entry) const
+	{
+		const uint8_t* stored = m_File.GetData() + entry.Offset;
+		if (!(entry.Flags & PackEntry::Compressed))
+			return FileData::View(stored, (size_t)entry.Size);
+
+		std::unique_ptr<uint8_t[]> buffer(new uint8_t[(size_t)entry.Size]);
+		if (!LZ4::Decompress(stored, (size_t)entry.StoredSize, buffer.get(), (size_t)entry.Size)) {
+			SPARKY_CORE_ERROR("{0}: {1} is corrupt", m_Path, GetPath(entry));
+			return FileData();
+		}
+		return FileData::Own(std::move(buffer), (size_t)entry.Size);
+	}
+
+	std::string PackReader::GetPath(const PackEntry& entry) const
+	{
+		return std::string(m_Strings + entry.PathOffset, entry.PathLength);
+	}
+
+	void PackWriter::Add(const std::string& path, const uint8_t* data, size_t size, bool compress)
+	{
+		std::vector<uint8_t> stored;
+		bool compressed = Encode(data, size, compress, stored);
+		AddStored(path, std::move(stored), size, PackFile::HashContent(data, size), compressed);
+	}
+
+	void PackWriter::AddStored(const std::string& path, std::vector<uint8_t> stored, uint64_t size, uint64_t contentHash, bool compressed)
+	{
+		Entry entry;
+		entry.Path = path;
+		entry.Data = std::move(stored);
+		entry.Size = size;
+		entry.ContentHash = contentHash;
+		entry.Compressed = compressed;
+		m_Entries.push_back(std::move(entry));
+	}
+
+	bool PackWriter::Encode(const uint8_t* data, size_t size, bool compress, std::vector<uint8_t>& stored)
+	{
+		if (compress && size > 0) {
+			stored.resize(LZ4::CompressBound(size));
+			size_t compressed = LZ4::Compress(data, size, stored.data(), stored.size());
+			if (compressed && compressed <= size - size / 8) {
+				stored.resize(compressed);
+				return true;
+			}
+		}
+		stored.assign(data, data + size);
+		return false;
+	}
+
+	bool PackWriter::Write(const std::string& path) const
+	{
+		std::vector<const Entry*> order;
+		for (const Entry& entry : m_Entries)
+			order.push_back(&entry);
+		std::sort(order.begin(), order.end(), [](const Entry* a, const Entry* b) { return PackFile::HashPath(a->Path) < PackFile::HashPath(b->Path); });
+
+		std::string strings;
+		std::vector<PackEntry> toc(order.size());
+		for (size_t i = 0; i < order.size(); ++i) {
+			PackEntry& entry = toc[i];
+			memset(&entry, 0, sizeof(entry));
+			entry.PathHash = PackFile::HashPath(order[i]->Path);
+			entry.PathOffset = (uint32_t)strings.size();
+			entry.PathLength = (uint32_t)order[i]->Path.size();
+			entry.StoredSize = order[i]->Data.size();
+			entry.Size = order[i]->Size;
+			entry.ContentHash = order[i]->ContentHash;
+			entry.Flags = order[i]->Compressed ? PackEntry::Compressed : 0;
+			strings += order[i]->Path;
+		}
+
+		PackHeader header;
+		header.Magic = PackHeader::MagicValue;
+		header.Version = PackHeader::CurrentVersion;
+		header.EntryCount = (uint32_t)toc.size();
+		header.Alignment = PackFile::Alignment;
+		header.StringsOffset = sizeof(PackHeader) + toc.size() * sizeof(PackEntry);
+		header.StringsSize = strings.size();
+
+		uint64_t offset = header.StringsOffset + header.StringsSize;
+		for (PackEntry& entry : toc) {
+			offset = (offset + PackFile::Alignment - 1) & ~(uint64_t)(PackFile::Alignment - 1);
+			entry.Offset = offset;
+			offset += entry.StoredSize;
+		}
+
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file) {
+			SPARKY_CORE_ERROR("Could not write {0}", path);
+			return false;
+		}
+		bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+		if (!toc.empty())
+			ok = ok && fwrite(toc.data(), sizeof(PackEntry), toc.size(), file) == toc.size();
+		ok = ok && fwrite(strings.data(), 1, strings.size(), file) == strings.size();
+		uint64_t written = header.StringsOffset + header.StringsSize;
+		static const uint8_t s_Padding[PackFile::Alignment] = {};
+		for (size_t i = 0; i < toc.size() && ok; ++i) {
+			size_t padding = (size_t)(toc[i].Offset - written);
+			ok = fwrite(s_Padding, 1, padding, file) == padding;
+			if (!order[i]->Data.empty())
+				ok = ok && fwrite(order[i]->Data.data(), 1, order[i]->Data.size(), file) == order[i]->Data.size();
+			written = toc[i].Offset + toc[i].StoredSize;
+		}
+		ok = fclose(file) == 0 && ok;
+		if (!ok)
+			SPARKY_CORE_ERROR("Failed writing {0}", path);
+		return ok;
+	}
+
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "FileData.h"
+
+namespace sparky {
+
+	// Pack archive layout, little endian:
+	//
+	//   PackHeader
+	//   PackEntry[EntryCount]    sorted by PathHash
+	//   path strings             not terminated, PackEntry::PathOffset/PathLength
+	//   entry data               every entry starts on a 4 KB boundary
+	//
+	// The header, table of contents and strings come first so mounting reads
+	// one contiguous range; entries are views into the mapping. An entry is
+	// stored raw or as one LZ4 block (PackEntry::Compressed).
+	struct PackHeader
+	{
+		static const uint32_t MagicValue = 0x4B415053; // "SPAK"
+		static const uint32_t CurrentVersion = 1;
+
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t EntryCount;
+		uint32_t Alignment;
+		uint64_t StringsOffset;
+		uint64_t StringsSize;
+	};
+
+	struct PackEntry
+	{
+		static const uint32_t Compressed = 1;
+
+		uint64_t PathHash;
+		uint64_t Offset;
+		// bytes in the pack and bytes once decompressed
+		uint64_t StoredSize;
+		uint64_t Size;
+		// of the uncompressed data, for incremental rebuilds
+		uint64_t ContentHash;
+		uint32_t PathOffset;
+		uint32_t PathLength;
+		uint32_t Flags;
+		uint32_t Reserved;
+	};
+
+	class PackFile
+	{
+	public:
+		static const uint32_t Alignment = 4096;
+
+		// FNV-1a of the lower case path, so lookups ignore case everywhere
+		static uint64_t HashPath(const std::string& canonicalPath);
+		static uint64_t HashContent(const uint8_t* data, size_t size);
+	};
+
+	class PackReader
+	{
+	public:
+		bool Open(const std::string& path);
+		void Close();
+
+		const PackEntry* Find(const std::string& canonicalPath) const;
+		// A view into the mapping, or a decompressed copy for compressed entries
+		FileData Read(const PackEntry& entry) const;
+
+		inline uint32_t GetEntryCount() const { return m_EntryCount; }
+		inline const PackEntry* GetEntries() const { return m_Entries; }
+		std::string GetPath(const PackEntry& entry) const;
+		inline const std::string& GetFilePath() const { return m_Path; }
+	private:
+		MappedFile m_File;
+		std::string m_Path;
+		const PackEntry* m_Entries = nullptr;
+		const char* m_Strings = nullptr;
+		uint32_t m_EntryCount = 0;
+	};
+
+	// Collects entries in memory and writes them out as a pack. Compression is
+	// kept only when it saves at least an eighth of the entry.
+	class PackWriter
+	{
+	public:
+		void Add(const std::string& path, const uint8_t* data, size_t size, bool compress);
+		// Adds an entry already encoded by Encode, for tools that cache encoded entries
+		void AddStored(const std::string& path, std::vector<uint8_t> stored, uint64_t size, uint64_t contentHash, bool compressed);
+		bool Write(const std::string& path) const;
+
+		inline size_t GetEntryCount() const { return m_Entries.size(); }
+
+		// The bytes Add would store for data, returns whether they are compressed
+		static bool Encode(const uint8_t* data, size_t size, bool compress, std::vector<uint8_t>& stored);
+	private:
+		struct Entry
+		{
+			std::string Path;
+			std::vector<uint8_t> Data;
+			uint64_t Size, ContentHash;
+			bool Compressed;
+		};
+		std::vector<Entry> m_Entries;
+	};
+
+}
@@ -0,0 +1,237 @@
+#include <imgui/imgui.h>
+#include <time.h>
+#include <string>
+#include "PerfOverlay.h"
+#include "Layer.h"
+#include "Input.h"
+#include "GLIntercept.h"
+#include "Memory.h"
+#include "MemoryTracker.h"
+#include "AssetManager.h"
+#include "TextureStreamer.h"
+#include "Application.h"
+#include "DynamicResolution.h"
+#include "FrameContext.h"
+#include "FrameCapture.h"
+
+namespace sparky {
+
+	namespace {
+		inline float Milliseconds(PerfOverlay::Clock::duration d)
+		{
+			return std::chrono::duration<float, std::milli>(d).count();
+		}
+		// name_20261019_143000.ext, in the working directory
+		std::string TimestampedPath(const char* name, const char* extension)
+		{
+			char path[64];
+			time_t now = time(nullptr);
+			size_t length = strftime(path, sizeof(path), "_%Y%m%d_%H%M%S", localtime(&now));
+			return name + std::string(path, length) + extension;
+		}
+		inline uint64_t Microseconds(float milliseconds)
+		{
+			return milliseconds > 0.0f ? (uint64_t)(milliseconds * 1000.0f) : 0;
+		}
+	}
+
+	PerfOverlay& PerfOverlay::Get()
+	{
+		static PerfOverlay s_Instance;
+		return s_Instance;
+	}
+
+	void PerfOverlay::Init()
+	{
+		SPARKY_MEMORY_TAG(UI);
+		RenderStats::Install();
+		m_GpuTimer.Init();
+	}
+
+	void PerfOverlay::Shutdown()
+	{
+		m_GpuTimer.Shutdown();
+	}
+
+	void PerfOverlay::RecordLayer(const Layer* layer, Clock::time_point begin)
+	{
+		if (m_LayerCount < MaxLayers)
+			m_Layers[m_LayerCount++] = { layer, Milliseconds(Clock::now() - begin) };
+	}
+
+	void PerfOverlay::RecordSwap(Clock::time_point begin)
+	{
+		m_SwapMilliseconds = Milliseconds(Clock::now() - begin);
+	}
+
+	void PerfOverlay::EndFrame()
+	{
+		Clock::time_point now = Clock::now();
+		if (m_HasLastFrame) {
+			float frame = Milliseconds(now - m_LastFrameEnd);
+			// time blocked in the swap (vsync, a full GPU queue) is not CPU work
+			float cpu = frame - m_SwapMilliseconds;
+			m_FrameHistory[m_HistoryOffset] = frame;
+			m_CpuHistory[m_HistoryOffset] = cpu;
+			m_HistoryOffset = (m_HistoryOffset + 1) % HistoryLength;
+			m_FrameHistogram.Record(Microseconds(frame));
+			m_CpuHistogram.Record(Microseconds(cpu));
+		}
+		m_LastFrameEnd = now;
+		m_HasLastFrame = true;
+
+		float gpu;
+		m_NewGpuFrame = false;
+		while (m_GpuTimer.Poll(gpu)) {
+			m_NewGpuFrame = true;
+			m_GpuHistory[m_GpuHistoryOffset] = gpu;
+			m_GpuHistoryOffset = (m_GpuHistoryOffset + 1) % HistoryLength;
+			m_GpuHistogram.Record(Microseconds(gpu));
+		}
+
+		m_LastStats = RenderStats::EndFrame();
+		for (int i = 0; i < m_LayerCount; ++i)
+			m_LastLayers[i] = m_Layers[i];
+		m_LastLayerCount = m_LayerCount;
+		m_LayerCount = 0;
+	}
+
+	PerfOverlay::Percentiles PerfOverlay::Summarize(const HdrHistogram& histogram)
+	{
+		Percentiles p;
+		p.P50 = histogram.GetPercentile(50.0) / 1000.0f;
+		p.P95 = histogram.GetPercentile(95.0) / 1000.0f;
+		p.P99 = histogram.GetPercentile(99.0) / 1000.0f;
+		p.Max = histogram.GetMax() / 1000.0f;
+		return p;
+	}
+
+	void PerfOverlay::DrawPercentiles(const char* label, const Percentiles& p)
+	{
+		ImGui::Text("%-6s %7.2f %7.2f %7.2f %7.2f", label, p.P50, p.P95, p.P99, p.Max);
+	}
+
+	void PerfOverlay::Draw()
+	{
+		if (Input::GetSnapshot().WasKeyPressed(SP_KEY_F3))
+			m_Visible = !m_Visible;
+		if (Input::GetSnapshot().WasKeyPressed(SP_KEY_F12))
+			graphics::FrameCapture::Screenshot(TimestampedPath("screenshot", ".png"));
+		if (m_ShowDemoWindow)
+			ImGui::ShowDemoWindow(&m_ShowDemoWindow);
+		if (!m_Visible)
+			return;
+
+		Clock::time_point begin = Clock::now();
+		if (begin - m_LastSummary > std::chrono::milliseconds(250)) {
+			m_FramePercentiles = Summarize(m_FrameHistogram);
+			m_CpuPercentiles = Summarize(m_CpuHistogram);
+			m_GpuPercentiles = Summarize(m_GpuHistogram);
+			m_LastSummary = begin;
+		}
+
+		ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_FirstUseEver);
+		ImGui::SetNextWindowBgAlpha(0.7f);
+		ImGui::Begin("Performance (F3)", &m_Visible, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav);
+
+		int last = (m_HistoryOffset + HistoryLength - 1) % HistoryLength;
+		int lastGpu = (m_GpuHistoryOffset + HistoryLength - 1) % HistoryLength;
+		char overlay[32];
+		snprintf(overlay, sizeof(overlay), "cpu %.2f ms", m_CpuHistory[last]);
+		ImGui::PlotLines("##cpu", m_CpuHistory, HistoryLength, m_HistoryOffset, overlay, 0.0f, 33.3f, ImVec2(240.0f, 50.0f));
+		snprintf(overlay, sizeof(overlay), "gpu %.2f ms", m_GpuHistory[lastGpu]);
+		ImGui::PlotLines("##gpu", m_GpuHistory, HistoryLength, m_GpuHistoryOffset, overlay, 0.0f, 33.3f, ImVec2(240.0f, 50.0f));
+
+		ImGui::Text("ms         p50     p95     p99     max");
+		DrawPercentiles("frame", m_FramePercentiles);
+		DrawPercentiles("cpu", m_CpuPercentiles);
+		DrawPercentiles("gpu", m_GpuPercentiles);
+		if (ImGui::Button("Reset")) {
+			m_FrameHistogram.Reset();
+			m_CpuHistogram.Reset();
+			m_GpuHistogram.Reset();
+			m_LastSummary = Clock::time_point();
+		}
+
+		ImGui::Separator();
+		ImGui::Text("draw calls     %u", m_LastStats.DrawCalls);
+		ImGui::Text("triangles      %llu", (unsigned long long)m_LastStats.Triangles);
+		ImGui::Text("state changes  %u", m_LastStats.StateChanges);
+		ImGui::Text("uploads        %.1f KB", m_LastStats.UploadBytes / 1024.0f);
+		AssetManager::Stats assets = AssetManager::GetStats();
+		ImGui::Text("assets         %u live, %u cached (%.1f MB)", assets.Referenced, assets.Cached, assets.CachedBytes / 1048576.0f);
+		ImGui::Text("asset loads    %u, %u cache hits", assets.Loads, assets.CacheHits);
+		TextureStreamer::Stats streaming = TextureStreamer::GetStats();
+		if (streaming.Textures) {
+			ImGui::Text("streamed       %.1f / %.1f MB, %u textures", streaming.ResidentBytes / 1048576.0f, streaming.Budget / 1048576.0f, streaming.Textures);
+			ImGui::Text("streaming      %u loading, %u uploading, %.1f KB this frame", streaming.Loading, streaming.Uploading, streaming.UploadedBytes / 1024.0f);
+			ImGui::Text("stream loads   %u, %u evictions", streaming.Loads, streaming.Evictions);
+		}
+		ImGui::Text("frame arena    %.1f / %.1f KB", Memory::GetFrameArena().GetPeak() / 1024.0f, Memory::GetFrameArena().GetCapacity() / 1024.0f);
+#if SPARKY_TRACK_MEMORY
+		ImGui::Text("heap allocs    %u this frame, %u steady frames allocated", MemoryTracker::GetFrameAllocations(), MemoryTracker::GetAllocatingFrames());
+#endif
+		graphics::FrameContext::Stats frames = graphics::FrameContext::GetStats();
+		ImGui::Text("in flight      %u frames, %.2f ms waited, %u stalls", graphics::FrameContext::FramesInFlight, frames.WaitMilliseconds, frames.Stalls);
+		ImGui::Text("transient      %.1f / %.1f KB, %u overflows%s", frames.TransientUsed / 1024.0f, frames.TransientCapacity / 1024.0f, frames.Overflows, frames.Persistent ? ", mapped" : "");
+		ImGui::Text("deferred       %u pending, %u deleted", frames.PendingDeletions, frames.Deletions);
+		Application& app = Application::Get();
+		if (const DynamicResolution* resolution = app.GetDynamicResolution())
+			ImGui::Text("resolution     %3.0f%%, %dx%d for %.1f ms", resolution->GetScale() * 100.0f, app.GetRenderWidth(), app.GetRenderHeight(), resolution->GetSettings().BudgetMilliseconds);
+
+		ImGui::Separator();
+		if (ImGui::Button("Screenshot (F12)"))
+			graphics::FrameCapture::Screenshot(TimestampedPath("screenshot", ".png"));
+		ImGui::SameLine();
+		bool recording = graphics::FrameCapture::IsRecording();
+		if (ImGui::Checkbox("Record", &recording)) {
+			if (recording)
+				graphics::FrameCapture::StartRecording(TimestampedPath("capture", ".y4m"));
+			else
+				graphics::FrameCapture::StopRecording();
+		}
+		graphics::FrameCapture::Stats capture = graphics::FrameCapture::GetStats();
+		if (capture.Captured)
+			ImGui::Text("capture        %u frames, %u encoded, %u dropped, %.1f MB queued", capture.Captured, capture.Encoded, capture.Dropped, capture.QueuedBytes / 1048576.0f);
+
+		ImGui::Separator();
+		bool intercept = GLIntercept::IsInstalled();
+		if (ImGui::Checkbox("GL interception", &intercept)) {
+			if (intercept)
+				GLIntercept::Install();
+			else
+				GLIntercept::Uninstall();
+		}
+		if (GLIntercept::IsInstalled()) {
+			ImGui::Text("gl calls       %u", GLIntercept::GetFrameCalls());
+			ImGui::Text("driver time    %.3f ms", GLIntercept::GetFrameDriverMilliseconds());
+			ImGui::Text("sync points    %u", GLIntercept::GetFrameStalls());
+			ImGui::Text("state queries  %u", GLIntercept::GetFrameStateQueries());
+			GLIntercept::CallStat top[5];
+			int count = GLIntercept::GetTopFunctions(top, 5);
+			for (int i = 0; i < count; ++i)
+				ImGui::Text("  %-24s %5u %8.1f us", top[i].Name, top[i].Calls, top[i].Microseconds);
+		}
+
+#if SPARKY_TRACK_MEMORY
+		ImGui::Separator();
+		ImGui::Text("memory KB      live     peak   budget");
+		for (int i = 0; i < (int)MemoryTag::Count; ++i) {
+			MemoryTagStats stats = MemoryTracker::GetStats((MemoryTag)i);
+			ImGui::Text("%-10s %8.1f %8.1f %8.1f", MemoryTracker::GetTagName((MemoryTag)i), stats.LiveBytes / 1024.0f, stats.PeakBytes / 1024.0f, stats.Budget / 1024.0f);
+		}
+#endif
+
+		ImGui::Separator();
+		for (int i = 0; i < m_LastLayerCount; ++i)
+			ImGui::Text("%-14s %6.3f ms", m_LastLayers[i].Owner->GetName().c_str(), m_LastLayers[i].Milliseconds);
+		ImGui::Text("%-14s %6.3f ms", "swap", m_SwapMilliseconds);
+		ImGui::Text("overlay        %.1f us", m_DrawMicroseconds);
+
+		ImGui::Checkbox("ImGui demo", &m_ShowDemoWindow);
+		ImGui::End();
+
+		m_DrawMicroseconds = std::chrono::duration<float, std::micro>(Clock::now() - begin).count();
+	}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include "HdrHistogram.h"
+#include "RenderStats.h"
+
+namespace sparky {
+
+	class Layer;
+
+	// Frame statistics and the ImGui panel that shows them: rolling CPU and GPU
+	// frame time graphs, HDR histogram percentiles, the RenderStats counters and
+	// the update time of every layer. Application feeds it from EndFrame and
+	// ImGuiLayer draws it; F3 toggles the panel.
+	//
+	// Collecting is a handful of clock reads and adds per frame and drawing
+	// refreshes the percentiles four times a second, so the panel costs well
+	// under 50 us and can stay on in release builds.
+	class PerfOverlay
+	{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		static const int HistoryLength = 240;
+		static const int MaxLayers = 16;
+
+		static PerfOverlay& Get();
+
+		// Needs a current GL context
+		void Init();
+		void Shutdown();
+
+		void BeginGpuFrame() { m_GpuTimer.Begin(); }
+		void EndGpuFrame() { m_GpuTimer.End(); }
+		void RecordLayer(const Layer* layer, Clock::time_point begin);
+		void RecordSwap(Clock::time_point begin);
+		void EndFrame();
+
+		void Draw();
+
+		inline bool IsVisible() const { return m_Visible; }
+		inline void SetVisible(bool visible) { m_Visible = visible; }
+		inline const HdrHistogram& GetFrameHistogram() const { return m_FrameHistogram; }
+		// True when a GPU frame finished during the last EndFrame, the newest one's time
+		inline bool GetGpuFrameTime(float& milliseconds) const { milliseconds = m_GpuTimer.GetLastMilliseconds(); return m_NewGpuFrame; }
+	private:
+		PerfOverlay() {}
+
+		struct LayerTime
+		{
+			const Layer* Owner;
+			float Milliseconds;
+		};
+		struct Percentiles
+		{
+			float P50 = 0.0f, P95 = 0.0f, P99 = 0.0f, Max = 0.0f;
+		};
+		static Percentiles Summarize(const HdrHistogram& histogram);
+		void DrawPercentiles(const char* label, const Percentiles& p);
+	private:
+		GpuTimer m_GpuTimer;
+		Clock::time_point m_LastFrameEnd;
+		bool m_HasLastFrame = false;
+
+		float m_FrameHistory[HistoryLength] = {};
+		float m_CpuHistory[HistoryLength] = {};
+		float m_GpuHistory[HistoryLength] = {};
+		int m_HistoryOffset = 0, m_GpuHistoryOffset = 0;
+		bool m_NewGpuFrame = false;
+		HdrHistogram m_FrameHistogram, m_CpuHistogram, m_GpuHistogram;
+		Percentiles m_FramePercentiles, m_CpuPercentiles, m_GpuPercentiles;
+		Clock::time_point m_LastSummary;
+
+		RenderStats m_LastStats;
+		LayerTime m_Layers[MaxLayers] = {}, m_LastLayers[MaxLayers] = {};
+		int m_LayerCount = 0, m_LastLayerCount = 0;
+		float m_SwapMilliseconds = 0.0f;
+		float m_DrawMicroseconds = 0.0f;
+
+		bool m_Visible = true;
+		bool m_ShowDemoWindow = false;
+	};
+
+}
@@ -0,0 +1,63 @@
+#include "Pool.h"
+#include <stdint.h>
+
+namespace sparky {
+
+	Pool::Pool(size_t blockSize, size_t alignment, size_t blocksPerChunk, MemoryTag tag)
+		: m_Alignment(alignment < alignof(FreeBlock) ? alignof(FreeBlock) : alignment), m_BlocksPerChunk(blocksPerChunk), m_Tag(tag)
+	{
+		// a free block has to hold the list link and keep the next block aligned
+		size_t size = blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize;
+		m_BlockSize = (size + m_Alignment - 1) & ~(m_Alignment - 1);
+	}
+
+	Pool::~Pool()
+	{
+		while (m_Chunks) {
+			Chunk* next = m_Chunks->Next;
+			::operator delete(m_Chunks);
+			m_Chunks = next;
+		}
+	}
+
+	void* Pool::Allocate()
+	{
+		if (!m_Free)
+			Grow();
+		FreeBlock* block = m_Free;
+		m_Free = block->Next;
+		++m_Live;
+		return block;
+	}
+
+	void Pool::Free(void* block)
+	{
+		if (!block)
+			return;
+		FreeBlock* node = static_cast<FreeBlock*>(block);
+		node->Next = m_Free;
+		m_Free = node;
+		--m_Live;
+	}
+
+	void Pool::Grow()
+	{
+		// the chunk header is padded so the first block is aligned
+		size_t header = (sizeof(Chunk) + m_Alignment - 1) & ~(m_Alignment - 1);
+		MemoryTagScope tag(m_Tag);
+		char* memory = static_cast<char*>(::operator new(header + m_BlockSize * m_BlocksPerChunk + m_Alignment));
+		Chunk* chunk = reinterpret_cast<Chunk*>(memory);
+		chunk->Next = m_Chunks;
+		m_Chunks = chunk;
+
+		uintptr_t first = (reinterpret_cast<uintptr_t>(memory) + header + m_Alignment - 1) & ~(uintptr_t)(m_Alignment - 1);
+		// push in reverse so blocks are handed out in address order
+		for (size_t i = m_BlocksPerChunk; i-- > 0;) {
+			FreeBlock* block = reinterpret_cast<FreeBlock*>(first + i * m_BlockSize);
+			block->Next = m_Free;
+			m_Free = block;
+		}
+		m_Capacity += m_BlocksPerChunk;
+	}
+
+}
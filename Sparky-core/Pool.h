@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "MemoryTracker.h"
+
+namespace sparky {
+
+	// Fixed size blocks carved out of larger chunks. Free blocks form an
+	// intrusive list, so allocating and freeing are a couple of pointer moves.
+	// Chunks go back to the heap only when the pool is destroyed. Not thread
+	// safe, every pool belongs to one thread.
+	class Pool
+	{
+	public:
+		// Chunks are charged to tag
+		Pool(size_t blockSize, size_t alignment = alignof(std::max_align_t), size_t blocksPerChunk = 64, MemoryTag tag = MemoryTag::General);
+		~Pool();
+		Pool(const Pool&) = delete;
+		Pool& operator=(const Pool&) = delete;
+
+		void* Allocate();
+		void Free(void* block);
+
+		inline size_t GetBlockSize() const { return m_BlockSize; }
+		// every block is aligned to it
+		inline size_t GetAlignment() const { return m_Alignment; }
+		inline size_t GetLiveCount() const { return m_Live; }
+		inline size_t GetCapacity() const { return m_Capacity; }
+	private:
+		void Grow();
+	private:
+		struct FreeBlock { FreeBlock* Next; };
+		struct Chunk { Chunk* Next; };
+
+		FreeBlock* m_Free = nullptr;
+		Chunk* m_Chunks = nullptr;
+		size_t m_BlockSize, m_Alignment, m_BlocksPerChunk;
+		size_t m_Live = 0, m_Capacity = 0;
+		MemoryTag m_Tag;
+	};
+
+	template<typename T>
+	class TypedPool
+	{
+	public:
+		TypedPool(size_t blocksPerChunk = 64, MemoryTag tag = MemoryTag::General)
+			: m_Pool(sizeof(T), alignof(T), blocksPerChunk, tag) {}
+
+		template<typename... Args>
+		T* New(Args&&... args) { return new (m_Pool.Allocate()) T(std::forward<Args>(args)...); }
+		void Delete(T* object)
+		{
+			if (!object)
+				return;
+			object->~T();
+			m_Pool.Free(object);
+		}
+
+		inline Pool& GetPool() { return m_Pool; }
+	private:
+		Pool m_Pool;
+	};
+
+}
+
+// Routes new and delete of a class through a pool of its own, so existing
+// `new Type(...)` call sites allocate from the pool. Derived classes that are
+// larger than the block fall back to the global heap.
+#define SPARKY_POOLED_CLASS(Type, Tag) \
+	public: \
+		static ::sparky::Pool& GetPool() { static ::sparky::Pool s_Pool(sizeof(Type), alignof(Type), 64, ::sparky::MemoryTag::Tag); return s_Pool; } \
+		static void* operator new(size_t size) { return size <= sizeof(Type) ? GetPool().Allocate() : ::operator new(size); } \
+		static void operator delete(void* p, size_t size) { if (size <= sizeof(Type)) GetPool().Free(p); else ::operator delete(p); }
@@ -0,0 +1,361 @@
+#include "PostProcess.h"
+#include <algorithm>
+#include "Log.h"
+#include "FrameContext.h"
+#include "MemoryTracker.h"
+
+namespace sparky {
+	namespace graphics {
+		namespace {
+			const char* s_VertexSource = R"(#version 330 core
+out vec2 v_UV;
+void main()
+{
+	v_UV = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	gl_Position = vec4(v_UV * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+			const char* s_FragmentHeader = R"(#version 330 core
+in vec2 v_UV;
+out vec4 FragColor;
+uniform sampler2D u_Source;
+uniform sampler2D u_Scene;
+uniform vec2 u_SourceTexel;
+// the parts of the textures holding the image, and the last texel centres
+// inside them, so bilinear taps never blend in what lies beyond
+uniform vec2 u_SourceScale;
+uniform vec2 u_SceneScale;
+uniform vec2 u_SourceMax;
+uniform vec2 u_SceneMax;
+
+vec2 SourceUV(vec2 uv)
+{
+	return clamp(uv, u_SourceTexel * 0.5, u_SourceMax);
+}
+
+vec4 Scene(vec2 uv)
+{
+	return texture(u_Scene, min(uv * u_SceneScale, u_SceneMax));
+}
+)";
+		}
+
+		Framebuffer* RenderTargetPool::Acquire(GLsizei width, GLsizei height, GLenum format) {
+			for (Target& target : m_Targets) {
+				const FramebufferSpec& spec = target.Buffer->GetSpec();
+				if (!target.InUse && spec.Width == width && spec.Height == height && spec.ColorFormat == format) {
+					target.InUse = true;
+					target.Idle = 0;
+					return target.Buffer.get();
+				}
+			}
+			SPARKY_MEMORY_TAG(Renderer);
+			FramebufferSpec spec;
+			spec.Width = width;
+			spec.Height = height;
+			spec.ColorFormat = format;
+			spec.DepthFormat = 0;
+			m_Targets.push_back({ std::unique_ptr<Framebuffer>(new Framebuffer(spec)), true, 0 });
+			return m_Targets.back().Buffer.get();
+		}
+
+		void RenderTargetPool::Release(Framebuffer* target) {
+			for (Target& t : m_Targets) {
+				if (t.Buffer.get() == target)
+					t.InUse = false;
+			}
+		}
+
+		void RenderTargetPool::Trim(unsigned int frames) {
+			m_Targets.erase(std::remove_if(m_Targets.begin(), m_Targets.end(), [frames](Target& target) {
+				return !target.InUse && ++target.Idle > frames;
+			}), m_Targets.end());
+		}
+
+		void RenderTargetPool::Clear() {
+			m_Targets.clear();
+		}
+
+		PostProcessChain::PostProcessChain(GLenum format)
+			: m_Format(format)
+		{
+			glGenVertexArrays(1, &m_ArrayID);
+		}
+
+		PostProcessChain::~PostProcessChain() {
+			FrameContext::DeleteVertexArray(m_ArrayID);
+		}
+
+		void PostProcessChain::AddPass(const PostPass& pass) {
+			m_Passes.push_back(pass);
+			m_Dirty = true;
+		}
+
+		void PostProcessChain::SetEnabled(const std::string& name, bool enabled) {
+			for (PostPass& pass : m_Passes) {
+				if (pass.Name == name && pass.Enabled != enabled) {
+					pass.Enabled = enabled;
+					m_Dirty = true;
+				}
+			}
+		}
+
+		void PostProcessChain::SetParameter(const std::string& uniform, float value) {
+			m_Parameters[uniform] = value;
+		}
+
+		float PostProcessChain::GetParameter(const std::string& uniform) const {
+			auto it = m_Parameters.find(uniform);
+			return it != m_Parameters.end() ? it->second : 0.0f;
+		}
+
+		size_t PostProcessChain::GetStageCount() {
+			if (m_Dirty)
+				Build();
+			return m_Stages.size();
+		}
+
+		void PostProcessChain::Build() {
+			m_Stages.clear();
+			for (size_t i = 0; i < m_Passes.size(); ++i) {
+				const PostPass& pass = m_Passes[i];
+				if (!pass.Enabled)
+					continue;
+				if (m_Stages.empty() || pass.Neighborhood || pass.Scale != m_Stages.back().Scale)
+					m_Stages.push_back({ {}, pass.Scale, nullptr });
+				m_Stages.back().Passes.push_back(i);
+			}
+			// nothing enabled still copies the scene out
+			if (m_Stages.empty())
+				m_Stages.push_back({ {}, 1.0f, nullptr });
+			for (Stage& stage : m_Stages)
+				stage.Program = GetProgram(stage);
+			m_Dirty = false;
+		}
+
+		Shader* PostProcessChain::GetProgram(const Stage& stage) {
+			std::string key = "post";
+			for (size_t pass : stage.Passes)
+				key += ":" + m_Passes[pass].Name;
+			auto it = m_Programs.find(key);
+			if (it != m_Programs.end())
+				return it->second.get();
+
+			std::string source = s_FragmentHeader;
+			for (size_t pass : stage.Passes)
+				source += m_Passes[pass].Code + "\n";
+			source += "void main()\n{\n";
+			size_t first = 0;
+			if (!stage.Passes.empty() && m_Passes[stage.Passes[0]].Neighborhood) {
+				source += "\tvec4 color = " + m_Passes[stage.Passes[0]].Name + "(u_Source, v_UV * u_SourceScale, u_SourceTexel);\n";
+				first = 1;
+			}
+			else {
+				source += "\tvec4 color = texture(u_Source, SourceUV(v_UV * u_SourceScale));\n";
+			}
+			for (size_t i = first; i < stage.Passes.size(); ++i)
+				source += "\tcolor = " + m_Passes[stage.Passes[i]].Name + "(color, v_UV);\n";
+			source += "\tFragColor = color;\n}\n";
+
+			SPARKY_MEMORY_TAG(Renderer);
+			Shader* program = new Shader(key, s_VertexSource, source);
+			m_Programs.emplace(key, std::unique_ptr<Shader>(program));
+			return program;
+		}
+
+		void PostProcessChain::DrawStage(const Stage& stage, const Framebuffer& source, const glm::vec2& sourceScale, const glm::vec2& sceneScale, const glm::vec2& sceneMax, GLuint sceneTexture) {
+			Shader& program = *stage.Program;
+			program.enable();
+			program.setUniform1i("u_Source", 0);
+			program.setUniform1i("u_Scene", 1);
+			glm::vec2 texel(1.0f / source.GetWidth(), 1.0f / source.GetHeight());
+			glUniform2f(program.getUniformLocation("u_SourceTexel"), texel.x, texel.y);
+			glUniform2f(program.getUniformLocation("u_SourceScale"), sourceScale.x, sourceScale.y);
+			glUniform2f(program.getUniformLocation("u_SceneScale"), sceneScale.x, sceneScale.y);
+			glUniform2f(program.getUniformLocation("u_SourceMax"), sourceScale.x - texel.x * 0.5f, sourceScale.y - texel.y * 0.5f);
+			glUniform2f(program.getUniformLocation("u_SceneMax"), sceneMax.x, sceneMax.y);
+			for (const auto& parameter : m_Parameters) {
+				GLint location = program.getUniformLocation(parameter.first.c_str());
+				if (location != -1)
+					glUniform1f(location, parameter.second);
+			}
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, sceneTexture);
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, source.GetColorAttachment());
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+
+		void PostProcessChain::Apply(const Framebuffer& source, GLsizei sourceWidth, GLsizei sourceHeight, Framebuffer* target, GLsizei width, GLsizei height) {
+			if (m_Dirty)
+				Build();
+
+			// the demos bind once outside their loops, so whatever this touches is
+			// put back, the same way the ImGui backend does it
+			GLint lastProgram, lastArray, lastActiveTexture, lastTexture0, lastTexture1, lastPolygonMode[2];
+			glGetIntegerv(GL_CURRENT_PROGRAM, &lastProgram);
+			glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &lastArray);
+			glGetIntegerv(GL_ACTIVE_TEXTURE, &lastActiveTexture);
+			glActiveTexture(GL_TEXTURE1);
+			glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture1);
+			glActiveTexture(GL_TEXTURE0);
+			glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture0);
+			glGetIntegerv(GL_POLYGON_MODE, lastPolygonMode);
+			GLboolean lastDepthTest = glIsEnabled(GL_DEPTH_TEST);
+			GLboolean lastBlend = glIsEnabled(GL_BLEND);
+			GLboolean lastCullFace = glIsEnabled(GL_CULL_FACE);
+			GLboolean lastScissorTest = glIsEnabled(GL_SCISSOR_TEST);
+
+			glDisable(GL_DEPTH_TEST);
+			glDisable(GL_BLEND);
+			glDisable(GL_CULL_FACE);
+			glDisable(GL_SCISSOR_TEST);
+			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+			glBindVertexArray(m_ArrayID);
+
+			GLuint scene = source.GetColorAttachment();
+			glm::vec2 sceneScale((float)sourceWidth / source.GetWidth(), (float)sourceHeight / source.GetHeight());
+			// below full resolution the texels past the rendered region hold the clear colour
+			glm::vec2 sceneMax(sceneScale.x - 0.5f / source.GetWidth(), sceneScale.y - 0.5f / source.GetHeight());
+			const Framebuffer* input = &source;
+			glm::vec2 inputScale = sceneScale;
+			Framebuffer* previous = nullptr;
+			for (size_t i = 0; i < m_Stages.size(); ++i) {
+				const Stage& stage = m_Stages[i];
+				// the last stage always draws the output at full size
+				Framebuffer* output = nullptr;
+				if (i + 1 < m_Stages.size()) {
+					GLsizei stageWidth = std::max((GLsizei)1, (GLsizei)(width * stage.Scale + 0.5f));
+					GLsizei stageHeight = std::max((GLsizei)1, (GLsizei)(height * stage.Scale + 0.5f));
+					output = m_Targets.Acquire(stageWidth, stageHeight, m_Format);
+					output->bind();
+				}
+				else if (target) {
+					target->bind();
+				}
+				else {
+					Framebuffer::BindDefault(width, height);
+				}
+				DrawStage(stage, *input, inputScale, sceneScale, sceneMax, scene);
+
+				// a stage only ever reads the one before it
+				if (previous)
+					m_Targets.Release(previous);
+				previous = output;
+				if (output) {
+					input = output;
+					inputScale = glm::vec2(1.0f);
+				}
+			}
+			m_Targets.Trim();
+
+			glUseProgram((GLuint)lastProgram);
+			glBindVertexArray((GLuint)lastArray);
+			glBindTexture(GL_TEXTURE_2D, (GLuint)lastTexture0);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, (GLuint)lastTexture1);
+			glActiveTexture((GLenum)lastActiveTexture);
+			glPolygonMode(GL_FRONT_AND_BACK, (GLenum)lastPolygonMode[0]);
+			if (lastDepthTest) glEnable(GL_DEPTH_TEST);
+			if (lastBlend) glEnable(GL_BLEND);
+			if (lastCullFace) glEnable(GL_CULL_FACE);
+			if (lastScissorTest) glEnable(GL_SCISSOR_TEST);
+		}
+
+		PostPass PostProcessChain::Bloom(float scale) {
+			// 13 bilinear taps in the pattern of Jimenez's Call of Duty downsample,
+			// spaced so that together they cover the whole footprint of a target texel
+			PostPass pass;
+			pass.Name = "Bloom";
+			pass.Neighborhood = true;
+			pass.Scale = scale;
+			pass.Code = "const float BloomStep = " + std::to_string(0.5f / scale) + R"(;
+uniform float u_BloomThreshold;
+
+vec3 BloomTap(sampler2D source, vec2 uv)
+{
+	vec3 c = texture(source, SourceUV(uv)).rgb;
+	float brightness = max(c.r, max(c.g, c.b));
+	float knee = u_BloomThreshold * 0.5;
+	float soft = clamp(brightness - u_BloomThreshold + knee, 0.0, 2.0 * knee);
+	soft = soft * soft / (4.0 * knee + 1e-4);
+	return c * max(soft, brightness - u_BloomThreshold) / max(brightness, 1e-4);
+}
+
+vec4 Bloom(sampler2D source, vec2 uv, vec2 texel)
+{
+	vec2 d = texel * BloomStep;
+	vec3 inner = BloomTap(source, uv + d * vec2(-1.0, 1.0)) + BloomTap(source, uv + d * vec2(1.0, 1.0))
+		+ BloomTap(source, uv + d * vec2(-1.0, -1.0)) + BloomTap(source, uv + d * vec2(1.0, -1.0));
+	vec3 corners = BloomTap(source, uv + d * vec2(-2.0, 2.0)) + BloomTap(source, uv + d * vec2(2.0, 2.0))
+		+ BloomTap(source, uv + d * vec2(-2.0, -2.0)) + BloomTap(source, uv + d * vec2(2.0, -2.0));
+	vec3 edges = BloomTap(source, uv + d * vec2(0.0, 2.0)) + BloomTap(source, uv + d * vec2(-2.0, 0.0))
+		+ BloomTap(source, uv + d * vec2(2.0, 0.0)) + BloomTap(source, uv + d * vec2(0.0, -2.0));
+	vec3 center = BloomTap(source, uv);
+	return vec4(center * 0.125 + inner * 0.125 + corners * 0.03125 + edges * 0.0625, 1.0);
+}
+)";
+			return pass;
+		}
+
+		PostPass PostProcessChain::BloomComposite() {
+			PostPass pass;
+			pass.Name = "BloomComposite";
+			pass.Neighborhood = true;
+			pass.Code = R"(uniform float u_BloomIntensity;
+
+vec4 BloomComposite(sampler2D source, vec2 uv, vec2 texel)
+{
+	vec3 bloom = texture(source, SourceUV(uv)).rgb * 4.0;
+	bloom += (texture(source, SourceUV(uv + texel * vec2(-1.0, 0.0))).rgb + texture(source, SourceUV(uv + texel * vec2(1.0, 0.0))).rgb
+		+ texture(source, SourceUV(uv + texel * vec2(0.0, -1.0))).rgb + texture(source, SourceUV(uv + texel * vec2(0.0, 1.0))).rgb) * 2.0;
+	bloom += texture(source, SourceUV(uv + texel * vec2(-1.0, -1.0))).rgb + texture(source, SourceUV(uv + texel * vec2(1.0, -1.0))).rgb
+		+ texture(source, SourceUV(uv + texel * vec2(-1.0, 1.0))).rgb + texture(source, SourceUV(uv + texel * vec2(1.0, 1.0))).rgb;
+	vec4 scene = Scene(v_UV);
+	return vec4(scene.rgb + bloom * (u_BloomIntensity / 16.0), scene.a);
+}
+)";
+			return pass;
+		}
+
+		PostPass PostProcessChain::Tonemap() {
+			// Narkowicz's fit of the ACES filmic curve
+			PostPass pass;
+			pass.Name = "Tonemap";
+			pass.Code = R"(uniform float u_Exposure;
+
+vec4 Tonemap(vec4 color, vec2 uv)
+{
+	vec3 x = color.rgb * u_Exposure;
+	x = clamp((x * (2.51 * x + 0.03)) / (x * (2.43 * x + 0.59) + 0.14), 0.0, 1.0);
+	return vec4(x, 1.0);
+}
+)";
+			return pass;
+		}
+
+		PostPass PostProcessChain::Vignette() {
+			PostPass pass;
+			pass.Name = "Vignette";
+			pass.Code = R"(uniform float u_Vignette;
+
+vec4 Vignette(vec4 color, vec2 uv)
+{
+	vec2 d = uv - 0.5;
+	return vec4(color.rgb * clamp(1.0 - u_Vignette * dot(d, d) * 2.0, 0.0, 1.0), color.a);
+}
+)";
+			return pass;
+		}
+
+		void PostProcessChain::AddBloomTonemap() {
+			AddPass(Bloom());
+			AddPass(BloomComposite());
+			AddPass(Tonemap());
+			SetParameter("u_BloomThreshold", 0.8f);
+			SetParameter("u_BloomIntensity", 0.6f);
+			SetParameter("u_Exposure", 1.0f);
+		}
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Framebuffer.h"
+#include "Shader.h"
+
+namespace sparky {
+	namespace graphics {
+		// One effect of a PostProcessChain. Code is GLSL declaring the uniforms
+		// the pass reads and a function called Name:
+		//   vec4 Name(vec4 color, vec2 uv)                    per pixel
+		//   vec4 Name(sampler2D source, vec2 uv, vec2 texel)  reads neighbours
+		// uv is the output position, except that a neighbourhood pass gets it
+		// mapped into source for its taps, which go through SourceUV(uv) so they
+		// stay inside the part of source holding the image. Every pass can also
+		// read the chain's input with Scene(v_UV).
+		struct PostPass {
+			std::string Name;
+			std::string Code;
+			bool Neighborhood = false;
+			// resolution of the stage this pass starts, as a fraction of the output
+			float Scale = 1.0f;
+			bool Enabled = true;
+		};
+
+		// Color targets recycled by size and format, so a chain of any length
+		// ping-pongs between the same few. Targets nobody acquired for a while
+		// are freed by Trim.
+		class RenderTargetPool {
+		public:
+			Framebuffer* Acquire(GLsizei width, GLsizei height, GLenum format);
+			void Release(Framebuffer* target);
+			// Frees targets unused for more than frames calls to Trim
+			void Trim(unsigned int frames = 120);
+			void Clear();
+
+			inline size_t GetTargetCount() const { return m_Targets.size(); }
+		private:
+			struct Target {
+				std::unique_ptr<Framebuffer> Buffer;
+				bool InUse;
+				unsigned int Idle;
+			};
+			std::vector<Target> m_Targets;
+		};
+
+		// Full screen passes over a rendered scene. Passes are fused into as few
+		// draws as possible: a stage starts at a neighbourhood pass or at a change
+		// of scale, and every per pixel pass after it runs in the same shader on
+		// the value the previous one returned. Fused shaders are generated and
+		// compiled once per combination of passes.
+		//
+		// Each stage writes a pooled target at its scale of the output and the
+		// next stage reads it as source, the last stage draws into the output.
+		class PostProcessChain {
+		public:
+			PostProcessChain(GLenum format = GL_RGBA16F);
+			~PostProcessChain();
+			PostProcessChain(const PostProcessChain&) = delete;
+			PostProcessChain& operator=(const PostProcessChain&) = delete;
+
+			void AddPass(const PostPass& pass);
+			void SetEnabled(const std::string& name, bool enabled);
+			// A float uniform of any pass, set on every stage that declares it
+			void SetParameter(const std::string& uniform, float value);
+			float GetParameter(const std::string& uniform) const;
+
+			// Runs the chain on the bottom left sourceWidth x sourceHeight of source's
+			// color attachment into target, or into the window's framebuffer when
+			// target is null, scaling it to the output size width x height. GL
+			// state it changes is restored, the output stays bound.
+			void Apply(const Framebuffer& source, GLsizei sourceWidth, GLsizei sourceHeight, Framebuffer* target, GLsizei width, GLsizei height);
+			inline void Apply(const Framebuffer& source, Framebuffer* target, GLsizei width, GLsizei height) { Apply(source, source.GetWidth(), source.GetHeight(), target, width, height); }
+
+			// Full screen draws per Apply
+			size_t GetStageCount();
+			inline RenderTargetPool& GetTargets() { return m_Targets; }
+
+			// Thresholded downsample and blur in one pass at scale of the output
+			static PostPass Bloom(float scale = 0.25f);
+			// Tent upsampled bloom added to the scene
+			static PostPass BloomComposite();
+			// Exposure and the ACES filmic curve
+			static PostPass Tonemap();
+			static PostPass Vignette();
+			// Bloom and tonemapping in two draws
+			void AddBloomTonemap();
+		private:
+			struct Stage {
+				std::vector<size_t> Passes;
+				float Scale;
+				Shader* Program;
+			};
+
+			void Build();
+			Shader* GetProgram(const Stage& stage);
+			void DrawStage(const Stage& stage, const Framebuffer& source, const glm::vec2& sourceScale, const glm::vec2& sceneScale, const glm::vec2& sceneMax, GLuint sceneTexture);
+		private:
+			GLenum m_Format;
+			std::vector<PostPass> m_Passes;
+			std::vector<Stage> m_Stages;
+			bool m_Dirty = true;
+			// fused programs by the names of their passes
+			std::unordered_map<std::string, std::unique_ptr<Shader>> m_Programs;
+			std::unordered_map<std::string, float> m_Parameters;
+			RenderTargetPool m_Targets;
+			// attributeless full screen triangle
+			GLuint m_ArrayID = 0;
+		};
+	}
+}
@@ -0,0 +1,257 @@
+#include "Profiler.h"
+#include "Log.h"
+#include <stdio.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace sparky {
+
+	std::atomic<bool> Profiler::s_Active{ false };
+
+	namespace {
+		const uint32_t s_ChunkSize = 4096;
+
+		// Records of one thread are a list of chunks. The owning thread appends to
+		// the tail chunk and publishes with a release store of Count, Dump reads
+		// from the head and frees chunks the writer has moved past.
+		struct Chunk
+		{
+			ProfileRecord Records[s_ChunkSize];
+			std::atomic<uint32_t> Count{ 0 };
+			std::atomic<Chunk*> Next{ nullptr };
+		};
+
+		struct ThreadBuffer
+		{
+			uint32_t ThreadId;
+			std::string Name;
+			Chunk* Head;
+			uint32_t ReadIndex = 0;
+			Chunk* Tail;
+			std::atomic<bool> Finished{ false };
+		};
+
+		struct ThreadBufferOwner
+		{
+			ThreadBuffer* Buffer = nullptr;
+			~ThreadBufferOwner() { if (Buffer) Buffer->Finished.store(true, std::memory_order_release); }
+		};
+
+		std::mutex s_RegistryMutex;
+		std::vector<ThreadBuffer*> s_Buffers;
+		uint32_t s_NextThreadId = 1;
+		thread_local ThreadBufferOwner t_Buffer;
+
+		// tick to microsecond calibration, taken when the session begins
+		uint64_t s_SessionTicks = 0;
+		std::chrono::steady_clock::time_point s_SessionTime;
+
+		ThreadBuffer* GetThreadBuffer()
+		{
+			if (!t_Buffer.Buffer) {
+				ThreadBuffer* buffer = new ThreadBuffer();
+				buffer->Head = buffer->Tail = new Chunk();
+				std::lock_guard<std::mutex> lock(s_RegistryMutex);
+				buffer->ThreadId = s_NextThreadId++;
+				s_Buffers.push_back(buffer);
+				t_Buffer.Buffer = buffer;
+			}
+			return t_Buffer.Buffer;
+		}
+
+		struct CollectedRecord
+		{
+			uint32_t ThreadId;
+			ProfileRecord Record;
+		};
+
+		struct ThreadInfo
+		{
+			uint32_t ThreadId;
+			std::string Name;
+		};
+
+		// Takes everything published so far, s_RegistryMutex must be held
+		void Collect(std::vector<CollectedRecord>& out, std::vector<ThreadInfo>& threads)
+		{
+			for (size_t i = 0; i < s_Buffers.size(); ) {
+				ThreadBuffer* buffer = s_Buffers[i];
+				threads.push_back({ buffer->ThreadId, buffer->Name });
+				bool finished = buffer->Finished.load(std::memory_order_acquire);
+				for (;;) {
+					Chunk* chunk = buffer->Head;
+					uint32_t count = chunk->Count.load(std::memory_order_acquire);
+					for (uint32_t r = buffer->ReadIndex; r < count; ++r)
+						out.push_back({ buffer->ThreadId, chunk->Records[r] });
+					buffer->ReadIndex = count;
+
+					Chunk* next = chunk->Next.load(std::memory_order_acquire);
+					if (count < s_ChunkSize || !next)
+						break;
+					delete chunk;
+					buffer->Head = next;
+					buffer->ReadIndex = 0;
+				}
+
+				if (finished) {
+					delete buffer->Head;
+					delete buffer;
+					s_Buffers.erase(s_Buffers.begin() + i);
+				}
+				else {
+					++i;
+				}
+			}
+		}
+
+		double TicksPerMicrosecond()
+		{
+#if SPARKY_PROFILE_RDTSC
+			double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - s_SessionTime).count();
+			uint64_t ticks = Profiler::Now() - s_SessionTicks;
+			return elapsed > 0.0 ? ticks / elapsed : 1.0;
+#else
+			return 1000.0;
+#endif
+		}
+
+		void WriteEscaped(FILE* file, const char* s)
+		{
+			for (; *s; ++s) {
+				if (*s == '"' || *s == '\\')
+					fputc('\\', file);
+				fputc(*s, file);
+			}
+		}
+
+		bool WriteChromeTrace(const std::string& path, const std::vector<CollectedRecord>& records, const std::vector<ThreadInfo>& threads, double ticksPerUs)
+		{
+			FILE* file = fopen(path.c_str(), "wb");
+			if (!file)
+				return false;
+			fprintf(file, "{\"otherData\":{},\"traceEvents\":[");
+			bool first = true;
+			for (const ThreadInfo& thread : threads) {
+				if (thread.Name.empty())
+					continue;
+				fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",", thread.ThreadId);
+				WriteEscaped(file, thread.Name.c_str());
+				fprintf(file, "\"}}");
+				first = false;
+			}
+			for (const CollectedRecord& r : records) {
+				double ts = ((double)r.Record.Begin - (double)s_SessionTicks) / ticksPerUs;
+				double dur = (double)(r.Record.End - r.Record.Begin) / ticksPerUs;
+				fprintf(file, "%s\n{\"cat\":\"cpu\",\"name\":\"", first ? "" : ",");
+				WriteEscaped(file, r.Record.Name);
+				fprintf(file, "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", r.ThreadId, ts, dur);
+				first = false;
+			}
+			fprintf(file, "\n]}\n");
+			return fclose(file) == 0;
+		}
+
+		// "SPPF", uint32 version, double ticks per microsecond, uint64 session start tick,
+		// uint32 thread count, { uint32 id, uint16 length, name }, uint32 name count,
+		// { uint16 length, name }, uint64 record count, { uint32 thread, uint32 name, uint64 begin, uint64 end }
+		bool WriteBinaryTrace(const std::string& path, const std::vector<CollectedRecord>& records, const std::vector<ThreadInfo>& threads, double ticksPerUs)
+		{
+			FILE* file = fopen(path.c_str(), "wb");
+			if (!file)
+				return false;
+			auto put = [file](const void* data, size_t size) { fwrite(data, 1, size, file); };
+			auto putString = [&put](const char* s) { uint16_t length = (uint16_t)strlen(s); put(&length, 2); put(s, length); };
+
+			const uint32_t version = 1;
+			put("SPPF", 4);
+			put(&version, 4);
+			put(&ticksPerUs, 8);
+			put(&s_SessionTicks, 8);
+
+			uint32_t threadCount = (uint32_t)threads.size();
+			put(&threadCount, 4);
+			for (const ThreadInfo& thread : threads) {
+				put(&thread.ThreadId, 4);
+				putString(thread.Name.c_str());
+			}
+
+			// names are literals, so the pointer identifies them
+			std::unordered_map<const char*, uint32_t> nameIndex;
+			std::vector<const char*> names;
+			for (const CollectedRecord& r : records) {
+				if (nameIndex.emplace(r.Record.Name, (uint32_t)names.size()).second)
+					names.push_back(r.Record.Name);
+			}
+			uint32_t nameCount = (uint32_t)names.size();
+			put(&nameCount, 4);
+			for (const char* name : names)
+				putString(name);
+
+			uint64_t recordCount = records.size();
+			put(&recordCount, 8);
+			for (const CollectedRecord& r : records) {
+				uint32_t name = nameIndex[r.Record.Name];
+				put(&r.ThreadId, 4);
+				put(&name, 4);
+				put(&r.Record.Begin, 8);
+				put(&r.Record.End, 8);
+			}
+			return fclose(file) == 0;
+		}
+	}
+
+	void Profiler::BeginSession()
+	{
+		s_SessionTime = std::chrono::steady_clock::now();
+		s_SessionTicks = Now();
+		s_Active.store(true, std::memory_order_release);
+	}
+
+	void Profiler::EndSession()
+	{
+		s_Active.store(false, std::memory_order_release);
+	}
+
+	void Profiler::SetThreadName(const char* name)
+	{
+		ThreadBuffer* buffer = GetThreadBuffer();
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+		buffer->Name = name;
+	}
+
+	void Profiler::Append(const char* name, uint64_t begin, uint64_t end)
+	{
+		ThreadBuffer* buffer = GetThreadBuffer();
+		Chunk* chunk = buffer->Tail;
+		uint32_t count = chunk->Count.load(std::memory_order_relaxed);
+		if (count == s_ChunkSize) {
+			Chunk* next = new Chunk();
+			chunk->Next.store(next, std::memory_order_release);
+			buffer->Tail = chunk = next;
+			count = 0;
+		}
+		chunk->Records[count] = { name, begin, end };
+		chunk->Count.store(count + 1, std::memory_order_release);
+	}
+
+	bool Profiler::Dump(const std::string& jsonPath, const std::string& binaryPath)
+	{
+		SPARKY_PROFILE_FUNCTION();
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+		std::vector<CollectedRecord> records;
+		std::vector<ThreadInfo> threads;
+		Collect(records, threads);
+		double ticksPerUs = TicksPerMicrosecond();
+
+		bool ok = WriteChromeTrace(jsonPath, records, threads, ticksPerUs);
+		if (!binaryPath.empty())
+			ok = WriteBinaryTrace(binaryPath, records, threads, ticksPerUs) && ok;
+		if (ok)
+			SPARKY_CORE_INFO("Wrote {0} profile records to {1}", records.size(), jsonPath);
+		else
+			SPARKY_CORE_ERROR("Could not write profile to {0}", jsonPath);
+		return ok;
+	}
+
+}
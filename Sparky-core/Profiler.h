@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#if defined(_M_X64) || defined(_M_IX86)
+	#include <intrin.h>
+	#define SPARKY_PROFILE_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+	#define SPARKY_PROFILE_RDTSC 1
+#else
+	#define SPARKY_PROFILE_RDTSC 0
+#endif
+
+// Scoped CPU profiler.
+//
+//   SPARKY_PROFILE_FUNCTION();          times the enclosing function
+//   SPARKY_PROFILE_SCOPE("Name");       times the enclosing block, Name must be a literal
+//
+// Every thread appends its scopes to its own chunked buffer without locks or
+// atomics read-modify-write, nothing is recorded unless a session is running.
+// Profiler::Dump collects what was recorded so far and writes a Chrome
+// trace (chrome://tracing, Perfetto) and optionally a compact binary file.
+// Build with SPARKY_PROFILE=0 to compile the macros out.
+
+#ifndef SPARKY_PROFILE
+	#define SPARKY_PROFILE 1
+#endif
+
+namespace sparky {
+
+	struct ProfileRecord
+	{
+		const char* Name;
+		uint64_t Begin, End;
+	};
+
+	class Profiler
+	{
+	public:
+		// rdtsc on x86, steady_clock nanoseconds elsewhere
+		static inline uint64_t Now()
+		{
+#if SPARKY_PROFILE_RDTSC
+			return __rdtsc();
+#else
+			return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+		}
+
+		static inline bool IsActive() { return s_Active.load(std::memory_order_relaxed); }
+
+		static void BeginSession();
+		static void EndSession();
+		// Names the calling thread in the trace
+		static void SetThreadName(const char* name);
+
+		static inline void Record(const char* name, uint64_t begin, uint64_t end)
+		{
+			if (IsActive())
+				Append(name, begin, end);
+		}
+
+		// Writes everything recorded since the last dump, binaryPath may be empty
+		static bool Dump(const std::string& jsonPath, const std::string& binaryPath = std::string());
+	private:
+		static void Append(const char* name, uint64_t begin, uint64_t end);
+	private:
+		static std::atomic<bool> s_Active;
+	};
+
+	class ProfileScope
+	{
+	public:
+		ProfileScope(const char* name)
+			: m_Name(name), m_Begin(Profiler::Now()) {}
+		~ProfileScope() { Profiler::Record(m_Name, m_Begin, Profiler::Now()); }
+	private:
+		const char* m_Name;
+		uint64_t m_Begin;
+	};
+
+}
+
+#if SPARKY_PROFILE
+	#if defined(_MSC_VER)
+		#define SPARKY_FUNC_SIG __FUNCSIG__
+	#else
+		#define SPARKY_FUNC_SIG __PRETTY_FUNCTION__
+	#endif
+	#define SPARKY_PROFILE_CONCAT2(a, b) a##b
+	#define SPARKY_PROFILE_CONCAT(a, b) SPARKY_PROFILE_CONCAT2(a, b)
+	#define SPARKY_PROFILE_SCOPE(name) ::sparky::ProfileScope SPARKY_PROFILE_CONCAT(profileScope, __LINE__)(name)
+	#define SPARKY_PROFILE_FUNCTION() SPARKY_PROFILE_SCOPE(SPARKY_FUNC_SIG)
+#else
+	#define SPARKY_PROFILE_SCOPE(name)
+	#define SPARKY_PROFILE_FUNCTION()
+#endif
@@ -0,0 +1,295 @@
+#include "RangeAllocator.h"
+#include <algorithm>
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+namespace sparky {
+
+	namespace {
+		inline uint32_t HighestBit(uint32_t value)
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanReverse(&index, value);
+			return (uint32_t)index;
+#else
+			return 31 - (uint32_t)__builtin_clz(value);
+#endif
+		}
+
+		inline uint32_t LowestBit(uint32_t value)
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, value);
+			return (uint32_t)index;
+#else
+			return (uint32_t)__builtin_ctz(value);
+#endif
+		}
+	}
+
+	RangeAllocator::RangeAllocator(uint32_t capacity)
+	{
+		for (auto& level : m_Heads)
+			std::fill(level, level + SecondLevelCount, (uint32_t)InvalidNode);
+		if (capacity)
+			Grow(capacity);
+	}
+
+	// The first level is the power of two at or below size, the second splits
+	// it into SecondLevelCount steps. Sizes below SecondLevelCount share first
+	// level 0, one step each.
+	void RangeAllocator::MapSize(uint32_t size, uint32_t& firstLevel, uint32_t& secondLevel)
+	{
+		if (size < SecondLevelCount) {
+			firstLevel = 0;
+			secondLevel = size;
+			return;
+		}
+		uint32_t highest = HighestBit(size);
+		firstLevel = highest - SecondLevelBits + 1;
+		secondLevel = (size >> (highest - SecondLevelBits)) & (SecondLevelCount - 1);
+	}
+
+	uint32_t RangeAllocator::NewNode(uint32_t offset, uint32_t size)
+	{
+		uint32_t node;
+		if (!m_UnusedNodes.empty()) {
+			node = m_UnusedNodes.back();
+			m_UnusedNodes.pop_back();
+		}
+		else {
+			node = (uint32_t)m_Nodes.size();
+			m_Nodes.emplace_back();
+		}
+		Node& n = m_Nodes[node];
+		n.Offset = offset;
+		n.Size = size;
+		n.PreviousPhysical = n.NextPhysical = InvalidNode;
+		n.PreviousFree = n.NextFree = InvalidNode;
+		n.Free = false;
+		return node;
+	}
+
+	void RangeAllocator::ReleaseNode(uint32_t node)
+	{
+		m_UnusedNodes.push_back(node);
+	}
+
+	void RangeAllocator::InsertFree(uint32_t node)
+	{
+		Node& n = m_Nodes[node];
+		uint32_t firstLevel, secondLevel;
+		MapSize(n.Size, firstLevel, secondLevel);
+		uint32_t head = m_Heads[firstLevel][secondLevel];
+		n.Free = true;
+		n.PreviousFree = InvalidNode;
+		n.NextFree = head;
+		if (head != InvalidNode)
+			m_Nodes[head].PreviousFree = node;
+		m_Heads[firstLevel][secondLevel] = node;
+		m_FirstLevelBitmap |= 1u << firstLevel;
+		m_SecondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+	}
+
+	void RangeAllocator::RemoveFree(uint32_t node)
+	{
+		Node& n = m_Nodes[node];
+		if (n.PreviousFree != InvalidNode) {
+			m_Nodes[n.PreviousFree].NextFree = n.NextFree;
+		}
+		else {
+			uint32_t firstLevel, secondLevel;
+			MapSize(n.Size, firstLevel, secondLevel);
+			m_Heads[firstLevel][secondLevel] = n.NextFree;
+			if (n.NextFree == InvalidNode) {
+				m_SecondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+				if (!m_SecondLevelBitmaps[firstLevel])
+					m_FirstLevelBitmap &= ~(1u << firstLevel);
+			}
+		}
+		if (n.NextFree != InvalidNode)
+			m_Nodes[n.NextFree].PreviousFree = n.PreviousFree;
+		n.Free = false;
+		n.PreviousFree = n.NextFree = InvalidNode;
+	}
+
+	uint32_t RangeAllocator::FindFree(uint32_t size) const
+	{
+		// rounded up to the next size class, every block listed there or above fits
+		uint32_t rounded = size;
+		if (size >= SecondLevelCount) {
+			uint32_t step = (1u << (HighestBit(size) - SecondLevelBits)) - 1;
+			rounded = size <= 0xffffffffu - step ? size + step : 0xffffffffu;
+		}
+		uint32_t firstLevel, secondLevel;
+		MapSize(rounded, firstLevel, secondLevel);
+		uint32_t secondMap = m_SecondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+		if (!secondMap) {
+			uint32_t firstMap = firstLevel + 1 < 32 ? m_FirstLevelBitmap & (~0u << (firstLevel + 1)) : 0;
+			if (firstMap) {
+				firstLevel = LowestBit(firstMap);
+				secondMap = m_SecondLevelBitmaps[firstLevel];
+			}
+		}
+		if (secondMap)
+			return m_Heads[firstLevel][LowestBit(secondMap)];
+
+		// nothing a class up, a block in size's own class may still be large enough
+		MapSize(size, firstLevel, secondLevel);
+		for (uint32_t node = m_Heads[firstLevel][secondLevel]; node != InvalidNode; node = m_Nodes[node].NextFree) {
+			if (m_Nodes[node].Size >= size)
+				return node;
+		}
+		return InvalidNode;
+	}
+
+	uint32_t RangeAllocator::Allocate(uint32_t size)
+	{
+		if (!size)
+			return InvalidNode;
+		uint32_t node = FindFree(size);
+		if (node == InvalidNode)
+			return InvalidNode;
+		RemoveFree(node);
+
+		// the rest of the block stays free, right after the allocation
+		if (m_Nodes[node].Size > size) {
+			uint32_t rest = NewNode(m_Nodes[node].Offset + size, m_Nodes[node].Size - size);
+			Node& n = m_Nodes[node];
+			Node& r = m_Nodes[rest];
+			n.Size = size;
+			r.PreviousPhysical = node;
+			r.NextPhysical = n.NextPhysical;
+			if (n.NextPhysical != InvalidNode)
+				m_Nodes[n.NextPhysical].PreviousPhysical = rest;
+			else
+				m_Last = rest;
+			n.NextPhysical = rest;
+			InsertFree(rest);
+		}
+		m_Used += size;
+		m_Allocations++;
+		return node;
+	}
+
+	void RangeAllocator::Free(uint32_t node)
+	{
+		if (node == InvalidNode)
+			return;
+		m_Used -= m_Nodes[node].Size;
+		m_Allocations--;
+
+		uint32_t previous = m_Nodes[node].PreviousPhysical;
+		if (previous != InvalidNode && m_Nodes[previous].Free) {
+			RemoveFree(previous);
+			m_Nodes[previous].Size += m_Nodes[node].Size;
+			m_Nodes[previous].NextPhysical = m_Nodes[node].NextPhysical;
+			if (m_Nodes[node].NextPhysical != InvalidNode)
+				m_Nodes[m_Nodes[node].NextPhysical].PreviousPhysical = previous;
+			else
+				m_Last = previous;
+			ReleaseNode(node);
+			node = previous;
+		}
+		uint32_t next = m_Nodes[node].NextPhysical;
+		if (next != InvalidNode && m_Nodes[next].Free) {
+			RemoveFree(next);
+			m_Nodes[node].Size += m_Nodes[next].Size;
+			m_Nodes[node].NextPhysical = m_Nodes[next].NextPhysical;
+			if (m_Nodes[next].NextPhysical != InvalidNode)
+				m_Nodes[m_Nodes[next].NextPhysical].PreviousPhysical = node;
+			else
+				m_Last = node;
+			ReleaseNode(next);
+		}
+		InsertFree(node);
+	}
+
+	void RangeAllocator::Grow(uint32_t newCapacity)
+	{
+		if (newCapacity <= m_Capacity)
+			return;
+		uint32_t added = newCapacity - m_Capacity;
+		if (m_Last != InvalidNode && m_Nodes[m_Last].Free) {
+			RemoveFree(m_Last);
+			m_Nodes[m_Last].Size += added;
+			InsertFree(m_Last);
+		}
+		else {
+			uint32_t node = NewNode(m_Capacity, added);
+			m_Nodes[node].PreviousPhysical = m_Last;
+			if (m_Last != InvalidNode)
+				m_Nodes[m_Last].NextPhysical = node;
+			else
+				m_First = node;
+			m_Last = node;
+			InsertFree(node);
+		}
+		m_Capacity = newCapacity;
+	}
+
+	void RangeAllocator::Compact(const std::function<void(uint32_t node, uint32_t from, uint32_t to, uint32_t size)>& move)
+	{
+		for (auto& level : m_Heads)
+			std::fill(level, level + SecondLevelCount, (uint32_t)InvalidNode);
+		m_FirstLevelBitmap = 0;
+		std::fill(m_SecondLevelBitmaps, m_SecondLevelBitmaps + FirstLevelCount, 0u);
+
+		uint32_t offset = 0, previous = InvalidNode;
+		uint32_t node = m_First;
+		m_First = InvalidNode;
+		while (node != InvalidNode) {
+			uint32_t next = m_Nodes[node].NextPhysical;
+			Node& n = m_Nodes[node];
+			if (n.Free) {
+				ReleaseNode(node);
+			}
+			else {
+				if (n.Offset != offset) {
+					move(node, n.Offset, offset, n.Size);
+					n.Offset = offset;
+				}
+				offset += n.Size;
+				n.PreviousPhysical = previous;
+				n.NextPhysical = InvalidNode;
+				if (previous != InvalidNode)
+					m_Nodes[previous].NextPhysical = node;
+				else
+					m_First = node;
+				previous = node;
+			}
+			node = next;
+		}
+		m_Last = previous;
+
+		if (offset < m_Capacity) {
+			uint32_t rest = NewNode(offset, m_Capacity - offset);
+			m_Nodes[rest].PreviousPhysical = m_Last;
+			if (m_Last != InvalidNode)
+				m_Nodes[m_Last].NextPhysical = rest;
+			else
+				m_First = rest;
+			m_Last = rest;
+			InsertFree(rest);
+		}
+	}
+
+	RangeAllocator::Stats RangeAllocator::GetStats() const
+	{
+		Stats stats;
+		stats.Capacity = m_Capacity;
+		stats.Used = m_Used;
+		stats.Allocations = m_Allocations;
+		for (uint32_t node = m_First; node != InvalidNode; node = m_Nodes[node].NextPhysical) {
+			if (m_Nodes[node].Free) {
+				stats.FreeBlocks++;
+				stats.LargestFree = std::max(stats.LargestFree, m_Nodes[node].Size);
+			}
+		}
+		return stats;
+	}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+namespace sparky {
+
+	// Hands out ranges of a space it does not own, such as the vertices of a
+	// GPU buffer, so its bookkeeping lives in a node array rather than in the
+	// space itself. Two level segregated fit (TLSF): free blocks are listed by
+	// size class and found through two bitmaps in constant time, and a freed
+	// block merges with free neighbours at once. Not thread safe.
+	class RangeAllocator
+	{
+	public:
+		static const uint32_t InvalidNode = 0xffffffff;
+
+		struct Stats
+		{
+			uint32_t Capacity = 0, Used = 0, LargestFree = 0;
+			uint32_t Allocations = 0, FreeBlocks = 0;
+		};
+
+		explicit RangeAllocator(uint32_t capacity = 0);
+
+		// Node of a range of size units, InvalidNode when no free block fits
+		uint32_t Allocate(uint32_t size);
+		void Free(uint32_t node);
+		// Appends [capacity, newCapacity) to the space
+		void Grow(uint32_t newCapacity);
+		// Slides every allocation towards offset 0, in offset order, leaving one
+		// free block at the end. move(node, from, to, size) is called for each
+		// allocation that moved; nodes stay valid.
+		void Compact(const std::function<void(uint32_t node, uint32_t from, uint32_t to, uint32_t size)>& move);
+
+		inline uint32_t GetOffset(uint32_t node) const { return m_Nodes[node].Offset; }
+		inline uint32_t GetSize(uint32_t node) const { return m_Nodes[node].Size; }
+		inline uint32_t GetCapacity() const { return m_Capacity; }
+		Stats GetStats() const;
+	private:
+		static const uint32_t SecondLevelBits = 3;
+		static const uint32_t SecondLevelCount = 1 << SecondLevelBits;
+		static const uint32_t FirstLevelCount = 32 - SecondLevelBits + 1;
+
+		struct Node
+		{
+			uint32_t Offset, Size;
+			uint32_t PreviousPhysical, NextPhysical;
+			uint32_t PreviousFree, NextFree;
+			bool Free;
+		};
+
+		static void MapSize(uint32_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+
+		uint32_t NewNode(uint32_t offset, uint32_t size);
+		void ReleaseNode(uint32_t node);
+		void InsertFree(uint32_t node);
+		void RemoveFree(uint32_t node);
+		uint32_t FindFree(uint32_t size) const;
+	private:
+		std::vector<Node> m_Nodes;
+		std::vector<uint32_t> m_UnusedNodes;
+		uint32_t m_Heads[FirstLevelCount][SecondLevelCount];
+		uint32_t m_FirstLevelBitmap = 0;
+		uint32_t m_SecondLevelBitmaps[FirstLevelCount] = {};
+		// ends of the physical list
+		uint32_t m_First = InvalidNode, m_Last = InvalidNode;
+		uint32_t m_Capacity = 0, m_Used = 0, m_Allocations = 0;
+	};
+
+}
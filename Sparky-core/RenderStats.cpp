@@ -0,0 +1,233 @@
+#include "RenderStats.h"
+
+namespace sparky {
+
+	RenderStats RenderStats::s_Current;
+
+	namespace {
+		bool s_Installed = false;
+
+		PFNGLDRAWARRAYSPROC s_DrawArrays;
+		PFNGLDRAWELEMENTSPROC s_DrawElements;
+		PFNGLDRAWARRAYSINSTANCEDPROC s_DrawArraysInstanced;
+		PFNGLDRAWELEMENTSINSTANCEDPROC s_DrawElementsInstanced;
+		PFNGLDRAWELEMENTSBASEVERTEXPROC s_DrawElementsBaseVertex;
+		PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC s_MultiDrawElementsBaseVertex;
+		PFNGLUSEPROGRAMPROC s_UseProgram;
+		PFNGLBINDVERTEXARRAYPROC s_BindVertexArray;
+		PFNGLBINDBUFFERPROC s_BindBuffer;
+		PFNGLBINDTEXTUREPROC s_BindTexture;
+		PFNGLBINDFRAMEBUFFERPROC s_BindFramebuffer;
+		PFNGLENABLEPROC s_Enable;
+		PFNGLDISABLEPROC s_Disable;
+		PFNGLBLENDFUNCPROC s_BlendFunc;
+		PFNGLPOLYGONMODEPROC s_PolygonMode;
+		PFNGLBUFFERDATAPROC s_BufferData;
+		PFNGLBUFFERSUBDATAPROC s_BufferSubData;
+		PFNGLTEXIMAGE2DPROC s_TexImage2D;
+		PFNGLTEXSUBIMAGE2DPROC s_TexSubImage2D;
+
+		inline uint64_t Triangles(GLenum mode, GLsizei count)
+		{
+			switch (mode)
+			{
+			case GL_TRIANGLES: return (uint64_t)count / 3;
+			case GL_TRIANGLE_STRIP:
+			case GL_TRIANGLE_FAN: return count > 2 ? (uint64_t)count - 2 : 0;
+			default: return 0;
+			}
+		}
+
+		// Size of a tightly packed pixel, good enough for the formats the demos upload
+		inline uint64_t PixelSize(GLenum format, GLenum type)
+		{
+			uint64_t components;
+			switch (format)
+			{
+			case GL_RED: case GL_DEPTH_COMPONENT: components = 1; break;
+			case GL_RG: case GL_DEPTH_STENCIL: components = 2; break;
+			case GL_RGB: case GL_BGR: components = 3; break;
+			default: components = 4; break;
+			}
+			switch (type)
+			{
+			case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: return components * 2;
+			case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: return components * 4;
+			default: return components;
+			}
+		}
+
+		void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count)
+		{
+			RenderStats& stats = RenderStats::Current();
+			stats.DrawCalls++;
+			stats.Triangles += Triangles(mode, count);
+			s_DrawArrays(mode, first, count);
+		}
+
+		void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+		{
+			RenderStats& stats = RenderStats::Current();
+			stats.DrawCalls++;
+			stats.Triangles += Triangles(mode, count);
+			s_DrawElements(mode, count, type, indices);
+		}
+
+		void APIENTRY DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+		{
+			RenderStats& stats = RenderStats::Current();
+			stats.DrawCalls++;
+			stats.Triangles += Triangles(mode, count) * instances;
+			s_DrawArraysInstanced(mode, first, count, instances);
+		}
+
+		void APIENTRY DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances)
+		{
+			RenderStats& stats = RenderStats::Current();
+			stats.DrawCalls++;
+			stats.Triangles += Triangles(mode, count) * instances;
+			s_DrawElementsInstanced(mode, count, type, indices, instances);
+		}
+
+		void APIENTRY DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint baseVertex)
+		{
+			RenderStats& stats = RenderStats::Current();
+			stats.DrawCalls++;
+			stats.Triangles += Triangles(mode, count);
+			s_DrawElementsBaseVertex(mode, count, type, indices, baseVertex);
+		}
+
+		void APIENTRY MultiDrawElementsBaseVertex(GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawCount, const GLint* baseVertex)
+		{
+			RenderStats& stats = RenderStats::Current();
+			stats.DrawCalls++;
+			for (GLsizei i = 0; i < drawCount; ++i)
+				stats.Triangles += Triangles(mode, count[i]);
+			s_MultiDrawElementsBaseVertex(mode, count, type, indices, drawCount, baseVertex);
+		}
+
+		void APIENTRY UseProgram(GLuint program) { RenderStats::Current().StateChanges++; s_UseProgram(program); }
+		void APIENTRY BindVertexArray(GLuint array) { RenderStats::Current().StateChanges++; s_BindVertexArray(array); }
+		void APIENTRY BindBuffer(GLenum target, GLuint buffer) { RenderStats::Current().StateChanges++; s_BindBuffer(target, buffer); }
+		void APIENTRY BindTexture(GLenum target, GLuint texture) { RenderStats::Current().StateChanges++; s_BindTexture(target, texture); }
+		void APIENTRY BindFramebuffer(GLenum target, GLuint framebuffer) { RenderStats::Current().StateChanges++; s_BindFramebuffer(target, framebuffer); }
+		void APIENTRY Enable(GLenum cap) { RenderStats::Current().StateChanges++; s_Enable(cap); }
+		void APIENTRY Disable(GLenum cap) { RenderStats::Current().StateChanges++; s_Disable(cap); }
+		void APIENTRY BlendFunc(GLenum sfactor, GLenum dfactor) { RenderStats::Current().StateChanges++; s_BlendFunc(sfactor, dfactor); }
+		void APIENTRY PolygonMode(GLenum face, GLenum mode) { RenderStats::Current().StateChanges++; s_PolygonMode(face, mode); }
+
+		void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+		{
+			if (data)
+				RenderStats::Current().UploadBytes += (uint64_t)size;
+			s_BufferData(target, size, data, usage);
+		}
+
+		void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+		{
+			RenderStats::Current().UploadBytes += (uint64_t)size;
+			s_BufferSubData(target, offset, size, data);
+		}
+
+		void APIENTRY TexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
+		{
+			if (pixels)
+				RenderStats::Current().UploadBytes += (uint64_t)width * height * PixelSize(format, type);
+			s_TexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+		}
+
+		void APIENTRY TexSubImage2D(GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+		{
+			RenderStats::Current().UploadBytes += (uint64_t)width * height * PixelSize(format, type);
+			s_TexSubImage2D(target, level, x, y, width, height, format, type, pixels);
+		}
+
+		template<typename T>
+		inline void Hook(T& glad, T& original, T wrapper)
+		{
+			original = glad;
+			if (glad)
+				glad = wrapper;
+		}
+	}
+
+	void RenderStats::Install()
+	{
+		if (s_Installed)
+			return;
+		s_Installed = true;
+
+		Hook(glad_glDrawArrays, s_DrawArrays, &DrawArrays);
+		Hook(glad_glDrawElements, s_DrawElements, &DrawElements);
+		Hook(glad_glDrawArraysInstanced, s_DrawArraysInstanced, &DrawArraysInstanced);
+		Hook(glad_glDrawElementsInstanced, s_DrawElementsInstanced, &DrawElementsInstanced);
+		Hook(glad_glDrawElementsBaseVertex, s_DrawElementsBaseVertex, &DrawElementsBaseVertex);
+		Hook(glad_glMultiDrawElementsBaseVertex, s_MultiDrawElementsBaseVertex, &MultiDrawElementsBaseVertex);
+		Hook(glad_glUseProgram, s_UseProgram, &UseProgram);
+		Hook(glad_glBindVertexArray, s_BindVertexArray, &BindVertexArray);
+		Hook(glad_glBindBuffer, s_BindBuffer, &BindBuffer);
+		Hook(glad_glBindTexture, s_BindTexture, &BindTexture);
+		Hook(glad_glBindFramebuffer, s_BindFramebuffer, &BindFramebuffer);
+		Hook(glad_glEnable, s_Enable, &Enable);
+		Hook(glad_glDisable, s_Disable, &Disable);
+		Hook(glad_glBlendFunc, s_BlendFunc, &BlendFunc);
+		Hook(glad_glPolygonMode, s_PolygonMode, &PolygonMode);
+		Hook(glad_glBufferData, s_BufferData, &BufferData);
+		Hook(glad_glBufferSubData, s_BufferSubData, &BufferSubData);
+		Hook(glad_glTexImage2D, s_TexImage2D, &TexImage2D);
+		Hook(glad_glTexSubImage2D, s_TexSubImage2D, &TexSubImage2D);
+	}
+
+	RenderStats RenderStats::EndFrame()
+	{
+		RenderStats frame = s_Current;
+		s_Current = RenderStats();
+		return frame;
+	}
+
+	void GpuTimer::Init()
+	{
+		glGenQueries(QueryCount, m_Queries);
+		m_Issued = m_Read = 0;
+	}
+
+	void GpuTimer::Shutdown()
+	{
+		glDeleteQueries(QueryCount, m_Queries);
+	}
+
+	void GpuTimer::Begin()
+	{
+		// every query still in flight, skip this frame rather than wait
+		if (m_Issued - m_Read >= (uint32_t)QueryCount)
+			return;
+		glBeginQuery(GL_TIME_ELAPSED, m_Queries[m_Issued % QueryCount]);
+		m_Open = true;
+	}
+
+	void GpuTimer::End()
+	{
+		if (!m_Open)
+			return;
+		glEndQuery(GL_TIME_ELAPSED);
+		m_Issued++;
+		m_Open = false;
+	}
+
+	bool GpuTimer::Poll(float& milliseconds)
+	{
+		if (m_Read == m_Issued)
+			return false;
+		GLuint query = m_Queries[m_Read % QueryCount];
+		GLint available = 0;
+		glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			return false;
+		GLuint64 nanoseconds = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+		m_Read++;
+		m_LastMilliseconds = milliseconds = (float)(nanoseconds / 1.0e6);
+		return true;
+	}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+#include <glad/glad.h>
+
+namespace sparky {
+
+	// Per frame GL counters. RenderStats::Install swaps a handful of glad
+	// function pointers (draws, binds, enables, uploads) for wrappers that count
+	// and forward, so every call site in the demos is covered without touching
+	// it. Counting is a few adds on the main thread.
+	struct RenderStats
+	{
+		uint32_t DrawCalls = 0;
+		uint64_t Triangles = 0;
+		// program, vertex array, buffer, texture and framebuffer binds, enables and
+		// fixed function state
+		uint32_t StateChanges = 0;
+		// bytes handed to glBufferData / glBufferSubData / glTex(Sub)Image2D
+		uint64_t UploadBytes = 0;
+
+		// Needs a current context with glad loaded
+		static void Install();
+		static inline RenderStats& Current() { return s_Current; }
+		// Returns this frame's counters and starts the next frame at zero
+		static RenderStats EndFrame();
+	private:
+		static RenderStats s_Current;
+	};
+
+	// GPU time of a frame from GL_TIME_ELAPSED queries. Results are read a few
+	// frames late and only once the driver reports them available, so reading
+	// never waits for the GPU.
+	class GpuTimer
+	{
+	public:
+		static const int QueryCount = 4;
+
+		void Init();
+		void Shutdown();
+		void Begin();
+		void End();
+		// Milliseconds of the newest finished frame, negative until one finished
+		inline float GetLastMilliseconds() const { return m_LastMilliseconds; }
+		// True once per finished frame
+		bool Poll(float& milliseconds);
+	private:
+		GLuint m_Queries[QueryCount] = {};
+		// running counters, the query is the counter modulo QueryCount
+		uint32_t m_Issued = 0, m_Read = 0;
+		bool m_Open = false;
+		float m_LastMilliseconds = -1.0f;
+	};
+
+}
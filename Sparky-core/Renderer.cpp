@@ -1,14 +1,19 @@
 #include "Shader.h"
 #include "Renderer.h"
-#include <iostream>
+#include "GLDebug.h"
+#include "Log.h"
 
 void GLClearError() {
+	if (sparky::GLDebug::IsInstalled())
+		return;
 	while (glGetError() != GL_NO_ERROR);
 }
 
 bool GLLogCall(const char* function, const char* file, int line) {
+	if (sparky::GLDebug::IsInstalled())
+		return true;
 	while (GLenum error = glGetError()) {
-		std::cout << "[OpenGL Erro] (" << error << "): " << function << " " << file << ":" << line << std::endl;
+		SPARKY_CORE_ERROR("[OpenGL Error] ({0}): {1} {2}:{3}", error, function, file, line);
 		return false;
 	}
 	return true;
@@ -1,8 +1,16 @@
 #pragma once
 #define ASSERT(x) if (!(x)) __debugbreak();
+
+// Debug builds check glGetError around the wrapped call, unless KHR_debug
+// output is installed and already reports the error. Release builds compile to
+// the bare call and never poll.
+#ifdef _DEBUG
 #define GLCall(x) GLClearError();\
 	x;\
 	ASSERT(GLLogCall(#x, __FILE__, __LINE__))
+#else
+#define GLCall(x) x
+#endif
 
 void GLClearError();
-bool GLLogCall(const char* function, const char* file, int line);
\ No newline at end of file
+bool GLLogCall(const char* function, const char* file, int line);
@@ -1,4 +1,10 @@
 #include "Shader.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "Memory.h"
+#include "MemoryTracker.h"
+#include "VirtualFileSystem.h"
+#include "FrameContext.h"
 
 namespace sparky {
 	namespace graphics {
@@ -8,20 +14,35 @@ namespace sparky {
 			m_ShaderID = load();
 		}
 
+		Shader::Shader(const std::string& name, const std::string& vertSource, const std::string& fragSource)
+			: m_VertPath(name), m_FragPath(name)
+		{
+			m_ShaderID = compile(vertSource.c_str(), (GLint)vertSource.size(), fragSource.c_str(), (GLint)fragSource.size());
+		}
+
 		GLuint Shader::load() {
+			// sources are handed to GL straight from the file views with explicit lengths
+			FileData vertFile = VirtualFileSystem::Read(m_VertPath);
+			FileData fragFile = VirtualFileSystem::Read(m_FragPath);
+			if (!vertFile || !fragFile) {
+				SPARKY_CORE_ERROR("Could not open {0}", vertFile ? m_FragPath : m_VertPath);
+				return 0;
+			}
+
+			return compile(reinterpret_cast<const char*>(vertFile.data()), (GLint)vertFile.size(),
+				reinterpret_cast<const char*>(fragFile.data()), (GLint)fragFile.size());
+		}
+
+		GLuint Shader::compile(const char* vertSource, GLint vertLength, const char* fragSource, GLint fragLength) {
+			SPARKY_PROFILE_FUNCTION();
+			SPARKY_MEMORY_TAG(Renderer);
 			GLuint program = glCreateProgram();
 			GLuint vertex = glCreateShader(GL_VERTEX_SHADER);
 			GLuint fragment = glCreateShader(GL_FRAGMENT_SHADER);
 
-			std::string fragSourceString = read_file(m_FragPath);
-			std::string vertSourceString = read_file(m_VertPath);
-
-			const char* vertSource = vertSourceString.c_str();
-			const char* fragSource = fragSourceString.c_str();
-
 			GLint result;
 
-			glShaderSource(vertex, 1, &vertSource, NULL);
+			glShaderSource(vertex, 1, &vertSource, &vertLength);
 			glCompileShader(vertex);
 
 			glGetShaderiv(vertex, GL_COMPILE_STATUS, &result);
@@ -29,14 +50,15 @@ namespace sparky {
 			if (result == GL_FALSE) {
 				int length;
 				glGetShaderiv(vertex, GL_INFO_LOG_LENGTH, &length);
-				char* message = (char*)malloc((length+1)*sizeof(char));
-				glGetShaderInfoLog(vertex, length, &length, message);
-				std::cout << "Failed to compile vertex shader: \n" << message << std::endl;
+				ScratchScope scratch;
+				char* message = scratch.AllocateArray<char>(length + 1);
+				glGetShaderInfoLog(vertex, length + 1, &length, message);
+				SPARKY_CORE_ERROR("Failed to compile vertex shader {0}:\n{1}", m_VertPath, message);
 				glDeleteShader(vertex);
 				return 0;
 			}
 
-			glShaderSource(fragment, 1, &fragSource, NULL);
+			glShaderSource(fragment, 1, &fragSource, &fragLength);
 			glCompileShader(fragment);
 
 			glGetShaderiv(fragment, GL_COMPILE_STATUS, &result);
@@ -44,9 +66,10 @@ namespace sparky {
 			if (result == GL_FALSE) {
 				int length;
 				glGetShaderiv(fragment, GL_INFO_LOG_LENGTH, &length);
-				char* message = (char*)malloc((length + 1) * sizeof(char));
-				glGetShaderInfoLog(fragment, length, &length, message);
-				std::cout << "Failed to compile fragment shader: \n" << message << std::endl;
+				ScratchScope scratch;
+				char* message = scratch.AllocateArray<char>(length + 1);
+				glGetShaderInfoLog(fragment, length + 1, &length, message);
+				SPARKY_CORE_ERROR("Failed to compile fragment shader {0}:\n{1}", m_FragPath, message);
 				glDeleteShader(fragment);
 				return 0;
 			}
@@ -60,15 +83,53 @@ namespace sparky {
 			glDeleteShader(vertex);
 			glDeleteShader(fragment);
 
+			glGetProgramiv(program, GL_LINK_STATUS, &result);
+			if (result == GL_FALSE) {
+				int length;
+				glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+				ScratchScope scratch;
+				char* message = scratch.AllocateArray<char>(length + 1);
+				glGetProgramInfoLog(program, length + 1, &length, message);
+				SPARKY_CORE_ERROR("Failed to link {0}:\n{1}", m_FragPath, message);
+				glDeleteProgram(program);
+				return 0;
+			}
+
 			return program;
 		}
 
 		Shader::~Shader() {
-			glDeleteProgram(m_ShaderID);
+			FrameContext::DeleteProgram(m_ShaderID);
 		}
 
 		GLint Shader::getUniformLocation(const GLchar* name) {
-			return glGetUniformLocation(m_ShaderID, name);
+			return m_UniformCache.getLocation(m_ShaderID, name);
+		}
+
+		size_t UniformCache::NameHash::operator()(const Name& name) const {
+			// FNV-1a
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < name.Length; ++i)
+				hash = (hash ^ (uint8_t)name.Chars[i]) * 1099511628211ull;
+			return (size_t)hash;
+		}
+
+		GLint UniformCache::getLocation(GLuint program, const GLchar* name) {
+			Name key = { name, strlen(name) };
+			auto it = m_Locations.find(key);
+			if (it != m_Locations.end()) {
+				++m_Hits;
+				return it->second;
+			}
+			++m_Misses;
+			GLint location = glGetUniformLocation(program, name);
+			// the caller's string may not outlive the cache, keep a copy
+			char* interned = new char[key.Length + 1];
+			memcpy(interned, name, key.Length + 1);
+			m_Names.emplace_back(interned);
+			key.Chars = interned;
+			m_Locations.emplace(key, location);
+			return location;
 		}
 
 		void Shader::setUniform1f(const GLchar* name, float value) {
@@ -103,6 +164,12 @@ namespace sparky {
 		void Shader::setUniformMat4(const GLchar* name, const glm::mat4& mat) {
 			glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
 		}
+		void Shader::setUniformBlockBinding(const GLchar* name, GLuint binding) {
+			// like a missing uniform, a block the compiler dropped is ignored
+			GLuint index = glGetUniformBlockIndex(m_ShaderID, name);
+			if (index != GL_INVALID_INDEX)
+				glUniformBlockBinding(m_ShaderID, index, binding);
+		}
 
 		void Shader::enable() const {
 			glUseProgram(m_ShaderID);
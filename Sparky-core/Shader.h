@@ -9,13 +9,42 @@
 
 namespace sparky {
 	namespace graphics {
+		// Uniform locations by name. glGetUniformLocation is a driver round trip, so
+		// it is only called the first time a name is looked up for a program.
+		// Keys point at names interned on the first miss, a lookup wraps the
+		// caller's string without copying it so hits never allocate.
+		class UniformCache {
+		public:
+			GLint getLocation(GLuint program, const GLchar* name);
+
+			inline size_t hits() const { return m_Hits; }
+			inline size_t misses() const { return m_Misses; }
+		private:
+			struct Name {
+				const char* Chars;
+				size_t Length;
+			};
+			struct NameHash {
+				size_t operator()(const Name& name) const;
+			};
+			struct NameEqual {
+				inline bool operator()(const Name& a, const Name& b) const { return a.Length == b.Length && memcmp(a.Chars, b.Chars, a.Length) == 0; }
+			};
+
+			std::unordered_map<Name, GLint, NameHash, NameEqual> m_Locations;
+			std::vector<std::unique_ptr<char[]>> m_Names;
+			size_t m_Hits = 0, m_Misses = 0;
+		};
+
 		class Shader {
 		public:
 			GLuint m_ShaderID;
-			const char *m_VertPath;
-			const char* m_FragPath;
+			std::string m_VertPath;
+			std::string m_FragPath;
 		public:
 			Shader(const char* vertPath, const char* fragPath);
+			// Compiled from sources in memory, name only shows up in error messages
+			Shader(const std::string& name, const std::string& vertSource, const std::string& fragSource);
 			~Shader();
 
 			GLint getUniformLocation(const GLchar* name);
@@ -32,10 +61,15 @@ namespace sparky {
 
 			void setUniformMat4(const GLchar* name, const maths::mat4& mat);
 			void setUniformMat4(const GLchar* name, const glm::mat4& mat);
+			// Sources the named uniform block from glBindBufferRange(GL_UNIFORM_BUFFER, binding, ...)
+			void setUniformBlockBinding(const GLchar* name, GLuint binding);
 			void enable() const;
 			void disable() const;
 		private:
 			GLuint load();
+			GLuint compile(const char* vertSource, GLint vertLength, const char* fragSource, GLint fragLength);
+
+			UniformCache m_UniformCache;
 		};
 	}
 }
\ No newline at end of file
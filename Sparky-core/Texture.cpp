@@ -1,15 +1,35 @@
 #include "Texture.h"
+#include <string.h>
+#include <algorithm>
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image/stb_image.h"
+#include "Profiler.h"
+#include "MemoryTracker.h"
+#include "VirtualFileSystem.h"
+#include "CookedTexture.h"
+#include "TextureFormat.h"
+#include "TextureStreamer.h"
+#include "FrameContext.h"
 
 namespace sparky {
 	namespace graphics {
-		Texture::Texture(const std::string& path)
+		namespace {
+			int GetChannelCount(TextureFormat format)
+			{
+				switch (format) {
+				case TextureFormat::RGB8: case TextureFormat::BC1: return 3;
+				case TextureFormat::BC5: return 2;
+				default: return 4;
+				}
+			}
+		}
+
+		Texture::Texture(const std::string& path, const TextureSettings& settings)
 			: m_FilePath(path), m_Data(nullptr), m_Width(0), m_Height(0), m_Channels(0)
 		{
-			// flip image vertically
-			stbi_set_flip_vertically_on_load(1);
-			m_Data = stbi_load(path.c_str(), &m_Width, &m_Height, &m_Channels, 0);
+			SPARKY_PROFILE_FUNCTION();
+			SPARKY_MEMORY_TAG(Assets);
+			FileData file = VirtualFileSystem::Read(path);
 
 			glGenTextures(1, &m_TexID);
 			glBindTexture(GL_TEXTURE_2D, m_TexID);
@@ -19,22 +39,114 @@ namespace sparky {
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
+			// cooked, DDS and KTX2 textures are uploaded from the file as they are,
+			// unless the orientation asked for differs from the stored one
+			TextureImage image;
+			bool parsed = TextureImage::Parse(file.data(), file.size(), image);
+			bool orientationMatches = parsed && image.FlippedVertically == settings.FlipVertically;
+			const CookedTextureHeader* cooked = CookedTextureHeader::Parse(file.data(), file.size());
+			if (parsed && !IsFormatSupported(image.Format)) {
+				// uploading would fail and leave the texture black
+				SPARKY_ERROR("Texture {0} is {1}, which this GL context cannot sample", m_FilePath, GetFormatName(image.Format));
+			}
+			else if (cooked && orientationMatches && settings.Streamed && settings.GenerateMipmaps && TextureStreamer::IsSupported()) {
+				m_Width = (int)image.Width;
+				m_Height = (int)image.Height;
+				m_Channels = GetChannelCount(image.Format);
+				m_StreamID = TextureStreamer::Register(this, path, *cooked);
+			}
+			else if (orientationMatches) {
+				UploadImage(image, settings);
+			}
+			else if (parsed && IsBlockCompressed(image.Format)) {
+				// flipping blocks means decoding them, the cooker can flip offline instead
+				SPARKY_WARN("Texture {0} is stored {1}flipped, uploading it as stored", m_FilePath, image.FlippedVertically ? "" : "not ");
+				UploadImage(image, settings);
+			}
+			else if (parsed) {
+				m_Data = FlipImage(image);
+			}
+			else if (file) {
+				// flip image vertically
+				stbi_set_flip_vertically_on_load(settings.FlipVertically ? 1 : 0);
+				m_Data = stbi_load_from_memory(file.data(), (int)file.size(), &m_Width, &m_Height, &m_Channels, 0);
+			}
+
 			if (m_Data) {
+				// rows of RGB images are not 4 byte aligned unless the width is a multiple of 4
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 				glTexImage2D(GL_TEXTURE_2D, 0, (m_Channels==3) ? GL_RGB : GL_RGBA, m_Width, m_Height, 0, (m_Channels == 3) ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, m_Data);
-				glGenerateMipmap(GL_TEXTURE_2D);
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+				m_SizeInBytes = (size_t)m_Width * m_Height * m_Channels;
+				if (settings.GenerateMipmaps) {
+					glGenerateMipmap(GL_TEXTURE_2D);
+					m_SizeInBytes += m_SizeInBytes / 3;
+				}
 			}
-			else {
+			else if (!m_SizeInBytes) {
 				SPARKY_ERROR("Failed to load textures from file: {0}", m_FilePath);
 			}
 
 			if (m_Data) {
 				stbi_image_free(m_Data);
+				m_Data = nullptr;
 			}
 			glBindTexture(GL_TEXTURE_2D, 0);
 		}
 
+		void Texture::UploadImage(const TextureImage& image, const TextureSettings& settings) {
+			m_Width = (int)image.Width;
+			m_Height = (int)image.Height;
+			m_Channels = GetChannelCount(image.Format);
+			GLenum internalFormat, format;
+			GetGLFormat(image.Format, internalFormat, format);
+			bool compressed = IsBlockCompressed(image.Format);
+			uint32_t levels = settings.GenerateMipmaps ? image.MipCount : 1;
+
+			// levels are tightly packed, rows of odd RGB mips are not 4 byte aligned
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			for (uint32_t level = 0; level < levels; ++level) {
+				GLsizei width = CookedTextureHeader::LevelExtent(image.Width, level), height = CookedTextureHeader::LevelExtent(image.Height, level);
+				if (compressed)
+					glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, (GLsizei)image.GetLevelSize(level), image.Levels[level]);
+				else
+					glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, image.Levels[level]);
+				m_SizeInBytes += image.GetLevelSize(level);
+			}
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+			// compressed formats cannot be rendered to, so no generated mips for them
+			if (settings.GenerateMipmaps && levels == 1 && !compressed && (image.Width > 1 || image.Height > 1)) {
+				glGenerateMipmap(GL_TEXTURE_2D);
+				m_SizeInBytes += m_SizeInBytes / 3;
+			}
+			else {
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+			}
+		}
+
+		unsigned char* Texture::FlipImage(const TextureImage& image) {
+			// freed with stbi_image_free like a decoded image
+			m_Channels = GetChannelCount(image.Format);
+			size_t rowSize = (size_t)image.Width * m_Channels;
+			unsigned char* data = (unsigned char*)STBI_MALLOC(rowSize * image.Height);
+			if (!data)
+				return nullptr;
+			for (uint32_t row = 0; row < image.Height; ++row)
+				memcpy(data + row * rowSize, image.Levels[0] + (image.Height - 1 - row) * rowSize, rowSize);
+			m_Width = (int)image.Width;
+			m_Height = (int)image.Height;
+			return data;
+		}
+
 		Texture::~Texture() {
-			glDeleteTextures(1, &m_TexID);
+			if (m_StreamID)
+				TextureStreamer::Unregister(m_StreamID);
+			FrameContext::DeleteTexture(m_TexID);
+		}
+
+		void Texture::RequestScreenSize(float screenPixels) const {
+			if (m_StreamID)
+				TextureStreamer::Request(m_StreamID, TextureStreamer::ScreenSpaceMip((uint32_t)std::max(m_Width, m_Height), screenPixels));
 		}
 
 		void Texture::bind(unsigned int slot /*= 0*/) const {
@@ -2,15 +2,34 @@
 #include "Shader.h"
 
 namespace sparky {
+	struct TextureImage;
+	class TextureStreamer;
+
 	namespace graphics {
+		// Part of a texture's asset key, the same file loaded with other settings
+		// is a different asset
+		struct TextureSettings {
+			bool FlipVertically = true;
+			bool GenerateMipmaps = true;
+			// Only the low mips are uploaded at load and finer ones streamed in
+			// on request, see TextureStreamer. Needs a cooked texture, others
+			// load whole.
+			bool Streamed = false;
+		};
+
 		class Texture {
 		private:
 			unsigned int m_TexID;
 			int m_Width, m_Height, m_Channels;
 			std::string m_FilePath;
 			unsigned char* m_Data;
+			size_t m_SizeInBytes = 0;
+			uint32_t m_StreamID = 0;
+
+			void UploadImage(const TextureImage& image, const TextureSettings& settings);
+			unsigned char* FlipImage(const TextureImage& image);
 		public:
-			Texture(const std::string& path);
+			Texture(const std::string& path, const TextureSettings& settings = TextureSettings());
 			~Texture();
 
 			void bind(unsigned int slot = 0) const;
@@ -18,6 +37,17 @@ namespace sparky {
 
 			inline int GetWidth() { return m_Width; }
 			inline int GetHeight() { return m_Height; }
+			// Bytes of texture memory, mip chain included
+			inline size_t GetSizeInBytes() const { return m_SizeInBytes; }
+
+			inline bool IsStreamed() const { return m_StreamID != 0; }
+			// False when the file could not be read or decoded
+			inline bool IsLoaded() const { return m_SizeInBytes != 0 || IsStreamed(); }
+			// Asks the streamer for the mips needed when the texture covers about
+			// screenPixels pixels along its larger side, call every frame it is drawn
+			void RequestScreenSize(float screenPixels) const;
+
+			friend class sparky::TextureStreamer;
 		};
 	}
 }
\ No newline at end of file
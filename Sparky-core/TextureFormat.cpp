@@ -0,0 +1,209 @@
+#include "TextureFormat.h"
+#include <glad/glad.h>
+#include <string.h>
+#include "CookedTexture.h"
+
+// EXT_texture_compression_s3tc is not part of the core profile headers
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+	#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace sparky {
+
+	namespace {
+		bool HasExtension(const char* name)
+		{
+			GLint count = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+			for (GLint i = 0; i < count; ++i) {
+				const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, (GLuint)i));
+				if (extension && strcmp(extension, name) == 0)
+					return true;
+			}
+			return false;
+		}
+
+		inline uint32_t ReadU32(const uint8_t* data)
+		{
+			uint32_t value;
+			memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		inline uint64_t ReadU64(const uint8_t* data)
+		{
+			uint64_t value;
+			memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		inline uint32_t FourCC(char a, char b, char c, char d)
+		{
+			return (uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24);
+		}
+
+		// Levels stored back to back from offset, largest first
+		bool SetContiguousLevels(TextureImage& image, const uint8_t* data, size_t size, size_t offset)
+		{
+			if (image.Width == 0 || image.Height == 0 || image.Width > 65536 || image.Height > 65536)
+				return false;
+			if (image.MipCount == 0 || image.MipCount > TextureImage::MaxLevels)
+				return false;
+			for (uint32_t level = 0; level < image.MipCount; ++level) {
+				size_t levelSize = image.GetLevelSize(level);
+				if (offset > size || levelSize > size - offset)
+					return false;
+				image.Levels[level] = data + offset;
+				offset += levelSize;
+			}
+			return true;
+		}
+
+		bool ParseCooked(const uint8_t* data, size_t size, TextureImage& image)
+		{
+			const CookedTextureHeader* header = CookedTextureHeader::Parse(data, size);
+			if (!header)
+				return false;
+			image.Format = header->Format;
+			image.Width = header->Width;
+			image.Height = header->Height;
+			image.MipCount = header->MipCount;
+			image.FlippedVertically = (header->Flags & CookedTextureHeader::FlippedVertically) != 0;
+			return SetContiguousLevels(image, data, size, sizeof(CookedTextureHeader));
+		}
+
+		// DDS_HEADER follows the magic, DDS_HEADER_DXT10 follows it for "DX10"
+		bool ParseDDS(const uint8_t* data, size_t size, TextureImage& image)
+		{
+			const size_t headerSize = 4 + 124;
+			if (size < headerSize || ReadU32(data) != FourCC('D', 'D', 'S', ' ') || ReadU32(data + 4) != 124)
+				return false;
+			image.Height = ReadU32(data + 12);
+			image.Width = ReadU32(data + 16);
+			uint32_t mipCount = ReadU32(data + 28);
+			image.MipCount = mipCount ? mipCount : 1;
+			image.FlippedVertically = false;
+
+			// cube maps and volume textures are not 2D textures
+			const uint32_t DDSCAPS2_CUBEMAP = 0x200, DDSCAPS2_VOLUME = 0x200000;
+			if (ReadU32(data + 112) & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME))
+				return false;
+
+			const uint32_t DDPF_FOURCC = 0x4;
+			uint32_t pixelFlags = ReadU32(data + 80);
+			uint32_t fourCC = ReadU32(data + 84);
+			if (!(pixelFlags & DDPF_FOURCC))
+				return false;
+			size_t offset = headerSize;
+			if (fourCC == FourCC('D', 'X', 'T', '1'))
+				image.Format = TextureFormat::BC1;
+			else if (fourCC == FourCC('D', 'X', 'T', '5'))
+				image.Format = TextureFormat::BC3;
+			else if (fourCC == FourCC('A', 'T', 'I', '2') || fourCC == FourCC('B', 'C', '5', 'U'))
+				image.Format = TextureFormat::BC5;
+			else if (fourCC == FourCC('D', 'X', '1', '0')) {
+				if (size < headerSize + 20)
+					return false;
+				// DXGI_FORMAT, the sRGB variants are read as linear
+				switch (ReadU32(data + headerSize)) {
+				case 71: case 72: image.Format = TextureFormat::BC1; break;
+				case 77: case 78: image.Format = TextureFormat::BC3; break;
+				case 83: image.Format = TextureFormat::BC5; break;
+				case 98: case 99: image.Format = TextureFormat::BC7; break;
+				default: return false;
+				}
+				// only D3D10_RESOURCE_DIMENSION_TEXTURE2D, no cube maps or arrays
+				const uint32_t TEXTURE2D = 3, MISC_TEXTURECUBE = 0x4;
+				if (ReadU32(data + headerSize + 4) != TEXTURE2D || (ReadU32(data + headerSize + 8) & MISC_TEXTURECUBE) || ReadU32(data + headerSize + 12) > 1)
+					return false;
+				offset += 20;
+			}
+			else {
+				return false;
+			}
+			return SetContiguousLevels(image, data, size, offset);
+		}
+
+		bool ParseKTX2(const uint8_t* data, size_t size, TextureImage& image)
+		{
+			static const uint8_t Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+			const size_t headerSize = 12 + 9 * 4 + 4 * 4 + 2 * 8;
+			if (size < headerSize || memcmp(data, Identifier, sizeof(Identifier)) != 0)
+				return false;
+			// VkFormat, the sRGB variants are read as linear
+			switch (ReadU32(data + 12)) {
+			case 131: case 132: case 133: case 134: image.Format = TextureFormat::BC1; break;
+			case 137: case 138: image.Format = TextureFormat::BC3; break;
+			case 141: image.Format = TextureFormat::BC5; break;
+			case 145: case 146: image.Format = TextureFormat::BC7; break;
+			default: return false;
+			}
+			image.Width = ReadU32(data + 20);
+			image.Height = ReadU32(data + 24);
+			uint32_t depth = ReadU32(data + 28), layers = ReadU32(data + 32), faces = ReadU32(data + 36);
+			uint32_t levels = ReadU32(data + 40);
+			uint32_t supercompression = ReadU32(data + 44);
+			if (depth > 1 || layers > 1 || faces != 1 || supercompression != 0)
+				return false;
+			image.MipCount = levels ? levels : 1;
+			image.FlippedVertically = false;
+			if (image.Width == 0 || image.Height == 0 || image.Width > 65536 || image.Height > 65536)
+				return false;
+			if (image.MipCount > TextureImage::MaxLevels || size < headerSize + image.MipCount * 24)
+				return false;
+
+			// the level index lists level 0 first, each with its own offset
+			const uint8_t* index = data + headerSize;
+			for (uint32_t level = 0; level < image.MipCount; ++level) {
+				uint64_t offset = ReadU64(index + level * 24);
+				uint64_t length = ReadU64(index + level * 24 + 8);
+				// both come from the file, checked by subtraction so they cannot wrap
+				if (length < image.GetLevelSize(level) || offset > size || length > size - offset)
+					return false;
+				image.Levels[level] = data + offset;
+			}
+			return true;
+		}
+	}
+
+	const char* GetFormatName(TextureFormat format)
+	{
+		static const char* const s_Names[] = { "RGB8", "RGBA8", "BC1", "BC3", "BC5", "BC7" };
+		return format < TextureFormat::Count ? s_Names[(uint32_t)format] : "unknown";
+	}
+
+	void GetGLFormat(TextureFormat format, unsigned int& internalFormat, unsigned int& pixelFormat)
+	{
+		pixelFormat = GL_RGBA;
+		switch (format) {
+		case TextureFormat::RGB8: internalFormat = GL_RGB8; pixelFormat = GL_RGB; break;
+		case TextureFormat::RGBA8: internalFormat = GL_RGBA8; break;
+		case TextureFormat::BC1: internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT; break;
+		case TextureFormat::BC3: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+		case TextureFormat::BC5: internalFormat = GL_COMPRESSED_RG_RGTC2; break;
+		default: internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM; break;
+		}
+	}
+
+	bool IsFormatSupported(TextureFormat format)
+	{
+		// asked on the first texture load, a context's extensions do not change
+		static const bool s_S3TC = HasExtension("GL_EXT_texture_compression_s3tc");
+		static const bool s_BPTC = GLAD_GL_VERSION_4_2 || HasExtension("GL_ARB_texture_compression_bptc");
+		switch (format) {
+		case TextureFormat::BC1: case TextureFormat::BC3: return s_S3TC;
+		case TextureFormat::BC7: return s_BPTC;
+		// RGTC (BC5) is core since GL 3.0
+		default: return format < TextureFormat::Count;
+		}
+	}
+
+	bool TextureImage::Parse(const uint8_t* data, size_t size, TextureImage& image)
+	{
+		if (!data)
+			return false;
+		return ParseCooked(data, size, image) || ParseDDS(data, size, image) || ParseKTX2(data, size, image);
+	}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace sparky {
+
+	// Pixel formats textures are stored and uploaded in. The BC formats are
+	// 4x4 blocks: BC1 RGB in 8 bytes, BC3 RGBA, BC5 two channels (normal
+	// maps) and BC7 RGBA at higher quality in 16 bytes.
+	enum class TextureFormat : uint32_t
+	{
+		RGB8 = 0, RGBA8, BC1, BC3, BC5, BC7, Count
+	};
+
+	inline bool IsBlockCompressed(TextureFormat format)
+	{
+		return format >= TextureFormat::BC1 && format < TextureFormat::Count;
+	}
+
+	// Bytes of one pixel, or of one 4x4 block for the compressed formats
+	inline uint32_t GetFormatUnitSize(TextureFormat format)
+	{
+		switch (format) {
+		case TextureFormat::RGB8: return 3;
+		case TextureFormat::RGBA8: return 4;
+		case TextureFormat::BC1: return 8;
+		default: return 16;
+		}
+	}
+
+	inline size_t GetImageSize(TextureFormat format, uint32_t width, uint32_t height)
+	{
+		if (IsBlockCompressed(format))
+			return (size_t)((width + 3) / 4) * ((height + 3) / 4) * GetFormatUnitSize(format);
+		return (size_t)width * height * GetFormatUnitSize(format);
+	}
+
+	const char* GetFormatName(TextureFormat format);
+	// Sized internal format, and the pixel format of uncompressed uploads
+	void GetGLFormat(TextureFormat format, unsigned int& internalFormat, unsigned int& pixelFormat);
+	// False when the current GL context cannot sample the format: BC1 and BC3
+	// need EXT_texture_compression_s3tc, BC7 GL 4.2 or ARB_texture_compression_bptc
+	bool IsFormatSupported(TextureFormat format);
+
+	// A texture file's levels, pointing into the file data. Understands
+	// textures cooked by sparky-cook (CookedTexture.h), DDS with DXT1, DXT5,
+	// ATI2/BC5 or DX10 BC1/3/5/7 headers, and KTX2 with BC formats and no
+	// supercompression.
+	struct TextureImage
+	{
+		static const uint32_t MaxLevels = 17;
+
+		TextureFormat Format;
+		uint32_t Width, Height, MipCount;
+		// DDS and KTX2 are stored top row first, cooked textures usually not
+		bool FlippedVertically;
+		const uint8_t* Levels[MaxLevels];
+
+		inline size_t GetLevelSize(uint32_t level) const
+		{
+			uint32_t width = Width >> level, height = Height >> level;
+			return GetImageSize(Format, width ? width : 1, height ? height : 1);
+		}
+
+		// False when data is none of the formats above or is truncated
+		static bool Parse(const uint8_t* data, size_t size, TextureImage& image);
+	};
+
+}
@@ -0,0 +1,385 @@
+#include "TextureStreamer.h"
+#include <glad/glad.h>
+#include <math.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "CookedTexture.h"
+#include "FrameContext.h"
+#include "Log.h"
+#include "MemoryResource.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "Texture.h"
+#include "VirtualFileSystem.h"
+
+namespace sparky {
+
+	namespace {
+		const float NoRequest = 1e9f;
+
+		struct StreamedTexture
+		{
+			// the owning Texture's GL name, replaced on every reallocation
+			GLuint* Name;
+			std::string Path;
+			CookedTextureHeader Header;
+			GLenum Format, InternalFormat;
+			// levels [TailLevel, MipCount) are never evicted
+			uint32_t TailLevel;
+			// finest level with storage, and finest level with pixels in it
+			uint32_t StorageLevel, UploadedLevel;
+			float RequestedMip;
+			uint64_t LastRequestFrame = 0;
+			bool Loading = false, Failed = false;
+			// levels [StorageLevel, UploadedLevel) from the loader, finest first
+			std::vector<uint8_t> Pending;
+		};
+
+		struct LoadRequest
+		{
+			uint32_t ID;
+			std::string Path;
+			uint32_t First, Last;
+		};
+
+		struct LoadResult
+		{
+			uint32_t ID;
+			uint32_t First, Last;
+			std::vector<uint8_t> Data;
+		};
+
+		std::unordered_map<uint32_t, StreamedTexture> s_Textures;
+		uint32_t s_NextID = 1;
+		uint64_t s_Frame = 1;
+		size_t s_Budget = 256 << 20;
+		size_t s_UploadBytesPerFrame = 4 << 20;
+		TextureStreamer::Stats s_Stats;
+
+		std::thread s_Worker;
+		std::mutex s_Mutex;
+		std::condition_variable s_Wake;
+		std::deque<LoadRequest> s_Requests;
+		std::vector<LoadResult> s_Results;
+		// swapped with s_Results every frame, so both keep their capacity
+		std::vector<LoadResult> s_Completed;
+		bool s_Stop = false;
+
+		size_t LevelOffset(const CookedTextureHeader& header, uint32_t level)
+		{
+			size_t offset = 0;
+			for (uint32_t i = 0; i < level; ++i)
+				offset += header.LevelSize(i);
+			return offset;
+		}
+
+		// Bytes of levels [level, MipCount)
+		size_t StorageBytes(const CookedTextureHeader& header, uint32_t level)
+		{
+			return LevelOffset(header, header.MipCount) - LevelOffset(header, level);
+		}
+
+		void WorkerThread()
+		{
+			Profiler::SetThreadName("Texture streamer");
+			SPARKY_MEMORY_TAG(Assets);
+			std::unique_lock<std::mutex> lock(s_Mutex);
+			while (true) {
+				s_Wake.wait(lock, [] { return s_Stop || !s_Requests.empty(); });
+				if (s_Stop)
+					return;
+				LoadRequest request = std::move(s_Requests.front());
+				s_Requests.pop_front();
+				lock.unlock();
+
+				LoadResult result;
+				result.ID = request.ID;
+				result.First = request.First;
+				result.Last = request.Last;
+				{
+					SPARKY_PROFILE_SCOPE("TextureStreamer::Load");
+					// touching the pages here keeps the disk reads off the main thread
+					FileData file = VirtualFileSystem::Read(request.Path);
+					const CookedTextureHeader* header = CookedTextureHeader::Parse(file.data(), file.size());
+					if (header) {
+						const uint8_t* pixels = file.data() + sizeof(CookedTextureHeader);
+						result.Data.assign(pixels + LevelOffset(*header, request.First), pixels + LevelOffset(*header, request.Last));
+					}
+				}
+
+				lock.lock();
+				s_Results.push_back(std::move(result));
+			}
+		}
+
+		void SetParameters(const StreamedTexture& texture, uint32_t storageLevel)
+		{
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, texture.UploadedLevel - storageLevel);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture.Header.MipCount - 1 - storageLevel);
+		}
+
+		void UploadLevel(const StreamedTexture& texture, uint32_t level, const uint8_t* pixels)
+		{
+			const CookedTextureHeader& header = texture.Header;
+			GLsizei width = CookedTextureHeader::LevelExtent(header.Width, level), height = CookedTextureHeader::LevelExtent(header.Height, level);
+			if (IsBlockCompressed(header.Format)) {
+				glCompressedTexSubImage2D(GL_TEXTURE_2D, level - texture.StorageLevel, 0, 0, width, height,
+					texture.InternalFormat, (GLsizei)header.LevelSize(level), pixels);
+				return;
+			}
+			// levels are tightly packed, rows of odd RGB mips are not 4 byte aligned
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			glTexSubImage2D(GL_TEXTURE_2D, level - texture.StorageLevel, 0, 0, width, height, texture.Format, GL_UNSIGNED_BYTE, pixels);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		}
+
+		// Moves the texture to storage for levels [level, MipCount), keeping the
+		// uploaded levels both storages have
+		void Reallocate(StreamedTexture& texture, uint32_t level)
+		{
+			const CookedTextureHeader& header = texture.Header;
+			GLuint previous = *texture.Name;
+			uint32_t previousLevel = texture.StorageLevel;
+
+			GLuint name;
+			glGenTextures(1, &name);
+			glBindTexture(GL_TEXTURE_2D, name);
+			glTexStorage2D(GL_TEXTURE_2D, header.MipCount - level, texture.InternalFormat,
+				CookedTextureHeader::LevelExtent(header.Width, level), CookedTextureHeader::LevelExtent(header.Height, level));
+			uint32_t kept = std::max(level, texture.UploadedLevel);
+			for (uint32_t i = kept; i < header.MipCount; ++i) {
+				glCopyImageSubData(previous, GL_TEXTURE_2D, i - previousLevel, 0, 0, 0, name, GL_TEXTURE_2D, i - level, 0, 0, 0,
+					CookedTextureHeader::LevelExtent(header.Width, i), CookedTextureHeader::LevelExtent(header.Height, i), 1);
+			}
+			graphics::FrameContext::DeleteTexture(previous);
+
+			s_Stats.ResidentBytes += StorageBytes(header, level);
+			s_Stats.ResidentBytes -= StorageBytes(header, previousLevel);
+			*texture.Name = name;
+			texture.StorageLevel = level;
+			texture.UploadedLevel = kept;
+			SetParameters(texture, level);
+			glBindTexture(GL_TEXTURE_2D, 0);
+		}
+
+		// Drops least recently requested textures to their tail until bytes more fit
+		bool MakeRoom(size_t bytes)
+		{
+			if (s_Stats.ResidentBytes + bytes <= s_Budget)
+				return true;
+			// a frame temporary, gone when the frame arena resets
+			std::vector<StreamedTexture*, ArenaAllocator<StreamedTexture*>> candidates(ArenaAllocator<StreamedTexture*>(Memory::GetFrameArena()));
+			candidates.reserve(s_Textures.size());
+			for (auto& entry : s_Textures) {
+				StreamedTexture& texture = entry.second;
+				if (texture.StorageLevel < texture.TailLevel && !texture.Loading && texture.Pending.empty() && texture.LastRequestFrame < s_Frame)
+					candidates.push_back(&texture);
+			}
+			std::sort(candidates.begin(), candidates.end(), [](const StreamedTexture* a, const StreamedTexture* b) { return a->LastRequestFrame < b->LastRequestFrame; });
+			for (StreamedTexture* texture : candidates) {
+				if (s_Stats.ResidentBytes + bytes <= s_Budget)
+					break;
+				Reallocate(*texture, texture->TailLevel);
+				s_Stats.Evictions++;
+			}
+			return s_Stats.ResidentBytes + bytes <= s_Budget;
+		}
+	}
+
+	bool TextureStreamer::IsSupported()
+	{
+		return GLAD_GL_VERSION_4_3 && glTexStorage2D && glCopyImageSubData;
+	}
+
+	float TextureStreamer::ScreenSpaceMip(uint32_t extent, float screenPixels)
+	{
+		float mip = log2f((float)extent / std::max(screenPixels, 1.0f));
+		return mip > 0.0f ? mip : 0.0f;
+	}
+
+	void TextureStreamer::Request(uint32_t id, float mip)
+	{
+		auto it = s_Textures.find(id);
+		if (it != s_Textures.end())
+			it->second.RequestedMip = std::min(it->second.RequestedMip, mip);
+	}
+
+	uint32_t TextureStreamer::Register(graphics::Texture* owner, const std::string& path, const CookedTextureHeader& header)
+	{
+		uint32_t id = s_NextID++;
+		StreamedTexture& texture = s_Textures[id];
+		texture.Name = &owner->m_TexID;
+		texture.Path = path;
+		texture.Header = header;
+		GetGLFormat(header.Format, texture.InternalFormat, texture.Format);
+		texture.TailLevel = 0;
+		while (texture.TailLevel + 1 < header.MipCount
+			&& std::max(CookedTextureHeader::LevelExtent(header.Width, texture.TailLevel), CookedTextureHeader::LevelExtent(header.Height, texture.TailLevel)) > TailExtent)
+			texture.TailLevel++;
+		texture.StorageLevel = texture.UploadedLevel = texture.TailLevel;
+		texture.RequestedMip = NoRequest;
+
+		// the texture is bound and has no storage yet
+		uint32_t level = texture.TailLevel;
+		glTexStorage2D(GL_TEXTURE_2D, header.MipCount - level, texture.InternalFormat,
+			CookedTextureHeader::LevelExtent(header.Width, level), CookedTextureHeader::LevelExtent(header.Height, level));
+		const uint8_t* pixels = reinterpret_cast<const uint8_t*>(&header + 1) + LevelOffset(header, level);
+		for (uint32_t i = level; i < header.MipCount; ++i) {
+			UploadLevel(texture, i, pixels);
+			pixels += header.LevelSize(i);
+		}
+		SetParameters(texture, level);
+		s_Stats.ResidentBytes += StorageBytes(header, level);
+		// what the asset cache accounts for, streamed levels come and go
+		owner->m_SizeInBytes = StorageBytes(header, level);
+
+		if (!s_Worker.joinable()) {
+			s_Stop = false;
+			s_Worker = std::thread(&WorkerThread);
+		}
+		return id;
+	}
+
+	void TextureStreamer::Unregister(uint32_t id)
+	{
+		auto it = s_Textures.find(id);
+		if (it == s_Textures.end())
+			return;
+		s_Stats.ResidentBytes -= StorageBytes(it->second.Header, it->second.StorageLevel);
+		s_Textures.erase(it);
+	}
+
+	void TextureStreamer::Update()
+	{
+		SPARKY_PROFILE_FUNCTION();
+		s_Frame++;
+		s_Stats.UploadedBytes = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			s_Completed.swap(s_Results);
+		}
+		for (LoadResult& result : s_Completed) {
+			auto it = s_Textures.find(result.ID);
+			if (it == s_Textures.end())
+				continue;
+			StreamedTexture& texture = it->second;
+			texture.Loading = false;
+			if (result.Data.empty() || result.Last != texture.StorageLevel) {
+				SPARKY_CORE_ERROR("Could not stream {0}, keeping its resident mips", texture.Path);
+				texture.Failed = true;
+				continue;
+			}
+			Reallocate(texture, result.First);
+			texture.Pending = std::move(result.Data);
+		}
+		s_Completed.clear();
+
+		// coarsest level first, the base level follows each upload so sampling
+		// never reaches a level without pixels
+		for (auto& entry : s_Textures) {
+			StreamedTexture& texture = entry.second;
+			if (texture.Pending.empty())
+				continue;
+			glBindTexture(GL_TEXTURE_2D, *texture.Name);
+			while (texture.UploadedLevel > texture.StorageLevel && (s_Stats.UploadedBytes == 0 || s_Stats.UploadedBytes < s_UploadBytesPerFrame)) {
+				uint32_t level = texture.UploadedLevel - 1;
+				size_t offset = LevelOffset(texture.Header, level) - LevelOffset(texture.Header, texture.StorageLevel);
+				UploadLevel(texture, level, texture.Pending.data() + offset);
+				texture.UploadedLevel = level;
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level - texture.StorageLevel);
+				s_Stats.UploadedBytes += texture.Header.LevelSize(level);
+			}
+			glBindTexture(GL_TEXTURE_2D, 0);
+			if (texture.UploadedLevel == texture.StorageLevel)
+				std::vector<uint8_t>().swap(texture.Pending);
+			if (s_Stats.UploadedBytes >= s_UploadBytesPerFrame)
+				break;
+		}
+
+		// requests of the frame that just ended, all stamped first so none of
+		// them is picked for eviction by another's load
+		typedef std::pair<uint32_t, float> Request;
+		std::vector<Request, ArenaAllocator<Request>> requests(ArenaAllocator<Request>(Memory::GetFrameArena()));
+		requests.reserve(s_Textures.size());
+		for (auto& entry : s_Textures) {
+			StreamedTexture& texture = entry.second;
+			if (texture.RequestedMip == NoRequest)
+				continue;
+			texture.LastRequestFrame = s_Frame;
+			requests.push_back({ entry.first, texture.RequestedMip });
+			texture.RequestedMip = NoRequest;
+		}
+		for (const auto& request : requests) {
+			StreamedTexture& texture = s_Textures[request.first];
+			if (texture.Loading || texture.Failed || !texture.Pending.empty())
+				continue;
+
+			uint32_t wanted = std::min((uint32_t)request.second, texture.TailLevel);
+			// as fine as the budget allows
+			while (wanted < texture.StorageLevel && !MakeRoom(StorageBytes(texture.Header, wanted) - StorageBytes(texture.Header, texture.StorageLevel)))
+				wanted++;
+			if (wanted >= texture.StorageLevel)
+				continue;
+
+			texture.Loading = true;
+			s_Stats.Loads++;
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			s_Requests.push_back({ request.first, texture.Path, wanted, texture.StorageLevel });
+			s_Wake.notify_one();
+		}
+
+		// a lowered budget
+		MakeRoom(0);
+	}
+
+	void TextureStreamer::Shutdown()
+	{
+		if (s_Worker.joinable()) {
+			{
+				std::lock_guard<std::mutex> lock(s_Mutex);
+				s_Stop = true;
+				s_Requests.clear();
+			}
+			s_Wake.notify_one();
+			s_Worker.join();
+		}
+		s_Results.clear();
+		s_Completed.clear();
+		if (!s_Textures.empty())
+			SPARKY_CORE_WARN("TextureStreamer shut down with {0} textures still registered", s_Textures.size());
+	}
+
+	void TextureStreamer::SetBudget(size_t bytes)
+	{
+		s_Budget = bytes;
+	}
+
+	void TextureStreamer::SetUploadBytesPerFrame(size_t bytes)
+	{
+		s_UploadBytesPerFrame = bytes;
+	}
+
+	TextureStreamer::Stats TextureStreamer::GetStats()
+	{
+		Stats stats = s_Stats;
+		stats.Budget = s_Budget;
+		stats.Textures = (uint32_t)s_Textures.size();
+		stats.Loading = stats.Uploading = 0;
+		for (auto& entry : s_Textures) {
+			stats.Loading += entry.second.Loading ? 1 : 0;
+			stats.Uploading += entry.second.Pending.empty() ? 0 : 1;
+		}
+		return stats;
+	}
+
+}
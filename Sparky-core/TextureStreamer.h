@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace sparky {
+
+	struct CookedTextureHeader;
+
+	namespace graphics {
+		class Texture;
+	}
+
+	// Mip residency for textures loaded with TextureSettings::Streamed. Only
+	// the mip tail up to TailExtent texels is uploaded at load time; finer
+	// levels are read by a background thread once the texture is requested at
+	// that level and uploaded a few MB per frame, coarsest first, with
+	// GL_TEXTURE_BASE_LEVEL clamped to what has arrived so far.
+	//
+	// Storage is immutable (glTexStorage2D) and sized to exactly the resident
+	// levels, so growing or evicting reallocates the texture and copies the
+	// levels that stay with glCopyImageSubData. The GL name of a streamed
+	// texture therefore changes; bind it every frame. When the resident bytes
+	// would exceed the budget, textures that were not requested this frame are
+	// dropped back to their tail, least recently requested first.
+	//
+	// Main thread only, needs GL 4.3.
+	class TextureStreamer
+	{
+	public:
+		static const uint32_t TailExtent = 64;
+
+		struct Stats
+		{
+			size_t ResidentBytes = 0, Budget = 0;
+			size_t UploadedBytes = 0; // this frame
+			uint32_t Textures = 0, Loading = 0, Uploading = 0;
+			uint32_t Loads = 0, Evictions = 0;
+		};
+
+		static bool IsSupported();
+
+		// Mip level that maps about one texel to one pixel for a texture whose
+		// larger side is extent texels and covers screenPixels pixels on screen
+		static float ScreenSpaceMip(uint32_t extent, float screenPixels);
+		// The finest request of a frame wins
+		static void Request(uint32_t id, float mip);
+
+		// Once per frame: applies finished loads, uploads, issues new loads and evicts
+		static void Update();
+		static void Shutdown();
+
+		static void SetBudget(size_t bytes);
+		static void SetUploadBytesPerFrame(size_t bytes);
+		static Stats GetStats();
+	private:
+		friend class graphics::Texture;
+		// Allocates the tail of the bound texture and uploads it from the cooked data
+		static uint32_t Register(graphics::Texture* texture, const std::string& path, const CookedTextureHeader& header);
+		static void Unregister(uint32_t id);
+	};
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace sparky {
+
+	// Length of one frame in seconds
+	class Timestep
+	{
+	public:
+		Timestep(float time = 0.0f)
+			: m_Time(time)
+		{
+		}
+
+		operator float() const { return m_Time; }
+
+		float GetSeconds() const { return m_Time; }
+		float GetMilliseconds() const { return m_Time * 1000.0f; }
+	private:
+		float m_Time;
+	};
+
+}
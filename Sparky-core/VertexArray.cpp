@@ -1,4 +1,6 @@
 #include "VertexArray.h"
+#include "MemoryTracker.h"
+#include "FrameContext.h"
 
 namespace sparky {
 	namespace graphics {
@@ -9,9 +11,12 @@ namespace sparky {
 			for (unsigned int i = 0; i < m_Buffers.size(); ++i) {
 				delete m_Buffers[i];
 			}
+			FrameContext::DeleteVertexArray(m_ArrayID);
 		}
 
 		void VertexArray::AddBuffers(Buffer* buffer, GLuint index) {
+			SPARKY_MEMORY_TAG(Renderer);
+			m_Buffers.push_back(buffer);
 			bind();
 			buffer->bind();
 
@@ -0,0 +1,143 @@
+#include "VirtualFileSystem.h"
+#include <sys/stat.h>
+#include <memory>
+#include <vector>
+#include "PackFile.h"
+#include "Log.h"
+#include "Profiler.h"
+
+namespace sparky {
+
+	namespace {
+		class MountPoint
+		{
+		public:
+			virtual ~MountPoint() {}
+			virtual FileData Read(const std::string& path) const = 0;
+			virtual bool Exists(const std::string& path) const = 0;
+		};
+
+		class PackMount : public MountPoint
+		{
+		public:
+			bool Open(const std::string& path) { return m_Pack.Open(path); }
+			inline uint32_t GetEntryCount() const { return m_Pack.GetEntryCount(); }
+
+			FileData Read(const std::string& path) const override
+			{
+				const PackEntry* entry = m_Pack.Find(path);
+				return entry ? m_Pack.Read(*entry) : FileData();
+			}
+			bool Exists(const std::string& path) const override
+			{
+				return m_Pack.Find(path) != nullptr;
+			}
+		private:
+			PackReader m_Pack;
+		};
+
+		class DirectoryMount : public MountPoint
+		{
+		public:
+			DirectoryMount(const std::string& root)
+				: m_Root(root.empty() || root == "." ? std::string() : root + "/") {}
+
+			FileData Read(const std::string& path) const override
+			{
+				MappedFile file;
+				if (!file.Open(m_Root + path))
+					return FileData();
+				return FileData::Own(std::move(file));
+			}
+			bool Exists(const std::string& path) const override
+			{
+				struct stat info;
+				return stat((m_Root + path).c_str(), &info) == 0 && (info.st_mode & S_IFMT) == S_IFREG;
+			}
+		private:
+			std::string m_Root;
+		};
+
+		std::vector<std::unique_ptr<MountPoint>> s_Mounts;
+	}
+
+	bool VirtualFileSystem::Mount(const std::string& packPath)
+	{
+		SPARKY_PROFILE_FUNCTION();
+		std::unique_ptr<PackMount> mount(new PackMount());
+		if (!mount->Open(packPath)) {
+			SPARKY_CORE_ERROR("Could not mount {0}", packPath);
+			return false;
+		}
+		SPARKY_CORE_INFO("Mounted {0} ({1} files)", packPath, mount->GetEntryCount());
+		s_Mounts.push_back(std::move(mount));
+		return true;
+	}
+
+	void VirtualFileSystem::MountDirectory(const std::string& directory)
+	{
+		s_Mounts.emplace_back(new DirectoryMount(CanonicalPath(directory)));
+	}
+
+	void VirtualFileSystem::UnmountAll()
+	{
+		s_Mounts.clear();
+	}
+
+	FileData VirtualFileSystem::Read(const std::string& path)
+	{
+		std::string canonical = CanonicalPath(path);
+		if (s_Mounts.empty())
+			return DirectoryMount(std::string()).Read(canonical);
+		for (auto it = s_Mounts.rbegin(); it != s_Mounts.rend(); ++it) {
+			FileData file = (*it)->Read(canonical);
+			if (file)
+				return file;
+		}
+		return FileData();
+	}
+
+	bool VirtualFileSystem::Exists(const std::string& path)
+	{
+		std::string canonical = CanonicalPath(path);
+		if (s_Mounts.empty())
+			return DirectoryMount(std::string()).Exists(canonical);
+		for (auto it = s_Mounts.rbegin(); it != s_Mounts.rend(); ++it) {
+			if ((*it)->Exists(canonical))
+				return true;
+		}
+		return false;
+	}
+
+	std::string VirtualFileSystem::CanonicalPath(const std::string& path)
+	{
+		std::vector<std::string> parts;
+		bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\');
+		size_t begin = 0;
+		while (begin <= path.size()) {
+			size_t end = path.find_first_of("/\\", begin);
+			if (end == std::string::npos)
+				end = path.size();
+			std::string part = path.substr(begin, end - begin);
+			if (part == "..") {
+				if (!parts.empty() && parts.back() != "..")
+					parts.pop_back();
+				else if (!absolute)
+					parts.push_back(part);
+			}
+			else if (!part.empty() && part != ".") {
+				parts.push_back(part);
+			}
+			begin = end + 1;
+		}
+
+		std::string result = absolute ? "/" : "";
+		for (size_t i = 0; i < parts.size(); ++i) {
+			if (i)
+				result += '/';
+			result += parts[i];
+		}
+		return result;
+	}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include "FileData.h"
+
+namespace sparky {
+
+	// Every engine file read goes through here. Packs are memory mapped once and
+	// read as views without copying; directories are loose file overlays for
+	// development. Later mounts shadow earlier ones, so mounting the working
+	// directory after a pack lets edited files win over cooked ones. With
+	// nothing mounted paths are read relative to the working directory.
+	//
+	// Mount at startup from the main thread; Read and Exists may be called from
+	// any thread afterwards.
+	class VirtualFileSystem
+	{
+	public:
+		static bool Mount(const std::string& packPath);
+		static void MountDirectory(const std::string& directory);
+		static void UnmountAll();
+
+		static FileData Read(const std::string& path);
+		static bool Exists(const std::string& path);
+
+		// Forward slashes, no "." or "dir/.." parts
+		static std::string CanonicalPath(const std::string& path);
+	};
+
+}
@@ -1,4 +1,5 @@
 #include "buffer.h"
+#include "FrameContext.h"
 
 namespace sparky {
 	namespace graphics {
@@ -11,6 +12,10 @@ namespace sparky {
 			glBindBuffer(GL_ARRAY_BUFFER, 0);
 		}
 
+		Buffer::~Buffer() {
+			FrameContext::DeleteBuffer(m_BufferID);
+		}
+
 		void Buffer::bind() const {
 			glBindBuffer(GL_ARRAY_BUFFER, m_BufferID);
 		}
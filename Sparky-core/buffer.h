@@ -1,15 +1,19 @@
 #pragma once
 
 #include <glad/glad.h>
+#include "Pool.h"
 
 namespace sparky {
 	namespace graphics {
+		// Small and created in bulk by the demos, so instances come from a pool
 		class Buffer {
+			SPARKY_POOLED_CLASS(Buffer, Renderer)
 		private:
 			GLuint m_BufferID;
 			GLuint m_ComponentCount;
 		public:
 			Buffer(GLfloat* data, GLsizei count, GLuint componentCount);
+			~Buffer();
 
 			void bind() const;
 			void unbind() const;
@@ -2,21 +2,130 @@
 #include "Shader.h"
 #include "ExampleLayer.h"
 #include "ImGuiLayer.h"
+#include "GLIntercept.h"
+#include "MemoryTracker.h"
+#include "VirtualFileSystem.h"
+#include "TextureStreamer.h"
+#include "FrameCapture.h"
 
-int main() {
+// Command line:
+//   --record <file>      record the input of this run
+//   --replay <file>      replay a recording and print the frame time distribution
+//   --fixed-step <sec>   replay with a fixed timestep instead of the recorded ones
+//   --headless           hidden window, for replays
+//   --profile <file>     write a Chrome trace of the run (chrome://tracing)
+//   --profile-bin <file> also write the trace in Sparky's binary profile format
+//   --gl-intercept       count and time every GL call, report sync points on exit
+//   --gl-debug           debug context with KHR_debug output, the default in debug builds
+//   --pack <file>        mount a cooked pack, later packs shadow earlier ones
+//   --loose              loose files override the packs, the default in debug builds
+//   --no-loose           only read from packs, also in debug builds
+//   --texture-budget <MB> video memory for streamed textures, 256 by default
+//   --post               render offscreen with bloom and tonemapping
+//   --msaa <samples>     multisample the offscreen target, implies --post
+//   --dynamic-res <ms>   scale the rendering resolution to keep GPU frames within ms
+//   --capture <file>     record every frame to file.y4m, file.rgba or file_000000.png and up
+//   --capture-fps <fps>  frame rate written to the recording, 60 by default
+int main(int argc, char** argv) {
 	using namespace sparky;
 	using namespace graphics;
 	using namespace maths;
 
 	Log::Init();
+	Profiler::SetThreadName("Main");
 	SPARKY_CORE_WARN("Initialized logging.");
 	SPARKY_INFO("Hello {0}", "Sparky!");
 
-	auto app = sparky::CreateApplication();
+	const char* recordPath = nullptr;
+	const char* replayPath = nullptr;
+	std::string profilePath, profileBinaryPath;
+	float fixedStep = 0.0f;
+	bool interceptGL = false;
+	// 1 mounts loose files, 0 does not, -1 only when no pack is given. With
+	// packs a release run reads only from them, a few sequential reads.
+#ifdef _DEBUG
+	int looseFiles = 1;
+#else
+	int looseFiles = -1;
+#endif
+	int postSamples = 0;
+	float resolutionBudget = 0.0f;
+	const char* capturePath = nullptr;
+	uint32_t captureFps = 60;
+	std::vector<std::string> packs;
+	WindowProps props;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--record" && hasValue) recordPath = argv[++i];
+		else if (arg == "--replay" && hasValue) replayPath = argv[++i];
+		else if (arg == "--fixed-step" && hasValue) fixedStep = (float)atof(argv[++i]);
+		else if (arg == "--headless") props.Visible = false;
+		else if (arg == "--profile" && hasValue) profilePath = argv[++i];
+		else if (arg == "--profile-bin" && hasValue) profileBinaryPath = argv[++i];
+		else if (arg == "--gl-intercept") interceptGL = true;
+		else if (arg == "--gl-debug") props.DebugContext = true;
+		else if (arg == "--pack" && hasValue) packs.push_back(argv[++i]);
+		else if (arg == "--loose") looseFiles = 1;
+		else if (arg == "--no-loose") looseFiles = 0;
+		else if (arg == "--texture-budget" && hasValue) TextureStreamer::SetBudget((size_t)atoi(argv[++i]) << 20);
+		else if (arg == "--post") postSamples = std::max(postSamples, 1);
+		else if (arg == "--msaa" && hasValue) postSamples = std::max(atoi(argv[++i]), 1);
+		else if (arg == "--dynamic-res" && hasValue) resolutionBudget = (float)atof(argv[++i]);
+		else if (arg == "--capture" && hasValue) capturePath = argv[++i];
+		else if (arg == "--capture-fps" && hasValue) captureFps = (uint32_t)std::max(atoi(argv[++i]), 1);
+		else SPARKY_CORE_WARN("Unknown argument {0}", arg);
+	}
+
+	// soft budgets, going over one only logs a warning
+	MemoryTracker::SetBudget(MemoryTag::Renderer, 64 << 20);
+	MemoryTracker::SetBudget(MemoryTag::Assets, 256 << 20);
+	MemoryTracker::SetBudget(MemoryTag::Events, 1 << 20);
+	MemoryTracker::SetBudget(MemoryTag::UI, 16 << 20);
+
+	if (!profilePath.empty())
+		Profiler::BeginSession();
+
+	for (const std::string& pack : packs)
+		VirtualFileSystem::Mount(pack);
+	// mounted last so edited files win over cooked ones, and always without packs
+	if (looseFiles > 0 || (looseFiles < 0 && packs.empty()))
+		VirtualFileSystem::MountDirectory(".");
+
+	auto app = sparky::CreateApplication(props);
+	if (postSamples)
+		app->EnablePostProcessing(postSamples);
+	if (resolutionBudget > 0.0f)
+		app->EnableDynamicResolution(resolutionBudget);
 	app->PushLayer(new ExampleLayer());
 	app->PushLayer(new ImGuiLayer());
+	if (interceptGL)
+		GLIntercept::Install();
+	if (replayPath) {
+		// measure the work, not the display
+		app->GetWindow().SetVSync(false);
+		app->StartReplay(replayPath, fixedStep);
+	}
+	else if (recordPath) {
+		app->StartRecording(recordPath);
+	}
+	if (capturePath)
+		FrameCapture::StartRecording(capturePath, captureFps);
 	app->Run();
+	if (GLIntercept::IsInstalled()) {
+		GLIntercept::Report();
+		GLIntercept::Uninstall();
+	}
 	delete app;
+	VirtualFileSystem::UnmountAll();
+	MemoryTracker::ReportLeaks();
+
+	if (!profilePath.empty()) {
+		Profiler::EndSession();
+		Profiler::Dump(profilePath, profileBinaryPath);
+	}
+
+	Log::Shutdown();
 
 	return 0;
 }
\ No newline at end of file
@@ -3,6 +3,58 @@
 namespace sparky {
 	namespace maths {
 
+#if SPARKY_SIMD_SSE
+		// r.row(i) = sum(a[i][k] * b.row(k)), shared by operator* and glMultiply
+		static SPARKY_FORCEINLINE void multiply_rows(const float* a, const float* b, float* r) {
+			__m128 b0 = _mm_load_ps(b + 0);
+			__m128 b1 = _mm_load_ps(b + 4);
+			__m128 b2 = _mm_load_ps(b + 8);
+			__m128 b3 = _mm_load_ps(b + 12);
+			for (int i = 0; i < 4; ++i) {
+				__m128 row = _mm_mul_ps(_mm_set1_ps(a[4 * i + 0]), b0);
+				row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[4 * i + 1]), b1));
+				row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[4 * i + 2]), b2));
+				row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[4 * i + 3]), b3));
+				_mm_store_ps(r + 4 * i, row);
+			}
+		}
+
+		// c0 * v.x + c1 * v.y + c2 * v.z + c3 * v.w
+		static SPARKY_FORCEINLINE __m128 combine_columns(__m128 c0, __m128 c1, __m128 c2, __m128 c3, __m128 v) {
+			__m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, SPARKY_SHUFFLE(0, 0, 0, 0)));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(v, v, SPARKY_SHUFFLE(1, 1, 1, 1))));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, SPARKY_SHUFFLE(2, 2, 2, 2))));
+			r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(v, v, SPARKY_SHUFFLE(3, 3, 3, 3))));
+			return r;
+		}
+
+		// 2x2 helpers for the block inverse, each register holds a 2x2 matrix as (m00, m01, m10, m11)
+		static SPARKY_FORCEINLINE __m128 mat2_mul(__m128 a, __m128 b) {
+			return _mm_add_ps(
+				_mm_mul_ps(a, _mm_shuffle_ps(b, b, SPARKY_SHUFFLE(0, 3, 0, 3))),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, SPARKY_SHUFFLE(1, 0, 3, 2)), _mm_shuffle_ps(b, b, SPARKY_SHUFFLE(2, 1, 2, 1))));
+		}
+		// adj(a) * b
+		static SPARKY_FORCEINLINE __m128 mat2_adj_mul(__m128 a, __m128 b) {
+			return _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(a, a, SPARKY_SHUFFLE(3, 3, 0, 0)), b),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, SPARKY_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(b, b, SPARKY_SHUFFLE(2, 3, 0, 1))));
+		}
+		// a * adj(b)
+		static SPARKY_FORCEINLINE __m128 mat2_mul_adj(__m128 a, __m128 b) {
+			return _mm_sub_ps(
+				_mm_mul_ps(a, _mm_shuffle_ps(b, b, SPARKY_SHUFFLE(3, 0, 3, 0))),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, SPARKY_SHUFFLE(1, 0, 3, 2)), _mm_shuffle_ps(b, b, SPARKY_SHUFFLE(2, 1, 2, 1))));
+		}
+
+		static SPARKY_FORCEINLINE __m128 cross3(__m128 a, __m128 b) {
+			__m128 a_yzx = _mm_shuffle_ps(a, a, SPARKY_SHUFFLE(1, 2, 0, 3));
+			__m128 b_yzx = _mm_shuffle_ps(b, b, SPARKY_SHUFFLE(1, 2, 0, 3));
+			__m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+			return _mm_shuffle_ps(c, c, SPARKY_SHUFFLE(1, 2, 0, 3));
+		}
+#endif
+
 		mat4::mat4() {
 			for (int i = 0; i < 16; ++i) {
 				elements[i] = 0.0f;
@@ -98,6 +150,9 @@ namespace sparky {
 		}
 		mat4 mat4::operator*(const mat4& mat) const {
 			mat4 new_mat = mat4();
+#if SPARKY_SIMD_SSE
+			multiply_rows(elements, mat.elements, new_mat.elements);
+#else
 			for (int i = 0; i < 4; ++i) {
 				for (int j = 0; j < 4; ++j) {
 					for (int k = 0; k < 4; ++k) {
@@ -105,16 +160,26 @@ namespace sparky {
 					}
 				}
 			}
+#endif
 			return new_mat;
 		}
 
 		vec4 mat4::operator*(const vec4& vec) const {
+#if SPARKY_SIMD_SSE
+			__m128 c0 = columns[0].m128;
+			__m128 c1 = columns[1].m128;
+			__m128 c2 = columns[2].m128;
+			__m128 c3 = columns[3].m128;
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+			return vec4(combine_columns(c0, c1, c2, c3, vec.m128));
+#else
 			return vec4(
 				elements[4 * 0 + 0] * vec.x + elements[4 * 0 + 1] * vec.y + elements[4 * 0 + 2] * vec.z + elements[4 * 0 + 3] * vec.w,
 				elements[4 * 1 + 0] * vec.x + elements[4 * 1 + 1] * vec.y + elements[4 * 1 + 2] * vec.z + elements[4 * 1 + 3] * vec.w,
 				elements[4 * 2 + 0] * vec.x + elements[4 * 2 + 1] * vec.y + elements[4 * 2 + 2] * vec.z + elements[4 * 2 + 3] * vec.w,
 				elements[4 * 3 + 0] * vec.x + elements[4 * 3 + 1] * vec.y + elements[4 * 3 + 2] * vec.z + elements[4 * 3 + 3] * vec.w
 			);
+#endif
 		}
 		vec4 mat4::getColumn(const int col) const {
 			return columns[col];
@@ -160,23 +225,26 @@ namespace sparky {
 		}
 
 		bool mat4::operator==(const mat4& mat) {
+#if SPARKY_SIMD_SSE
+			__m128 eq = _mm_and_ps(
+				_mm_and_ps(_mm_cmpeq_ps(columns[0].m128, mat.columns[0].m128), _mm_cmpeq_ps(columns[1].m128, mat.columns[1].m128)),
+				_mm_and_ps(_mm_cmpeq_ps(columns[2].m128, mat.columns[2].m128), _mm_cmpeq_ps(columns[3].m128, mat.columns[3].m128)));
+			return _mm_movemask_ps(eq) == 0xF;
+#else
 			for (int i = 0; i < 16; ++i) {
-				for (int j = 0; j < 16; ++j) {
-					if (elements[i] != mat.elements[i]) return false;
-				}
+				if (elements[i] != mat.elements[i]) return false;
 			}
 			return true;
+#endif
 		}
 		bool mat4::operator!=(const mat4& mat) {
-			for (int i = 0; i < 16; ++i) {
-				for (int j = 0; j < 16; ++j) {
-					if (elements[i] != mat.elements[i]) return true;
-				}
-			}
-			return false;
+			return !(*this == mat);
 		}
 
 		void mat4::transpose() {
+#if SPARKY_SIMD_SSE
+			_MM_TRANSPOSE4_PS(columns[0].m128, columns[1].m128, columns[2].m128, columns[3].m128);
+#else
 			float temp;
 			for (int i = 0; i < 4; ++i) {
 				for (int j = i+1; j < 4; ++j) {
@@ -185,6 +253,11 @@ namespace sparky {
 					elements[4 * j + i] = temp;
 				}
 			}
+#endif
+		}
+
+		void mat4::invert() {
+			*this = Inverse(*this);
 		}
 
 		mat4 mat4::orthographic(float left, float right, float bottom, float top, float near, float far) {
@@ -216,12 +289,139 @@ namespace sparky {
 			return mat;
 		}
 		mat4 mat4::Transpose(const mat4& mat) {
-			mat4 new_mat = mat4();
-			for (int i = 0; i < 4; ++i) {
-				for (int j = 0; j < 4; ++j) {
-					new_mat.elements[4 * i + j] = mat.elements[4 * j + i];
-				}
+			mat4 new_mat = mat;
+			new_mat.transpose();
+			return new_mat;
+		}
+		mat4 mat4::Inverse(const mat4& mat) {
+			mat4 new_mat;
+#if SPARKY_SIMD_SSE
+			// Block inverse over the four 2x2 sub matrices | A B |
+			//                                              | C D |
+			// It does not depend on whether elements are read as rows or columns
+			__m128 c0 = mat.columns[0].m128;
+			__m128 c1 = mat.columns[1].m128;
+			__m128 c2 = mat.columns[2].m128;
+			__m128 c3 = mat.columns[3].m128;
+
+			__m128 A = _mm_movelh_ps(c0, c1);
+			__m128 B = _mm_movehl_ps(c1, c0);
+			__m128 C = _mm_movelh_ps(c2, c3);
+			__m128 D = _mm_movehl_ps(c3, c2);
+
+			// (|A|, |B|, |C|, |D|)
+			__m128 det_sub = _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(c0, c2, SPARKY_SHUFFLE(0, 2, 0, 2)), _mm_shuffle_ps(c1, c3, SPARKY_SHUFFLE(1, 3, 1, 3))),
+				_mm_mul_ps(_mm_shuffle_ps(c0, c2, SPARKY_SHUFFLE(1, 3, 1, 3)), _mm_shuffle_ps(c1, c3, SPARKY_SHUFFLE(0, 2, 0, 2))));
+			__m128 det_A = _mm_shuffle_ps(det_sub, det_sub, SPARKY_SHUFFLE(0, 0, 0, 0));
+			__m128 det_B = _mm_shuffle_ps(det_sub, det_sub, SPARKY_SHUFFLE(1, 1, 1, 1));
+			__m128 det_C = _mm_shuffle_ps(det_sub, det_sub, SPARKY_SHUFFLE(2, 2, 2, 2));
+			__m128 det_D = _mm_shuffle_ps(det_sub, det_sub, SPARKY_SHUFFLE(3, 3, 3, 3));
+
+			__m128 D_C = mat2_adj_mul(D, C);
+			__m128 A_B = mat2_adj_mul(A, B);
+			__m128 X = _mm_sub_ps(_mm_mul_ps(det_D, A), mat2_mul(B, D_C));
+			__m128 W = _mm_sub_ps(_mm_mul_ps(det_A, D), mat2_mul(C, A_B));
+			__m128 Y = _mm_sub_ps(_mm_mul_ps(det_B, C), mat2_mul_adj(D, A_B));
+			__m128 Z = _mm_sub_ps(_mm_mul_ps(det_C, B), mat2_mul_adj(A, D_C));
+
+			// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+			__m128 tr = _mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, SPARKY_SHUFFLE(0, 2, 1, 3)));
+			tr = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+			tr = _mm_add_ss(tr, _mm_shuffle_ps(tr, tr, SPARKY_SHUFFLE(1, 1, 1, 1)));
+			tr = _mm_shuffle_ps(tr, tr, SPARKY_SHUFFLE(0, 0, 0, 0));
+			__m128 det_M = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_A, det_D), _mm_mul_ps(det_B, det_C)), tr);
+
+			__m128 rcp_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det_M);
+			X = _mm_mul_ps(X, rcp_det);
+			Y = _mm_mul_ps(Y, rcp_det);
+			Z = _mm_mul_ps(Z, rcp_det);
+			W = _mm_mul_ps(W, rcp_det);
+
+			new_mat.columns[0].m128 = _mm_shuffle_ps(X, Y, SPARKY_SHUFFLE(3, 1, 3, 1));
+			new_mat.columns[1].m128 = _mm_shuffle_ps(X, Y, SPARKY_SHUFFLE(2, 0, 2, 0));
+			new_mat.columns[2].m128 = _mm_shuffle_ps(Z, W, SPARKY_SHUFFLE(3, 1, 3, 1));
+			new_mat.columns[3].m128 = _mm_shuffle_ps(Z, W, SPARKY_SHUFFLE(2, 0, 2, 0));
+#else
+			const float* m = mat.elements;
+			float* inv = new_mat.elements;
+
+			inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+			inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+			inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+			inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+			inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+			inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+			inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+			inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+			inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+			inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+			inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+			inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+			inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+			inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+			inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+			inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+			float det = 1.0f / (m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12]);
+			for (int i = 0; i < 16; ++i) {
+				inv[i] *= det;
+			}
+#endif
+			return new_mat;
+		}
+		mat4 mat4::AffineInverse(const mat4& mat) {
+			mat4 new_mat;
+#if SPARKY_SIMD_SSE
+			const __m128 xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+			__m128 a = _mm_and_ps(mat.columns[0].m128, xyz_mask);
+			__m128 b = _mm_and_ps(mat.columns[1].m128, xyz_mask);
+			__m128 c = _mm_and_ps(mat.columns[2].m128, xyz_mask);
+
+			// rows of the inverse 3x3 are the cross products of its columns over the determinant
+			__m128 r0 = cross3(b, c);
+			__m128 r1 = cross3(c, a);
+			__m128 r2 = cross3(a, b);
+			__m128 det = _mm_mul_ps(a, r0);
+			det = _mm_add_ps(det, _mm_movehl_ps(det, det));
+			det = _mm_add_ss(det, _mm_shuffle_ps(det, det, SPARKY_SHUFFLE(1, 1, 1, 1)));
+			__m128 rcp_det = _mm_div_ps(_mm_set1_ps(1.0f), _mm_shuffle_ps(det, det, SPARKY_SHUFFLE(0, 0, 0, 0)));
+			r0 = _mm_mul_ps(r0, rcp_det);
+			r1 = _mm_mul_ps(r1, rcp_det);
+			r2 = _mm_mul_ps(r2, rcp_det);
+
+			__m128 r3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			__m128 t = _mm_sub_ps(_mm_setzero_ps(), combine_columns(r0, r1, r2, r3, mat.columns[3].m128));
+			new_mat.columns[0].m128 = r0;
+			new_mat.columns[1].m128 = r1;
+			new_mat.columns[2].m128 = r2;
+			new_mat.columns[3].m128 = _mm_add_ps(t, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+#else
+			const float* m = mat.elements;
+			float* inv = new_mat.elements;
+
+			inv[0] = m[5] * m[10] - m[6] * m[9];
+			inv[1] = m[2] * m[9] - m[1] * m[10];
+			inv[2] = m[1] * m[6] - m[2] * m[5];
+			inv[4] = m[6] * m[8] - m[4] * m[10];
+			inv[5] = m[0] * m[10] - m[2] * m[8];
+			inv[6] = m[2] * m[4] - m[0] * m[6];
+			inv[8] = m[4] * m[9] - m[5] * m[8];
+			inv[9] = m[1] * m[8] - m[0] * m[9];
+			inv[10] = m[0] * m[5] - m[1] * m[4];
+
+			float det = 1.0f / (m[0] * inv[0] + m[4] * inv[1] + m[8] * inv[2]);
+			for (int i = 0; i < 3; ++i) {
+				inv[4 * i + 0] *= det;
+				inv[4 * i + 1] *= det;
+				inv[4 * i + 2] *= det;
 			}
+			inv[12] = -(inv[0] * m[12] + inv[4] * m[13] + inv[8] * m[14]);
+			inv[13] = -(inv[1] * m[12] + inv[5] * m[13] + inv[9] * m[14]);
+			inv[14] = -(inv[2] * m[12] + inv[6] * m[13] + inv[10] * m[14]);
+			inv[15] = 1.0f;
+#endif
 			return new_mat;
 		}
 		mat4 mat4::rotation(float angle, const vec3& axis) {
@@ -255,6 +455,10 @@ namespace sparky {
 		}
 		mat4 mat4::glMultiply(const mat4& mat1, const mat4& mat2) {
 			mat4 new_mat = mat4();
+#if SPARKY_SIMD_SSE
+			// column i of the product is mat1 applied to column i of mat2
+			multiply_rows(mat2.elements, mat1.elements, new_mat.elements);
+#else
 			float sum;
 			for (int i = 0; i < 4; ++i) {
 				for (int j = 0; j < 4; ++j) {
@@ -265,9 +469,61 @@ namespace sparky {
 					new_mat.elements[4 * i + j] = sum;
 				}
 			}
+#endif
 			return new_mat;
 		}
 
+		void mat4::transformPoints(const mat4& mat, const vec4* in, vec4* out, size_t count) {
+#if SPARKY_SIMD_SSE
+			size_t i = 0;
+#if SPARKY_SIMD_AVX
+			// two points per iteration, each 128 bit lane holds one point
+			__m256 c0 = _mm256_broadcast_ps(&mat.columns[0].m128);
+			__m256 c1 = _mm256_broadcast_ps(&mat.columns[1].m128);
+			__m256 c2 = _mm256_broadcast_ps(&mat.columns[2].m128);
+			__m256 c3 = _mm256_broadcast_ps(&mat.columns[3].m128);
+			for (; i + 2 <= count; i += 2) {
+				__m256 p = _mm256_loadu_ps(in[i].coords);
+				__m256 r = _mm256_mul_ps(c0, _mm256_permute_ps(p, SPARKY_SHUFFLE(0, 0, 0, 0)));
+				r = _mm256_add_ps(r, _mm256_mul_ps(c1, _mm256_permute_ps(p, SPARKY_SHUFFLE(1, 1, 1, 1))));
+				r = _mm256_add_ps(r, _mm256_mul_ps(c2, _mm256_permute_ps(p, SPARKY_SHUFFLE(2, 2, 2, 2))));
+				r = _mm256_add_ps(r, _mm256_mul_ps(c3, _mm256_permute_ps(p, SPARKY_SHUFFLE(3, 3, 3, 3))));
+				_mm256_storeu_ps(out[i].coords, r);
+			}
+#endif
+			__m128 m0 = mat.columns[0].m128;
+			__m128 m1 = mat.columns[1].m128;
+			__m128 m2 = mat.columns[2].m128;
+			__m128 m3 = mat.columns[3].m128;
+			for (; i < count; ++i) {
+				out[i].m128 = combine_columns(m0, m1, m2, m3, in[i].m128);
+			}
+#else
+			const float* m = mat.elements;
+			for (size_t i = 0; i < count; ++i) {
+				vec4 p = in[i];
+				out[i] = vec4(
+					m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12] * p.w,
+					m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13] * p.w,
+					m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14] * p.w,
+					m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15] * p.w
+				);
+			}
+#endif
+		}
+		void mat4::transformPoints(const mat4& mat, const vec3* in, vec3* out, size_t count) {
+			// points are implicitly w = 1, the projective component is dropped
+			const float* m = mat.elements;
+			for (size_t i = 0; i < count; ++i) {
+				vec3 p = in[i];
+				out[i] = vec3(
+					m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+					m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+					m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]
+				);
+			}
+		}
+
 		std::ostream& operator<<(std::ostream& stream, const mat4& mat) {
 			stream << "mat4:" << std::endl;
 			for (int i = 0; i < 4; ++i) {
@@ -5,7 +5,7 @@
 namespace sparky {
 	namespace maths {
 
-		struct mat4 {
+		struct alignas(16) mat4 {
 
 			union
 			{
@@ -53,6 +53,7 @@ namespace sparky {
 			bool operator!=(const mat4& mat);
 
 			void transpose();
+			void invert();
 
 			static mat4 orthographic(float left, float right, float bottom, float top, float near, float far);
 			static mat4 perspective(float fov, float aspectRatio, float near, float far);
@@ -75,6 +76,15 @@ namespace sparky {
 			static mat4 scale(const vec3& scale);
 
 			static mat4 Transpose(const mat4& mat);
+			// General inverse, the result is not finite for a singular matrix
+			static mat4 Inverse(const mat4& mat);
+			// Inverse of an affine transform, i.e. bottom row (0, 0, 0, 1) in OpenGL layout
+			static mat4 AffineInverse(const mat4& mat);
+
+			// Transform count points in one go using the OpenGL convention (same as glMultiply).
+			// in and out may point to the same array.
+			static void transformPoints(const mat4& mat, const vec4* in, vec4* out, size_t count);
+			static void transformPoints(const mat4& mat, const vec3* in, vec3* out, size_t count);
 			
 			void glMultiply(const mat4& mat);
 			static mat4 glMultiply(const mat4& mat1, const mat4& mat2);
@@ -1,18 +0,0 @@
-#pragma once
-
-#include "Input.h"
-
-namespace sparky {
-
-	class WindowsInput : public Input
-	{
-	protected:
-		virtual bool IsKeyPressedImpl(int keycode) override;
-
-		virtual bool IsMouseButtonPressedImpl(int button) override;
-		virtual std::pair<float, float> GetMousePositionImpl() override;
-		virtual float GetMouseXImpl() override;
-		virtual float GetMouseYImpl() override;
-	};
-
-}
\ No newline at end of file
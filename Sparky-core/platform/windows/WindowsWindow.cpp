@@ -2,6 +2,7 @@
 #include "Events/ApplicationEvent.h"
 #include "Events/MouseEvent.h"
 #include "Events/KeyEvent.h"
+#include "GLDebug.h"
 
 namespace sparky {
 
@@ -44,10 +45,14 @@ namespace sparky {
 			s_GLFWInitialized = true;
 		}
 
+		glfwWindowHint(GLFW_VISIBLE, props.Visible ? GLFW_TRUE : GLFW_FALSE);
+		glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, props.DebugContext ? GLFW_TRUE : GLFW_FALSE);
 		m_Window = glfwCreateWindow((int)props.Width, (int)props.Height, m_Data.Title.c_str(), nullptr, nullptr);
 		glfwMakeContextCurrent(m_Window);
 		int status = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 		SPARKY_CORE_ASSERT(status, "Failed to initialize GLAD!");
+		if (props.DebugContext)
+			GLDebug::Install();
 		glfwSetWindowUserPointer(m_Window, &m_Data);
 		SetVSync(true);
 
@@ -144,6 +149,7 @@ namespace sparky {
 
 	void WindowsWindow::Shutdown()
 	{
+		GLDebug::Uninstall();
 		glfwDestroyWindow(m_Window);
 	}
 
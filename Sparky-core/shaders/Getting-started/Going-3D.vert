@@ -5,8 +5,12 @@ layout (location = 1) in vec2 aTexCoord;
 out vec2 TexCoord;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 proj;
+// per frame, from the frame's transient buffer
+layout (std140) uniform Camera
+{
+	mat4 view;
+	mat4 proj;
+};
 
 void main()
 {
@@ -0,0 +1,41 @@
+#pragma once
+
+// SIMD backend selection for the maths library.
+//
+// The backend is picked at compile time from the target architecture flags:
+//   SPARKY_SIMD_AVX - 256 bit paths for batched work (/arch:AVX, -mavx)
+//   SPARKY_SIMD_SSE - 128 bit paths for vec4/mat4 (always on for x64 builds)
+// Define SPARKY_SIMD_DISABLE to force the portable scalar fallback.
+
+#if !defined(SPARKY_SIMD_DISABLE)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define SPARKY_SIMD_SSE 1
+	#endif
+	#if defined(SPARKY_SIMD_SSE) && defined(__AVX__)
+		#define SPARKY_SIMD_AVX 1
+	#endif
+#endif
+
+#ifndef SPARKY_SIMD_SSE
+	#define SPARKY_SIMD_SSE 0
+#endif
+#ifndef SPARKY_SIMD_AVX
+	#define SPARKY_SIMD_AVX 0
+#endif
+
+#if SPARKY_SIMD_AVX
+	#include <immintrin.h>
+#elif SPARKY_SIMD_SSE
+	#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+	#define SPARKY_FORCEINLINE __forceinline
+#else
+	#define SPARKY_FORCEINLINE inline __attribute__((always_inline))
+#endif
+
+#if SPARKY_SIMD_SSE
+	// Builds an _mm_shuffle_ps immediate from lane indices written in memory order
+	#define SPARKY_SHUFFLE(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+#endif
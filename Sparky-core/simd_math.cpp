@@ -0,0 +1,170 @@
+#include "simd_math.h"
+
+namespace sparky {
+	namespace maths {
+		namespace simd {
+			namespace detail {
+
+#if SPARKY_SIMD_AVX && defined(__AVX2__)
+				// Eight lanes, the integer parts of the kernels need AVX2
+				struct vint {
+					__m256i m;
+					vint(__m256i m) : m(m) {}
+					vint(int32_t i) : m(_mm256_set1_epi32(i)) {}
+				};
+				struct vfloat {
+					static const size_t Width = 8;
+					__m256 m;
+					vfloat() {}
+					vfloat(__m256 m) : m(m) {}
+					vfloat(float f) : m(_mm256_set1_ps(f)) {}
+					static vfloat load(const float* p) { return _mm256_loadu_ps(p); }
+					void store(float* p) const { _mm256_storeu_ps(p, m); }
+				};
+
+				SPARKY_FORCEINLINE vfloat operator+(const vfloat& a, const vfloat& b) { return _mm256_add_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat operator-(const vfloat& a, const vfloat& b) { return _mm256_sub_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat operator*(const vfloat& a, const vfloat& b) { return _mm256_mul_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat operator/(const vfloat& a, const vfloat& b) { return _mm256_div_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat operator-(const vfloat& a) { return _mm256_xor_ps(a.m, _mm256_set1_ps(-0.0f)); }
+				SPARKY_FORCEINLINE vfloat operator>(const vfloat& a, const vfloat& b) { return _mm256_cmp_ps(a.m, b.m, _CMP_GT_OQ); }
+				SPARKY_FORCEINLINE vfloat operator<(const vfloat& a, const vfloat& b) { return _mm256_cmp_ps(a.m, b.m, _CMP_LT_OQ); }
+				SPARKY_FORCEINLINE vfloat operator==(const vfloat& a, const vfloat& b) { return _mm256_cmp_ps(a.m, b.m, _CMP_EQ_OQ); }
+				SPARKY_FORCEINLINE vfloat select(const vfloat& mask, const vfloat& a, const vfloat& b) { return _mm256_blendv_ps(b.m, a.m, mask.m); }
+				SPARKY_FORCEINLINE vfloat vabs(const vfloat& a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.m); }
+
+				SPARKY_FORCEINLINE vint operator+(const vint& a, const vint& b) { return _mm256_add_epi32(a.m, b.m); }
+				SPARKY_FORCEINLINE vint operator-(const vint& a, const vint& b) { return _mm256_sub_epi32(a.m, b.m); }
+				SPARKY_FORCEINLINE vint operator&(const vint& a, const vint& b) { return _mm256_and_si256(a.m, b.m); }
+				SPARKY_FORCEINLINE vint operator|(const vint& a, const vint& b) { return _mm256_or_si256(a.m, b.m); }
+				SPARKY_FORCEINLINE vint operator<<(const vint& a, int n) { return _mm256_slli_epi32(a.m, n); }
+				SPARKY_FORCEINLINE vint operator>>(const vint& a, int n) { return _mm256_srai_epi32(a.m, n); }
+
+				SPARKY_FORCEINLINE vint round_int(const vfloat& a) { return _mm256_cvtps_epi32(a.m); }
+				SPARKY_FORCEINLINE vfloat to_float(const vint& a) { return _mm256_cvtepi32_ps(a.m); }
+				SPARKY_FORCEINLINE vint as_int(const vfloat& a) { return _mm256_castps_si256(a.m); }
+				SPARKY_FORCEINLINE vfloat as_float(const vint& a) { return _mm256_castsi256_ps(a.m); }
+				SPARKY_FORCEINLINE vfloat sign_bit(const vfloat& a) { return _mm256_castsi256_ps(_mm256_srai_epi32(_mm256_castps_si256(a.m), 31)); }
+				SPARKY_FORCEINLINE vfloat bit_set(const vint& a, int32_t bit) {
+					__m256i b = _mm256_set1_epi32(bit);
+					return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a.m, b), b));
+				}
+#elif SPARKY_SIMD_SSE
+				// Four lanes, SSE2 only so that blends are and / andnot / or
+				struct vint {
+					__m128i m;
+					vint(__m128i m) : m(m) {}
+					vint(int32_t i) : m(_mm_set1_epi32(i)) {}
+				};
+				struct vfloat {
+					static const size_t Width = 4;
+					__m128 m;
+					vfloat() {}
+					vfloat(__m128 m) : m(m) {}
+					vfloat(float f) : m(_mm_set1_ps(f)) {}
+					static vfloat load(const float* p) { return _mm_loadu_ps(p); }
+					void store(float* p) const { _mm_storeu_ps(p, m); }
+				};
+
+				SPARKY_FORCEINLINE vfloat operator+(const vfloat& a, const vfloat& b) { return _mm_add_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat operator-(const vfloat& a, const vfloat& b) { return _mm_sub_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat operator*(const vfloat& a, const vfloat& b) { return _mm_mul_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat operator/(const vfloat& a, const vfloat& b) { return _mm_div_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat operator-(const vfloat& a) { return _mm_xor_ps(a.m, _mm_set1_ps(-0.0f)); }
+				SPARKY_FORCEINLINE vfloat operator>(const vfloat& a, const vfloat& b) { return _mm_cmpgt_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat operator<(const vfloat& a, const vfloat& b) { return _mm_cmplt_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat operator==(const vfloat& a, const vfloat& b) { return _mm_cmpeq_ps(a.m, b.m); }
+				SPARKY_FORCEINLINE vfloat select(const vfloat& mask, const vfloat& a, const vfloat& b) { return _mm_or_ps(_mm_and_ps(mask.m, a.m), _mm_andnot_ps(mask.m, b.m)); }
+				SPARKY_FORCEINLINE vfloat vabs(const vfloat& a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.m); }
+
+				SPARKY_FORCEINLINE vint operator+(const vint& a, const vint& b) { return _mm_add_epi32(a.m, b.m); }
+				SPARKY_FORCEINLINE vint operator-(const vint& a, const vint& b) { return _mm_sub_epi32(a.m, b.m); }
+				SPARKY_FORCEINLINE vint operator&(const vint& a, const vint& b) { return _mm_and_si128(a.m, b.m); }
+				SPARKY_FORCEINLINE vint operator|(const vint& a, const vint& b) { return _mm_or_si128(a.m, b.m); }
+				SPARKY_FORCEINLINE vint operator<<(const vint& a, int n) { return _mm_slli_epi32(a.m, n); }
+				SPARKY_FORCEINLINE vint operator>>(const vint& a, int n) { return _mm_srai_epi32(a.m, n); }
+
+				SPARKY_FORCEINLINE vint round_int(const vfloat& a) { return _mm_cvtps_epi32(a.m); }
+				SPARKY_FORCEINLINE vfloat to_float(const vint& a) { return _mm_cvtepi32_ps(a.m); }
+				SPARKY_FORCEINLINE vint as_int(const vfloat& a) { return _mm_castps_si128(a.m); }
+				SPARKY_FORCEINLINE vfloat as_float(const vint& a) { return _mm_castsi128_ps(a.m); }
+				SPARKY_FORCEINLINE vfloat sign_bit(const vfloat& a) { return _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(a.m), 31)); }
+				SPARKY_FORCEINLINE vfloat bit_set(const vint& a, int32_t bit) {
+					__m128i b = _mm_set1_epi32(bit);
+					return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a.m, b), b));
+				}
+#endif
+
+				// Runs kernel over full registers, the remainder goes through the scalar lane functions
+				template<typename K>
+				SPARKY_FORCEINLINE void map(const float* in, float* out, size_t count, K kernel) {
+					size_t i = 0;
+#if SPARKY_SIMD_SSE
+					for (; i + vfloat::Width <= count; i += vfloat::Width)
+						kernel(vfloat::load(in + i)).store(out + i);
+#endif
+					for (; i < count; ++i) out[i] = kernel(in[i]);
+				}
+				template<typename K>
+				SPARKY_FORCEINLINE void map(const float* a, const float* b, float* out, size_t count, K kernel) {
+					size_t i = 0;
+#if SPARKY_SIMD_SSE
+					for (; i + vfloat::Width <= count; i += vfloat::Width)
+						kernel(vfloat::load(a + i), vfloat::load(b + i)).store(out + i);
+#endif
+					for (; i < count; ++i) out[i] = kernel(a[i], b[i]);
+				}
+			}
+
+			template<Accuracy A>
+			void sin(const float* in, float* out, size_t count) {
+				detail::map(in, out, count, [](auto x) { decltype(x) s, c; detail::sincos1<A>(x, s, c); return s; });
+			}
+			template<Accuracy A>
+			void cos(const float* in, float* out, size_t count) {
+				detail::map(in, out, count, [](auto x) { decltype(x) s, c; detail::sincos1<A>(x, s, c); return c; });
+			}
+			template<Accuracy A>
+			void sincos(const float* in, float* outSin, float* outCos, size_t count) {
+				size_t i = 0;
+#if SPARKY_SIMD_SSE
+				for (; i + detail::vfloat::Width <= count; i += detail::vfloat::Width) {
+					detail::vfloat s, c;
+					detail::sincos1<A>(detail::vfloat::load(in + i), s, c);
+					s.store(outSin + i);
+					c.store(outCos + i);
+				}
+#endif
+				for (; i < count; ++i) detail::sincos1<A>(in[i], outSin[i], outCos[i]);
+			}
+			template<Accuracy A>
+			void exp(const float* in, float* out, size_t count) {
+				detail::map(in, out, count, [](auto x) { return detail::exp1<A>(x); });
+			}
+			template<Accuracy A>
+			void log(const float* in, float* out, size_t count) {
+				detail::map(in, out, count, [](auto x) { return detail::log1<A>(x); });
+			}
+			template<Accuracy A>
+			void pow(const float* x, const float* y, float* out, size_t count) {
+				detail::map(x, y, out, count, [](auto a, auto b) { return detail::pow1<A>(a, b); });
+			}
+			template<Accuracy A>
+			void atan2(const float* y, const float* x, float* out, size_t count) {
+				detail::map(y, x, out, count, [](auto a, auto b) { return detail::atan2_1<A>(a, b); });
+			}
+
+			#define SPARKY_SIMD_MATH_INSTANTIATE(A)\
+				template void sin<A>(const float*, float*, size_t);\
+				template void cos<A>(const float*, float*, size_t);\
+				template void sincos<A>(const float*, float*, float*, size_t);\
+				template void exp<A>(const float*, float*, size_t);\
+				template void log<A>(const float*, float*, size_t);\
+				template void pow<A>(const float*, const float*, float*, size_t);\
+				template void atan2<A>(const float*, const float*, float*, size_t);
+
+			SPARKY_SIMD_MATH_INSTANTIATE(Accuracy::Fast)
+			SPARKY_SIMD_MATH_INSTANTIATE(Accuracy::Default)
+		}
+	}
+}
@@ -0,0 +1,195 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include "soa.h"
+
+// Vectorised approximations of the libm transcendentals for float arrays and
+// the wide floatx types. The array versions run 4 (SSE2) or 8 (AVX2) lanes per
+// step with intrinsics, the tail and SPARKY_SIMD_DISABLE builds use the same
+// kernels on plain floats.
+//
+// Two accuracy tiers are available:
+//   Accuracy::Fast    - short polynomials, for animation and particles
+//   Accuracy::Default - close to single precision libm
+//
+// Maximum absolute error against double precision libm, measured by Sparky-bench:
+//   function    Fast        Default      valid input
+//   sin, cos    7e-4        9e-8         |x| < 100, Default grows to 1.1e-6 at |x| = 1e5
+//   exp         1.2e-4 rel  1.2e-7 rel   x clamped to [-87, 88]
+//   log         2e-4        2.8e-7       x > 0 and denormals (1 ulp of the result for large x),
+//                                        log(0) = -inf, log(x < 0) = NaN, inf and NaN pass through
+//   pow         exp(y * log(x)), x >= 0 only, relative error ~ |y log(x)| * log error,
+//               pow(x, 0) = 1, pow(0, y > 0) = 0, pow(0, y < 0) = inf, otherwise clamped like exp
+//   atan2       1.5e-3      2.7e-7       any, atan2(0, 0) = 0
+
+namespace sparky {
+	namespace maths {
+		namespace simd {
+
+			enum class Accuracy { Fast, Default };
+
+			namespace detail {
+				static const float PI = 3.14159265358979f;
+				static const float PI_2 = 1.57079632679490f;
+				static const float PI_4 = 0.78539816339745f;
+				static const float TWO_OVER_PI = 0.63661977236758f;
+				// pi / 2 split in two parts for Cody-Waite range reduction
+				static const float PI_2_HI = 1.5703125f;
+				static const float PI_2_LO = 4.83826794897e-4f;
+				static const float LOG2E = 1.44269504088896f;
+				static const float LN2_HI = 0.693359375f;
+				static const float LN2_LO = -2.12194440e-4f;
+
+				// Scalar lane operations. The kernels below are written once against this
+				// small set of functions, simd_math.cpp supplies the same set for SSE and
+				// AVX registers so every lane runs the same branch free code.
+				SPARKY_FORCEINLINE float as_float(int32_t i) { float f; memcpy(&f, &i, sizeof(f)); return f; }
+				SPARKY_FORCEINLINE int32_t as_int(float f) { int32_t i; memcpy(&i, &f, sizeof(i)); return i; }
+				SPARKY_FORCEINLINE float to_float(int32_t i) { return (float)i; }
+				// round to nearest without going through the FPU rounding mode
+				SPARKY_FORCEINLINE int32_t round_int(float x) { return (int32_t)(x + (x >= 0.0f ? 0.5f : -0.5f)); }
+				SPARKY_FORCEINLINE float select(bool mask, float a, float b) { return mask ? a : b; }
+				SPARKY_FORCEINLINE float vabs(float x) { return fabsf(x); }
+				// sign bit rather than a compare so that -0 behaves like libm
+				SPARKY_FORCEINLINE bool sign_bit(float x) { return as_int(x) < 0; }
+				SPARKY_FORCEINLINE bool bit_set(int32_t i, int32_t bit) { return (i & bit) != 0; }
+
+				// sin and cos of r in [-pi/4, pi/4]
+				template<Accuracy A, typename V>
+				SPARKY_FORCEINLINE V sin_poly(const V& r) {
+					V r2 = r * r;
+					if (A == Accuracy::Fast)
+						return r + r * r2 * (-1.6605e-1f + r2 * 7.61e-3f);
+					return r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+				}
+				template<Accuracy A, typename V>
+				SPARKY_FORCEINLINE V cos_poly(const V& r) {
+					V r2 = r * r;
+					if (A == Accuracy::Fast)
+						return 1.0f + r2 * (-4.967e-1f + r2 * 3.705e-2f);
+					return 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+				}
+
+				template<Accuracy A, typename V>
+				SPARKY_FORCEINLINE void sincos1(const V& x, V& s, V& c) {
+					auto q = round_int(x * TWO_OVER_PI);
+					V qf = to_float(q);
+					V r = (x - qf * PI_2_HI) - qf * PI_2_LO;
+					V ps = sin_poly<A>(r);
+					V pc = cos_poly<A>(r);
+					auto swap = bit_set(q, 1);
+					V ss = select(swap, pc, ps);
+					V cc = select(swap, ps, pc);
+					s = select(bit_set(q, 2), -ss, ss);
+					c = select(bit_set(q + 1, 2), -cc, cc);
+				}
+
+				template<Accuracy A, typename V>
+				SPARKY_FORCEINLINE V exp1(V x) {
+					x = select(x > 88.0f, V(88.0f), x);
+					x = select(x < -87.0f, V(-87.0f), x);
+					auto k = round_int(x * LOG2E);
+					V kf = to_float(k);
+					V r = (x - kf * LN2_HI) - kf * LN2_LO;
+					V p;
+					if (A == Accuracy::Fast)
+						p = 1.0f + r + r * r * (5.039416e-1f + r * 1.666286e-1f);
+					else
+						p = 1.0f + r + r * r * (5.0000001201e-1f + r * (1.6666665459e-1f + r * (4.1665795894e-2f +
+							r * (8.3334519073e-3f + r * (1.3981999507e-3f + r * 1.9875691500e-4f)))));
+					return p * as_float((k + 127) << 23);
+				}
+
+				template<Accuracy A, typename V>
+				SPARKY_FORCEINLINE V log1(const V& x) {
+					// denormals have no implicit bit, scaled by 2^23 they are normal
+					auto tiny = x < 1.17549435e-38f;
+					auto bits = as_int(select(tiny, x * 8388608.0f, x));
+					auto e = ((bits >> 23) & 0xFF) - 127;
+					V m = as_float((bits & 0x007FFFFF) | 0x3F800000);
+					// keep the mantissa in [sqrt(1/2), sqrt(2)) so the polynomial stays small
+					auto big = m > 1.41421356f;
+					m = select(big, m * 0.5f, m);
+					V ef = to_float(e) + select(big, V(1.0f), V(0.0f)) - select(tiny, V(23.0f), V(0.0f));
+					V f = m - 1.0f;
+					V z = f * f;
+					V p;
+					if (A == Accuracy::Fast)
+						p = f - 0.5f * z + z * f * (3.516147e-1f - 2.389986e-1f * f);
+					else
+						p = f - 0.5f * z + z * f * (3.3333331174e-1f + f * (-2.4999993993e-1f + f * (2.0000714765e-1f +
+							f * (-1.6668057665e-1f + f * (1.4249322787e-1f + f * (-1.2420140846e-1f + f * (1.1676998740e-1f +
+							f * (-1.1514610310e-1f + f * 7.0376836292e-2f))))))));
+					V r = p + ef * 0.693147180559945f;
+					r = select(x == 0.0f, V(-INFINITY), r);
+					r = select(x < 0.0f, V(NAN), r);
+					// false only for +inf and NaN, which are their own log
+					return select(x < INFINITY, r, x);
+				}
+
+				// x >= 0 only
+				template<Accuracy A, typename V>
+				SPARKY_FORCEINLINE V pow1(const V& x, const V& y) {
+					V r = select(x == 0.0f, select(y < 0.0f, V(INFINITY), V(0.0f)), exp1<A>(y * log1<A>(x)));
+					return select(y == 0.0f, V(1.0f), r);
+				}
+
+				template<Accuracy A, typename V>
+				SPARKY_FORCEINLINE V atan2_1(const V& y, const V& x) {
+					V ax = vabs(x), ay = vabs(y);
+					auto steep = ay > ax;
+					V mx = select(steep, ay, ax);
+					V mn = select(steep, ax, ay);
+					V a = select(mx > 0.0f, mn / mx, V(0.0f));
+					V r;
+					if (A == Accuracy::Fast) {
+						r = PI_4 * a - a * (a - 1.0f) * (0.2447f + 0.0663f * a);
+					}
+					else {
+						// reduce a in [0, 1] to |t| <= tan(pi / 8)
+						auto reduce = a > 0.41421356f;
+						V t = select(reduce, (a - 1.0f) / (a + 1.0f), a);
+						V z = t * t;
+						r = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * t + t;
+						r = select(reduce, r + PI_4, r);
+					}
+					r = select(steep, PI_2 - r, r);
+					r = select(sign_bit(x), PI - r, r);
+					return select(sign_bit(y), -r, r);
+				}
+			}
+
+			// Array versions, out may alias in
+			template<Accuracy A = Accuracy::Default>
+			void sin(const float* in, float* out, size_t count);
+			template<Accuracy A = Accuracy::Default>
+			void cos(const float* in, float* out, size_t count);
+			template<Accuracy A = Accuracy::Default>
+			void sincos(const float* in, float* outSin, float* outCos, size_t count);
+			template<Accuracy A = Accuracy::Default>
+			void exp(const float* in, float* out, size_t count);
+			template<Accuracy A = Accuracy::Default>
+			void log(const float* in, float* out, size_t count);
+			template<Accuracy A = Accuracy::Default>
+			void pow(const float* x, const float* y, float* out, size_t count);
+			template<Accuracy A = Accuracy::Default>
+			void atan2(const float* y, const float* x, float* out, size_t count);
+
+			// Wide versions, one call covers every lane
+			template<Accuracy A = Accuracy::Default, int N>
+			inline void sincos(const floatx<N>& x, floatx<N>& s, floatx<N>& c) { sincos<A>(x.v, s.v, c.v, N); }
+			template<Accuracy A = Accuracy::Default, int N>
+			inline floatx<N> sin(const floatx<N>& x) { floatx<N> r; sin<A>(x.v, r.v, N); return r; }
+			template<Accuracy A = Accuracy::Default, int N>
+			inline floatx<N> cos(const floatx<N>& x) { floatx<N> r; cos<A>(x.v, r.v, N); return r; }
+			template<Accuracy A = Accuracy::Default, int N>
+			inline floatx<N> exp(const floatx<N>& x) { floatx<N> r; exp<A>(x.v, r.v, N); return r; }
+			template<Accuracy A = Accuracy::Default, int N>
+			inline floatx<N> log(const floatx<N>& x) { floatx<N> r; log<A>(x.v, r.v, N); return r; }
+			template<Accuracy A = Accuracy::Default, int N>
+			inline floatx<N> pow(const floatx<N>& x, const floatx<N>& y) { floatx<N> r; pow<A>(x.v, y.v, r.v, N); return r; }
+			template<Accuracy A = Accuracy::Default, int N>
+			inline floatx<N> atan2(const floatx<N>& y, const floatx<N>& x) { floatx<N> r; atan2<A>(y.v, x.v, r.v, N); return r; }
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#include "soa.h"
+
+namespace sparky {
+	namespace maths {
+		namespace bulk {
+
+			void transformPoints(const mat4& mat, const vec3* points, vec3* out, size_t count) {
+				const float* m = mat.elements;
+				for (size_t i = 0; i < count; i += 8) {
+					int n = (count - i < 8) ? (int)(count - i) : 8;
+					vec3x8 p = vec3x8::load(points + i, n);
+					vec3x8 r(
+						p.x * m[0] + p.y * m[4] + p.z * m[8] + m[12],
+						p.x * m[1] + p.y * m[5] + p.z * m[9] + m[13],
+						p.x * m[2] + p.y * m[6] + p.z * m[10] + m[14]);
+					r.store(out + i, n);
+				}
+			}
+
+			void distances(const vec3& camera, const vec3* points, float* out, size_t count) {
+				vec3x8 eye(camera);
+				for (size_t i = 0; i < count; i += 8) {
+					int n = (count - i < 8) ? (int)(count - i) : 8;
+					floatx8 d = length(vec3x8::load(points + i, n) - eye);
+					for (int l = 0; l < n; ++l) {
+						out[i + l] = d.v[l];
+					}
+				}
+			}
+
+			void transformSpheres(const mat4* models, const vec3* centers, const float* radii,
+				vec3* outCenters, float* outRadii, size_t count) {
+				for (size_t i = 0; i < count; i += 8) {
+					int n = (count - i < 8) ? (int)(count - i) : 8;
+					mat4x8 m = mat4x8::load(models + i, n);
+					floatx8 r;
+					for (int l = 0; l < n; ++l) {
+						r.v[l] = radii[i + l];
+					}
+					m.transformPoint(vec3x8::load(centers + i, n)).store(outCenters + i, n);
+					r = r * m.maxScale();
+					for (int l = 0; l < n; ++l) {
+						outRadii[i + l] = r.v[l];
+					}
+				}
+			}
+		}
+	}
+}
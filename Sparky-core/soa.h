@@ -0,0 +1,119 @@
+#pragma once
+#include "common_math.h"
+#include "vector.h"
+#include "matrix.h"
+
+// Structure-of-arrays (SoA) maths types. Every wide type stores N values per
+// component so that one lane maps to one object. The loops over N have a fixed
+// trip count and compile to straight vector instructions (8 lanes in one AVX
+// register, 4 lanes in one SSE register), so culling, LOD and particle code can
+// work on 8 objects at a time without writing intrinsics.
+
+namespace sparky {
+	namespace maths {
+
+		template<int N>
+		struct alignas(N * sizeof(float)) floatx {
+			float v[N];
+
+			floatx() : v() {}
+			floatx(float k) : v() { for (int i = 0; i < N; ++i) v[i] = k; }
+
+			float& operator[](const int i) { return v[i]; }
+			float operator[](const int i) const { return v[i]; }
+
+			floatx operator+(const floatx& o) const { floatx r; for (int i = 0; i < N; ++i) r.v[i] = v[i] + o.v[i]; return r; }
+			floatx operator-(const floatx& o) const { floatx r; for (int i = 0; i < N; ++i) r.v[i] = v[i] - o.v[i]; return r; }
+			floatx operator*(const floatx& o) const { floatx r; for (int i = 0; i < N; ++i) r.v[i] = v[i] * o.v[i]; return r; }
+			floatx operator/(const floatx& o) const { floatx r; for (int i = 0; i < N; ++i) r.v[i] = v[i] / o.v[i]; return r; }
+		};
+
+		template<int N>
+		inline floatx<N> vmin(const floatx<N>& a, const floatx<N>& b) { floatx<N> r; for (int i = 0; i < N; ++i) r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i]; return r; }
+		template<int N>
+		inline floatx<N> vmax(const floatx<N>& a, const floatx<N>& b) { floatx<N> r; for (int i = 0; i < N; ++i) r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i]; return r; }
+		template<int N>
+		inline floatx<N> vsqrt(const floatx<N>& a) { floatx<N> r; for (int i = 0; i < N; ++i) r.v[i] = sqrtf(a.v[i]); return r; }
+
+		template<int N>
+		struct alignas(N * sizeof(float)) vec3xN {
+			floatx<N> x, y, z;
+
+			vec3xN() {}
+			vec3xN(const floatx<N>& x, const floatx<N>& y, const floatx<N>& z) : x(x), y(y), z(z) {}
+			// broadcast one vector to every lane
+			vec3xN(const vec3& v) : x(v.x), y(v.y), z(v.z) {}
+
+			vec3xN operator+(const vec3xN& o) const { return vec3xN(x + o.x, y + o.y, z + o.z); }
+			vec3xN operator-(const vec3xN& o) const { return vec3xN(x - o.x, y - o.y, z - o.z); }
+			vec3xN operator*(const floatx<N>& f) const { return vec3xN(x * f, y * f, z * f); }
+
+			vec3 get(int lane) const { return vec3(x.v[lane], y.v[lane], z.v[lane]); }
+			void set(int lane, const vec3& p) { x.v[lane] = p.x; y.v[lane] = p.y; z.v[lane] = p.z; }
+
+			// Gather count (<= N) AoS vectors, unused lanes are zero
+			static vec3xN load(const vec3* p, int count = N) {
+				vec3xN r;
+				for (int i = 0; i < count; ++i) r.set(i, p[i]);
+				return r;
+			}
+			void store(vec3* p, int count = N) const {
+				for (int i = 0; i < count; ++i) p[i] = get(i);
+			}
+		};
+
+		template<int N>
+		inline floatx<N> dot(const vec3xN<N>& a, const vec3xN<N>& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+		template<int N>
+		inline vec3xN<N> cross(const vec3xN<N>& a, const vec3xN<N>& b) {
+			return vec3xN<N>(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+		}
+		template<int N>
+		inline floatx<N> length(const vec3xN<N>& a) { return vsqrt(dot(a, a)); }
+
+		// N matrices in OpenGL layout, e[i] holds element i of every matrix
+		template<int N>
+		struct alignas(N * sizeof(float)) mat4xN {
+			floatx<N> e[16];
+
+			static mat4xN load(const mat4* m, int count = N) {
+				mat4xN r;
+				for (int l = 0; l < count; ++l) {
+					for (int i = 0; i < 16; ++i) r.e[i].v[l] = m[l].elements[i];
+				}
+				return r;
+			}
+
+			// Transform one point per lane (w = 1)
+			vec3xN<N> transformPoint(const vec3xN<N>& p) const {
+				return vec3xN<N>(
+					e[0] * p.x + e[4] * p.y + e[8] * p.z + e[12],
+					e[1] * p.x + e[5] * p.y + e[9] * p.z + e[13],
+					e[2] * p.x + e[6] * p.y + e[10] * p.z + e[14]);
+			}
+			// Largest axis scale, conservative radius multiplier for bounding spheres
+			floatx<N> maxScale() const {
+				floatx<N> sx = e[0] * e[0] + e[1] * e[1] + e[2] * e[2];
+				floatx<N> sy = e[4] * e[4] + e[5] * e[5] + e[6] * e[6];
+				floatx<N> sz = e[8] * e[8] + e[9] * e[9] + e[10] * e[10];
+				return vsqrt(vmax(sx, vmax(sy, sz)));
+			}
+		};
+
+		typedef floatx<4> floatx4;
+		typedef floatx<8> floatx8;
+		typedef vec3xN<4> vec3x4;
+		typedef vec3xN<8> vec3x8;
+		typedef mat4xN<8> mat4x8;
+
+		namespace bulk {
+			// out[i] = mat * points[i] (w = 1), eight points per step
+			void transformPoints(const mat4& mat, const vec3* points, vec3* out, size_t count);
+			// out[i] = |points[i] - camera|
+			void distances(const vec3& camera, const vec3* points, float* out, size_t count);
+			// World space bounding spheres from per-object model matrices and local spheres
+			void transformSpheres(const mat4* models, const vec3* centers, const float* radii,
+				vec3* outCenters, float* outRadii, size_t count);
+		}
+	}
+}
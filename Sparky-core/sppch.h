@@ -14,4 +14,6 @@
 
 #include "Log.h"
 
-#include <Windows.h>
\ No newline at end of file
+#ifdef _WIN32
+	#include <Windows.h>
+#endif
\ No newline at end of file
@@ -125,6 +125,53 @@ namespace sparky {
 		}
 
 		// vec4 methods
+#if SPARKY_SIMD_SSE
+		vec4 vec4::operator+(const vec4& v) {
+			return vec4(_mm_add_ps(m128, v.m128));
+		}
+		vec4 vec4::operator-(const vec4& v) {
+			return vec4(_mm_sub_ps(m128, v.m128));
+		}
+
+		vec4 vec4::operator+(const float f) {
+			return vec4(_mm_add_ps(m128, _mm_set1_ps(f)));
+		}
+		vec4 vec4::operator-(const float f) {
+			return vec4(_mm_sub_ps(m128, _mm_set1_ps(f)));
+		}
+		vec4 vec4::operator*(const float f) {
+			return vec4(_mm_mul_ps(m128, _mm_set1_ps(f)));
+		}
+		vec4 vec4::operator/(const float f) {
+			return vec4(_mm_div_ps(m128, _mm_set1_ps(f)));
+		}
+
+		void vec4::operator+=(const vec4& v) {
+			m128 = _mm_add_ps(m128, v.m128);
+		}
+		void vec4::operator-=(const vec4& v) {
+			m128 = _mm_sub_ps(m128, v.m128);
+		}
+		void vec4::operator+=(const float f) {
+			m128 = _mm_add_ps(m128, _mm_set1_ps(f));
+		}
+		void vec4::operator-=(const float f) {
+			m128 = _mm_sub_ps(m128, _mm_set1_ps(f));
+		}
+		void vec4::operator*=(const float f) {
+			m128 = _mm_mul_ps(m128, _mm_set1_ps(f));
+		}
+		void vec4::operator/=(const float f) {
+			m128 = _mm_div_ps(m128, _mm_set1_ps(f));
+		}
+
+		bool vec4::operator==(const vec4& v) {
+			return _mm_movemask_ps(_mm_cmpeq_ps(m128, v.m128)) == 0xF;
+		}
+		bool vec4::operator!=(const vec4& v) {
+			return _mm_movemask_ps(_mm_cmpeq_ps(m128, v.m128)) != 0xF;
+		}
+#else
 		vec4 vec4::operator+(const vec4& v) {
 			return vec4(x + v.x, y + v.y, z + v.z, w + v.w);
 		}
@@ -188,6 +235,7 @@ namespace sparky {
 		bool vec4::operator!=(const vec4& v) {
 			return x != v.x || y != v.y || z != v.z || w != v.w;
 		}
+#endif
 
 		std::ostream& operator<<(std::ostream& stream, const vec4& v) {
 			stream << "vec4: (" << v.x << ", " << v.y << ", " << v.z << ", " << v.w << ")";
@@ -198,5 +246,15 @@ namespace sparky {
 		float dot(const vec2& v1, const vec2& v2) {
 			return v1.x * v2.x + v1.y * v2.y;
 		}
+		float dot(const vec4& v1, const vec4& v2) {
+#if SPARKY_SIMD_SSE
+			__m128 m = _mm_mul_ps(v1.m128, v2.m128);
+			m = _mm_add_ps(m, _mm_movehl_ps(m, m));
+			m = _mm_add_ss(m, _mm_shuffle_ps(m, m, SPARKY_SHUFFLE(1, 1, 1, 1)));
+			return _mm_cvtss_f32(m);
+#else
+			return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z + v1.w * v2.w;
+#endif
+		}
 	}
 }
\ No newline at end of file
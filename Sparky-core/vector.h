@@ -1,5 +1,6 @@
 #pragma once
 #include "common_math.h"
+#include "simd.h"
 
 namespace sparky {
 	namespace maths {
@@ -77,18 +78,26 @@ namespace sparky {
 			friend std::ostream& operator<<(std::ostream& stream, const vec3& v);
 		};
 
-		struct vec4 {
+		// 16 byte aligned so that it can be loaded straight into an SSE register
+		struct alignas(16) vec4 {
 
 			union {
 				struct {
 					float x, y, z, w;
 				};
 				float coords[4];
+#if SPARKY_SIMD_SSE
+				__m128 m128;
+#endif
 			};
 
 			vec4() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
 			vec4(const float& k) : x(k), y(k), z(k), w(k) {}
+#if SPARKY_SIMD_SSE
+			vec4(const vec4& v) : m128(v.m128) {}
+#else
 			vec4(const vec4& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+#endif
 			vec4(const vec3& v, const float& w) : x(v.x), y(v.y), z(v.z), w(w) {}
 			vec4(const float& x, const vec3& v) : x(x), y(v.x), z(v.y), w(v.z) {}
 			vec4(const vec2& v1, const vec2& v2) :x(v1.x), y(v1.y), z(v2.x), w(v2.y) {}
@@ -96,6 +105,9 @@ namespace sparky {
 			vec4(const float& x, const vec2& v, const float& w) : x(x), y(v.x), z(v.y), w(w) {}
 			vec4(const vec2& v, const float& z, const float& w) : x(v.x), y(v.y), z(z), w(w) {}
 			vec4(const float& x, const float& y, const float& z, const float& w) : x(x), y(y), z(z), w(w) {};
+#if SPARKY_SIMD_SSE
+			vec4(const __m128& v) : m128(v) {}
+#endif
 
 			vec4 operator+(const vec4& v);
 			vec4 operator-(const vec4& v);
@@ -120,6 +132,7 @@ namespace sparky {
 		};
 
 		float dot(const vec2& v1, const vec2& v2);
+		float dot(const vec4& v1, const vec4& v2);
 		// static float cross(const vec2& v1, const vec2& v2);
 	}
 }
\ No newline at end of file
@@ -48,11 +48,21 @@ namespace sparky {
 		std::string Title;
 		unsigned int Width;
 		unsigned int Height;
+		// hidden windows still get a GL context, for headless replays
+		bool Visible;
+		// debug context with KHR_debug output routed to the log, on in debug builds
+		bool DebugContext;
 
 		WindowProps(const std::string& title = "Sparky Engine",
 			unsigned int width = 1280,
-			unsigned int height = 720)
-			: Title(title), Width(width), Height(height)
+			unsigned int height = 720,
+			bool visible = true)
+			: Title(title), Width(width), Height(height), Visible(visible)
+#ifdef _DEBUG
+			, DebugContext(true)
+#else
+			, DebugContext(false)
+#endif
 		{
 		}
 	};